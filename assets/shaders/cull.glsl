@@ -0,0 +1,106 @@
+#version 450
+
+// Culling por draw: testa a esfera envolvente de cada comando indireto contra
+// o frustum e, se houver, contra a pirâmide Hi-Z do frame anterior. Os
+// sobreviventes são compactados em visibleCommands, com o total em visibleCount.
+
+layout(local_size_x = 64) in;
+
+struct DrawCommand {
+    uint indexCount;
+    uint instanceCount;
+    uint firstIndex;
+    int vertexOffset;
+    uint firstInstance;
+};
+
+layout(std430, set = 0, binding = 0) readonly buffer Commands { DrawCommand commands[]; };
+layout(std430, set = 0, binding = 1) readonly buffer Bounds { vec4 spheres[]; }; // xyz centro, w raio
+layout(std430, set = 0, binding = 2) writeonly buffer Visible { DrawCommand visibleCommands[]; };
+layout(std430, set = 0, binding = 3) buffer Count { uint visibleCount; };
+layout(set = 0, binding = 4) uniform sampler2D hiz; // profundidade máxima por texel, mip a mip
+
+layout(std140, set = 0, binding = 5) uniform Params {
+    mat4 viewProj;
+    vec4 planes[6];   // normalizados, apontando para dentro
+    vec2 hizSize;     // tamanho do mip 0
+    float hizLevels;
+    uint drawCount;
+    uint flags;
+} params;
+
+const uint kFrustum = 1u;
+const uint kOcclusion = 2u;
+const uint kCompact = 4u;
+
+bool insideFrustum(vec4 sphere) {
+    for (int i = 0; i < 6; i++) {
+        if (dot(params.planes[i].xyz, sphere.xyz) + params.planes[i].w < -sphere.w) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool occluded(vec4 sphere) {
+    // Retângulo em tela e profundidade mais próxima da AABB da esfera
+    vec2 lo = vec2(1.0);
+    vec2 hi = vec2(-1.0);
+    float nearest = 1.0;
+    for (int i = 0; i < 8; i++) {
+        vec3 corner = sphere.xyz + sphere.w * vec3((i & 1) != 0 ? 1.0 : -1.0,
+                                                   (i & 2) != 0 ? 1.0 : -1.0,
+                                                   (i & 4) != 0 ? 1.0 : -1.0);
+        vec4 clip = params.viewProj * vec4(corner, 1.0);
+        if (clip.w <= 0.0) {
+            return false; // cruza o plano da câmera: conservadoramente visível
+        }
+        vec3 ndc = clip.xyz / clip.w;
+        lo = min(lo, ndc.xy);
+        hi = max(hi, ndc.xy);
+        nearest = min(nearest, ndc.z);
+    }
+
+    vec2 uvLo = clamp(lo * 0.5 + 0.5, 0.0, 1.0);
+    vec2 uvHi = clamp(hi * 0.5 + 0.5, 0.0, 1.0);
+
+    // Mip em que o retângulo cobre no máximo 2x2 texels
+    vec2 sizePx = (uvHi - uvLo) * params.hizSize;
+    float level = min(ceil(log2(max(max(sizePx.x, sizePx.y), 1.0))), params.hizLevels - 1.0);
+
+    float farthest = max(max(textureLod(hiz, uvLo, level).r, textureLod(hiz, vec2(uvHi.x, uvLo.y), level).r),
+                         max(textureLod(hiz, vec2(uvLo.x, uvHi.y), level).r, textureLod(hiz, uvHi, level).r));
+    return nearest > farthest;
+}
+
+void main() {
+    uint index = gl_GlobalInvocationID.x;
+    if (index >= params.drawCount) {
+        return;
+    }
+
+    DrawCommand command = commands[index];
+    vec4 sphere = spheres[index];
+
+    bool visible = command.instanceCount > 0;
+    if (visible && (params.flags & kFrustum) != 0u) {
+        visible = insideFrustum(sphere);
+    }
+    if (visible && (params.flags & kOcclusion) != 0u) {
+        visible = !occluded(sphere);
+    }
+
+    if ((params.flags & kCompact) != 0u) {
+        if (visible) {
+            visibleCommands[atomicAdd(visibleCount, 1u)] = command;
+        }
+    } else {
+        // Sem draw indirect count: mantém a posição e zera as instâncias descartadas
+        if (!visible) {
+            command.instanceCount = 0u;
+        } else {
+            atomicAdd(visibleCount, 1u);
+        }
+        visibleCommands[index] = command;
+    }
+}
@@ -0,0 +1,37 @@
+#version 450
+
+// Um nível da pirâmide Hi-Z: cada texel guarda a profundidade máxima (mais
+// distante) da região que cobre no nível anterior. No nível 0 a origem é o
+// próprio depth buffer, copiado com scale = 1.
+
+layout(local_size_x = 8, local_size_y = 8) in;
+
+layout(set = 0, binding = 0) uniform sampler2D src;
+layout(set = 0, binding = 1, r32f) uniform writeonly image2D dst;
+
+layout(push_constant) uniform Params {
+    ivec2 srcSize;
+    ivec2 dstSize;
+    int scale;
+} params;
+
+void main() {
+    ivec2 texel = ivec2(gl_GlobalInvocationID.xy);
+    if (any(greaterThanEqual(texel, params.dstSize))) {
+        return;
+    }
+
+    // A última linha/coluna também cobre o texel que sobra em tamanhos ímpares
+    ivec2 first = texel * params.scale;
+    ivec2 last = min(first + params.scale - 1, params.srcSize - 1);
+    if (texel.x == params.dstSize.x - 1) last.x = params.srcSize.x - 1;
+    if (texel.y == params.dstSize.y - 1) last.y = params.srcSize.y - 1;
+
+    float depth = 0.0;
+    for (int y = first.y; y <= last.y; y++) {
+        for (int x = first.x; x <= last.x; x++) {
+            depth = max(depth, texelFetch(src, ivec2(x, y), 0).r);
+        }
+    }
+    imageStore(dst, texel, vec4(depth));
+}
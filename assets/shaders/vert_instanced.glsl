@@ -0,0 +1,12 @@
+#version 450
+
+layout(location = 0) in vec2 inPosition;
+
+// Por instância (binding 1, VK_VERTEX_INPUT_RATE_INSTANCE)
+layout(location = 2) in vec2 inOffset;
+layout(location = 3) in float inScale;
+
+void main() {
+    // Cada instância escala e desloca o mesh em espaço clip
+    gl_Position = vec4(inPosition * inScale + inOffset, 0.0, 1.0);
+}
@@ -0,0 +1,17 @@
+#version 450
+
+layout(location = 0) in vec2 inPosition;
+
+// Por instância (binding 1, VK_VERTEX_INPUT_RATE_INSTANCE)
+layout(location = 2) in vec2 inOffset;
+layout(location = 3) in float inScale;
+
+// Constantes do frame, escritas no FrameArena e lidas via dynamic offset
+layout(set = 0, binding = 0) uniform Frame {
+    mat4 viewProjection;
+} frame;
+
+void main() {
+    vec2 position = inPosition * inScale + inOffset;
+    gl_Position = frame.viewProjection * vec4(position, 0.0, 1.0);
+}
@@ -0,0 +1,98 @@
+#include "BenchContext.h"
+#include "Benchmarks.h"
+
+#include "core/MemoryAllocator.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+namespace vke::bench {
+
+    namespace {
+
+        constexpr VkDeviceSize kBlockSize = 1ull << 30; // só offsets: não reserva memória
+        constexpr uint32_t kAllocations = 10000;
+        constexpr int kIterations = 30;
+
+        // Tamanhos de buffers típicos: muitos pequenos, alguns de dezenas de KB
+        std::vector<VkDeviceSize> makeSizes() {
+            std::mt19937 rng(11);
+            std::uniform_int_distribution<int> shift(8, 16);
+            std::vector<VkDeviceSize> sizes(kAllocations);
+            for (auto& size : sizes) {
+                VkDeviceSize base = 1ull << shift(rng);
+                size = base + rng() % base;
+            }
+            return sizes;
+        }
+
+    } // namespace
+
+    void runAllocatorBenchmark(BenchContext& context) {
+        std::vector<VkDeviceSize> sizes = makeSizes();
+        std::vector<VkDeviceSize> offsets(kAllocations);
+
+        // Ordem de liberação embaralhada: fragmenta e exercita a fusão de buddies
+        std::vector<uint32_t> freeOrder(kAllocations);
+        for (uint32_t i = 0; i < kAllocations; i++) {
+            freeOrder[i] = i;
+        }
+        std::shuffle(freeOrder.begin(), freeOrder.end(), std::mt19937(5));
+
+        auto allocateAll = [&](BlockAllocator& block) {
+            for (uint32_t i = 0; i < kAllocations; i++) {
+                if (!block.allocate(sizes[i], 256, offsets[i])) {
+                    throw std::runtime_error("Allocator benchmark ran out of block space!");
+                }
+            }
+        };
+
+        BuddyBlockAllocator buddy(kBlockSize);
+        SampleStats buddyStats = sampleMs(kIterations, [&] {
+            allocateAll(buddy);
+            for (uint32_t i : freeOrder) {
+                buddy.free(offsets[i], sizes[i]);
+            }
+        });
+
+        LinearBlockAllocator linear(kBlockSize);
+        SampleStats linearStats = sampleMs(kIterations, [&] {
+            allocateAll(linear);
+            for (uint32_t i : freeOrder) {
+                linear.free(offsets[i], sizes[i]);
+            }
+        });
+
+        // Caminho completo do device: lock, escolha do tipo e do bloco (blocos já reservados após a 1ª iteração)
+        MemoryAllocator& allocator = context.device().allocator();
+        VkMemoryRequirements requirements{};
+        requirements.alignment = 256;
+        requirements.memoryTypeBits = ~0u;
+        std::vector<MemoryAllocation> allocations(kAllocations);
+        SampleStats deviceStats = sampleMs(kIterations, [&] {
+            for (uint32_t i = 0; i < kAllocations; i++) {
+                requirements.size = sizes[i];
+                allocations[i] = allocator.allocate(requirements, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+            }
+            for (uint32_t i : freeOrder) {
+                allocator.free(allocations[i]);
+            }
+        });
+
+        context.report().add("allocator", "buddy_ms", buddyStats);
+        context.report().add("allocator", "linear_ms", linearStats);
+        context.report().add("allocator", "device_ms", deviceStats);
+
+        std::printf("allocator (%u allocations of 256 B - 128 KB, then freed in random order):\n", kAllocations);
+        std::printf("  buddy block : p50 %8.3f ms  p99 %8.3f ms  (%6.1f ns/op)\n",
+                    buddyStats.p50, buddyStats.p99, buddyStats.p50 * 1e6 / (2.0 * kAllocations));
+        std::printf("  linear block: p50 %8.3f ms  p99 %8.3f ms  (%6.1f ns/op)\n",
+                    linearStats.p50, linearStats.p99, linearStats.p50 * 1e6 / (2.0 * kAllocations));
+        std::printf("  device      : p50 %8.3f ms  p99 %8.3f ms  (%6.1f ns/op)\n",
+                    deviceStats.p50, deviceStats.p99, deviceStats.p50 * 1e6 / (2.0 * kAllocations));
+    }
+
+} // namespace vke::bench
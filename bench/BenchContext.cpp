@@ -0,0 +1,83 @@
+#include "BenchContext.h"
+
+#include "gfx/OffscreenTarget.h"
+
+#include <stdexcept>
+#include <vector>
+
+namespace vke::bench {
+
+    BenchContext::BenchContext() {
+        VkApplicationInfo appInfo{};
+        appInfo.sType = VK_STRUCTURE_TYPE_APPLICATION_INFO;
+        appInfo.pApplicationName = "vke_bench";
+        appInfo.pEngineName = "Vulkan Engine";
+        appInfo.apiVersion = VK_API_VERSION_1_0;
+
+        std::vector<const char*> extensions;
+        Device::appendInstanceExtensions(extensions);
+
+        VkInstanceCreateInfo createInfo{};
+        createInfo.sType = VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO;
+        createInfo.pApplicationInfo = &appInfo;
+        createInfo.enabledExtensionCount = static_cast<uint32_t>(extensions.size());
+        createInfo.ppEnabledExtensionNames = extensions.data();
+
+        if (vkCreateInstance(&createInfo, nullptr, &m_instance) != VK_SUCCESS) {
+            throw std::runtime_error("Fail to create Vulkan instance!");
+        }
+
+        // Sem surface: roda em máquinas sem display (ex.: CI com lavapipe).
+        // Cache de pipelines só em memória para não deixar arquivos para trás
+        m_device = std::make_unique<Device>(m_instance, VK_NULL_HANDLE, "");
+        createRenderPass();
+    }
+
+    BenchContext::~BenchContext() {
+        if (m_renderPass != VK_NULL_HANDLE) {
+            vkDestroyRenderPass(m_device->device(), m_renderPass, nullptr);
+        }
+        m_device.reset();
+        if (m_instance) {
+            vkDestroyInstance(m_instance, nullptr);
+        }
+    }
+
+    std::string BenchContext::deviceName() const {
+        VkPhysicalDeviceProperties properties;
+        vkGetPhysicalDeviceProperties(m_device->physicalDevice(), &properties);
+        return properties.deviceName;
+    }
+
+    // Render pass mínima compatível com o pipeline padrão
+    void BenchContext::createRenderPass() {
+        VkAttachmentDescription colorAttachment{};
+        colorAttachment.format = OffscreenTarget::kDefaultFormat;
+        colorAttachment.samples = VK_SAMPLE_COUNT_1_BIT;
+        colorAttachment.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
+        colorAttachment.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
+        colorAttachment.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+        colorAttachment.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+        colorAttachment.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+        colorAttachment.finalLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+
+        VkAttachmentReference colorAttachmentRef{ 0, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL };
+
+        VkSubpassDescription subpass{};
+        subpass.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
+        subpass.colorAttachmentCount = 1;
+        subpass.pColorAttachments = &colorAttachmentRef;
+
+        VkRenderPassCreateInfo renderPassInfo{};
+        renderPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO;
+        renderPassInfo.attachmentCount = 1;
+        renderPassInfo.pAttachments = &colorAttachment;
+        renderPassInfo.subpassCount = 1;
+        renderPassInfo.pSubpasses = &subpass;
+
+        if (vkCreateRenderPass(m_device->device(), &renderPassInfo, nullptr, &m_renderPass) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to create render pass!");
+        }
+    }
+
+} // namespace vke::bench
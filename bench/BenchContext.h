@@ -0,0 +1,71 @@
+#ifndef VKE_BENCHCONTEXT_H
+#define VKE_BENCHCONTEXT_H
+
+#include <vulkan/vulkan.h>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "BenchReport.h"
+#include "core/Device.h"
+
+namespace vke::bench {
+
+    // Instância + device headless mínimos para benchmarks, sem janela nem render loop.
+    class BenchContext {
+    public:
+        BenchContext();
+        ~BenchContext();
+
+        BenchContext(const BenchContext&) = delete;
+        BenchContext& operator=(const BenchContext&) = delete;
+
+        [[nodiscard]] Device& device() const { return *m_device; }
+
+        // Render pass de cor única (OffscreenTarget::kDefaultFormat) para compilar pipelines
+        [[nodiscard]] VkRenderPass renderPass() const { return m_renderPass; }
+
+        // Métricas exportadas em JSON (--json) e comparadas com o baseline (--baseline)
+        [[nodiscard]] BenchReport& report() { return m_report; }
+        [[nodiscard]] std::string deviceName() const;
+
+    private:
+        void createRenderPass();
+
+    private:
+        VkInstance m_instance = VK_NULL_HANDLE;
+        VkRenderPass m_renderPass = VK_NULL_HANDLE;
+        std::unique_ptr<Device> m_device;
+        BenchReport m_report;
+    };
+
+    // Cronômetro de parede simples
+    class Timer {
+    public:
+        Timer() : m_start(std::chrono::steady_clock::now()) {}
+
+        [[nodiscard]] double seconds() const {
+            return std::chrono::duration<double>(std::chrono::steady_clock::now() - m_start).count();
+        }
+
+    private:
+        std::chrono::steady_clock::time_point m_start;
+    };
+
+    // Executa fn iterations vezes e resume os tempos (ms) de cada execução
+    template <typename Fn>
+    SampleStats sampleMs(int iterations, Fn&& fn) {
+        std::vector<double> times;
+        times.reserve(iterations);
+        for (int i = 0; i < iterations; i++) {
+            Timer timer;
+            fn();
+            times.push_back(timer.seconds() * 1000.0);
+        }
+        return SampleStats::fromSamples(std::move(times));
+    }
+
+} // namespace vke::bench
+
+#endif // VKE_BENCHCONTEXT_H
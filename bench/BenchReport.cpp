@@ -0,0 +1,149 @@
+#include "BenchReport.h"
+
+#include "util/Json.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <numeric>
+#include <sstream>
+#include <stdexcept>
+
+namespace vke::bench {
+
+    namespace {
+
+        double percentile(const std::vector<double>& sorted, double fraction) {
+            auto rank = static_cast<size_t>(std::ceil(fraction * static_cast<double>(sorted.size())));
+            return sorted[std::clamp<size_t>(rank, 1, sorted.size()) - 1];
+        }
+
+        BenchResult readResult(const JsonValue& entry) {
+            BenchResult result;
+            result.benchmark = entry["benchmark"].getString();
+            result.metric = entry["metric"].getString();
+            SampleStats& s = result.stats;
+            s.count = static_cast<uint32_t>(entry["count"].getNumber());
+            s.min = entry["min"].getNumber();
+            s.p50 = entry["p50"].getNumber();
+            s.p95 = entry["p95"].getNumber();
+            s.p99 = entry["p99"].getNumber();
+            s.max = entry["max"].getNumber();
+            s.mean = entry["mean"].getNumber();
+            return result;
+        }
+
+    } // namespace
+
+    SampleStats SampleStats::fromSamples(std::vector<double> samples) {
+        SampleStats stats;
+        if (samples.empty()) {
+            return stats;
+        }
+        std::sort(samples.begin(), samples.end());
+        stats.count = static_cast<uint32_t>(samples.size());
+        stats.min = samples.front();
+        stats.p50 = percentile(samples, 0.50);
+        stats.p95 = percentile(samples, 0.95);
+        stats.p99 = percentile(samples, 0.99);
+        stats.max = samples.back();
+        stats.mean = std::accumulate(samples.begin(), samples.end(), 0.0) / static_cast<double>(samples.size());
+        return stats;
+    }
+
+    void BenchReport::add(const std::string& benchmark, const std::string& metric, const SampleStats& stats) {
+        m_results.push_back({ benchmark, metric, stats });
+    }
+
+    void BenchReport::add(const std::string& benchmark, const std::string& metric, std::vector<double> samplesMs) {
+        add(benchmark, metric, SampleStats::fromSamples(std::move(samplesMs)));
+    }
+
+    void BenchReport::writeJson(const std::string& path, const std::string& deviceName) const {
+        std::ofstream out(path, std::ios::trunc);
+        if (!out) {
+            throw std::runtime_error("Failed to open benchmark report: " + path);
+        }
+
+        char line[256];
+        out << "{\n\"version\": 1,\n\"device\": ";
+        writeJsonString(out, deviceName);
+        out << ",\n\"results\": [";
+        for (size_t i = 0; i < m_results.size(); i++) {
+            const BenchResult& result = m_results[i];
+            const SampleStats& s = result.stats;
+            out << (i == 0 ? "\n" : ",\n") << "{\"benchmark\": ";
+            writeJsonString(out, result.benchmark);
+            out << ", \"metric\": ";
+            writeJsonString(out, result.metric);
+            std::snprintf(line, sizeof(line),
+                          ", \"count\": %u, \"min\": %.6f, \"p50\": %.6f, \"p95\": %.6f, \"p99\": %.6f, \"max\": %.6f, \"mean\": %.6f}",
+                          s.count, s.min, s.p50, s.p95, s.p99, s.max, s.mean);
+            out << line;
+        }
+        out << "\n]\n}\n";
+
+        if (!out) {
+            throw std::runtime_error("Failed to write benchmark report: " + path);
+        }
+    }
+
+    std::vector<BenchResult> BenchReport::readJson(const std::string& path, std::string* deviceName) {
+        std::ifstream in(path);
+        if (!in) {
+            throw std::runtime_error("Failed to open benchmark baseline: " + path);
+        }
+        std::stringstream buffer;
+        buffer << in.rdbuf();
+        std::string text = buffer.str();
+
+        JsonValue document = JsonValue::parse(text, path);
+        if (!document.isObject()) {
+            throw std::runtime_error("Invalid benchmark JSON: " + path);
+        }
+        if (deviceName) {
+            *deviceName = document["device"].getString();
+        }
+        std::vector<BenchResult> results;
+        const JsonValue& entries = document["results"];
+        results.reserve(entries.size());
+        for (const JsonValue& entry : entries.getArray()) {
+            results.push_back(readResult(entry));
+        }
+        return results;
+    }
+
+    uint32_t BenchReport::compareWithBaseline(const std::string& path, double tolerance) const {
+        std::string baselineDevice;
+        std::vector<BenchResult> baseline = readJson(path, &baselineDevice);
+
+        std::printf("baseline comparison against %s (%s), p50, tolerance %.0f%%:\n",
+                    path.c_str(), baselineDevice.c_str(), tolerance * 100.0);
+        uint32_t regressions = 0;
+        uint32_t compared = 0;
+        for (const BenchResult& result : m_results) {
+            auto match = std::find_if(baseline.begin(), baseline.end(), [&](const BenchResult& entry) {
+                return entry.benchmark == result.benchmark && entry.metric == result.metric;
+            });
+            if (match == baseline.end()) {
+                std::printf("  %-40s %10s -> %10.4f ms  (new)\n",
+                            (result.benchmark + "." + result.metric).c_str(), "-", result.stats.p50);
+                continue;
+            }
+            compared++;
+
+            double before = match->stats.p50;
+            double after = result.stats.p50;
+            double change = before > 0.0 ? (after - before) / before : 0.0;
+            bool regressed = change > tolerance && after - before > kMinRegressionMs;
+            regressions += regressed ? 1 : 0;
+            std::printf("  %-40s %10.4f -> %10.4f ms  %+6.1f%%%s\n",
+                        (result.benchmark + "." + result.metric).c_str(), before, after, change * 100.0,
+                        regressed ? "  REGRESSION" : "");
+        }
+        std::printf("  %u metric(s) compared, %u regression(s)\n", compared, regressions);
+        return regressions;
+    }
+
+} // namespace vke::bench
@@ -0,0 +1,60 @@
+#ifndef VKE_BENCHREPORT_H
+#define VKE_BENCHREPORT_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace vke::bench {
+
+    // Resumo de uma série de amostras (percentis por nearest-rank)
+    struct SampleStats {
+        uint32_t count = 0;
+        double min = 0.0;
+        double p50 = 0.0;
+        double p95 = 0.0;
+        double p99 = 0.0;
+        double max = 0.0;
+        double mean = 0.0;
+
+        static SampleStats fromSamples(std::vector<double> samples);
+    };
+
+    // Uma métrica de um benchmark; todas são tempos em ms (menor é melhor)
+    struct BenchResult {
+        std::string benchmark;
+        std::string metric;
+        SampleStats stats;
+    };
+
+    // Resultados de uma execução do vke_bench, exportados em JSON e comparáveis
+    // com um arquivo de baseline gravado antes (o mesmo formato)
+    class BenchReport {
+    public:
+        // Diferenças absolutas abaixo disso são ruído de medida, não regressão
+        static constexpr double kMinRegressionMs = 0.005;
+
+        void add(const std::string& benchmark, const std::string& metric, const SampleStats& stats);
+        void add(const std::string& benchmark, const std::string& metric, std::vector<double> samplesMs);
+
+        [[nodiscard]] const std::vector<BenchResult>& getResults() const { return m_results; }
+
+        void writeJson(const std::string& path, const std::string& deviceName) const;
+
+        /**
+         * Compara o p50 de cada métrica com a do baseline e imprime a tabela.
+         * Uma métrica regride se ficou mais de tolerance (fração) acima do baseline.
+         * @return número de métricas que regrediram
+         */
+        uint32_t compareWithBaseline(const std::string& path, double tolerance) const;
+
+        // Lê um arquivo gravado por writeJson; deviceName recebe o device da gravação
+        static std::vector<BenchResult> readJson(const std::string& path, std::string* deviceName = nullptr);
+
+    private:
+        std::vector<BenchResult> m_results;
+    };
+
+} // namespace vke::bench
+
+#endif // VKE_BENCHREPORT_H
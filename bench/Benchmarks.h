@@ -0,0 +1,63 @@
+#ifndef VKE_BENCHMARKS_H
+#define VKE_BENCHMARKS_H
+
+namespace vke::bench {
+
+    class BenchContext;
+
+    // Throughput de upload: caminho antigo (HOST_VISIBLE + map/memcpy) vs staging para DEVICE_LOCAL
+    void runUploadBenchmark(BenchContext& context);
+
+    // Tempo de vkCreateGraphicsPipelines com cache vazio vs cache recarregado do disco
+    void runPipelineCacheBenchmark(BenchContext& context);
+
+    // Tempo de frame (p50/p99) com materiais novos chegando: compilação síncrona vs em segundo plano
+    void runPipelineStreamBenchmark(BenchContext& context);
+
+    // Tempo de CPU para gravar 100k draws em secundários, por número de threads
+    void runRecordBenchmark(BenchContext& context);
+
+    // Custo de lançar/roubar jobs e escalabilidade do parallelFor, por número de threads
+    void runJobBenchmark(BenchContext& context);
+
+    // Draw calls e tempo de CPU (gravação + submit) de 10k cópias de um mesh: draws avulsos vs um draw instanciado
+    void runInstancingBenchmark(BenchContext& context);
+
+    // Tempo de CPU para submeter N meshes distintos: draw por mesh vs geometria empacotada + multi-draw indireto
+    void runIndirectBenchmark(BenchContext& context);
+
+    // Tempo de frame com 80% dos meshes fora da tela: lista indireta completa vs culling por compute;
+    // e com 80% atrás de uma parede no depth: só frustum vs frustum + oclusão Hi-Z (meshes visíveis em cada um)
+    void runGpuCullBenchmark(BenchContext& context);
+
+    // Culling de 1M esferas contra o frustum na CPU: kernel escalar vs SSE/AVX2/NEON e com várias threads
+    void runCpuCullBenchmark(BenchContext& context);
+
+    // Atualização de transformações de 1M nós: tudo sujo, 1% sujo e nada sujo, por número de threads
+    void runSceneBenchmark(BenchContext& context);
+
+    // Custo de CPU de 10k blocos de constantes por frame: um uniform buffer por draw vs arena por frame
+    void runFrameArenaBenchmark(BenchContext& context);
+
+    // Custo de CPU de 10k draws com materiais diferentes: set alocado e ligado por draw vs tabela global + índice por push constant
+    void runDescriptorBenchmark(BenchContext& context);
+
+    // Alocar/liberar 10k faixas de tamanhos mistos: alocadores buddy e linear isolados e o MemoryAllocator do device
+    void runAllocatorBenchmark(BenchContext& context);
+
+    // Solda de vértices e bounds de uma grade de 1,5M vértices não indexada
+    void runMeshBenchmark(BenchContext& context);
+
+    // Importação de um .glb com 64 meshes e ~1M triângulos: primitivas em série vs em paralelo no JobSystem,
+    // e o mesmo arquivo carregado pelo Renderer::loadModel e desenhado em frames headless
+    void runGltfBenchmark(BenchContext& context);
+
+    // Cenários headless de ponta a ponta (p50/p95/p99 de CPU e frame): muitos draws, muitas instâncias, mesh grande
+    void runScenarioBenchmark(BenchContext& context);
+
+    // Binds e tempo de CPU de 20k draws com pipelines/materiais/meshes misturados: ordem de chegada vs fila ordenada por chave
+    void runRenderQueueBenchmark(BenchContext& context);
+
+} // namespace vke::bench
+
+#endif // VKE_BENCHMARKS_H
@@ -0,0 +1,100 @@
+#include "BenchContext.h"
+#include "Benchmarks.h"
+
+#include "core/JobSystem.h"
+#include "gfx/FrustumCulling.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace vke::bench {
+
+    namespace {
+
+        constexpr uint32_t kObjectCount = 1000000;
+        constexpr uint32_t kGrain = 16384;
+        constexpr int kIterations = 15;
+
+        // Perspectiva de 90 graus olhando para +z, profundidade 0..1 (column-major)
+        std::array<float, 16> makeViewProjection() {
+            constexpr float kNear = 0.1f;
+            constexpr float kFar = 100.0f;
+            return { 1.0f, 0.0f, 0.0f,                             0.0f,
+                     0.0f, 1.0f, 0.0f,                             0.0f,
+                     0.0f, 0.0f, kFar / (kFar - kNear),            1.0f,
+                     0.0f, 0.0f, -kNear * kFar / (kFar - kNear),   0.0f };
+        }
+
+    } // namespace
+
+    void runCpuCullBenchmark(BenchContext& context) {
+        // Esferas espalhadas em volta da câmera: cerca de um sexto fica no frustum
+        std::mt19937 rng(42);
+        std::uniform_real_distribution<float> position(-100.0f, 100.0f);
+        std::uniform_real_distribution<float> radius(0.1f, 2.0f);
+        BoundsSoA bounds;
+        bounds.reserve(kObjectCount);
+        for (uint32_t i = 0; i < kObjectCount; i++) {
+            BoundingSphere sphere;
+            sphere.center[0] = position(rng);
+            sphere.center[1] = position(rng);
+            sphere.center[2] = position(rng);
+            sphere.radius = radius(rng);
+            bounds.add(sphere);
+        }
+        Frustum frustum = Frustum::fromViewProjection(makeViewProjection());
+
+        std::vector<uint32_t> reference(kObjectCount);
+        std::vector<uint32_t> visible(kObjectCount);
+        uint32_t referenceCount = cullSpheres(frustum, bounds, 0, kObjectCount, reference.data(), CullKernel::Scalar);
+
+        std::printf("cpu_cull (%u spheres x 6 planes, %u visible; dispatch picks %s):\n",
+                    kObjectCount, referenceCount, cullKernelName(bestCullKernel()));
+
+        double scalarMs = 0.0;
+        for (CullKernel kernel : { CullKernel::Scalar, CullKernel::SSE, CullKernel::AVX2, CullKernel::NEON }) {
+            if (!isCullKernelSupported(kernel)) {
+                continue;
+            }
+            uint32_t count = 0;
+            SampleStats stats = sampleMs(kIterations, [&] {
+                count = cullSpheres(frustum, bounds, 0, kObjectCount, visible.data(), kernel);
+            });
+            context.report().add("cpu_cull", std::string(cullKernelName(kernel)) + "_ms", stats);
+            double ms = stats.p50;
+            if (kernel == CullKernel::Scalar) {
+                scalarMs = ms;
+            }
+            bool matches = count == referenceCount &&
+                           std::equal(reference.begin(), reference.begin() + count, visible.begin());
+            std::printf("  %-6s %8.3f ms  %7.1f Mobj/s  (%.1fx vs scalar)%s\n",
+                        cullKernelName(kernel), ms, kObjectCount / ms / 1000.0, scalarMs / ms,
+                        matches ? "" : "  MISMATCH");
+        }
+
+        // Faixas disjuntas em paralelo: cada faixa compacta no seu trecho da saída
+        uint32_t maxThreads = std::max(1u, std::thread::hardware_concurrency());
+        for (uint32_t threads = 2; threads <= maxThreads; threads *= 2) {
+            JobSystem jobs(threads);
+            std::atomic<uint32_t> total{ 0 };
+            SampleStats stats = sampleMs(kIterations, [&] {
+                total = 0;
+                jobs.parallelFor(kObjectCount, kGrain, [&](uint32_t begin, uint32_t end) {
+                    uint32_t count = cullSpheres(frustum, bounds, begin, end, visible.data() + begin, bestCullKernel());
+                    total.fetch_add(count, std::memory_order_relaxed);
+                });
+            });
+            context.report().add("cpu_cull", "threads" + std::to_string(threads) + "_ms", stats);
+            double ms = stats.p50;
+            std::printf("  %-6s %8.3f ms  %7.1f Mobj/s  (%u threads)%s\n",
+                        cullKernelName(bestCullKernel()), ms, kObjectCount / ms / 1000.0, threads,
+                        total == referenceCount ? "" : "  MISMATCH");
+        }
+    }
+
+} // namespace vke::bench
@@ -0,0 +1,144 @@
+#include "BenchContext.h"
+#include "Benchmarks.h"
+#include "SubmitHarness.h"
+
+#include "gfx/Buffer.h"
+#include "gfx/DescriptorAllocator.h"
+#include "gfx/OffscreenTarget.h"
+#include "gfx/PipelineRegistry.h"
+#include "gfx/ResourceTable.h"
+#include "gfx/Vertex.h"
+#include "gfx/VertexBuffer.h"
+
+#include <cstdio>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+namespace vke::bench {
+
+    namespace {
+
+        constexpr uint32_t kDrawsPerFrame = 10000;
+        constexpr uint32_t kMaterials = 32; // cabe também na tabela de fallback
+        constexpr uint32_t kExtent = 64;
+        constexpr int kIterations = 20;
+
+        // Índices do draw na tabela; o layout de push constants dos shaders bindless
+        struct DrawIndices {
+            uint32_t material;
+            uint32_t instance;
+        };
+
+    } // namespace
+
+    void runDescriptorBenchmark(BenchContext& context) {
+        Device& device = context.device();
+        PipelineRegistry& pipelines = device.pipelines();
+
+        VertexBuffer triangle(device);
+        triangle.create({
+            { { 0.0f,  -0.5f }, { 1.0f, 0.0f, 0.0f } },
+            { { 0.5f,   0.5f }, { 0.0f, 1.0f, 0.0f } },
+            { { -0.5f, -0.5f }, { 0.0f, 0.0f, 1.0f } }
+        });
+
+        // Um pequeno storage buffer por material
+        std::vector<std::unique_ptr<Buffer>> materials;
+        for (uint32_t i = 0; i < kMaterials; i++) {
+            auto buffer = std::make_unique<Buffer>(device);
+            buffer->create(64, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+                           VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+            materials.push_back(std::move(buffer));
+        }
+
+        // Antes: um set por draw com o buffer do material, alocado de pools por frame
+        VkDescriptorSetLayoutBinding binding{};
+        binding.binding = 0;
+        binding.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+        binding.descriptorCount = 1;
+        binding.stageFlags = VK_SHADER_STAGE_ALL_GRAPHICS;
+        VkDescriptorSetLayoutCreateInfo setLayoutInfo{};
+        setLayoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+        setLayoutInfo.bindingCount = 1;
+        setLayoutInfo.pBindings = &binding;
+        VkDescriptorSetLayout perDrawSetLayout = VK_NULL_HANDLE;
+        if (vkCreateDescriptorSetLayout(device.device(), &setLayoutInfo, nullptr, &perDrawSetLayout) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to create per-draw descriptor set layout!");
+        }
+        VkPipelineLayoutCreateInfo layoutInfo{};
+        layoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+        layoutInfo.setLayoutCount = 1;
+        layoutInfo.pSetLayouts = &perDrawSetLayout;
+        VkPipelineLayout perDrawLayout = VK_NULL_HANDLE;
+        if (vkCreatePipelineLayout(device.device(), &layoutInfo, nullptr, &perDrawLayout) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to create per-draw pipeline layout!");
+        }
+        FrameDescriptorAllocator perDrawSets(device, 1, { { VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1024 } }, 1024);
+
+        // Depois: tabela ligada uma vez, índice do material por push constant
+        ResourceTable table(device, 1);
+        std::vector<uint32_t> materialIndices;
+        for (const auto& buffer : materials) {
+            materialIndices.push_back(table.registerBuffer(buffer->getBuffer()));
+        }
+
+        // Os shaders de triângulo não leem descritores; o custo medido é o de CPU do bind
+        PipelineKey key{};
+        key.vertexShader = pipelines.registerShader("shaders/vert.spv");
+        key.fragmentShader = pipelines.registerShader("shaders/frag.spv");
+        key.vertexLayout = pipelines.registerVertexLayout(Vertex::getVertexLayout());
+        key.colorFormat = OffscreenTarget::kDefaultFormat;
+        key.pipelineLayout = pipelines.registerPipelineLayout(perDrawLayout);
+        VkPipeline perDrawPipeline = pipelines.getPipeline(key, context.renderPass());
+        key.pipelineLayout = pipelines.registerPipelineLayout(table.getPipelineLayout());
+        VkPipeline tablePipeline = pipelines.getPipeline(key, context.renderPass());
+
+        SubmitHarness harness(context, kExtent);
+
+        SubmitTiming perDraw = harness.measure(kIterations, [&](VkCommandBuffer commandBuffer) {
+            // O harness espera a fence a cada iteração: os sets do frame anterior já estão livres
+            perDrawSets.beginFrame(0);
+            vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, perDrawPipeline);
+            triangle.bind(commandBuffer);
+            for (uint32_t i = 0; i < kDrawsPerFrame; i++) {
+                VkDescriptorSet set = perDrawSets.allocate(perDrawSetLayout);
+                VkDescriptorBufferInfo bufferInfo{ materials[i % kMaterials]->getBuffer(), 0, VK_WHOLE_SIZE };
+                VkWriteDescriptorSet write{};
+                write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+                write.dstSet = set;
+                write.dstBinding = 0;
+                write.descriptorCount = 1;
+                write.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+                write.pBufferInfo = &bufferInfo;
+                vkUpdateDescriptorSets(device.device(), 1, &write, 0, nullptr);
+                vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, perDrawLayout,
+                                        0, 1, &set, 0, nullptr);
+                vkCmdDraw(commandBuffer, 3, 1, 0, 0);
+            }
+        });
+
+        SubmitTiming indexed = harness.measure(kIterations, [&](VkCommandBuffer commandBuffer) {
+            table.beginFrame(0);
+            vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, tablePipeline);
+            triangle.bind(commandBuffer);
+            table.bind(commandBuffer);
+            for (uint32_t i = 0; i < kDrawsPerFrame; i++) {
+                table.push(commandBuffer, DrawIndices{ materialIndices[i % kMaterials], i });
+                vkCmdDraw(commandBuffer, 3, 1, 0, 0);
+            }
+        });
+
+        std::printf("descriptors (%u draws per frame, %u materials; table mode %s, %u buffers / %u textures):\n",
+                    kDrawsPerFrame, kMaterials, table.isBindless() ? "bindless" : "per-frame fallback",
+                    table.getBufferCapacity(), table.getTextureCapacity());
+        std::printf("  set per draw       : cpu %8.3f ms, frame %8.3f ms (%u pools)\n",
+                    perDraw.cpuMs, perDraw.frameMs, perDrawSets.getPoolCount());
+        std::printf("  table + push index : cpu %8.3f ms, frame %8.3f ms (%.1fx cpu)\n",
+                    indexed.cpuMs, indexed.frameMs, perDraw.cpuMs / indexed.cpuMs);
+
+        vkDestroyPipelineLayout(device.device(), perDrawLayout, nullptr);
+        vkDestroyDescriptorSetLayout(device.device(), perDrawSetLayout, nullptr);
+    }
+
+} // namespace vke::bench
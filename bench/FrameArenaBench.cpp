@@ -0,0 +1,87 @@
+#include "BenchContext.h"
+#include "Benchmarks.h"
+
+#include "gfx/Buffer.h"
+#include "gfx/FrameArena.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace vke::bench {
+
+    namespace {
+
+        constexpr uint32_t kDrawsPerFrame = 10000;
+        constexpr uint32_t kFramesInFlight = 2;
+        constexpr int kIterations = 9;
+
+        // Constantes típicas de um draw: model-view-projection + cor
+        struct DrawUniforms {
+            std::array<float, 16> modelViewProjection;
+            std::array<float, 4> color;
+        };
+
+        // Mediana, em microssegundos por frame
+        double measure(const std::function<void()>& frame) {
+            std::vector<double> times;
+            for (int i = 0; i < kIterations; i++) {
+                Timer timer;
+                frame();
+                times.push_back(timer.seconds() * 1e6);
+            }
+            std::sort(times.begin(), times.end());
+            return times[times.size() / 2];
+        }
+
+    } // namespace
+
+    void runFrameArenaBenchmark(BenchContext& context) {
+        Device& device = context.device();
+        DrawUniforms uniforms{};
+        uniforms.modelViewProjection[0] = 1.0f;
+        uniforms.color = { 1.0f, 0.5f, 0.25f, 1.0f };
+
+        // Sem arena: um uniform buffer por draw, criado e preenchido a cada frame
+        std::vector<std::unique_ptr<Buffer>> buffers;
+        buffers.reserve(kDrawsPerFrame);
+        double perDrawUs = measure([&] {
+            buffers.clear();
+            for (uint32_t i = 0; i < kDrawsPerFrame; i++) {
+                auto buffer = std::make_unique<Buffer>(device);
+                buffer->create(sizeof(DrawUniforms), VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
+                               VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+                buffer->uploadData(&uniforms, sizeof(DrawUniforms));
+                buffers.push_back(std::move(buffer));
+            }
+        });
+        buffers.clear();
+
+        // Arena: bump pointer na região do slot, offsets usados como dynamic offsets
+        FrameArena arena(device, kFramesInFlight, 4u << 20);
+        uint32_t slot = 0;
+        uint64_t offsetSum = 0;
+        double arenaUs = measure([&] {
+            arena.beginFrame(slot);
+            for (uint32_t i = 0; i < kDrawsPerFrame; i++) {
+                offsetSum += arena.pushUniform(uniforms);
+            }
+            arena.flush();
+            slot = (slot + 1) % kFramesInFlight;
+        });
+
+        std::printf("frame_arena (%u draws x %zu bytes of uniforms per frame, alignment %llu):\n",
+                    kDrawsPerFrame, sizeof(DrawUniforms),
+                    static_cast<unsigned long long>(device.properties().limits.minUniformBufferOffsetAlignment));
+        std::printf("  buffer per draw : %10.1f us/frame\n", perDrawUs);
+        std::printf("  frame arena     : %10.1f us/frame (%.0fx, peak %llu KB of %llu KB)%s\n",
+                    arenaUs, perDrawUs / arenaUs,
+                    static_cast<unsigned long long>(arena.getPeakUsed() / 1024),
+                    static_cast<unsigned long long>(arena.getCapacityPerFrame() / 1024),
+                    offsetSum == 0 ? " (no allocations?)" : "");
+    }
+
+} // namespace vke::bench
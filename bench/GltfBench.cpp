@@ -0,0 +1,159 @@
+#include "BenchContext.h"
+#include "Benchmarks.h"
+
+#include "core/Engine.h"
+#include "core/JobSystem.h"
+#include "util/GltfImporter.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace vke::bench {
+
+    namespace {
+
+        constexpr uint32_t kMeshes = 64;
+        constexpr uint32_t kGrid = 91; // 91 x 91 quads por mesh: 64 * 16562 ≈ 1,06M triângulos
+        constexpr int kIterations = 5;
+        constexpr int kExtent = 512;
+        constexpr uint32_t kFrames = 60;
+
+        template <typename T>
+        void append(std::vector<uint8_t>& out, const T& value) {
+            const auto* bytes = reinterpret_cast<const uint8_t*>(&value);
+            out.insert(out.end(), bytes, bytes + sizeof(T));
+        }
+
+        // .glb sintético no formato típico de exportador: POSITION float, COLOR_0 em
+        // bytes normalizados e índices de 16 bits, um nó por mesh sob uma raiz
+        void writeSyntheticGlb(const std::string& path) {
+            constexpr uint32_t vertexCount = (kGrid + 1) * (kGrid + 1);
+            constexpr uint32_t indexCount = kGrid * kGrid * 6;
+
+            std::vector<uint8_t> bin;
+            std::string views, accessors, meshes, nodes, children;
+            char text[512];
+            for (uint32_t mesh = 0; mesh < kMeshes; mesh++) {
+                size_t positionOffset = bin.size();
+                for (uint32_t y = 0; y <= kGrid; y++) {
+                    for (uint32_t x = 0; x <= kGrid; x++) {
+                        append(bin, static_cast<float>(x) / kGrid);
+                        append(bin, static_cast<float>(y) / kGrid);
+                        append(bin, 0.0f);
+                    }
+                }
+                size_t colorOffset = bin.size();
+                for (uint32_t i = 0; i < vertexCount; i++) {
+                    uint8_t color[4] = { static_cast<uint8_t>(i), static_cast<uint8_t>(mesh * 4), 128, 255 };
+                    bin.insert(bin.end(), color, color + 4);
+                }
+                size_t indexOffset = bin.size();
+                for (uint32_t y = 0; y < kGrid; y++) {
+                    for (uint32_t x = 0; x < kGrid; x++) {
+                        auto a = static_cast<uint16_t>(y * (kGrid + 1) + x);
+                        auto c = static_cast<uint16_t>(a + kGrid + 1);
+                        for (uint16_t index : { a, static_cast<uint16_t>(a + 1), c, static_cast<uint16_t>(a + 1),
+                                                static_cast<uint16_t>(c + 1), c }) {
+                            append(bin, index);
+                        }
+                    }
+                }
+                bin.resize((bin.size() + 3) & ~size_t(3));
+
+                uint32_t view = mesh * 3;
+                std::snprintf(text, sizeof(text),
+                              "%s{\"buffer\":0,\"byteOffset\":%zu,\"byteLength\":%zu},"
+                              "{\"buffer\":0,\"byteOffset\":%zu,\"byteLength\":%zu},"
+                              "{\"buffer\":0,\"byteOffset\":%zu,\"byteLength\":%zu}",
+                              mesh ? "," : "", positionOffset, colorOffset - positionOffset,
+                              colorOffset, indexOffset - colorOffset, indexOffset, size_t(indexCount) * 2);
+                views += text;
+                std::snprintf(text, sizeof(text),
+                              "%s{\"bufferView\":%u,\"componentType\":5126,\"count\":%u,\"type\":\"VEC3\"},"
+                              "{\"bufferView\":%u,\"componentType\":5121,\"normalized\":true,\"count\":%u,\"type\":\"VEC4\"},"
+                              "{\"bufferView\":%u,\"componentType\":5123,\"count\":%u,\"type\":\"SCALAR\"}",
+                              mesh ? "," : "", view, vertexCount, view + 1, vertexCount, view + 2, indexCount);
+                accessors += text;
+                std::snprintf(text, sizeof(text),
+                              "%s{\"primitives\":[{\"attributes\":{\"POSITION\":%u,\"COLOR_0\":%u},\"indices\":%u}]}",
+                              mesh ? "," : "", view, view + 1, view + 2);
+                meshes += text;
+                std::snprintf(text, sizeof(text), ",{\"mesh\":%u,\"translation\":[%.3f,%.3f,0]}",
+                              mesh, static_cast<float>(mesh % 8) - 4.0f, static_cast<float>(mesh / 8) - 4.0f);
+                nodes += text;
+                std::snprintf(text, sizeof(text), "%s%u", mesh ? "," : "", mesh + 1);
+                children += text;
+            }
+
+            std::string json = "{\"asset\":{\"version\":\"2.0\"},\"scene\":0,\"scenes\":[{\"nodes\":[0]}],"
+                               "\"nodes\":[{\"name\":\"root\",\"children\":[" + children + "]}" + nodes + "],"
+                               "\"meshes\":[" + meshes + "],\"accessors\":[" + accessors + "],"
+                               "\"bufferViews\":[" + views + "],\"buffers\":[{\"byteLength\":" +
+                               std::to_string(bin.size()) + "}]}";
+            json.resize((json.size() + 3) & ~size_t(3), ' ');
+
+            std::vector<uint8_t> glb;
+            append(glb, 0x46546C67u);
+            append(glb, 2u);
+            append(glb, static_cast<uint32_t>(12 + 8 + json.size() + 8 + bin.size()));
+            append(glb, static_cast<uint32_t>(json.size()));
+            append(glb, 0x4E4F534Au);
+            glb.insert(glb.end(), json.begin(), json.end());
+            append(glb, static_cast<uint32_t>(bin.size()));
+            append(glb, 0x004E4942u);
+            glb.insert(glb.end(), bin.begin(), bin.end());
+
+            std::ofstream out(path, std::ios::binary | std::ios::trunc);
+            out.write(reinterpret_cast<const char*>(glb.data()), static_cast<std::streamsize>(glb.size()));
+        }
+
+    } // namespace
+
+    void runGltfBenchmark(BenchContext& context) {
+        std::string path = (std::filesystem::temp_directory_path() / "vke_bench_scene.glb").string();
+        writeSyntheticGlb(path);
+
+        size_t triangles = 0;
+        SampleStats serial = sampleMs(kIterations, [&] {
+            triangles = GltfImporter::load(path).getTriangleCount();
+        });
+
+        // Uma thread por núcleo; as 64 primitivas são distribuídas entre elas
+        uint32_t threads = std::max(1u, std::thread::hardware_concurrency());
+        JobSystem jobs(threads);
+        SampleStats parallel = sampleMs(kIterations, [&] { GltfImporter::load(path, &jobs); });
+
+        // Caminho completo do app (--mesh): import, pool dimensionado pela cena e upload
+        // pelo Renderer::loadModel, depois frames headless desenhando a cena carregada
+        SampleStats rendererLoad;
+        double frameMs = 0.0;
+        {
+            Engine engine("vke_bench", kExtent, kExtent, true);
+            rendererLoad = sampleMs(kIterations, [&] { engine.loadModel(path); });
+            double fps = engine.runHeadless(kFrames);
+            frameMs = fps > 0.0 ? 1000.0 / fps : 0.0;
+        }
+        std::filesystem::remove(path);
+
+        context.report().add("gltf", "import_serial_ms", serial);
+        context.report().add("gltf", "import_parallel_ms", parallel);
+        context.report().add("gltf", "renderer_load_ms", rendererLoad);
+        context.report().add("gltf", "renderer_frame_ms", std::vector<double>{ frameMs });
+
+        std::printf("gltf (.glb with %u meshes, %zu triangles, uint16 indices + ubyte colors):\n", kMeshes, triangles);
+        std::printf("  serial      : p50 %8.3f ms  p99 %8.3f ms  (%6.1f Mtri/s)\n",
+                    serial.p50, serial.p99, triangles / serial.p50 / 1000.0);
+        std::printf("  %2u threads  : p50 %8.3f ms  p99 %8.3f ms  (%6.1f Mtri/s, %.2fx)\n",
+                    threads, parallel.p50, parallel.p99, triangles / parallel.p50 / 1000.0, serial.p50 / parallel.p50);
+        std::printf("  loadModel   : p50 %8.3f ms  p99 %8.3f ms  (import + upload into the renderer)\n",
+                    rendererLoad.p50, rendererLoad.p99);
+        std::printf("  headless    : %8.3f ms/frame over %u frames at %dx%d\n", frameMs, kFrames, kExtent, kExtent);
+    }
+
+} // namespace vke::bench
@@ -0,0 +1,248 @@
+#include "BenchContext.h"
+#include "Benchmarks.h"
+#include "SubmitHarness.h"
+
+#include "gfx/GeometryPool.h"
+#include "gfx/Buffer.h"
+#include "gfx/GpuCuller.h"
+#include "gfx/HiZPyramid.h"
+#include "gfx/Model.h"
+#include "gfx/OffscreenTarget.h"
+#include "gfx/PipelineRegistry.h"
+#include "gfx/UploadContext.h"
+#include "gfx/Vertex.h"
+
+#include <cstdio>
+#include <stdexcept>
+#include <vector>
+
+namespace vke::bench {
+
+    namespace {
+
+        constexpr uint32_t kMeshCounts[] = { 4000, 16000, 64000 };
+        constexpr uint32_t kExtent = 256;
+        constexpr int kIterations = 20;
+
+        constexpr uint32_t kOcclusionMeshes = 16000;
+        constexpr float kOccluderDepth = 0.25f;
+        constexpr float kOccludedShare = 0.8f;
+
+        // Com frustumSplit, um em cada cinco meshes fica na tela e os outros quatro
+        // ficam fora do frustum, como os 80% de uma cena típica que não contribuem
+        // para a imagem; sem ele, todos ficam na tela
+        std::vector<Vertex> makeTriangle(uint32_t index, bool frustumSplit) {
+            float x = static_cast<float>(index % 128) / 64.0f - 1.0f;
+            float y = static_cast<float>(index / 128 % 128) / 64.0f - 1.0f;
+            if (frustumSplit && index % 5 != 0) {
+                x += 4.0f;
+            }
+            return {
+                { { x,          y          }, { 1.0f, 0.0f, 0.0f } },
+                { { x + 0.02f,  y + 0.02f  }, { 0.0f, 1.0f, 0.0f } },
+                { { x - 0.02f,  y + 0.02f  }, { 0.0f, 0.0f, 1.0f } }
+            };
+        }
+
+        // Depth buffer sintético (D32_SFLOAT): uma parede em kOccluderDepth cobrindo as
+        // colunas à esquerda de kOccludedShare da tela e o plano distante (1.0) no resto.
+        // Enviado por cópia no primeiro record() e depois só amostrado pelo Hi-Z.
+        class SyntheticDepth {
+        public:
+            SyntheticDepth(Device& device, uint32_t extent) : m_device(device), m_extent(extent), m_staging(device) {
+                VkImageCreateInfo imageInfo{};
+                imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+                imageInfo.imageType = VK_IMAGE_TYPE_2D;
+                imageInfo.format = VK_FORMAT_D32_SFLOAT;
+                imageInfo.extent = { extent, extent, 1 };
+                imageInfo.mipLevels = 1;
+                imageInfo.arrayLayers = 1;
+                imageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+                imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+                imageInfo.usage = VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT;
+                imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+                imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+                if (vkCreateImage(device.device(), &imageInfo, nullptr, &m_image) != VK_SUCCESS) {
+                    throw std::runtime_error("Failed to create synthetic depth image!");
+                }
+                m_allocation = device.allocator().allocateForImage(m_image, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+                vkBindImageMemory(device.device(), m_image, m_allocation.memory, m_allocation.offset);
+
+                VkImageViewCreateInfo viewInfo{};
+                viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+                viewInfo.image = m_image;
+                viewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
+                viewInfo.format = VK_FORMAT_D32_SFLOAT;
+                viewInfo.subresourceRange = { VK_IMAGE_ASPECT_DEPTH_BIT, 0, 1, 0, 1 };
+                if (vkCreateImageView(device.device(), &viewInfo, nullptr, &m_view) != VK_SUCCESS) {
+                    throw std::runtime_error("Failed to create synthetic depth view!");
+                }
+
+                std::vector<float> depth(static_cast<size_t>(extent) * extent);
+                for (uint32_t y = 0; y < extent; y++) {
+                    for (uint32_t x = 0; x < extent; x++) {
+                        depth[y * extent + x] = x < kOccludedShare * extent ? kOccluderDepth : 1.0f;
+                    }
+                }
+                VkDeviceSize size = sizeof(float) * depth.size();
+                m_staging.create(size, VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+                                 VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+                m_staging.uploadData(depth.data(), size);
+            }
+
+            ~SyntheticDepth() {
+                vkDestroyImageView(m_device.device(), m_view, nullptr);
+                vkDestroyImage(m_device.device(), m_image, nullptr);
+                m_device.allocator().free(m_allocation);
+            }
+
+            SyntheticDepth(const SyntheticDepth&) = delete;
+            SyntheticDepth& operator=(const SyntheticDepth&) = delete;
+
+            // Fora da render pass; deixa a imagem em kLayout, visível a shaders de compute
+            void record(VkCommandBuffer commandBuffer) {
+                if (m_uploaded) {
+                    return;
+                }
+                VkImageMemoryBarrier barrier{};
+                barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+                barrier.srcAccessMask = 0;
+                barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+                barrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+                barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+                barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+                barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+                barrier.image = m_image;
+                barrier.subresourceRange = { VK_IMAGE_ASPECT_DEPTH_BIT, 0, 1, 0, 1 };
+                vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
+                                     0, 0, nullptr, 0, nullptr, 1, &barrier);
+
+                VkBufferImageCopy region{};
+                region.imageSubresource = { VK_IMAGE_ASPECT_DEPTH_BIT, 0, 0, 1 };
+                region.imageExtent = { m_extent, m_extent, 1 };
+                vkCmdCopyBufferToImage(commandBuffer, m_staging.getBuffer(), m_image,
+                                       VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
+
+                barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+                barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+                barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+                barrier.newLayout = kLayout;
+                vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                                     0, 0, nullptr, 0, nullptr, 1, &barrier);
+                m_uploaded = true;
+            }
+
+            static constexpr VkImageLayout kLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+
+            [[nodiscard]] VkImageView getView() const { return m_view; }
+
+        private:
+            Device& m_device;
+            uint32_t m_extent;
+            VkImage m_image = VK_NULL_HANDLE;
+            MemoryAllocation m_allocation{};
+            VkImageView m_view = VK_NULL_HANDLE;
+            Buffer m_staging;
+            bool m_uploaded = false;
+        };
+
+    } // namespace
+
+    void runGpuCullBenchmark(BenchContext& context) {
+        Device& device = context.device();
+        PipelineRegistry& pipelines = device.pipelines();
+
+        PipelineKey key{};
+        key.vertexShader = pipelines.registerShader("shaders/vert.spv");
+        key.fragmentShader = pipelines.registerShader("shaders/frag.spv");
+        key.vertexLayout = pipelines.registerVertexLayout(Vertex::getVertexLayout());
+        key.colorFormat = OffscreenTarget::kDefaultFormat;
+        VkPipeline pipeline = pipelines.getPipeline(key, context.renderPass());
+
+        SubmitHarness harness(context, kExtent);
+        GpuCuller culler(device, 1);
+        CullView view{};
+        view.viewProjection = { 1.0f, 0.0f, 0.0f, 0.0f,
+                                0.0f, 1.0f, 0.0f, 0.0f,
+                                0.0f, 0.0f, 1.0f, 0.0f,
+                                0.0f, 0.0f, 0.0f, 1.0f };
+
+        std::printf("gpu_cull (80%% of meshes outside the frustum; draw indirect count %s):\n",
+                    device.features().drawIndirectCount ? "yes" : "no");
+
+        for (uint32_t meshCount : kMeshCounts) {
+            GeometryPool geometry(device, 3 * meshCount, 3 * meshCount);
+            Model model(device, geometry);
+            {
+                UploadBatch batch(device.uploader());
+                for (uint32_t i = 0; i < meshCount; i++) {
+                    model.addMesh(makeTriangle(i, true));
+                }
+                model.uploadDrawData();
+            }
+
+            // Antes: a lista completa vai para o vertex shader
+            SubmitTiming before = harness.measure(kIterations, [&](VkCommandBuffer commandBuffer) {
+                vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline);
+                model.recordDrawCommands(commandBuffer);
+            });
+
+            // Depois: o compute filtra a lista antes da render pass
+            SubmitTiming after = harness.measure(
+                kIterations,
+                [&](VkCommandBuffer commandBuffer) {
+                    vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline);
+                    culler.draw(commandBuffer, 0, model);
+                },
+                [&](VkCommandBuffer commandBuffer) { culler.record(commandBuffer, 0, model, view); });
+
+            std::printf("  %6u meshes: all drawn, frame %8.3f ms | culled (%6u visible), frame %8.3f ms (%.1fx)\n",
+                        meshCount, before.frameMs, culler.getVisibleCount(0), after.frameMs,
+                        before.frameMs / after.frameMs);
+        }
+
+        // Oclusão: todos os meshes na tela, em profundidade 0.5, atrás de uma parede que
+        // cobre kOccludedShare da tela. A pirâmide Hi-Z é reconstruída a cada frame.
+        CullView occlusionView = view;
+        occlusionView.viewProjection[14] = 0.5f;
+        SyntheticDepth depth(device, kExtent);
+        HiZPyramid hiz(device, kExtent, kExtent);
+        GeometryPool geometry(device, 3 * kOcclusionMeshes, 3 * kOcclusionMeshes);
+        Model model(device, geometry);
+        {
+            UploadBatch batch(device.uploader());
+            for (uint32_t i = 0; i < kOcclusionMeshes; i++) {
+                model.addMesh(makeTriangle(i, false));
+            }
+            model.uploadDrawData();
+        }
+        auto drawCulled = [&](VkCommandBuffer commandBuffer) {
+            vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline);
+            culler.draw(commandBuffer, 0, model);
+        };
+
+        occlusionView.occlusion = nullptr;
+        SubmitTiming frustumOnly = harness.measure(kIterations, drawCulled, [&](VkCommandBuffer commandBuffer) {
+            culler.record(commandBuffer, 0, model, occlusionView);
+        });
+        uint32_t frustumVisible = culler.getVisibleCount(0);
+
+        occlusionView.occlusion = &hiz;
+        SubmitTiming occlusion = harness.measure(kIterations, drawCulled, [&](VkCommandBuffer commandBuffer) {
+            depth.record(commandBuffer);
+            hiz.build(commandBuffer, depth.getView(), SyntheticDepth::kLayout);
+            culler.record(commandBuffer, 0, model, occlusionView);
+        });
+        uint32_t occlusionVisible = culler.getVisibleCount(0);
+
+        frustumOnly.report(context.report(), "gpu_cull_frustum_only");
+        occlusion.report(context.report(), "gpu_cull_hiz");
+
+        std::printf("gpu_cull occlusion (%u meshes on screen, %.0f%% behind a depth wall; Hi-Z rebuilt every frame):\n",
+                    kOcclusionMeshes, kOccludedShare * 100.0f);
+        std::printf("  frustum only : %6u visible, frame %8.3f ms\n", frustumVisible, frustumOnly.frameMs);
+        std::printf("  + Hi-Z       : %6u visible, frame %8.3f ms (%.1fx)\n", occlusionVisible, occlusion.frameMs,
+                    frustumOnly.frameMs / occlusion.frameMs);
+    }
+
+} // namespace vke::bench
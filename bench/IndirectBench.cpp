@@ -0,0 +1,85 @@
+#include "BenchContext.h"
+#include "Benchmarks.h"
+#include "SubmitHarness.h"
+
+#include "gfx/GeometryPool.h"
+#include "gfx/Model.h"
+#include "gfx/OffscreenTarget.h"
+#include "gfx/PipelineRegistry.h"
+#include "gfx/UploadContext.h"
+#include "gfx/Vertex.h"
+
+#include <cstdio>
+#include <vector>
+
+namespace vke::bench {
+
+    namespace {
+
+        constexpr uint32_t kMeshCounts[] = { 1000, 4000, 16000 };
+        constexpr uint32_t kExtent = 256;
+        constexpr int kIterations = 20;
+
+        // Triângulos pequenos distintos espalhados pela tela: cada um é um mesh próprio
+        std::vector<Vertex> makeTriangle(uint32_t index) {
+            float x = static_cast<float>(index % 128) / 64.0f - 1.0f;
+            float y = static_cast<float>(index / 128 % 128) / 64.0f - 1.0f;
+            return {
+                { { x,          y          }, { 1.0f, 0.0f, 0.0f } },
+                { { x + 0.01f,  y + 0.01f  }, { 0.0f, 1.0f, 0.0f } },
+                { { x - 0.01f,  y + 0.01f  }, { 0.0f, 0.0f, 1.0f } }
+            };
+        }
+
+        void fill(Model& model, uint32_t meshCount, UploadContext& uploader) {
+            UploadBatch batch(uploader);
+            for (uint32_t i = 0; i < meshCount; i++) {
+                model.addMesh(makeTriangle(i));
+            }
+            model.uploadDrawData();
+        }
+
+    } // namespace
+
+    void runIndirectBenchmark(BenchContext& context) {
+        Device& device = context.device();
+        PipelineRegistry& pipelines = device.pipelines();
+
+        PipelineKey key{};
+        key.vertexShader = pipelines.registerShader("shaders/vert.spv");
+        key.fragmentShader = pipelines.registerShader("shaders/frag.spv");
+        key.vertexLayout = pipelines.registerVertexLayout(Vertex::getVertexLayout());
+        key.colorFormat = OffscreenTarget::kDefaultFormat;
+        VkPipeline pipeline = pipelines.getPipeline(key, context.renderPass());
+
+        SubmitHarness harness(context, kExtent);
+        const DeviceFeatures& features = device.features();
+        std::printf("indirect (distinct meshes; multiDrawIndirect %s, drawIndirectFirstInstance %s):\n",
+                    features.multiDrawIndirect ? "yes" : "no", features.drawIndirectFirstInstance ? "yes" : "no");
+
+        for (uint32_t meshCount : kMeshCounts) {
+            auto recordWith = [&](const Model& model) {
+                return [&model, pipeline](VkCommandBuffer commandBuffer) {
+                    vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline);
+                    model.recordDrawCommands(commandBuffer);
+                };
+            };
+
+            // Antes: buffers e draw próprios por mesh
+            Model perMesh(device);
+            fill(perMesh, meshCount, device.uploader());
+            SubmitTiming before = harness.measure(kIterations, recordWith(perMesh));
+
+            // Depois: geometria empacotada e um draw indireto para a cena
+            GeometryPool geometry(device, 3 * meshCount, 3 * meshCount);
+            Model packed(device, geometry);
+            fill(packed, meshCount, device.uploader());
+            SubmitTiming after = harness.measure(kIterations, recordWith(packed));
+
+            std::printf("  %5u meshes: per-mesh %5u draws, cpu %8.3f ms | indirect %5u draw(s), cpu %8.3f ms (%.1fx)\n",
+                        meshCount, perMesh.getDrawCallCount(0, meshCount), before.cpuMs,
+                        packed.getDrawCallCount(0, meshCount), after.cpuMs, before.cpuMs / after.cpuMs);
+        }
+    }
+
+} // namespace vke::bench
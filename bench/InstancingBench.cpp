@@ -0,0 +1,84 @@
+#include "BenchContext.h"
+#include "Benchmarks.h"
+#include "SubmitHarness.h"
+
+#include "gfx/Model.h"
+#include "gfx/OffscreenTarget.h"
+#include "gfx/PipelineRegistry.h"
+#include "gfx/Vertex.h"
+
+#include <cstdio>
+#include <vector>
+
+namespace vke::bench {
+
+    namespace {
+
+        constexpr uint32_t kCopies = 10000;
+        constexpr uint32_t kExtent = 256;
+        constexpr int kIterations = 20;
+
+    } // namespace
+
+    void runInstancingBenchmark(BenchContext& context) {
+        Device& device = context.device();
+        PipelineRegistry& pipelines = device.pipelines();
+
+        PipelineKey plainKey{};
+        plainKey.vertexShader = pipelines.registerShader("shaders/vert.spv");
+        plainKey.fragmentShader = pipelines.registerShader("shaders/frag.spv");
+        plainKey.vertexLayout = pipelines.registerVertexLayout(Vertex::getVertexLayout());
+        plainKey.colorFormat = OffscreenTarget::kDefaultFormat;
+        VkPipeline plainPipeline = pipelines.getPipeline(plainKey, context.renderPass());
+
+        PipelineKey instancedKey = plainKey;
+        instancedKey.vertexShader = pipelines.registerShader("shaders/vert_instanced.spv");
+        instancedKey.vertexLayout = pipelines.registerVertexLayout(Vertex::getInstancedVertexLayout());
+        VkPipeline instancedPipeline = pipelines.getPipeline(instancedKey, context.renderPass());
+
+        SubmitHarness harness(context, kExtent);
+
+        const std::vector<Vertex> triangle = {
+            { { 0.0f,  -0.5f }, { 1.0f, 0.0f, 0.0f } },
+            { { 0.5f,   0.5f }, { 0.0f, 1.0f, 0.0f } },
+            { { -0.5f, -0.5f }, { 0.0f, 0.0f, 1.0f } }
+        };
+
+        // Antes: o mesmo mesh desenhado kCopies vezes, cada draw com seus binds
+        Model plain(device);
+        plain.addMesh(triangle);
+        SubmitTiming before = harness.measure(kIterations, [&](VkCommandBuffer commandBuffer) {
+            vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, plainPipeline);
+            for (uint32_t i = 0; i < kCopies; i++) {
+                plain.recordDrawCommands(commandBuffer);
+            }
+        });
+
+        // Depois: as cópias viram instâncias de um único draw
+        Model instanced(device);
+        size_t mesh = instanced.addMesh(triangle);
+        std::vector<InstanceData> instances(kCopies);
+        for (uint32_t i = 0; i < kCopies; i++) {
+            float x = static_cast<float>(i % 100) / 50.0f - 1.0f;
+            float y = static_cast<float>(i / 100) / 50.0f - 1.0f;
+            instances[i] = { { x, y }, 0.02f };
+        }
+        instanced.setInstances(mesh, instances);
+        instanced.uploadDrawData();
+        SubmitTiming after = harness.measure(kIterations, [&](VkCommandBuffer commandBuffer) {
+            vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, instancedPipeline);
+            instanced.recordDrawCommands(commandBuffer);
+        });
+
+        before.report(context.report(), "instancing_per_copy");
+        after.report(context.report(), "instancing_instanced");
+
+        std::printf("instancing (%u copies of one mesh):\n", kCopies);
+        std::printf("  per-copy draws: %5u draw calls, cpu record+submit %8.3f ms, frame %8.3f ms\n",
+                    kCopies, before.cpuMs, before.frameMs);
+        std::printf("  instanced     : %5u draw calls, cpu record+submit %8.3f ms, frame %8.3f ms (%.1fx less cpu)\n",
+                    instanced.getDrawCallCount(0, instanced.getMeshCount()), after.cpuMs, after.frameMs,
+                    before.cpuMs / after.cpuMs);
+    }
+
+} // namespace vke::bench
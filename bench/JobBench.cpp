@@ -0,0 +1,79 @@
+#include "BenchContext.h"
+#include "Benchmarks.h"
+
+#include "core/JobSystem.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+namespace vke::bench {
+
+    namespace {
+
+        constexpr uint32_t kSpawnJobs = 200000;
+        constexpr uint32_t kForCount = 1u << 22;
+        constexpr uint32_t kForGrain = 4096;
+        constexpr int kIterations = 5;
+
+    } // namespace
+
+    void runJobBenchmark(BenchContext& context) {
+        uint32_t maxThreads = std::max(1u, std::thread::hardware_concurrency());
+
+        // Carga por elemento barata o bastante para expor o overhead do escalonador
+        std::vector<float> data(kForCount, 1.0f);
+        auto body = [&](uint32_t begin, uint32_t end) {
+            for (uint32_t i = begin; i < end; i++) {
+                data[i] = std::sqrt(data[i] * 1.0001f + 0.5f);
+            }
+        };
+
+        double singleThreadMs = 0.0;
+        std::printf("jobs (spawn: %u empty jobs; parallelFor: %u elements, grain %u):\n",
+                    kSpawnJobs, kForCount, kForGrain);
+        // Potências de dois e, por último, o número real de núcleos (ex.: 6, 12, 24)
+        std::vector<uint32_t> threadCounts;
+        for (uint32_t threads = 1; threads < maxThreads; threads *= 2) {
+            threadCounts.push_back(threads);
+        }
+        threadCounts.push_back(maxThreads);
+        for (uint32_t threads : threadCounts) {
+            JobSystem jobs(threads);
+            JobSystemStats before = jobs.getStats();
+
+            // Jobs vazios lançados da thread principal: os outros workers só
+            // conseguem trabalho roubando da fila dela
+            std::atomic<uint32_t> sink{ 0 };
+            SampleStats spawn = sampleMs(kIterations, [&] {
+                JobCounter counter;
+                for (uint32_t i = 0; i < kSpawnJobs; i++) {
+                    jobs.run([&sink] { sink.fetch_add(1, std::memory_order_relaxed); }, &counter);
+                }
+                jobs.wait(counter);
+            });
+            SampleStats parallelFor = sampleMs(kIterations, [&] { jobs.parallelFor(kForCount, kForGrain, body); });
+
+            std::string suffix = "_threads" + std::to_string(threads) + "_ms";
+            context.report().add("jobs", "spawn" + suffix, spawn);
+            context.report().add("jobs", "parallel_for" + suffix, parallelFor);
+            double spawnMs = spawn.p50;
+            double forMs = parallelFor.p50;
+            if (threads == 1) {
+                singleThreadMs = forMs;
+            }
+
+            JobSystemStats after = jobs.getStats();
+            uint64_t executed = after.executed - before.executed;
+            uint64_t stolen = after.stolen - before.stolen;
+            std::printf("  %2u thread(s): spawn %7.1f ns/job, %5.1f%% stolen | parallelFor %8.3f ms (%.2fx)\n",
+                        threads, spawnMs * 1e6 / kSpawnJobs,
+                        executed > 0 ? 100.0 * static_cast<double>(stolen) / static_cast<double>(executed) : 0.0,
+                        forMs, singleThreadMs / forMs);
+        }
+    }
+
+} // namespace vke::bench
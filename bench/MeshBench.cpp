@@ -0,0 +1,87 @@
+#include "BenchContext.h"
+#include "Benchmarks.h"
+
+#include "gfx/Bounds.h"
+#include "util/MeshFile.h"
+#include "util/MeshUtils.h"
+
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace vke::bench {
+
+    namespace {
+
+        constexpr uint32_t kGrid = 512; // 512 x 512 quads, 2 triângulos cada
+        constexpr int kIterations = 10;
+
+        // Grade como lista de triângulos não indexada (como sai de um exportador simples):
+        // cada vértice interno aparece em seis triângulos
+        std::vector<Vertex> makeTriangleList() {
+            std::vector<Vertex> vertices;
+            vertices.reserve(kGrid * kGrid * 6);
+            auto corner = [](uint32_t x, uint32_t y) {
+                float u = static_cast<float>(x) / kGrid;
+                float v = static_cast<float>(y) / kGrid;
+                return Vertex{ { u * 2.0f - 1.0f, v * 2.0f - 1.0f }, { u, v, 1.0f - u } };
+            };
+            for (uint32_t y = 0; y < kGrid; y++) {
+                for (uint32_t x = 0; x < kGrid; x++) {
+                    Vertex a = corner(x, y), b = corner(x + 1, y), c = corner(x, y + 1), d = corner(x + 1, y + 1);
+                    vertices.insert(vertices.end(), { a, b, c, b, d, c });
+                }
+            }
+            return vertices;
+        }
+
+    } // namespace
+
+    void runMeshBenchmark(BenchContext& context) {
+        std::vector<Vertex> triangleList = makeTriangleList();
+
+        std::vector<Vertex> welded;
+        std::vector<uint32_t> indices;
+        SampleStats weld = sampleMs(kIterations, [&] { weldVertices(triangleList, welded, indices); });
+
+        BoundingSphere sphere{};
+        SampleStats bounds = sampleMs(kIterations, [&] { sphere = computeBounds(welded); });
+
+        // Formato .vkm: cozinhar uma vez, depois cada carga é mapear + copiar as seções.
+        // A cópia vai para um buffer comum no lugar do staging (sem GPU no caminho)
+        std::string path = (std::filesystem::temp_directory_path() / "vke_bench_mesh.vkm").string();
+        std::vector<MeshFileInput> input(1);
+        input[0].vertices = welded;
+        input[0].indices = indices;
+        SampleStats cook = sampleMs(kIterations, [&] { MeshFile::write(path, input); });
+
+        std::vector<uint8_t> staging(welded.size() * sizeof(Vertex) + indices.size() * sizeof(uint32_t));
+        size_t fileSize = 0;
+        SampleStats load = sampleMs(kIterations, [&] {
+            MeshFile file(path);
+            const MeshFileEntry& entry = file.getMesh(0);
+            size_t vertexBytes = entry.vertexCount * sizeof(Vertex);
+            std::memcpy(staging.data(), file.getVertices(entry), vertexBytes);
+            std::memcpy(staging.data() + vertexBytes, file.getIndices(entry), entry.indexCount * sizeof(uint32_t));
+            fileSize = file.getFileSize();
+        });
+        std::filesystem::remove(path);
+
+        context.report().add("mesh", "weld_ms", weld);
+        context.report().add("mesh", "bounds_ms", bounds);
+        context.report().add("mesh", "cook_ms", cook);
+        context.report().add("mesh", "file_load_ms", load);
+
+        std::printf("mesh (%zu-vertex triangle list -> %zu unique vertices, %zu indices):\n",
+                    triangleList.size(), welded.size(), indices.size());
+        std::printf("  weld  : p50 %8.3f ms  p99 %8.3f ms  (%6.1f Mvert/s)\n",
+                    weld.p50, weld.p99, triangleList.size() / weld.p50 / 1000.0);
+        std::printf("  bounds: p50 %8.3f ms  p99 %8.3f ms  (radius %.3f)\n", bounds.p50, bounds.p99, sphere.radius);
+        std::printf("  cook  : p50 %8.3f ms  p99 %8.3f ms\n", cook.p50, cook.p99);
+        std::printf("  load  : p50 %8.3f ms  p99 %8.3f ms  (%6.1f MB/s, warm page cache)\n",
+                    load.p50, load.p99, fileSize / load.p50 / 1000.0);
+    }
+
+} // namespace vke::bench
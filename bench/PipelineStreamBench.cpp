@@ -0,0 +1,111 @@
+#include "BenchContext.h"
+#include "Benchmarks.h"
+
+#include "gfx/OffscreenTarget.h"
+#include "gfx/PipelineRegistry.h"
+#include "gfx/Vertex.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <vector>
+
+namespace vke::bench {
+
+    namespace {
+
+        constexpr uint32_t kFrameCount = 240;
+        constexpr uint32_t kFramesPerPermutation = 4; // um material novo a cada 4 frames
+        constexpr double kFrameWorkMs = 2.0;          // trabalho simulado do resto do frame
+
+        struct StreamResult {
+            double p50Ms = 0.0;
+            double p99Ms = 0.0;
+            double maxMs = 0.0;
+            uint32_t framesWaitingPipeline = 0; // frames que desenharam sem o pipeline novo
+        };
+
+        void spin(double milliseconds) {
+            Timer timer;
+            while (timer.seconds() * 1000.0 < milliseconds) {
+            }
+        }
+
+        // Permutações distintas de blend/cull/topologia com o frontFace dado.
+        // Cada modo usa um frontFace diferente para não reaproveitar o cache do outro.
+        std::vector<PipelineKey> makePermutations(const PipelineKey& base, VkFrontFace frontFace) {
+            const BlendMode blends[] = { BlendMode::Opaque, BlendMode::AlphaBlend, BlendMode::Additive };
+            const VkCullModeFlags culls[] = { VK_CULL_MODE_NONE, VK_CULL_MODE_FRONT_BIT, VK_CULL_MODE_BACK_BIT };
+            const VkPrimitiveTopology topologies[] = { VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST,
+                                                       VK_PRIMITIVE_TOPOLOGY_TRIANGLE_STRIP,
+                                                       VK_PRIMITIVE_TOPOLOGY_LINE_LIST };
+            std::vector<PipelineKey> keys;
+            for (auto blend : blends) {
+                for (auto cull : culls) {
+                    for (auto topology : topologies) {
+                        PipelineKey key = base;
+                        key.blend = static_cast<uint8_t>(blend);
+                        key.cullMode = static_cast<uint8_t>(cull);
+                        key.topology = static_cast<uint8_t>(topology);
+                        key.frontFace = static_cast<uint8_t>(frontFace);
+                        keys.push_back(key);
+                    }
+                }
+            }
+            return keys;
+        }
+
+        StreamResult runStream(BenchContext& context, bool async, VkFrontFace frontFace) {
+            // Registro novo: nenhum pipeline compilado ainda
+            PipelineRegistry registry(context.device());
+            PipelineKey base{};
+            base.vertexShader = registry.registerShader("shaders/vert.spv");
+            base.fragmentShader = registry.registerShader("shaders/frag.spv");
+            base.vertexLayout = registry.registerVertexLayout(Vertex::getVertexLayout());
+            base.colorFormat = OffscreenTarget::kDefaultFormat;
+            std::vector<PipelineKey> keys = makePermutations(base, frontFace);
+
+            StreamResult result;
+            std::vector<PipelineHandle> handles;
+            std::vector<double> frameMs;
+            for (uint32_t frame = 0; frame < kFrameCount; frame++) {
+                Timer timer;
+
+                uint32_t permutation = frame / kFramesPerPermutation;
+                if (frame % kFramesPerPermutation == 0 && permutation < keys.size()) {
+                    if (async) {
+                        handles.push_back(registry.requestPipeline(keys[permutation], context.renderPass()));
+                    } else {
+                        registry.getPipeline(keys[permutation], context.renderPass());
+                    }
+                }
+
+                // O frame desenharia com o que estiver pronto; o resto é pulado
+                bool waiting = std::any_of(handles.begin(), handles.end(),
+                                           [](const PipelineHandle& handle) { return !handle.ready(); });
+                result.framesWaitingPipeline += waiting ? 1 : 0;
+
+                spin(kFrameWorkMs);
+                frameMs.push_back(timer.seconds() * 1000.0);
+            }
+            registry.waitIdle();
+
+            std::sort(frameMs.begin(), frameMs.end());
+            result.p50Ms = frameMs[frameMs.size() / 2];
+            result.p99Ms = frameMs[std::min(frameMs.size() - 1, frameMs.size() * 99 / 100)];
+            result.maxMs = frameMs.back();
+            return result;
+        }
+
+    } // namespace
+
+    void runPipelineStreamBenchmark(BenchContext& context) {
+        StreamResult sync = runStream(context, false, VK_FRONT_FACE_CLOCKWISE);
+        StreamResult async = runStream(context, true, VK_FRONT_FACE_COUNTER_CLOCKWISE);
+
+        std::printf("pipeline_stream (%u frames, new permutation every %u frames):\n", kFrameCount, kFramesPerPermutation);
+        std::printf("  sync : p50 %.3f ms, p99 %.3f ms, max %.3f ms\n", sync.p50Ms, sync.p99Ms, sync.maxMs);
+        std::printf("  async: p50 %.3f ms, p99 %.3f ms, max %.3f ms (%u frames drew without a pending pipeline)\n",
+                    async.p50Ms, async.p99Ms, async.maxMs, async.framesWaitingPipeline);
+    }
+
+} // namespace vke::bench
@@ -0,0 +1,80 @@
+#include "BenchContext.h"
+#include "Benchmarks.h"
+
+#include "core/JobSystem.h"
+#include "gfx/Mesh.h"
+#include "gfx/OffscreenTarget.h"
+#include "gfx/ParallelRecorder.h"
+#include "gfx/PipelineRegistry.h"
+#include "gfx/Vertex.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace vke::bench {
+
+    namespace {
+
+        constexpr uint32_t kDrawCount = 100000;
+        constexpr int kIterations = 5;
+
+    } // namespace
+
+    void runRecordBenchmark(BenchContext& context) {
+        Device& device = context.device();
+
+        PipelineRegistry& pipelines = device.pipelines();
+        PipelineKey key{};
+        key.vertexShader = pipelines.registerShader("shaders/vert.spv");
+        key.fragmentShader = pipelines.registerShader("shaders/frag.spv");
+        key.vertexLayout = pipelines.registerVertexLayout(Vertex::getVertexLayout());
+        key.colorFormat = OffscreenTarget::kDefaultFormat;
+        VkPipeline pipeline = pipelines.getPipeline(key, context.renderPass());
+
+        // Um único mesh desenhado kDrawCount vezes: cada draw grava os mesmos
+        // binds de vertex/index buffer + drawIndexed de um mesh real
+        Mesh mesh(device);
+        mesh.load({
+            { { 0.0f,  -0.5f }, { 1.0f, 0.0f, 0.0f } },
+            { { 0.5f,   0.5f }, { 0.0f, 1.0f, 0.0f } },
+            { { -0.5f, -0.5f }, { 0.0f, 0.0f, 1.0f } }
+        });
+
+        VkCommandBufferInheritanceInfo inheritance{};
+        inheritance.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+        inheritance.renderPass = context.renderPass();
+        inheritance.subpass = 0;
+
+        auto recordFn = [&](VkCommandBuffer commandBuffer, uint32_t begin, uint32_t end) {
+            vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline);
+            for (uint32_t i = begin; i < end; i++) {
+                mesh.recordDrawCommands(commandBuffer);
+            }
+        };
+
+        uint32_t maxThreads = std::max(1u, std::thread::hardware_concurrency());
+        double singleThreadMs = 0.0;
+        std::printf("record (%u draws into secondary command buffers):\n", kDrawCount);
+        // Potências de dois e, por último, o número real de núcleos (ex.: 6, 12, 24)
+        std::vector<uint32_t> threadCounts;
+        for (uint32_t threads = 1; threads < maxThreads; threads *= 2) {
+            threadCounts.push_back(threads);
+        }
+        threadCounts.push_back(maxThreads);
+        for (uint32_t threads : threadCounts) {
+            JobSystem jobs(threads);
+            ParallelRecorder recorder(device, jobs, device.queueFamilies().graphicsFamily.value(), 1);
+
+            SampleStats record = sampleMs(kIterations, [&] { recorder.record(0, inheritance, kDrawCount, recordFn); });
+            context.report().add("record", "record_threads" + std::to_string(threads) + "_ms", record);
+            if (threads == 1) {
+                singleThreadMs = record.p50;
+            }
+            std::printf("  %2u thread(s): %8.3f ms (%.2fx)\n", threads, record.p50, singleThreadMs / record.p50);
+        }
+    }
+
+} // namespace vke::bench
@@ -0,0 +1,222 @@
+#include "BenchContext.h"
+#include "Benchmarks.h"
+#include "SubmitHarness.h"
+
+#include "gfx/Buffer.h"
+#include "gfx/GraphicsPipeline.h"
+#include "gfx/Model.h"
+#include "gfx/OffscreenTarget.h"
+#include "gfx/PipelineRegistry.h"
+#include "gfx/RenderQueue.h"
+#include "gfx/UploadContext.h"
+#include "gfx/Vertex.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+namespace vke::bench {
+
+    namespace {
+
+        constexpr uint32_t kDrawsPerFrame = 20000;
+        constexpr uint32_t kPipelines = 9; // 3 modos de blend x 3 modos de cull
+        constexpr uint32_t kMaterials = 64;
+        constexpr uint32_t kMeshes = 256;
+        constexpr uint32_t kExtent = 64;
+        constexpr int kIterations = 20;
+
+        // Constantes por draw, lidas pelo vertex shader via push constants
+        struct DrawConstants {
+            float offset[2];
+            float scale;
+            uint32_t instance;
+        };
+
+        // Um draw pedido pela "cena", em ordem de chegada
+        struct SceneDraw {
+            uint32_t pipeline;
+            uint32_t material;
+            uint32_t mesh;
+            DrawConstants constants;
+        };
+
+        void printStats(const char* label, const SubmitTiming& timing, const RenderQueueStats& stats) {
+            std::printf("  %-10s: cpu %7.3f ms | binds %6u (pipeline %5u, material %5u, vertex %5u, index %5u), %6u skipped\n",
+                        label, timing.cpuMs, stats.getBinds(), stats.pipelineBinds, stats.descriptorBinds,
+                        stats.vertexBinds, stats.indexBinds, stats.getBindsSkipped());
+        }
+
+    } // namespace
+
+    void runRenderQueueBenchmark(BenchContext& context) {
+        Device& device = context.device();
+        PipelineRegistry& pipelines = device.pipelines();
+
+        // Material: um storage buffer no set 0
+        VkDescriptorSetLayoutBinding binding{};
+        binding.binding = 0;
+        binding.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+        binding.descriptorCount = 1;
+        binding.stageFlags = VK_SHADER_STAGE_ALL_GRAPHICS;
+        VkDescriptorSetLayoutCreateInfo setLayoutInfo{};
+        setLayoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+        setLayoutInfo.bindingCount = 1;
+        setLayoutInfo.pBindings = &binding;
+        VkDescriptorSetLayout materialSetLayout = VK_NULL_HANDLE;
+        if (vkCreateDescriptorSetLayout(device.device(), &setLayoutInfo, nullptr, &materialSetLayout) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to create material descriptor set layout!");
+        }
+
+        VkPushConstantRange pushRange{ VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(DrawConstants) };
+        VkPipelineLayoutCreateInfo layoutInfo{};
+        layoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+        layoutInfo.setLayoutCount = 1;
+        layoutInfo.pSetLayouts = &materialSetLayout;
+        layoutInfo.pushConstantRangeCount = 1;
+        layoutInfo.pPushConstantRanges = &pushRange;
+        VkPipelineLayout layout = VK_NULL_HANDLE;
+        if (vkCreatePipelineLayout(device.device(), &layoutInfo, nullptr, &layout) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to create render queue pipeline layout!");
+        }
+
+        VkDescriptorPoolSize poolSize{ VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, kMaterials };
+        VkDescriptorPoolCreateInfo poolInfo{};
+        poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+        poolInfo.maxSets = kMaterials;
+        poolInfo.poolSizeCount = 1;
+        poolInfo.pPoolSizes = &poolSize;
+        VkDescriptorPool descriptorPool = VK_NULL_HANDLE;
+        if (vkCreateDescriptorPool(device.device(), &poolInfo, nullptr, &descriptorPool) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to create material descriptor pool!");
+        }
+
+        std::vector<std::unique_ptr<Buffer>> materialBuffers;
+        std::vector<VkDescriptorSet> materialSets(kMaterials);
+        std::vector<VkDescriptorSetLayout> setLayouts(kMaterials, materialSetLayout);
+        VkDescriptorSetAllocateInfo allocInfo{};
+        allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+        allocInfo.descriptorPool = descriptorPool;
+        allocInfo.descriptorSetCount = kMaterials;
+        allocInfo.pSetLayouts = setLayouts.data();
+        if (vkAllocateDescriptorSets(device.device(), &allocInfo, materialSets.data()) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to allocate material descriptor sets!");
+        }
+        for (uint32_t i = 0; i < kMaterials; i++) {
+            auto buffer = std::make_unique<Buffer>(device);
+            buffer->create(64, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+                           VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+            VkDescriptorBufferInfo bufferInfo{ buffer->getBuffer(), 0, VK_WHOLE_SIZE };
+            VkWriteDescriptorSet write{};
+            write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+            write.dstSet = materialSets[i];
+            write.dstBinding = 0;
+            write.descriptorCount = 1;
+            write.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+            write.pBufferInfo = &bufferInfo;
+            vkUpdateDescriptorSets(device.device(), 1, &write, 0, nullptr);
+            materialBuffers.push_back(std::move(buffer));
+        }
+
+        // Pipelines que diferem em blend e cull; os shaders ignoram material e constantes
+        PipelineKey key{};
+        key.vertexShader = pipelines.registerShader("shaders/vert.spv");
+        key.fragmentShader = pipelines.registerShader("shaders/frag.spv");
+        key.vertexLayout = pipelines.registerVertexLayout(Vertex::getVertexLayout());
+        key.pipelineLayout = pipelines.registerPipelineLayout(layout);
+        key.colorFormat = OffscreenTarget::kDefaultFormat;
+        const VkCullModeFlags cullModes[] = { VK_CULL_MODE_NONE, VK_CULL_MODE_BACK_BIT, VK_CULL_MODE_FRONT_BIT };
+        std::vector<VkPipeline> pipelineHandles;
+        for (uint32_t i = 0; i < kPipelines; i++) {
+            key.blend = static_cast<uint8_t>(i / 3);
+            key.cullMode = static_cast<uint8_t>(cullModes[i % 3]);
+            pipelineHandles.push_back(pipelines.getPipeline(key, context.renderPass()));
+        }
+
+        // Cada mesh com seus próprios buffers: trocar de mesh troca vertex e index buffer
+        Model model(device);
+        {
+            UploadBatch batch(device.uploader());
+            for (uint32_t i = 0; i < kMeshes; i++) {
+                float x = static_cast<float>(i % 16) / 8.0f - 1.0f;
+                float y = static_cast<float>(i / 16) / 8.0f - 1.0f;
+                model.addMesh({
+                    { { x,          y          }, { 1.0f, 0.0f, 0.0f } },
+                    { { x + 0.1f,   y + 0.1f   }, { 0.0f, 1.0f, 0.0f } },
+                    { { x - 0.1f,   y + 0.1f   }, { 0.0f, 0.0f, 1.0f } }
+                });
+            }
+        }
+
+        std::mt19937 rng(7);
+        std::vector<SceneDraw> scene(kDrawsPerFrame);
+        for (uint32_t i = 0; i < kDrawsPerFrame; i++) {
+            scene[i].pipeline = static_cast<uint32_t>(rng() % kPipelines);
+            scene[i].material = static_cast<uint32_t>(rng() % kMaterials);
+            scene[i].mesh = static_cast<uint32_t>(rng() % kMeshes);
+            scene[i].constants = { { 0.0f, 0.0f }, 1.0f, i };
+        }
+
+        RenderQueue queue(0);
+        queue.reserve(kDrawsPerFrame);
+        auto fillQueue = [&] {
+            queue.clear();
+            for (const SceneDraw& draw : scene) {
+                DrawItem base{};
+                base.pipeline = pipelineHandles[draw.pipeline];
+                base.layout = layout;
+                base.materialSet = materialSets[draw.material];
+                SortKey sortKey{ 0, draw.pipeline, draw.material, 0, 0 };
+                model.enqueueDraws(queue, base, sortKey, draw.mesh, draw.mesh + 1,
+                                   &draw.constants, sizeof(DrawConstants));
+            }
+        };
+
+        SubmitHarness harness(context, kExtent);
+        RenderQueueStats unsortedStats;
+        RenderQueueStats sortedStats;
+
+        // Antes: ordem de chegada, sem nada a reaproveitar entre draws vizinhos
+        SubmitTiming unsorted = harness.measure(kIterations, [&](VkCommandBuffer commandBuffer) {
+            fillQueue();
+            unsortedStats = queue.record(commandBuffer);
+        });
+
+        // Depois: ordenado por pipeline > material > mesh, binds repetidos pulados
+        SubmitTiming sorted = harness.measure(kIterations, [&](VkCommandBuffer commandBuffer) {
+            fillQueue();
+            queue.sort();
+            sortedStats = queue.record(commandBuffer);
+        });
+
+        // Só o radix sort, para separar o custo da ordenação do da gravação
+        std::vector<double> sortTimes;
+        for (int i = 0; i < kIterations; i++) {
+            fillQueue();
+            Timer timer;
+            queue.sort();
+            sortTimes.push_back(timer.seconds() * 1e3);
+        }
+        SampleStats sortStats = SampleStats::fromSamples(sortTimes);
+
+        unsorted.report(context.report(), "render_queue_arrival");
+        sorted.report(context.report(), "render_queue_sorted");
+        context.report().add("render_queue", "radix_sort_ms", sortStats);
+
+        std::printf("render_queue (%u draws per frame: %u pipelines, %u materials, %u meshes; cpu = fill + sort + record + submit):\n",
+                    kDrawsPerFrame, kPipelines, kMaterials, kMeshes);
+        printStats("arrival", unsorted, unsortedStats);
+        printStats("sorted", sorted, sortedStats);
+        std::printf("  radix sort of %u keys: %.3f ms; binds saved per frame by sorting: %u\n",
+                    kDrawsPerFrame, sortStats.p50,
+                    unsortedStats.getBinds() - sortedStats.getBinds());
+
+        vkDestroyDescriptorPool(device.device(), descriptorPool, nullptr);
+        vkDestroyPipelineLayout(device.device(), layout, nullptr);
+        vkDestroyDescriptorSetLayout(device.device(), materialSetLayout, nullptr);
+    }
+
+} // namespace vke::bench
@@ -0,0 +1,130 @@
+#include "BenchContext.h"
+#include "Benchmarks.h"
+#include "SubmitHarness.h"
+
+#include "gfx/Model.h"
+#include "gfx/OffscreenTarget.h"
+#include "gfx/PipelineRegistry.h"
+#include "gfx/UploadContext.h"
+#include "gfx/Vertex.h"
+
+#include <cstdio>
+#include <vector>
+
+namespace vke::bench {
+
+    namespace {
+
+        constexpr uint32_t kDraws = 10000;
+        constexpr uint32_t kInstances = 200000;
+        constexpr uint32_t kLargeGrid = 724;  // ~1M triângulos indexados
+        constexpr uint32_t kExtent = 512;
+        constexpr int kIterations = 60;
+
+        void printScenario(const char* label, const char* detail, const SubmitTiming& timing) {
+            std::printf("  %-14s %-24s cpu p50 %7.3f p95 %7.3f p99 %7.3f ms | frame p50 %7.3f p95 %7.3f p99 %7.3f ms\n",
+                        label, detail, timing.cpu.p50, timing.cpu.p95, timing.cpu.p99,
+                        timing.frame.p50, timing.frame.p95, timing.frame.p99);
+        }
+
+    } // namespace
+
+    void runScenarioBenchmark(BenchContext& context) {
+        Device& device = context.device();
+        PipelineRegistry& pipelines = device.pipelines();
+
+        PipelineKey plainKey{};
+        plainKey.vertexShader = pipelines.registerShader("shaders/vert.spv");
+        plainKey.fragmentShader = pipelines.registerShader("shaders/frag.spv");
+        plainKey.vertexLayout = pipelines.registerVertexLayout(Vertex::getVertexLayout());
+        plainKey.colorFormat = OffscreenTarget::kDefaultFormat;
+        VkPipeline plainPipeline = pipelines.getPipeline(plainKey, context.renderPass());
+
+        PipelineKey instancedKey = plainKey;
+        instancedKey.vertexShader = pipelines.registerShader("shaders/vert_instanced.spv");
+        instancedKey.vertexLayout = pipelines.registerVertexLayout(Vertex::getInstancedVertexLayout());
+        VkPipeline instancedPipeline = pipelines.getPipeline(instancedKey, context.renderPass());
+
+        SubmitHarness harness(context, kExtent);
+
+        // Muitos draws: meshes distintos, cada um com seus buffers e seu draw
+        Model manyMeshes(device);
+        {
+            UploadBatch batch(device.uploader());
+            for (uint32_t i = 0; i < kDraws; i++) {
+                float x = static_cast<float>(i % 100) / 50.0f - 1.0f;
+                float y = static_cast<float>(i / 100) / 50.0f - 1.0f;
+                manyMeshes.addMesh({
+                    { { x,          y          }, { 1.0f, 0.0f, 0.0f } },
+                    { { x + 0.02f,  y + 0.02f  }, { 0.0f, 1.0f, 0.0f } },
+                    { { x - 0.02f,  y + 0.02f  }, { 0.0f, 0.0f, 1.0f } }
+                });
+            }
+        }
+        SubmitTiming manyDraws = harness.measure(kIterations, [&](VkCommandBuffer commandBuffer) {
+            vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, plainPipeline);
+            manyMeshes.recordDrawCommands(commandBuffer);
+        });
+
+        // Muitas instâncias: um mesh, um draw instanciado
+        Model instanced(device);
+        size_t mesh = instanced.addMesh({
+            { { 0.0f,  -0.5f }, { 1.0f, 0.0f, 0.0f } },
+            { { 0.5f,   0.5f }, { 0.0f, 1.0f, 0.0f } },
+            { { -0.5f, -0.5f }, { 0.0f, 0.0f, 1.0f } }
+        });
+        std::vector<InstanceData> instances(kInstances);
+        for (uint32_t i = 0; i < kInstances; i++) {
+            float x = static_cast<float>(i % 500) / 250.0f - 1.0f;
+            float y = static_cast<float>(i / 500) / 200.0f - 1.0f;
+            instances[i] = { { x, y }, 0.004f };
+        }
+        instanced.setInstances(mesh, instances);
+        instanced.uploadDrawData();
+        SubmitTiming manyInstances = harness.measure(kIterations, [&](VkCommandBuffer commandBuffer) {
+            vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, instancedPipeline);
+            instanced.recordDrawCommands(commandBuffer);
+        });
+
+        // Mesh grande: uma grade indexada cobrindo a tela, limitada pelo processamento de vértices
+        std::vector<Vertex> gridVertices;
+        std::vector<uint32_t> gridIndices;
+        gridVertices.reserve((kLargeGrid + 1) * (kLargeGrid + 1));
+        gridIndices.reserve(kLargeGrid * kLargeGrid * 6);
+        for (uint32_t y = 0; y <= kLargeGrid; y++) {
+            for (uint32_t x = 0; x <= kLargeGrid; x++) {
+                float u = static_cast<float>(x) / kLargeGrid;
+                float v = static_cast<float>(y) / kLargeGrid;
+                gridVertices.push_back({ { u * 2.0f - 1.0f, v * 2.0f - 1.0f }, { u, v, 0.5f } });
+            }
+        }
+        for (uint32_t y = 0; y < kLargeGrid; y++) {
+            for (uint32_t x = 0; x < kLargeGrid; x++) {
+                uint32_t a = y * (kLargeGrid + 1) + x;
+                uint32_t c = a + kLargeGrid + 1;
+                gridIndices.insert(gridIndices.end(), { a, a + 1, c, a + 1, c + 1, c });
+            }
+        }
+        Model large(device);
+        large.addMesh(gridVertices, gridIndices);
+        SubmitTiming largeMesh = harness.measure(kIterations, [&](VkCommandBuffer commandBuffer) {
+            vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, plainPipeline);
+            large.recordDrawCommands(commandBuffer);
+        });
+
+        manyDraws.report(context.report(), "scenario_many_draws");
+        manyInstances.report(context.report(), "scenario_many_instances");
+        largeMesh.report(context.report(), "scenario_large_mesh");
+
+        std::printf("scenarios (headless %ux%u, %d frames each; cpu = record + submit, frame = until the fence):\n",
+                    kExtent, kExtent, kIterations);
+        char detail[64];
+        std::snprintf(detail, sizeof(detail), "%u draws", kDraws);
+        printScenario("many_draws", detail, manyDraws);
+        std::snprintf(detail, sizeof(detail), "%u instances", kInstances);
+        printScenario("many_instances", detail, manyInstances);
+        std::snprintf(detail, sizeof(detail), "%zu triangles", gridIndices.size() / 3);
+        printScenario("large_mesh", detail, largeMesh);
+    }
+
+} // namespace vke::bench
@@ -0,0 +1,86 @@
+#include "BenchContext.h"
+#include "Benchmarks.h"
+
+#include "core/JobSystem.h"
+#include "scene/Scene.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace vke::bench {
+
+    namespace {
+
+        constexpr uint32_t kNodeCount = 1000000;
+        constexpr uint32_t kRootCount = 1000;
+        constexpr uint32_t kDirtyCount = kNodeCount / 100;
+        constexpr int kIterations = 9;
+
+        // Pai sorteado entre os nós já criados: árvore recursiva aleatória, rasa (~ln n níveis)
+        // e com subárvores pequenas na média, como cenas com muitos props sob poucos grupos
+        std::vector<SceneNode> buildScene(Scene& scene, std::mt19937& rng) {
+            std::uniform_real_distribution<float> position(-10.0f, 10.0f);
+            std::vector<SceneNode> nodes;
+            nodes.reserve(kNodeCount);
+            for (uint32_t i = 0; i < kNodeCount; i++) {
+                SceneNode parent;
+                if (i >= kRootCount) {
+                    parent = nodes[rng() % i];
+                }
+                Transform local;
+                local.position[0] = position(rng);
+                local.position[1] = position(rng);
+                local.position[2] = position(rng);
+                nodes.push_back(scene.create(parent, local));
+                scene.setLocalBounds(nodes.back(), { { 0.0f, 0.0f, 0.0f }, 1.0f });
+            }
+            return nodes;
+        }
+
+    } // namespace
+
+    void runSceneBenchmark(BenchContext&) {
+        std::mt19937 rng(7);
+        Scene scene;
+        std::vector<SceneNode> nodes = buildScene(scene, rng);
+
+        // A primeira atualização também ordena os arrays por profundidade
+        Timer sortTimer;
+        scene.updateTransforms();
+        std::printf("scene (%u nodes, %u roots; first update incl. depth sort %.2f ms):\n",
+                    kNodeCount, kRootCount, sortTimer.seconds() * 1000.0);
+
+        auto measure = [&](JobSystem* jobs, uint32_t dirtyCount) {
+            std::vector<double> times;
+            uint32_t updated = 0;
+            for (int i = 0; i < kIterations; i++) {
+                for (uint32_t d = 0; d < dirtyCount; d++) {
+                    SceneNode node = dirtyCount == kNodeCount ? nodes[d] : nodes[rng() % kNodeCount];
+                    scene.setPosition(node, 1.0f, 2.0f, 3.0f);
+                }
+                Timer timer;
+                scene.updateTransforms(jobs);
+                times.push_back(timer.seconds() * 1000.0);
+                updated = scene.getLastUpdatedCount();
+            }
+            std::sort(times.begin(), times.end());
+            return std::make_pair(times[times.size() / 2], updated);
+        };
+
+        uint32_t maxThreads = std::max(1u, std::thread::hardware_concurrency());
+        for (uint32_t threads = 1; threads <= maxThreads; threads *= 2) {
+            JobSystem jobs(threads);
+            JobSystem* scheduler = threads > 1 ? &jobs : nullptr;
+            auto [fullMs, fullUpdated] = measure(scheduler, kNodeCount);
+            auto [partialMs, partialUpdated] = measure(scheduler, kDirtyCount);
+            auto [idleMs, idleUpdated] = measure(scheduler, 0);
+            std::printf("  %2u thread(s): all dirty %8.3f ms (%7u nodes) | 1%% dirty %8.3f ms (%7u nodes) | clean %6.3f ms\n",
+                        threads, fullMs, fullUpdated, partialMs, partialUpdated, idleMs);
+            (void)idleUpdated;
+        }
+    }
+
+} // namespace vke::bench
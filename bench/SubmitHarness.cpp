@@ -0,0 +1,125 @@
+#include "SubmitHarness.h"
+#include "BenchContext.h"
+
+#include "gfx/OffscreenTarget.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+namespace vke::bench {
+
+    SubmitHarness::SubmitHarness(BenchContext& context, uint32_t extent)
+        : m_context(context)
+        , m_extent(extent)
+    {
+        Device& device = context.device();
+        m_target = std::make_unique<OffscreenTarget>(device, extent, extent, 1);
+
+        VkImageView attachment = m_target->getImageViews()[0];
+        VkFramebufferCreateInfo framebufferInfo{};
+        framebufferInfo.sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
+        framebufferInfo.renderPass = context.renderPass();
+        framebufferInfo.attachmentCount = 1;
+        framebufferInfo.pAttachments = &attachment;
+        framebufferInfo.width = extent;
+        framebufferInfo.height = extent;
+        framebufferInfo.layers = 1;
+        if (vkCreateFramebuffer(device.device(), &framebufferInfo, nullptr, &m_framebuffer) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to create framebuffer!");
+        }
+
+        VkCommandPoolCreateInfo poolInfo{};
+        poolInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+        poolInfo.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+        poolInfo.queueFamilyIndex = device.queueFamilies().graphicsFamily.value();
+        if (vkCreateCommandPool(device.device(), &poolInfo, nullptr, &m_commandPool) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to create command pool!");
+        }
+
+        VkCommandBufferAllocateInfo allocInfo{};
+        allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+        allocInfo.commandPool = m_commandPool;
+        allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+        allocInfo.commandBufferCount = 1;
+        if (vkAllocateCommandBuffers(device.device(), &allocInfo, &m_commandBuffer) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to allocate command buffer!");
+        }
+
+        VkFenceCreateInfo fenceInfo{};
+        fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+        if (vkCreateFence(device.device(), &fenceInfo, nullptr, &m_fence) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to create fence!");
+        }
+    }
+
+    SubmitHarness::~SubmitHarness() {
+        VkDevice device = m_context.device().device();
+        vkDestroyFence(device, m_fence, nullptr);
+        vkDestroyCommandPool(device, m_commandPool, nullptr);
+        vkDestroyFramebuffer(device, m_framebuffer, nullptr);
+    }
+
+    SubmitTiming SubmitHarness::measure(int iterations, const std::function<void(VkCommandBuffer)>& recordDraws,
+                                        const std::function<void(VkCommandBuffer)>& prePass) {
+        Device& device = m_context.device();
+
+        std::vector<double> cpuTimes;
+        std::vector<double> frameTimes;
+        for (int i = 0; i < iterations; i++) {
+            Timer timer;
+            vkResetCommandPool(device.device(), m_commandPool, 0);
+
+            VkCommandBufferBeginInfo beginInfo{};
+            beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+            beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+            vkBeginCommandBuffer(m_commandBuffer, &beginInfo);
+            if (prePass) {
+                prePass(m_commandBuffer);
+            }
+
+            VkClearValue clearColor = { {{ 0.0f, 0.0f, 0.0f, 1.0f }} };
+            VkRenderPassBeginInfo renderPassInfo{};
+            renderPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
+            renderPassInfo.renderPass = m_context.renderPass();
+            renderPassInfo.framebuffer = m_framebuffer;
+            renderPassInfo.renderArea = { { 0, 0 }, { m_extent, m_extent } };
+            renderPassInfo.clearValueCount = 1;
+            renderPassInfo.pClearValues = &clearColor;
+            vkCmdBeginRenderPass(m_commandBuffer, &renderPassInfo, VK_SUBPASS_CONTENTS_INLINE);
+
+            VkViewport viewport{ 0.0f, 0.0f, static_cast<float>(m_extent), static_cast<float>(m_extent), 0.0f, 1.0f };
+            VkRect2D scissor{ { 0, 0 }, { m_extent, m_extent } };
+            vkCmdSetViewport(m_commandBuffer, 0, 1, &viewport);
+            vkCmdSetScissor(m_commandBuffer, 0, 1, &scissor);
+            recordDraws(m_commandBuffer);
+
+            vkCmdEndRenderPass(m_commandBuffer);
+            vkEndCommandBuffer(m_commandBuffer);
+
+            VkSubmitInfo submitInfo{};
+            submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+            submitInfo.commandBufferCount = 1;
+            submitInfo.pCommandBuffers = &m_commandBuffer;
+            vkQueueSubmit(device.graphicsQueue(), 1, &submitInfo, m_fence);
+            cpuTimes.push_back(timer.seconds() * 1000.0);
+
+            vkWaitForFences(device.device(), 1, &m_fence, VK_TRUE, UINT64_MAX);
+            vkResetFences(device.device(), 1, &m_fence);
+            frameTimes.push_back(timer.seconds() * 1000.0);
+        }
+
+        SubmitTiming timing;
+        timing.cpu = SampleStats::fromSamples(std::move(cpuTimes));
+        timing.frame = SampleStats::fromSamples(std::move(frameTimes));
+        timing.cpuMs = timing.cpu.p50;
+        timing.frameMs = timing.frame.p50;
+        return timing;
+    }
+
+    void SubmitTiming::report(BenchReport& report, const std::string& benchmark) const {
+        report.add(benchmark, "cpu_ms", cpu);
+        report.add(benchmark, "frame_ms", frame);
+    }
+
+} // namespace vke::bench
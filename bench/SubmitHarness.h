@@ -0,0 +1,59 @@
+#ifndef VKE_SUBMITHARNESS_H
+#define VKE_SUBMITHARNESS_H
+
+#include <vulkan/vulkan.h>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+
+#include "BenchReport.h"
+
+namespace vke {
+    class OffscreenTarget;
+}
+
+namespace vke::bench {
+
+    class BenchContext;
+
+    // Tempos de um frame offscreen: CPU (gravação + vkQueueSubmit) e frame completo (até a fence).
+    // cpuMs/frameMs são as medianas; as distribuições completas ficam em cpu/frame
+    struct SubmitTiming {
+        double cpuMs = 0.0;
+        double frameMs = 0.0;
+        SampleStats cpu;
+        SampleStats frame;
+
+        // Registra as duas distribuições como "<benchmark>" cpu_ms e frame_ms
+        void report(BenchReport& report, const std::string& benchmark) const;
+    };
+
+    // Alvo offscreen quadrado com framebuffer, command buffer e fence próprios,
+    // para medir o custo de gravar e submeter frames inteiros na render pass do contexto
+    class SubmitHarness {
+    public:
+        SubmitHarness(BenchContext& context, uint32_t extent);
+        ~SubmitHarness();
+
+        SubmitHarness(const SubmitHarness&) = delete;
+        SubmitHarness& operator=(const SubmitHarness&) = delete;
+
+        // recordDraws grava dentro da render pass, com viewport/scissor já definidos;
+        // prePass (opcional) grava antes dela, ex.: dispatches de compute
+        SubmitTiming measure(int iterations, const std::function<void(VkCommandBuffer)>& recordDraws,
+                             const std::function<void(VkCommandBuffer)>& prePass = {});
+
+    private:
+        BenchContext& m_context;
+        uint32_t m_extent;
+        std::unique_ptr<OffscreenTarget> m_target;
+        VkFramebuffer m_framebuffer = VK_NULL_HANDLE;
+        VkCommandPool m_commandPool = VK_NULL_HANDLE;
+        VkCommandBuffer m_commandBuffer = VK_NULL_HANDLE;
+        VkFence m_fence = VK_NULL_HANDLE;
+    };
+
+} // namespace vke::bench
+
+#endif // VKE_SUBMITHARNESS_H
@@ -0,0 +1,89 @@
+#include "BenchContext.h"
+#include "Benchmarks.h"
+
+#include "gfx/Buffer.h"
+#include "gfx/UploadContext.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace vke::bench {
+
+    namespace {
+
+        constexpr uint32_t kMeshCount = 2048;
+        constexpr VkDeviceSize kMeshBytes = 64 * 1024;
+        constexpr int kIterations = 5;
+
+        // Mediana de kIterations execuções, em MB/s
+        double measure(const std::function<void()>& body) {
+            std::vector<double> rates;
+            for (int i = 0; i < kIterations; i++) {
+                Timer timer;
+                body();
+                double seconds = timer.seconds();
+                rates.push_back(static_cast<double>(kMeshCount * kMeshBytes) / (1024.0 * 1024.0) / seconds);
+            }
+            std::sort(rates.begin(), rates.end());
+            return rates[rates.size() / 2];
+        }
+
+    } // namespace
+
+    void runUploadBenchmark(BenchContext& context) {
+        Device& device = context.device();
+        std::vector<char> payload(kMeshBytes, 0x5A);
+        std::vector<std::unique_ptr<Buffer>> buffers;
+        buffers.reserve(kMeshCount);
+
+        // Caminho antigo: cada mesh em HOST_VISIBLE | HOST_COHERENT, escrito direto pela CPU
+        double hostVisible = measure([&] {
+            buffers.clear();
+            for (uint32_t i = 0; i < kMeshCount; i++) {
+                auto buffer = std::make_unique<Buffer>(device);
+                buffer->create(kMeshBytes, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
+                               VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+                buffer->uploadData(payload.data(), kMeshBytes);
+                buffers.push_back(std::move(buffer));
+            }
+        });
+
+        // Staging sem lote: uma submissão e uma espera de fence por mesh
+        double stagedUnbatched = measure([&] {
+            buffers.clear();
+            for (uint32_t i = 0; i < kMeshCount; i++) {
+                auto buffer = std::make_unique<Buffer>(device);
+                buffer->create(kMeshBytes, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                               VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+                device.uploader().uploadToBuffer(*buffer, payload.data(), kMeshBytes);
+                buffers.push_back(std::move(buffer));
+            }
+        });
+
+        // Staging em lote: todos os meshes em um command buffer (respeitando o tamanho do staging)
+        device.uploader().resetStats();
+        double stagedBatched = measure([&] {
+            buffers.clear();
+            UploadBatch batch(device.uploader());
+            for (uint32_t i = 0; i < kMeshCount; i++) {
+                auto buffer = std::make_unique<Buffer>(device);
+                buffer->create(kMeshBytes, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                               VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+                device.uploader().uploadToBuffer(*buffer, payload.data(), kMeshBytes);
+                buffers.push_back(std::move(buffer));
+            }
+        });
+        UploadStats stats = device.uploader().getStats();
+        buffers.clear();
+
+        std::printf("upload: %u meshes x %llu KB\n", kMeshCount, static_cast<unsigned long long>(kMeshBytes / 1024));
+        std::printf("  host-visible map/memcpy : %8.1f MB/s\n", hostVisible);
+        std::printf("  staged, fence per mesh  : %8.1f MB/s\n", stagedUnbatched);
+        std::printf("  staged, batched         : %8.1f MB/s (%u submits per run)\n",
+                    stagedBatched, stats.submitCount / kIterations);
+    }
+
+} // namespace vke::bench
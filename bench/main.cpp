@@ -0,0 +1,109 @@
+#include "BenchContext.h"
+#include "Benchmarks.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+    struct BenchEntry {
+        const char* name;
+        void (*run)(vke::bench::BenchContext&);
+    };
+
+    const BenchEntry kBenchmarks[] = {
+        { "upload", vke::bench::runUploadBenchmark },
+        { "pipeline_cache", vke::bench::runPipelineCacheBenchmark },
+        { "pipeline_stream", vke::bench::runPipelineStreamBenchmark },
+        { "record", vke::bench::runRecordBenchmark },
+        { "jobs", vke::bench::runJobBenchmark },
+        { "instancing", vke::bench::runInstancingBenchmark },
+        { "indirect", vke::bench::runIndirectBenchmark },
+        { "gpu_cull", vke::bench::runGpuCullBenchmark },
+        { "cpu_cull", vke::bench::runCpuCullBenchmark },
+        { "scene", vke::bench::runSceneBenchmark },
+        { "frame_arena", vke::bench::runFrameArenaBenchmark },
+        { "descriptors", vke::bench::runDescriptorBenchmark },
+        { "render_queue", vke::bench::runRenderQueueBenchmark },
+        { "allocator", vke::bench::runAllocatorBenchmark },
+        { "mesh", vke::bench::runMeshBenchmark },
+        { "gltf", vke::bench::runGltfBenchmark },
+        { "scenarios", vke::bench::runScenarioBenchmark },
+    };
+
+    void printUsage(const char* program) {
+        std::cerr << "Usage: " << program << " [--json out.json] [--baseline base.json] [--tolerance 0.10] [--list] [name...]\n";
+    }
+
+} // namespace
+
+// Uso: vke_bench [--json saida.json] [--baseline base.json] [--tolerance fração] [nome...]
+// Sem nomes roda todos. Com --baseline, sai com erro se alguma métrica regrediu.
+int main(int argc, char** argv) {
+    std::string jsonPath;
+    std::string baselinePath;
+    double tolerance = 0.10;
+    std::vector<std::string> names;
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--json") == 0 && i + 1 < argc) {
+            jsonPath = argv[++i];
+        } else if (std::strcmp(argv[i], "--baseline") == 0 && i + 1 < argc) {
+            baselinePath = argv[++i];
+        } else if (std::strcmp(argv[i], "--tolerance") == 0 && i + 1 < argc) {
+            tolerance = std::strtod(argv[++i], nullptr);
+        } else if (std::strcmp(argv[i], "--list") == 0) {
+            for (const auto& bench : kBenchmarks) {
+                std::cout << bench.name << "\n";
+            }
+            return EXIT_SUCCESS;
+        } else if (argv[i][0] == '-') {
+            printUsage(argv[0]);
+            return EXIT_FAILURE;
+        } else {
+            names.emplace_back(argv[i]);
+        }
+    }
+
+    // Um nome errado rodaria nada e passaria no gate de regressão
+    for (const auto& name : names) {
+        bool known = false;
+        for (const auto& bench : kBenchmarks) {
+            known |= name == bench.name;
+        }
+        if (!known) {
+            std::cerr << "Unknown benchmark: " << name << " (see --list)\n";
+            printUsage(argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    try {
+        vke::bench::BenchContext context;
+        for (const auto& bench : kBenchmarks) {
+            bool selected = names.empty();
+            for (const auto& name : names) {
+                selected |= name == bench.name;
+            }
+            if (selected) {
+                bench.run(context);
+            }
+        }
+
+        vke::bench::BenchReport& report = context.report();
+        if (!jsonPath.empty()) {
+            report.writeJson(jsonPath, context.deviceName());
+            std::printf("%zu metric(s) written to %s\n", report.getResults().size(), jsonPath.c_str());
+        }
+        if (!baselinePath.empty() && report.compareWithBaseline(baselinePath, tolerance) > 0) {
+            return EXIT_FAILURE;
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Fatal error: " << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
@@ -7,23 +7,50 @@
 #include <memory>
 #include <optional>
 
+#include "core/MemoryAllocator.h"
+#include "core/PipelineCache.h"
+
 namespace vke {
 
+    class PipelineRegistry;
+    class UploadContext;
+
     // Estrutura que encapsula os índices das filas (graphics e present)
     struct QueueFamilyIndices {
         std::optional<uint32_t> graphicsFamily;
         std::optional<uint32_t> presentFamily;
 
-        bool isComplete() const {
-            return graphicsFamily.has_value() && presentFamily.has_value();
+        // Em modo headless não há surface, então a fila de apresentação é opcional
+        bool isComplete(bool needsPresent = true) const {
+            return graphicsFamily.has_value() && (presentFamily.has_value() || !needsPresent);
         }
     };
 
+    // Recursos opcionais detectados na GPU e habilitados quando disponíveis
+    struct DeviceFeatures {
+        bool multiDrawIndirect = false;         // drawCount > 1 em vkCmdDrawIndexedIndirect
+        bool drawIndirectFirstInstance = false; // firstInstance != 0 em comandos indiretos
+        bool drawIndirectCount = false;         // VK_KHR_draw_indirect_count
+        bool descriptorIndexing = false;        // VK_EXT_descriptor_indexing com update-after-bind (tabela bindless)
+        bool dynamicRendering = false;          // VK_KHR_dynamic_rendering + VK_KHR_synchronization2 (sem VkRenderPass)
+        bool timestampQueries = false;          // vkCmdWriteTimestamp na fila gráfica (timestampValidBits > 0)
+        bool pipelineStatisticsQuery = false;   // queries de estatísticas do pipeline (primitivas, invocações)
+    };
+
     class Device {
     public:
-        Device(VkInstance instance, VkSurfaceKHR surface);
+        static constexpr const char* kDefaultPipelineCachePath = "pipeline_cache.bin";
+
+        // surface == VK_NULL_HANDLE cria um device headless (sem swapchain nem present).
+        // pipelineCachePath vazio mantém o cache de pipelines só em memória.
+        Device(VkInstance instance, VkSurfaceKHR surface,
+               const std::string& pipelineCachePath = kDefaultPipelineCachePath);
         ~Device();
 
+        // Acrescenta as extensões de instância opcionais que o Device aproveita
+        // (VK_KHR_get_physical_device_properties2). Chamar antes de vkCreateInstance.
+        static void appendInstanceExtensions(std::vector<const char*>& extensions);
+
         // Proíbe cópia
         Device(const Device&) = delete;
         Device& operator=(const Device&) = delete;
@@ -33,14 +60,49 @@ namespace vke {
         VkPhysicalDevice physicalDevice() const { return m_physicalDevice; }
         VkQueue graphicsQueue() const { return m_graphicsQueue; }
         VkQueue presentQueue() const { return m_presentQueue; }
+        bool headless() const { return m_surface == VK_NULL_HANDLE; }
+        const QueueFamilyIndices& queueFamilies() const { return m_queueFamilies; }
+
+        // Propriedades da GPU consultadas uma única vez na criação
+        const VkPhysicalDeviceProperties& properties() const { return m_properties; }
+        const VkPhysicalDeviceMemoryProperties& memoryProperties() const { return m_memoryProperties; }
+        const DeviceFeatures& features() const { return m_features; }
+        // Bits válidos dos timestamps da fila gráfica; 0 sem suporte
+        uint32_t timestampValidBits() const { return m_timestampValidBits; }
+        // Limites de descritores update-after-bind; zerados sem features().descriptorIndexing
+        const VkPhysicalDeviceDescriptorIndexingPropertiesEXT& descriptorIndexingProperties() const { return m_descriptorIndexingProperties; }
+
+        // vkCmdDrawIndexedIndirectCountKHR; nullptr sem VK_KHR_draw_indirect_count
+        PFN_vkCmdDrawIndexedIndirectCountKHR cmdDrawIndexedIndirectCount() const { return m_cmdDrawIndexedIndirectCount; }
+        // Comandos de dynamic rendering e barreiras sync2; nullptr sem features().dynamicRendering
+        PFN_vkCmdBeginRenderingKHR cmdBeginRendering() const { return m_cmdBeginRendering; }
+        PFN_vkCmdEndRenderingKHR cmdEndRendering() const { return m_cmdEndRendering; }
+        PFN_vkCmdPipelineBarrier2KHR cmdPipelineBarrier2() const { return m_cmdPipelineBarrier2; }
+
+        // Alocador de memória compartilhado por todos os recursos do device
+        MemoryAllocator& allocator() const { return *m_allocator; }
+
+        // Serviço de upload via staging para buffers DEVICE_LOCAL
+        UploadContext& uploader() const { return *m_uploader; }
+
+        // Cache de pipelines persistido em disco entre execuções
+        PipelineCache& pipelineCache() const { return *m_pipelineCache; }
+
+        // Registro de pipelines deduplicados por chave
+        PipelineRegistry& pipelines() const { return *m_pipelines; }
 
     private:
         // Funções auxiliares
         void pickPhysicalDevice();
         bool isDeviceSuitable(VkPhysicalDevice device) const;
         bool checkDeviceExtensionSupport(VkPhysicalDevice device) const;
+        bool isExtensionAvailable(VkPhysicalDevice device, const char* extensionName) const;
         QueueFamilyIndices findQueueFamilies(VkPhysicalDevice device) const;
         void createLogicalDevice();
+        bool queryFeatures2(void* chain) const;
+        bool queryDescriptorIndexing(VkPhysicalDeviceDescriptorIndexingFeaturesEXT& enabled);
+        bool queryDynamicRendering(VkPhysicalDeviceDynamicRenderingFeaturesKHR& rendering,
+                                   VkPhysicalDeviceSynchronization2FeaturesKHR& synchronization2) const;
 
     private:
         VkInstance m_instance = VK_NULL_HANDLE;
@@ -55,11 +117,24 @@ namespace vke {
         // Filas para gráficos e apresentação
         VkQueue m_graphicsQueue = VK_NULL_HANDLE;
         VkQueue m_presentQueue = VK_NULL_HANDLE;
+        QueueFamilyIndices m_queueFamilies;
+
+        VkPhysicalDeviceProperties m_properties{};
+        VkPhysicalDeviceMemoryProperties m_memoryProperties{};
+        DeviceFeatures m_features{};
+        uint32_t m_timestampValidBits = 0;
+        VkPhysicalDeviceDescriptorIndexingPropertiesEXT m_descriptorIndexingProperties{};
+        PFN_vkCmdDrawIndexedIndirectCountKHR m_cmdDrawIndexedIndirectCount = nullptr;
+        PFN_vkCmdBeginRenderingKHR m_cmdBeginRendering = nullptr;
+        PFN_vkCmdEndRenderingKHR m_cmdEndRendering = nullptr;
+        PFN_vkCmdPipelineBarrier2KHR m_cmdPipelineBarrier2 = nullptr;
+        std::unique_ptr<MemoryAllocator> m_allocator;
+        std::unique_ptr<UploadContext> m_uploader;
+        std::unique_ptr<PipelineCache> m_pipelineCache;
+        std::unique_ptr<PipelineRegistry> m_pipelines;
 
-        // Lista de extensões necessárias (por exemplo, swapchain)
-        const std::vector<const char*> m_requiredExtensions = {
-            VK_KHR_SWAPCHAIN_EXTENSION_NAME
-        };
+        // Lista de extensões necessárias (swapchain apenas quando há surface)
+        std::vector<const char*> m_requiredExtensions;
     };
 
 } // namespace vke
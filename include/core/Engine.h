@@ -5,16 +5,20 @@
 #include <GLFW/glfw3.h>
 #include <string>
 #include <memory>
-#include "core/Swapchain.h"
+#include "core/SwapChain.h"
 #include "gfx/Renderer.h"
 
 namespace vke {
 
     class Device; // Forward declaration
+    class JobSystem;
+    class OffscreenTarget;
 
     class Engine {
     public:
-        Engine(std::string windowTitle, int width, int height);
+        // headless = true: sem GLFW, surface nem swapchain; renderiza em imagens
+        // offscreen (útil em CI com lavapipe/SwiftShader)
+        Engine(std::string windowTitle, int width, int height, bool headless = false);
         ~Engine();
 
         // Proíbe cópia
@@ -23,6 +27,15 @@ namespace vke {
 
         void run() const;
 
+        // Substitui o triângulo padrão pelos meshes de um arquivo .vkm (vke_meshcook) ou glTF 2.0
+        void loadModel(const std::string& path);
+
+        // Renderiza frameCount frames sem janela e retorna a vazão em frames/s.
+        // Se dumpPath não for vazio, o último frame é lido de volta e gravado como PPM;
+        // se gpuTracePath não for vazio, os escopos de GPU viram um Chrome trace JSON.
+        double runHeadless(uint32_t frameCount, const std::string& dumpPath = {},
+                           const std::string& gpuTracePath = {});
+
     private:
         void initWindow();
         void initVulkan();
@@ -32,12 +45,16 @@ namespace vke {
         // Funções Vulkan extras
         void createInstance();
         void createSurface();
+        void reportPipelineCache() const;
+        void reportGpuProfile() const;
         static bool checkValidationLayerSupport();
+        static void framebufferResizeCallback(GLFWwindow* window, int width, int height);
 
     private:
         std::string m_windowTitle;
         int m_width;
         int m_height;
+        bool m_headless;
         GLFWwindow* m_window = nullptr;
 
         VkInstance m_instance = VK_NULL_HANDLE;
@@ -47,12 +64,19 @@ namespace vke {
         VkDebugUtilsMessengerEXT m_debugMessenger = VK_NULL_HANDLE;
 #endif
 
+        // Escalonador de tarefas de CPU; a thread principal é o worker 0
+        std::unique_ptr<JobSystem> m_jobs;
+
         // Gerenciador do device
         std::unique_ptr<Device> m_device;
 
         // Novos membros para a swapchain e o renderer
         std::unique_ptr<SwapChain> m_swapChain;
+        std::unique_ptr<OffscreenTarget> m_offscreenTarget; // só no modo headless
         std::unique_ptr<Renderer> m_renderer;
+
+        // O relatório do cache de pipelines sai uma vez só (ver reportPipelineCache)
+        mutable bool m_pipelineCacheReported = false;
     };
 
 } // namespace vke
@@ -0,0 +1,110 @@
+#ifndef VKE_JOBSYSTEM_H
+#define VKE_JOBSYSTEM_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace vke {
+
+    class JobSystem;
+
+    using Job = std::function<void()>;
+
+    // Contador de jobs pendentes. Cada job lançado com um contador o incrementa
+    // e o decrementa ao terminar; quando chega a zero, as continuações
+    // registradas com runAfter() são escalonadas. Pode ser reutilizado depois de
+    // wait() retornar.
+    class JobCounter {
+    public:
+        JobCounter() = default;
+        JobCounter(const JobCounter&) = delete;
+        JobCounter& operator=(const JobCounter&) = delete;
+
+        [[nodiscard]] bool done() const { return m_value.load(std::memory_order_acquire) == 0; }
+
+    private:
+        friend class JobSystem;
+
+        std::atomic<uint32_t> m_value{ 0 };
+        mutable std::mutex m_mutex;
+        std::vector<std::pair<Job, JobCounter*>> m_continuations;
+    };
+
+    struct JobSystemStats {
+        uint64_t executed = 0; // jobs executados
+        uint64_t stolen = 0;   // jobs tirados da fila de outra thread
+    };
+
+    // Escalonador de tarefas com work stealing: cada worker tem sua própria fila
+    // (o dono empilha/desempilha no fim, ladrões retiram do início). A thread que
+    // cria o sistema é o worker 0 e participa executando jobs enquanto espera
+    // em wait()/parallelFor(), então nunca bloqueia ociosa.
+    class JobSystem {
+    public:
+        // threadCount = 0 usa std::thread::hardware_concurrency() (incluindo a thread chamadora)
+        explicit JobSystem(uint32_t threadCount = 0);
+        ~JobSystem();
+
+        // Proíbe cópia
+        JobSystem(const JobSystem&) = delete;
+        JobSystem& operator=(const JobSystem&) = delete;
+
+        // Lança um job; counter (opcional) é incrementado agora e decrementado ao fim.
+        // Jobs não podem lançar exceções: capture-as dentro do job.
+        void run(Job job, JobCounter* counter = nullptr);
+
+        // Lança job só depois que dependency chegar a zero
+        void runAfter(JobCounter& dependency, Job job, JobCounter* counter = nullptr);
+
+        // Executa outros jobs até o contador zerar
+        void wait(const JobCounter& counter);
+
+        // Divide [0, count) em faixas de até grainSize e espera todas terminarem
+        void parallelFor(uint32_t count, uint32_t grainSize,
+                         const std::function<void(uint32_t begin, uint32_t end)>& body);
+
+        [[nodiscard]] uint32_t getWorkerCount() const { return static_cast<uint32_t>(m_queues.size()); }
+
+        // Índice do worker da thread atual em [0, getWorkerCount()). Threads de fora
+        // contam como 0, então estado por worker só é seguro se elas não o usarem
+        [[nodiscard]] uint32_t currentWorkerIndex() const;
+
+        [[nodiscard]] JobSystemStats getStats() const;
+
+    private:
+        struct alignas(64) WorkerQueue {
+            std::mutex mutex;
+            std::deque<std::pair<Job, JobCounter*>> jobs;
+        };
+
+        void push(uint32_t worker, Job job, JobCounter* counter);
+        bool tryExecuteOne(uint32_t worker);
+        void finish(JobCounter* counter);
+        void workerLoop(uint32_t worker);
+
+    private:
+        std::vector<std::unique_ptr<WorkerQueue>> m_queues;
+        std::vector<std::thread> m_threads;
+
+        // Workers ociosos dormem aqui; m_queuedJobs evita acordá-los à toa e
+        // m_sleepingWorkers deixa push() longe do mutex quando ninguém dorme
+        std::atomic<uint32_t> m_queuedJobs{ 0 };
+        std::atomic<uint32_t> m_sleepingWorkers{ 0 };
+        std::mutex m_sleepMutex;
+        std::condition_variable m_sleepCv;
+        std::atomic<bool> m_stopping{ false };
+
+        std::atomic<uint64_t> m_executed{ 0 };
+        std::atomic<uint64_t> m_stolen{ 0 };
+    };
+
+} // namespace vke
+
+#endif // VKE_JOBSYSTEM_H
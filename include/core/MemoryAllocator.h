@@ -0,0 +1,186 @@
+#ifndef VKE_MEMORYALLOCATOR_H
+#define VKE_MEMORYALLOCATOR_H
+
+#include <vulkan/vulkan.h>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace vke {
+
+    // Estratégia de sub-alocação usada dentro de cada bloco de VkDeviceMemory
+    enum class AllocationStrategy {
+        Linear, // bump pointer; o bloco só é reciclado quando todas as alocações são liberadas
+        Buddy   // potências de dois com fusão de "buddies" na liberação
+    };
+
+    // Estatísticas de ocupação (por bloco ou agregadas)
+    struct MemoryStats {
+        uint32_t blockCount = 0;
+        uint32_t allocationCount = 0;
+        uint32_t dedicatedCount = 0;
+        VkDeviceSize blockBytes = 0;       // total reservado com vkAllocateMemory
+        VkDeviceSize usedBytes = 0;        // total entregue às alocações (inclui arredondamento)
+        VkDeviceSize requestedBytes = 0;   // total efetivamente pedido pelos recursos
+        VkDeviceSize freeBytes = 0;
+        VkDeviceSize largestFreeRange = 0;
+
+        // 0 = todo o espaço livre é contíguo; perto de 1 = espaço livre muito picotado
+        [[nodiscard]] float externalFragmentation() const {
+            return freeBytes == 0 ? 0.0f
+                                  : 1.0f - static_cast<float>(largestFreeRange) / static_cast<float>(freeBytes);
+        }
+
+        // Fração do espaço usado que é desperdiçada por arredondamento/alinhamento
+        [[nodiscard]] float internalFragmentation() const {
+            return usedBytes == 0 ? 0.0f
+                                  : 1.0f - static_cast<float>(requestedBytes) / static_cast<float>(usedBytes);
+        }
+    };
+
+    // Interface dos algoritmos de sub-alocação. Trabalham apenas com offsets,
+    // sem nenhuma chamada Vulkan, e podem ser exercitados isoladamente.
+    class BlockAllocator {
+    public:
+        virtual ~BlockAllocator() = default;
+
+        // Retorna false se não houver espaço contíguo suficiente
+        virtual bool allocate(VkDeviceSize size, VkDeviceSize alignment, VkDeviceSize& outOffset) = 0;
+        virtual void free(VkDeviceSize offset, VkDeviceSize size) = 0;
+
+        [[nodiscard]] virtual bool empty() const = 0;
+        [[nodiscard]] virtual MemoryStats stats() const = 0;
+    };
+
+    class LinearBlockAllocator final : public BlockAllocator {
+    public:
+        explicit LinearBlockAllocator(VkDeviceSize capacity);
+
+        bool allocate(VkDeviceSize size, VkDeviceSize alignment, VkDeviceSize& outOffset) override;
+        void free(VkDeviceSize offset, VkDeviceSize size) override;
+
+        [[nodiscard]] bool empty() const override { return m_liveCount == 0; }
+        [[nodiscard]] MemoryStats stats() const override;
+
+    private:
+        VkDeviceSize m_capacity;
+        VkDeviceSize m_head = 0;
+        VkDeviceSize m_requested = 0;
+        uint32_t m_liveCount = 0;
+    };
+
+    class BuddyBlockAllocator final : public BlockAllocator {
+    public:
+        // capacity e minBlockSize precisam ser potências de dois
+        explicit BuddyBlockAllocator(VkDeviceSize capacity, VkDeviceSize minBlockSize = 256);
+
+        bool allocate(VkDeviceSize size, VkDeviceSize alignment, VkDeviceSize& outOffset) override;
+        void free(VkDeviceSize offset, VkDeviceSize size) override;
+
+        [[nodiscard]] bool empty() const override { return m_liveCount == 0; }
+        [[nodiscard]] MemoryStats stats() const override;
+
+    private:
+        [[nodiscard]] bool isFree(uint32_t order, VkDeviceSize offset) const;
+        void setFree(uint32_t order, VkDeviceSize offset, bool value);
+
+    private:
+        VkDeviceSize m_capacity;
+        uint32_t m_minShift;
+        uint32_t m_orderCount;
+
+        // Listas livres por ordem. Entradas obsoletas (já fundidas) são
+        // descartadas na retirada, validando contra o bitmap da ordem.
+        std::vector<std::vector<VkDeviceSize>> m_freeLists;
+        std::vector<std::vector<uint64_t>> m_freeBits;
+
+        // Ordem de cada alocação viva, indexada por offset >> m_minShift
+        std::vector<uint8_t> m_allocOrder;
+
+        VkDeviceSize m_usedBytes = 0;
+        VkDeviceSize m_requested = 0;
+        uint32_t m_liveCount = 0;
+    };
+
+    // Resultado de uma sub-alocação: memória + offset a usar em vkBind*Memory
+    struct MemoryAllocation {
+        VkDeviceMemory memory = VK_NULL_HANDLE;
+        VkDeviceSize offset = 0;
+        VkDeviceSize size = 0;
+        void* mapped = nullptr; // já deslocado para o offset, se a memória for HOST_VISIBLE
+        uint32_t memoryType = 0;
+        uint32_t blockIndex = UINT32_MAX; // UINT32_MAX indica alocação dedicada
+        AllocationStrategy strategy = AllocationStrategy::Buddy;
+
+        [[nodiscard]] bool valid() const { return memory != VK_NULL_HANDLE; }
+    };
+
+    // Alocador de memória no nível do device: reserva blocos grandes por tipo de
+    // memória e sub-aloca recursos dentro deles, evitando um vkAllocateMemory
+    // por buffer (e o limite maxMemoryAllocationCount).
+    class MemoryAllocator {
+    public:
+        static constexpr VkDeviceSize kDefaultBlockSize = 64ull * 1024 * 1024;
+
+        MemoryAllocator(VkDevice device,
+                        const VkPhysicalDeviceMemoryProperties& memoryProperties,
+                        const VkPhysicalDeviceLimits& limits,
+                        VkDeviceSize preferredBlockSize = kDefaultBlockSize);
+        ~MemoryAllocator();
+
+        // Proíbe cópia
+        MemoryAllocator(const MemoryAllocator&) = delete;
+        MemoryAllocator& operator=(const MemoryAllocator&) = delete;
+
+        MemoryAllocation allocate(const VkMemoryRequirements& requirements,
+                                  VkMemoryPropertyFlags properties,
+                                  AllocationStrategy strategy = AllocationStrategy::Buddy);
+
+        // Imagens com tiling ótimo são alinhadas/arredondadas a bufferImageGranularity
+        // para nunca dividirem uma "página" com buffers no mesmo bloco
+        MemoryAllocation allocateForImage(VkImage image, VkMemoryPropertyFlags properties);
+
+        void free(MemoryAllocation& allocation);
+
+        // Torna escritas do host visíveis ao device (no-op em memória HOST_COHERENT)
+        void flush(const MemoryAllocation& allocation, VkDeviceSize offset, VkDeviceSize size) const;
+
+        [[nodiscard]] uint32_t findMemoryType(uint32_t typeFilter, VkMemoryPropertyFlags properties) const;
+        [[nodiscard]] MemoryStats getStats() const;
+        [[nodiscard]] MemoryStats getStats(uint32_t memoryType) const;
+
+    private:
+        struct MemoryBlock {
+            VkDeviceMemory memory = VK_NULL_HANDLE;
+            VkDeviceSize size = 0;
+            void* mapped = nullptr;
+            AllocationStrategy strategy = AllocationStrategy::Buddy;
+            std::unique_ptr<BlockAllocator> allocator;
+        };
+
+        struct MemoryTypePool {
+            std::vector<MemoryBlock> blocks; // blocos liberados ficam com memory == VK_NULL_HANDLE
+            uint32_t dedicatedCount = 0;
+            VkDeviceSize dedicatedBytes = 0;
+        };
+
+        VkDeviceSize blockSizeFor(uint32_t memoryType) const;
+        VkDeviceMemory allocateDeviceMemory(uint32_t memoryType, VkDeviceSize size, void** outMapped);
+        void releaseBlock(uint32_t memoryType, uint32_t blockIndex);
+        void accumulateStats(uint32_t memoryType, MemoryStats& stats) const;
+
+    private:
+        VkDevice m_device;
+        VkPhysicalDeviceMemoryProperties m_memoryProperties;
+        VkDeviceSize m_nonCoherentAtomSize;
+        VkDeviceSize m_bufferImageGranularity;
+        VkDeviceSize m_preferredBlockSize;
+
+        std::vector<MemoryTypePool> m_pools;
+        mutable std::mutex m_mutex;
+    };
+
+} // namespace vke
+
+#endif // VKE_MEMORYALLOCATOR_H
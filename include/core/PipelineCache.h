@@ -0,0 +1,50 @@
+#ifndef VKE_PIPELINECACHE_H
+#define VKE_PIPELINECACHE_H
+
+#include <vulkan/vulkan.h>
+#include <cstddef>
+#include <string>
+
+namespace vke {
+
+    // VkPipelineCache persistente. O arquivo em disco leva um cabeçalho próprio
+    // com vendorID/deviceID/driverVersion/pipelineCacheUUID; se algum não bater
+    // (troca de GPU ou driver) ou o checksum falhar, o cache começa vazio.
+    class PipelineCache {
+    public:
+        // path vazio = cache apenas em memória, nunca salvo
+        PipelineCache(VkDevice device, const VkPhysicalDeviceProperties& properties, std::string path);
+        ~PipelineCache();
+
+        // Proíbe cópia
+        PipelineCache(const PipelineCache&) = delete;
+        PipelineCache& operator=(const PipelineCache&) = delete;
+
+        // Grava o cache de forma atômica (arquivo temporário + rename), de modo que
+        // um crash no meio da escrita nunca deixa um arquivo corrompido no lugar.
+        // Não faz nada se o conteúdo não cresceu desde o último save/load.
+        void save();
+
+        [[nodiscard]] VkPipelineCache handle() const { return m_cache; }
+        [[nodiscard]] const std::string& path() const { return m_path; }
+
+        // true se dados válidos foram carregados do disco (warm start)
+        [[nodiscard]] bool loadedFromDisk() const { return m_loadedBytes > 0; }
+        [[nodiscard]] size_t loadedBytes() const { return m_loadedBytes; }
+
+    private:
+        std::string readValidatedFile() const;
+
+    private:
+        VkDevice m_device;
+        VkPhysicalDeviceProperties m_properties;
+        std::string m_path;
+        VkPipelineCache m_cache = VK_NULL_HANDLE;
+
+        size_t m_loadedBytes = 0;
+        size_t m_savedBytes = 0;
+    };
+
+} // namespace vke
+
+#endif // VKE_PIPELINECACHE_H
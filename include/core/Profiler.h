@@ -0,0 +1,124 @@
+#ifndef VKE_PROFILER_H
+#define VKE_PROFILER_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+// Liga os macros de instrumentação (definido pelo CMake com VKE_ENABLE_PROFILING).
+// Com 0 os macros somem e não sobra nenhum custo no código instrumentado.
+#ifndef VKE_PROFILING
+#define VKE_PROFILING 0
+#endif
+
+// Timestamps por rdtsc em x86 (alguns ns por leitura); steady_clock nos demais
+#ifndef VKE_PROFILER_RDTSC
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define VKE_PROFILER_RDTSC 1
+#else
+#define VKE_PROFILER_RDTSC 0
+#endif
+#endif
+
+#if VKE_PROFILER_RDTSC
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#endif
+
+namespace vke {
+
+    // Profiler de CPU: zonas, contadores e marcadores de frame gravados em um
+    // ring buffer por thread (um produtor, sem locks) e drenados pela thread
+    // que marca os frames. Só grava enquanto a captura está ligada; desligada,
+    // cada zona custa uma leitura atômica relaxada. Exporta no formato JSON do
+    // Chrome trace (chrome://tracing, Perfetto).
+    class CpuProfiler {
+    public:
+        // Eventos por thread entre duas drenagens; o excesso é descartado e contado
+        static constexpr uint32_t kRingCapacity = 1u << 14;
+        // Limite de eventos guardados por captura, para traces longos não crescerem sem fim
+        static constexpr size_t kDefaultMaxCapturedEvents = size_t(1) << 22;
+
+        [[nodiscard]] static uint64_t now() {
+#if VKE_PROFILER_RDTSC
+            return __rdtsc();
+#else
+            return static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+        }
+
+        [[nodiscard]] static bool isCapturing() { return s_capturing.load(std::memory_order_relaxed); }
+
+        // Ligar descarta o que havia sido capturado antes
+        static void setCapture(bool enabled, size_t maxEvents = kDefaultMaxCapturedEvents);
+
+        // Nome da thread atual no trace (ex.: "Main", "Job worker 3")
+        static void setThreadName(const std::string& name);
+
+        // Grava uma zona [start, end] da thread atual; name precisa ser um literal
+        static void zone(const char* name, uint64_t start, uint64_t end);
+        static void counter(const char* name, double value);
+
+        // Fim de um frame: marca o trace e drena os rings de todas as threads
+        static void frameMark(const char* name = "frame");
+
+        // Drena os rings sem marcar frame (ex.: antes de exportar)
+        static void collect();
+
+        // Drena e grava o que foi capturado; com a captura ligada ela continua
+        static void writeChromeTrace(const std::string& path);
+
+        [[nodiscard]] static size_t getEventCount();
+        // Eventos perdidos por ring cheio ou por exceder o limite da captura
+        [[nodiscard]] static uint64_t getDroppedEvents();
+
+        // Zona RAII: mede do construtor ao destrutor
+        class Zone {
+        public:
+            explicit Zone(const char* name)
+                : m_name(isCapturing() ? name : nullptr), m_start(m_name ? now() : 0) {}
+            ~Zone() {
+                if (m_name) {
+                    zone(m_name, m_start, now());
+                }
+            }
+
+            Zone(const Zone&) = delete;
+            Zone& operator=(const Zone&) = delete;
+
+        private:
+            const char* m_name;
+            uint64_t m_start;
+        };
+
+    private:
+        static std::atomic<bool> s_capturing;
+    };
+
+} // namespace vke
+
+#define VKE_PROFILE_CONCAT_INNER(a, b) a##b
+#define VKE_PROFILE_CONCAT(a, b) VKE_PROFILE_CONCAT_INNER(a, b)
+
+#if VKE_PROFILING
+#define VKE_PROFILE_ZONE(name) ::vke::CpuProfiler::Zone VKE_PROFILE_CONCAT(vkeProfileZone, __LINE__)(name)
+#define VKE_PROFILE_COUNTER(name, value)                                                      \
+    do {                                                                                      \
+        if (::vke::CpuProfiler::isCapturing()) {                                              \
+            ::vke::CpuProfiler::counter(name, static_cast<double>(value));                    \
+        }                                                                                     \
+    } while (0)
+#define VKE_PROFILE_FRAME() ::vke::CpuProfiler::frameMark()
+#define VKE_PROFILE_THREAD(name) ::vke::CpuProfiler::setThreadName(name)
+#else
+#define VKE_PROFILE_ZONE(name) ((void)0)
+#define VKE_PROFILE_COUNTER(name, value) ((void)0)
+#define VKE_PROFILE_FRAME() ((void)0)
+#define VKE_PROFILE_THREAD(name) ((void)0)
+#endif
+
+#endif // VKE_PROFILER_H
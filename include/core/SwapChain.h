@@ -25,11 +25,17 @@ public:
     // Destrutor para liberar os recursos (swapchain e image views)
     ~SwapChain();
 
+    // Recria a swapchain no lugar (ex.: após resize), passando a antiga como
+    // oldSwapchain para o driver reaproveitar recursos. O device não é tocado;
+    // quem chama garante que nenhuma imagem antiga ainda está em uso.
+    void recreate(uint32_t width, uint32_t height);
+
     // Acesso aos recursos criados
     [[nodiscard]] VkSwapchainKHR getSwapChain() const { return m_swapChain; }
     [[nodiscard]] VkFormat getImageFormat() const { return m_imageFormat; }
     [[nodiscard]] VkExtent2D getExtent() const { return m_extent; }
     [[nodiscard]] const std::vector<VkImageView>& getImageViews() const { return m_imageViews; }
+    [[nodiscard]] const std::vector<VkImage>& getImages() const { return m_images; }
 
 private:
     // --- Métodos auxiliares estáticos ---
@@ -41,8 +47,9 @@ private:
                                        uint32_t height);
 
     // --- Criação e configuração da swapchain ---
-    void createSwapChain();
-    [[nodiscard]] VkSwapchainKHR createSwapChainInternal() const;
+    void createSwapChain(VkSwapchainKHR oldSwapChain = VK_NULL_HANDLE);
+    [[nodiscard]] VkSwapchainKHR createSwapChainInternal(VkSwapchainKHR oldSwapChain);
+    void destroyImageViews();
     std::vector<VkImage> getSwapChainImages(VkSwapchainKHR swapChain) const;
     VkImageView createImageView(VkImage image, VkFormat format) const;
 
@@ -0,0 +1,57 @@
+#ifndef VKE_BOUNDS_H
+#define VKE_BOUNDS_H
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include "gfx/Vertex.h"
+
+namespace vke {
+
+    // Esfera envolvente em espaço de objeto, usada pelo culling
+    struct BoundingSphere {
+        float center[3] = { 0.0f, 0.0f, 0.0f };
+        float radius = 0.0f;
+    };
+
+    // Centro da AABB e a maior distância até ele: não é a esfera mínima, mas é barata e justa o bastante
+    BoundingSphere computeBounds(const std::vector<Vertex>& vertices);
+    BoundingSphere computeBounds(const Vertex* vertices, size_t count);
+
+    // Seis planos (nx, ny, nz, d) normalizados com a normal para dentro: um ponto
+    // p está dentro quando dot(n, p) + d >= 0 para todos eles
+    struct Frustum {
+        float planes[6][4]{};
+
+        // Extrai os planos das linhas de uma view-projection column-major com
+        // profundidade 0..1 (convenção do Vulkan)
+        static Frustum fromViewProjection(const std::array<float, 16>& viewProjection);
+    };
+
+    // Esferas em structure-of-arrays: cada componente em um array contíguo, para
+    // que os kernels de culling carreguem 4-8 objetos por instrução
+    class BoundsSoA {
+    public:
+        uint32_t add(const BoundingSphere& sphere);
+        void set(uint32_t index, const BoundingSphere& sphere);
+        [[nodiscard]] BoundingSphere get(uint32_t index) const;
+        void reserve(size_t count);
+        void clear();
+
+        [[nodiscard]] uint32_t size() const { return static_cast<uint32_t>(m_radius.size()); }
+        [[nodiscard]] const float* centersX() const { return m_centerX.data(); }
+        [[nodiscard]] const float* centersY() const { return m_centerY.data(); }
+        [[nodiscard]] const float* centersZ() const { return m_centerZ.data(); }
+        [[nodiscard]] const float* radii() const { return m_radius.data(); }
+
+    private:
+        std::vector<float> m_centerX;
+        std::vector<float> m_centerY;
+        std::vector<float> m_centerZ;
+        std::vector<float> m_radius;
+    };
+
+} // namespace vke
+
+#endif // VKE_BOUNDS_H
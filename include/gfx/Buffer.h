@@ -3,36 +3,43 @@
 
 #include <vulkan/vulkan.h>
 
+#include "core/MemoryAllocator.h"
+
 namespace vke {
 
+    class Device;
+
     class Buffer {
     public:
-        Buffer(VkDevice device, VkPhysicalDevice physicalDevice);
+        explicit Buffer(Device& device);
         ~Buffer();
 
         // Proíbe cópia
         Buffer(const Buffer&) = delete;
         Buffer& operator=(const Buffer&) = delete;
 
-        // Cria buffer com alocação de memória
-        void create(VkDeviceSize size, VkBufferUsageFlags usage, VkMemoryPropertyFlags properties);
+        // Cria buffer sub-alocado a partir do MemoryAllocator do device
+        void create(VkDeviceSize size, VkBufferUsageFlags usage, VkMemoryPropertyFlags properties,
+                    AllocationStrategy strategy = AllocationStrategy::Buddy);
         void destroy();
 
         // Copia dados do host (CPU) para o buffer (caso memória visível)
-        void uploadData(const void* srcData, VkDeviceSize size);
+        void uploadData(const void* srcData, VkDeviceSize size, VkDeviceSize dstOffset = 0);
+        // Para quem escreve direto em getMappedData(): torna a faixa visível à GPU (no-op se coerente)
+        void flush(VkDeviceSize offset, VkDeviceSize size) const;
 
         [[nodiscard]] VkBuffer getBuffer() const { return m_buffer; }
-        [[nodiscard]] VkDeviceMemory getMemory() const { return m_memory; }
-
-    private:
-        uint32_t findMemoryType(uint32_t typeFilter, VkMemoryPropertyFlags properties);
+        [[nodiscard]] VkDeviceMemory getMemory() const { return m_allocation.memory; }
+        [[nodiscard]] VkDeviceSize getMemoryOffset() const { return m_allocation.offset; }
+        [[nodiscard]] VkDeviceSize getSize() const { return m_size; }
+        [[nodiscard]] void* getMappedData() const { return m_allocation.mapped; }
 
     private:
-        VkDevice m_device;
-        VkPhysicalDevice m_physicalDevice;
+        Device& m_device;
 
         VkBuffer m_buffer = VK_NULL_HANDLE;
-        VkDeviceMemory m_memory = VK_NULL_HANDLE;
+        VkDeviceSize m_size = 0;
+        MemoryAllocation m_allocation{};
     };
 
 } // namespace vke
@@ -0,0 +1,46 @@
+#ifndef VKE_COMPUTEPIPELINE_H
+#define VKE_COMPUTEPIPELINE_H
+
+#include <vulkan/vulkan.h>
+
+namespace vke {
+
+// Classe que encapsula a criação de um pipeline de compute. Assim como em
+// GraphicsPipeline, o módulo de shader e o layout pertencem a quem chama.
+class ComputePipeline {
+public:
+    /**
+     * Construtor
+     * @param device: o dispositivo lógico Vulkan
+     * @param shader: módulo SPIR-V com o ponto de entrada "main"
+     * @param layout: descriptor set layouts + push constants usados pelo shader
+     * @param pipelineCache: cache usado para evitar recompilar o shader (opcional)
+     */
+    ComputePipeline(VkDevice device, VkShaderModule shader, VkPipelineLayout layout,
+                    VkPipelineCache pipelineCache = VK_NULL_HANDLE);
+
+    ~ComputePipeline();
+
+    // Proíbe cópia
+    ComputePipeline(const ComputePipeline&) = delete;
+    ComputePipeline& operator=(const ComputePipeline&) = delete;
+
+    /// Vincula o pipeline no bind point de compute
+    void bind(VkCommandBuffer commandBuffer) const;
+
+    [[nodiscard]] VkPipeline getPipeline() const { return m_pipeline; }
+    [[nodiscard]] VkPipelineLayout getPipelineLayout() const { return m_pipelineLayout; }
+
+    /// Tempo gasto em vkCreateComputePipelines, em milissegundos
+    [[nodiscard]] double getCreationMs() const { return m_creationMs; }
+
+private:
+    VkDevice m_device;
+    VkPipelineLayout m_pipelineLayout;
+    VkPipeline m_pipeline = VK_NULL_HANDLE;
+    double m_creationMs = 0.0;
+};
+
+} // namespace vke
+
+#endif // VKE_COMPUTEPIPELINE_H
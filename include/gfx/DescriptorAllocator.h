@@ -0,0 +1,61 @@
+#ifndef VKE_DESCRIPTORALLOCATOR_H
+#define VKE_DESCRIPTORALLOCATOR_H
+
+#include <vulkan/vulkan.h>
+#include <cstdint>
+#include <vector>
+
+namespace vke {
+
+    class Device;
+
+    // Sets de vida curta, válidos só no frame em que foram alocados. Cada slot
+    // do ring de frames em voo tem sua lista de pools; quando o pool atual
+    // esgota, o próximo é usado (e criado, se preciso). Nada é liberado set a
+    // set: beginFrame() reseta os pools do slot de uma vez e os mantém para os
+    // frames seguintes, então depois do aquecimento não há criação de pools.
+    class FrameDescriptorAllocator {
+    public:
+        /**
+         * @param poolSizes: descritores de cada tipo em um pool
+         * @param setsPerPool: maxSets de cada pool
+         */
+        FrameDescriptorAllocator(Device& device, uint32_t framesInFlight,
+                                 std::vector<VkDescriptorPoolSize> poolSizes, uint32_t setsPerPool);
+        ~FrameDescriptorAllocator();
+
+        // Proíbe cópia
+        FrameDescriptorAllocator(const FrameDescriptorAllocator&) = delete;
+        FrameDescriptorAllocator& operator=(const FrameDescriptorAllocator&) = delete;
+
+        // Reseta os pools do slot; só depois de esperar a fence do frame que os usou
+        void beginFrame(uint32_t frameSlot);
+
+        // Lança std::runtime_error se o layout não couber nem em um pool vazio
+        VkDescriptorSet allocate(VkDescriptorSetLayout layout);
+
+        // Pools criados em todos os slots e sets alocados no frame atual
+        [[nodiscard]] uint32_t getPoolCount() const;
+        [[nodiscard]] uint32_t getAllocatedThisFrame() const { return m_allocatedThisFrame; }
+
+    private:
+        VkDescriptorPool createPool();
+
+    private:
+        struct FramePools {
+            std::vector<VkDescriptorPool> pools;
+            uint32_t current = 0; // pools antes de current já esgotaram neste frame
+        };
+
+        Device& m_device;
+        std::vector<VkDescriptorPoolSize> m_poolSizes;
+        uint32_t m_setsPerPool = 0;
+
+        std::vector<FramePools> m_frames;
+        uint32_t m_frameSlot = 0;
+        uint32_t m_allocatedThisFrame = 0;
+    };
+
+} // namespace vke
+
+#endif // VKE_DESCRIPTORALLOCATOR_H
@@ -0,0 +1,77 @@
+#ifndef VKE_FRAMEARENA_H
+#define VKE_FRAMEARENA_H
+
+#include <vulkan/vulkan.h>
+#include <cstdint>
+#include <cstring>
+
+#include "gfx/Buffer.h"
+
+namespace vke {
+
+    class Device;
+
+    // Fatia do arena válida até o slot do frame ser reutilizado
+    struct FrameAllocation {
+        VkBuffer buffer = VK_NULL_HANDLE;
+        VkDeviceSize offset = 0; // a partir do início do buffer (serve como dynamic offset)
+        void* data = nullptr;    // já mapeado
+    };
+
+    // Ring de regiões, uma por frame em voo, num único buffer HOST_VISIBLE
+    // mapeado permanentemente. Dentro do frame a alocação é um bump pointer:
+    // sem vkMapMemory, sem alocação de memória e sem liberar nada. A região do
+    // slot só é reciclada em beginFrame(), depois que a fence dele sinalizou.
+    // Como é um buffer só, um descriptor UNIFORM_BUFFER_DYNAMIC serve para todos
+    // os frames: cada draw passa o offset como dynamic offset.
+    class FrameArena {
+    public:
+        static constexpr VkDeviceSize kDefaultCapacityPerFrame = 1u << 20;
+
+        FrameArena(Device& device, uint32_t framesInFlight, VkDeviceSize capacityPerFrame = kDefaultCapacityPerFrame);
+
+        // Proíbe cópia
+        FrameArena(const FrameArena&) = delete;
+        FrameArena& operator=(const FrameArena&) = delete;
+
+        // Reinicia a região do slot; só depois de esperar a fence do frame que a usou
+        void beginFrame(uint32_t frameSlot);
+        // Torna as escritas do frame visíveis à GPU (no-op em memória coerente); antes do submit
+        void flush() const;
+
+        // Lança std::runtime_error se a região do frame não comportar o pedido
+        FrameAllocation allocate(VkDeviceSize size, VkDeviceSize alignment);
+        // Alinhados a minUniformBufferOffsetAlignment / minStorageBufferOffsetAlignment
+        FrameAllocation allocateUniform(VkDeviceSize size) { return allocate(size, m_uniformAlignment); }
+        FrameAllocation allocateStorage(VkDeviceSize size) { return allocate(size, m_storageAlignment); }
+
+        // Copia um bloco de constantes e devolve o dynamic offset para vkCmdBindDescriptorSets
+        template <typename T>
+        uint32_t pushUniform(const T& value) {
+            FrameAllocation allocation = allocateUniform(sizeof(T));
+            std::memcpy(allocation.data, &value, sizeof(T));
+            return static_cast<uint32_t>(allocation.offset);
+        }
+
+        // Para o descriptor dinâmico: range é o tamanho lido por draw a partir do offset
+        [[nodiscard]] VkDescriptorBufferInfo getDescriptorInfo(VkDeviceSize range) const { return { m_buffer.getBuffer(), 0, range }; }
+        [[nodiscard]] VkBuffer getBuffer() const { return m_buffer.getBuffer(); }
+        [[nodiscard]] VkDeviceSize getCapacityPerFrame() const { return m_capacityPerFrame; }
+        // Bytes usados pelo frame atual e o pico desde a criação
+        [[nodiscard]] VkDeviceSize getUsed() const { return m_head - m_frameBegin; }
+        [[nodiscard]] VkDeviceSize getPeakUsed() const { return m_peakUsed; }
+
+    private:
+        Buffer m_buffer;
+        VkDeviceSize m_capacityPerFrame = 0;
+        VkDeviceSize m_uniformAlignment = 0;
+        VkDeviceSize m_storageAlignment = 0;
+
+        VkDeviceSize m_frameBegin = 0;
+        VkDeviceSize m_head = 0;
+        VkDeviceSize m_peakUsed = 0;
+    };
+
+} // namespace vke
+
+#endif // VKE_FRAMEARENA_H
@@ -0,0 +1,39 @@
+#ifndef VKE_FRUSTUMCULLING_H
+#define VKE_FRUSTUMCULLING_H
+
+#include <cstdint>
+
+#include "gfx/Bounds.h"
+
+namespace vke {
+
+    // Implementações do teste esfera x frustum; Scalar é a referência
+    enum class CullKernel {
+        Scalar,
+        SSE,  // 4 esferas por instrução (x86-64)
+        AVX2, // 8 esferas por instrução, quando a CPU suporta
+        NEON, // 4 esferas por instrução (AArch64)
+    };
+
+    [[nodiscard]] const char* cullKernelName(CullKernel kernel);
+    // Compilado para esta arquitetura e suportado pela CPU atual
+    [[nodiscard]] bool isCullKernelSupported(CullKernel kernel);
+    // Kernel mais largo suportado, detectado uma vez por processo
+    [[nodiscard]] CullKernel bestCullKernel();
+
+    /**
+     * Testa as esferas [first, end) contra os seis planos do frustum.
+     * @param outVisible: recebe, em ordem crescente, os índices das esferas que
+     *        tocam o frustum; precisa de espaço para end - first índices
+     * @return quantos índices foram escritos
+     * Kernels não suportados caem para o escalar. Faixas disjuntas podem ser
+     * processadas em paralelo (ex.: JobSystem::parallelFor).
+     */
+    uint32_t cullSpheres(const Frustum& frustum, const BoundsSoA& bounds, uint32_t first, uint32_t end,
+                         uint32_t* outVisible, CullKernel kernel);
+    // Todas as esferas, com o melhor kernel
+    uint32_t cullSpheres(const Frustum& frustum, const BoundsSoA& bounds, uint32_t* outVisible);
+
+} // namespace vke
+
+#endif // VKE_FRUSTUMCULLING_H
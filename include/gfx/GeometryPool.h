@@ -0,0 +1,75 @@
+#ifndef VKE_GEOMETRYPOOL_H
+#define VKE_GEOMETRYPOOL_H
+
+#include <vulkan/vulkan.h>
+#include <cstdint>
+#include <vector>
+
+#include "gfx/Bounds.h"
+#include "gfx/Buffer.h"
+#include "gfx/Vertex.h"
+
+namespace vke {
+
+    class Device;
+
+    // Posição de um mesh dentro dos buffers compartilhados; os campos de
+    // índice/vértice seguem VkDrawIndexedIndirectCommand
+    struct MeshRange {
+        uint32_t firstIndex = 0;
+        uint32_t indexCount = 0;
+        int32_t vertexOffset = 0;
+        uint32_t vertexCount = 0;
+        BoundingSphere bounds;
+    };
+
+    // Mega vertex/index buffer: a geometria de todos os meshes vive em um único
+    // par de buffers DEVICE_LOCAL, vinculado uma vez por command buffer, o que
+    // permite desenhar a cena inteira com um só draw indireto. A alocação é
+    // linear (append); reset() descarta tudo de uma vez.
+    class GeometryPool {
+    public:
+        static constexpr uint32_t kDefaultVertexCapacity = 1u << 18;
+        static constexpr uint32_t kDefaultIndexCapacity = 1u << 20;
+
+        explicit GeometryPool(Device& device,
+                              uint32_t vertexCapacity = kDefaultVertexCapacity,
+                              uint32_t indexCapacity = kDefaultIndexCapacity);
+
+        // Proíbe cópia
+        GeometryPool(const GeometryPool&) = delete;
+        GeometryPool& operator=(const GeometryPool&) = delete;
+
+        // Lista de triângulos sem índices: os vértices duplicados são soldados antes do upload
+        MeshRange add(const std::vector<Vertex>& vertices);
+        // Índices relativos ao primeiro vértice do mesh (vertexOffset é somado pelo draw)
+        MeshRange add(const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices);
+        // Mesma coisa a partir de ponteiros (ex.: de um MeshFile mapeado), com bounds já calculados
+        MeshRange add(const Vertex* vertices, uint32_t vertexCount, const uint32_t* indices, uint32_t indexCount,
+                      const BoundingSphere& bounds);
+
+        // Vincula o vertex buffer no binding 0 e o index buffer (UINT32)
+        void bind(VkCommandBuffer commandBuffer) const;
+
+        // Só é seguro quando nenhum frame em voo usa a geometria
+        void reset();
+
+        [[nodiscard]] uint32_t getVertexCount() const { return m_vertexCount; }
+        [[nodiscard]] uint32_t getIndexCount() const { return m_indexCount; }
+        // Índices sempre VK_INDEX_TYPE_UINT32
+        [[nodiscard]] VkBuffer getVertexBuffer() const { return m_vertexBuffer.getBuffer(); }
+        [[nodiscard]] VkBuffer getIndexBuffer() const { return m_indexBuffer.getBuffer(); }
+
+    private:
+        Device& m_device;
+        Buffer m_vertexBuffer;
+        Buffer m_indexBuffer;
+        uint32_t m_vertexCapacity;
+        uint32_t m_indexCapacity;
+        uint32_t m_vertexCount = 0;
+        uint32_t m_indexCount = 0;
+    };
+
+} // namespace vke
+
+#endif // VKE_GEOMETRYPOOL_H
@@ -0,0 +1,81 @@
+#ifndef VKE_GPUCULLER_H
+#define VKE_GPUCULLER_H
+
+#include <vulkan/vulkan.h>
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "core/MemoryAllocator.h"
+
+namespace vke {
+
+    class Buffer;
+    class ComputePipeline;
+    class Device;
+    class HiZPyramid;
+    class Model;
+
+    // Câmera usada no culling
+    struct CullView {
+        std::array<float, 16> viewProjection{}; // column-major, clip = M * mundo (convenção do Vulkan)
+        bool frustum = true;
+        const HiZPyramid* occlusion = nullptr;  // Hi-Z do frame anterior; nullptr desliga a oclusão
+    };
+
+    // Culling na GPU de um model empacotado: um shader de compute testa a esfera
+    // de cada comando indireto e escreve a lista de draws sobreviventes, que o
+    // draw lê direto da GPU sem voltar à CPU. Com VK_KHR_draw_indirect_count a
+    // lista sai compacta; sem a extensão, os descartados ficam com instanceCount 0.
+    class GpuCuller {
+    public:
+        GpuCuller(Device& device, uint32_t framesInFlight);
+        ~GpuCuller();
+
+        // Proíbe cópia
+        GpuCuller(const GpuCuller&) = delete;
+        GpuCuller& operator=(const GpuCuller&) = delete;
+
+        // Grava o culling fora da render pass; o slot não pode estar em voo
+        void record(VkCommandBuffer commandBuffer, uint32_t frameSlot, const Model& model, const CullView& view);
+        // Grava, dentro da render pass, os draws que sobreviveram ao último record() do slot
+        void draw(VkCommandBuffer commandBuffer, uint32_t frameSlot, const Model& model) const;
+
+        // Draws visíveis segundo a GPU; válido depois de esperar a fence do frame do slot
+        [[nodiscard]] uint32_t getVisibleCount(uint32_t frameSlot) const;
+
+    private:
+        struct SlotData {
+            std::unique_ptr<Buffer> params;
+            std::unique_ptr<Buffer> visible;
+            std::unique_ptr<Buffer> count;
+            std::unique_ptr<Buffer> countReadback;
+            VkDescriptorSet descriptorSet = VK_NULL_HANDLE;
+            bool compact = false;
+        };
+
+        void createDescriptors(uint32_t framesInFlight);
+        void createDummyHiZ();
+        void initializeDummyHiZ(VkCommandBuffer commandBuffer);
+
+    private:
+        Device& m_device;
+        std::vector<SlotData> m_slots;
+
+        VkDescriptorSetLayout m_setLayout = VK_NULL_HANDLE;
+        VkPipelineLayout m_pipelineLayout = VK_NULL_HANDLE;
+        VkDescriptorPool m_descriptorPool = VK_NULL_HANDLE;
+        std::unique_ptr<ComputePipeline> m_pipeline;
+
+        // Imagem 1x1 vinculada quando não há Hi-Z (o binding precisa ser válido)
+        VkImage m_dummyImage = VK_NULL_HANDLE;
+        MemoryAllocation m_dummyAllocation{};
+        VkImageView m_dummyView = VK_NULL_HANDLE;
+        VkSampler m_dummySampler = VK_NULL_HANDLE;
+        bool m_dummyInitialized = false;
+    };
+
+} // namespace vke
+
+#endif // VKE_GPUCULLER_H
@@ -0,0 +1,165 @@
+#ifndef VKE_GPUPROFILER_H
+#define VKE_GPUPROFILER_H
+
+#include <vulkan/vulkan.h>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace vke {
+
+    class Device;
+
+    // Contadores de uma query de estatísticas do pipeline
+    struct GpuPipelineStatistics {
+        uint64_t inputPrimitives = 0;      // primitivas montadas pelo input assembly
+        uint64_t vertexInvocations = 0;
+        uint64_t clippingPrimitives = 0;   // primitivas que saíram do clipping
+        uint64_t fragmentInvocations = 0;
+        uint64_t computeInvocations = 0;
+    };
+
+    // Resultado de um escopo em um frame já concluído pela GPU
+    struct GpuScopeTiming {
+        const char* name = nullptr;
+        uint32_t depth = 0;          // aninhamento (0 = escopo de fora)
+        double startMs = 0.0;        // relativo ao primeiro escopo do frame
+        double gpuMs = 0.0;
+        bool hasStatistics = false;
+        GpuPipelineStatistics statistics{};
+    };
+
+    // Profiler de GPU com query pools de timestamp (e, opcionalmente, de
+    // estatísticas do pipeline) por frame em voo. Os escopos são marcados no
+    // command buffer e lidos sem bloquear quando o slot volta a ser gravado,
+    // ou seja, N frames depois, com a fence do slot já esperada.
+    // Sem suporte a timestamps na fila gráfica todas as chamadas viram no-op.
+    class GpuProfiler {
+    public:
+        static constexpr uint32_t kDefaultMaxScopes = 64;
+        static constexpr uint32_t kInvalidScope = UINT32_MAX;
+
+        // statistics: também conta primitivas/invocações (exige a feature pipelineStatisticsQuery)
+        GpuProfiler(Device& device, uint32_t framesInFlight, uint32_t maxScopes = kDefaultMaxScopes,
+                    bool statistics = true);
+        ~GpuProfiler();
+
+        // Proíbe cópia
+        GpuProfiler(const GpuProfiler&) = delete;
+        GpuProfiler& operator=(const GpuProfiler&) = delete;
+
+        /**
+         * Lê os resultados do último frame gravado neste slot e reseta suas
+         * queries. Chamar logo após vkBeginCommandBuffer, fora de render pass,
+         * com a fence do slot já esperada.
+         */
+        void beginFrame(VkCommandBuffer commandBuffer, uint32_t frameSlot);
+
+        /**
+         * Abre um escopo no frame atual. name precisa viver tanto quanto o
+         * profiler (literais). Estatísticas só valem no escopo mais externo que
+         * as pedir, e não em escopos que executam secundários (exigiria inheritedQueries);
+         * o escopo não pode atravessar o início/fim de uma render pass.
+         * @return índice para endScope, ou kInvalidScope se desligado ou sem espaço
+         */
+        uint32_t beginScope(VkCommandBuffer commandBuffer, const char* name, bool statistics = true);
+        void endScope(VkCommandBuffer commandBuffer, uint32_t scope);
+
+        // Escopo RAII: fecha no destrutor
+        class Scope {
+        public:
+            Scope(GpuProfiler& profiler, VkCommandBuffer commandBuffer, const char* name, bool statistics = true)
+                : m_profiler(profiler), m_commandBuffer(commandBuffer),
+                  m_scope(profiler.beginScope(commandBuffer, name, statistics)) {}
+            ~Scope() { m_profiler.endScope(m_commandBuffer, m_scope); }
+
+            Scope(const Scope&) = delete;
+            Scope& operator=(const Scope&) = delete;
+
+        private:
+            GpuProfiler& m_profiler;
+            VkCommandBuffer m_commandBuffer;
+            uint32_t m_scope;
+        };
+
+        // Lê todos os slots pendentes; útil depois de vkDeviceWaitIdle (ex.: antes de exportar)
+        void flush();
+
+        // Escopos do frame lido mais recentemente, na ordem em que foram abertos
+        [[nodiscard]] const std::vector<GpuScopeTiming>& getLastResults() const { return m_lastResults; }
+        // Índice (contado por beginFrame) do frame de getLastResults
+        [[nodiscard]] uint64_t getLastResultsFrame() const { return m_lastResultsFrame; }
+        // Soma dos escopos com esse nome no último frame lido; 0 se não houver
+        [[nodiscard]] double getScopeMs(const char* name) const;
+
+        [[nodiscard]] bool isEnabled() const { return !m_slots.empty(); }
+        [[nodiscard]] bool hasStatistics() const { return m_statistics; }
+        // Escopos descartados por exceder maxScopes
+        [[nodiscard]] uint64_t getDroppedScopes() const { return m_droppedScopes; }
+
+        // Acumula os escopos lidos para exportar (ligar limpa o que havia)
+        void setTraceCapture(bool enabled);
+        [[nodiscard]] size_t getTraceEventCount() const { return m_trace.size(); }
+
+        // Grava os eventos capturados no formato JSON do Chrome trace (chrome://tracing, Perfetto)
+        void writeChromeTrace(const std::string& path) const;
+
+    private:
+        struct ScopeRecord {
+            const char* name;
+            uint32_t depth;
+            bool statistics;
+            bool closed;
+        };
+
+        struct SlotData {
+            VkQueryPool timestamps = VK_NULL_HANDLE;  // 2 por escopo: início e fim
+            VkQueryPool statistics = VK_NULL_HANDLE;  // 1 por escopo (usado só pelos que pedem)
+            std::vector<ScopeRecord> scopes;
+            uint64_t frame = 0;
+            bool pending = false;
+        };
+
+        struct TraceEvent {
+            const char* name;
+            uint64_t frame;
+            uint32_t depth;
+            uint64_t startTicks;
+            uint64_t durationTicks;
+            bool hasStatistics;
+            GpuPipelineStatistics statistics;
+        };
+
+        void collect(SlotData& slot);
+
+    private:
+        Device& m_device;
+        std::vector<SlotData> m_slots;
+        uint32_t m_maxScopes;
+        bool m_statistics = false;
+        uint64_t m_timestampMask = 0;
+        double m_msPerTick = 0.0;
+
+        // Frame em gravação
+        SlotData* m_current = nullptr;
+        uint32_t m_depth = 0;
+        bool m_statisticsActive = false;
+        uint64_t m_frameCounter = 0;
+        uint64_t m_droppedScopes = 0;
+
+        std::vector<GpuScopeTiming> m_lastResults;
+        std::vector<GpuScopeTiming> m_collected; // troca de lugar com m_lastResults a cada leitura
+        uint64_t m_lastResultsFrame = 0;
+        uint64_t m_lastCollectedFrame = 0;
+
+        // Reaproveitados entre leituras
+        std::vector<uint64_t> m_timestampData;
+        std::vector<uint64_t> m_statisticsData;
+
+        bool m_traceCapture = false;
+        std::vector<TraceEvent> m_trace;
+    };
+
+} // namespace vke
+
+#endif // VKE_GPUPROFILER_H
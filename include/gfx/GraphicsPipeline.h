@@ -2,44 +2,86 @@
 #define VKE_GRAPHICSPIPELINE_H
 
 #include <vulkan/vulkan.h>
-#include <string>
-#include <vector>
+#include <cstdint>
+
+#include "gfx/Vertex.h"
 
 namespace vke {
 
-// Classe que encapsula a criação e gerenciamento do pipeline gráfico
+// Modos de blending suportados pelos pipelines
+enum class BlendMode : uint8_t {
+    Opaque,
+    AlphaBlend,
+    Additive
+};
+
+// Descrição completa de um pipeline gráfico, já com os handles resolvidos.
+// Módulos de shader, layouts e render pass pertencem a quem chama. Sem render
+// pass, o pipeline é criado para dynamic rendering a partir dos formatos.
+struct GraphicsPipelineDesc {
+    VkShaderModule vertexShader = VK_NULL_HANDLE;
+    VkShaderModule fragmentShader = VK_NULL_HANDLE;
+    const VertexLayout* vertexLayout = nullptr;
+
+    VkPrimitiveTopology topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+    VkCullModeFlags cullMode = VK_CULL_MODE_BACK_BIT;
+    VkFrontFace frontFace = VK_FRONT_FACE_CLOCKWISE;
+    BlendMode blend = BlendMode::Opaque;
+
+    // Só aplicados quando a render pass tem attachment de profundidade
+    bool hasDepthAttachment = false;
+    bool depthTest = false;
+    bool depthWrite = false;
+    VkCompareOp depthCompare = VK_COMPARE_OP_LESS;
+    VkSampleCountFlagBits samples = VK_SAMPLE_COUNT_1_BIT;
+
+    VkPipelineLayout layout = VK_NULL_HANDLE;
+    VkRenderPass renderPass = VK_NULL_HANDLE;
+
+    // Attachments do dynamic rendering (usados só com renderPass == VK_NULL_HANDLE)
+    VkFormat colorFormat = VK_FORMAT_UNDEFINED;
+    VkFormat depthFormat = VK_FORMAT_UNDEFINED;
+};
+
+// Classe que encapsula a criação de um pipeline gráfico a partir de uma descrição.
+// Normalmente obtido via PipelineRegistry, que deduplica permutações.
 class GraphicsPipeline {
 public:
     /**
      * Construtor
      * @param device: o dispositivo lógico Vulkan
-     * @param renderPass: a render pass com a qual o pipeline se integrará
-     * @param swapChainExtent: a extensão (dimensões) da swapchain
+     * @param desc: shaders, estados e render pass (ou formatos) com os quais o pipeline se integrará
+     * @param pipelineCache: cache usado para evitar recompilar os shaders (opcional)
+     *
+     * Viewport e scissor são estados dinâmicos (vkCmdSetViewport/vkCmdSetScissor),
+     * então o pipeline sobrevive a recriações da swapchain.
      */
-    GraphicsPipeline(VkDevice device, VkRenderPass renderPass, VkExtent2D swapChainExtent);
+    GraphicsPipeline(VkDevice device, const GraphicsPipelineDesc& desc, VkPipelineCache pipelineCache = VK_NULL_HANDLE);
 
     ~GraphicsPipeline();
 
+    // Proíbe cópia
+    GraphicsPipeline(const GraphicsPipeline&) = delete;
+    GraphicsPipeline& operator=(const GraphicsPipeline&) = delete;
+
     /// Retorna o pipeline gráfico criado
     [[nodiscard]] VkPipeline getPipeline() const { return m_graphicsPipeline; }
 
-    /// Retorna o pipeline layout
+    /// Retorna o pipeline layout (não pertence a esta classe)
     [[nodiscard]] VkPipelineLayout getPipelineLayout() const { return m_pipelineLayout; }
 
-private:
-    /// Cria o pipeline gráfico (inclui criação dos módulos de shader, layout e pipeline propriamente dito)
-    void createPipeline(VkRenderPass renderPass, VkExtent2D swapChainExtent);
-
-    /// Cria um módulo de shader a partir do código SPIR-V
-    VkShaderModule createShaderModule(const std::vector<char>& code);
+    /// Tempo gasto em vkCreateGraphicsPipelines, em milissegundos (cold vs warm cache)
+    [[nodiscard]] double getCreationMs() const { return m_creationMs; }
 
-    /// Função utilitária para carregar um arquivo (por exemplo, o shader compilado) para um vetor de bytes
-    static std::vector<char> readFile(const std::string& filename);
+private:
+    /// Cria o pipeline gráfico a partir da descrição
+    void createPipeline(const GraphicsPipelineDesc& desc, VkPipelineCache pipelineCache);
 
 private:
     VkDevice m_device;
     VkPipelineLayout m_pipelineLayout = VK_NULL_HANDLE;
     VkPipeline m_graphicsPipeline = VK_NULL_HANDLE;
+    double m_creationMs = 0.0;
 };
 
 } // namespace vke
@@ -0,0 +1,79 @@
+#ifndef VKE_HIZPYRAMID_H
+#define VKE_HIZPYRAMID_H
+
+#include <vulkan/vulkan.h>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "core/MemoryAllocator.h"
+
+namespace vke {
+
+    class ComputePipeline;
+    class Device;
+
+    // Pirâmide hierárquica de profundidade (Hi-Z): cadeia de mips R32_SFLOAT em
+    // que cada texel guarda a profundidade máxima da região que cobre. Construída
+    // a partir do depth buffer do frame anterior, serve para o culling descartar
+    // objetos cuja esfera fica inteira atrás do que já foi desenhado.
+    // A imagem fica sempre em VK_IMAGE_LAYOUT_GENERAL.
+    class HiZPyramid {
+    public:
+        // Máximo de depth views distintas (ex.: uma por imagem da swapchain) entre resizes
+        static constexpr uint32_t kMaxDepthViews = 8;
+
+        HiZPyramid(Device& device, uint32_t width, uint32_t height);
+        ~HiZPyramid();
+
+        // Proíbe cópia
+        HiZPyramid(const HiZPyramid&) = delete;
+        HiZPyramid& operator=(const HiZPyramid&) = delete;
+
+        // Só é seguro quando nenhum frame em voo usa a pirâmide
+        void resize(uint32_t width, uint32_t height);
+
+        /**
+         * Grava a redução completa, fora de uma render pass.
+         * @param depthView: profundidade do tamanho da pirâmide, com escritas já
+         *        visíveis a shaders de compute e amostrável em depthLayout
+         * Ao final, os mips estão prontos para leitura em shaders de compute.
+         */
+        void build(VkCommandBuffer commandBuffer, VkImageView depthView, VkImageLayout depthLayout);
+
+        [[nodiscard]] VkImageView getView() const { return m_view; }
+        [[nodiscard]] VkSampler getSampler() const { return m_sampler; }
+        [[nodiscard]] VkExtent2D getExtent() const { return m_extent; }
+        [[nodiscard]] uint32_t getLevelCount() const { return static_cast<uint32_t>(m_mipViews.size()); }
+
+    private:
+        void createImage();
+        void destroyImage();
+        VkDescriptorSet allocateSet(VkImageView source, VkImageLayout sourceLayout, uint32_t dstLevel);
+        [[nodiscard]] VkExtent2D levelExtent(uint32_t level) const;
+
+    private:
+        Device& m_device;
+        VkExtent2D m_extent{};
+
+        VkImage m_image = VK_NULL_HANDLE;
+        MemoryAllocation m_allocation{};
+        VkImageView m_view = VK_NULL_HANDLE;   // todos os mips, para amostragem
+        std::vector<VkImageView> m_mipViews;   // um por mip, para escrita
+        bool m_initialized = false;            // já saiu de UNDEFINED
+
+        VkSampler m_sampler = VK_NULL_HANDLE;
+        VkDescriptorSetLayout m_setLayout = VK_NULL_HANDLE;
+        VkPipelineLayout m_pipelineLayout = VK_NULL_HANDLE;
+        std::unique_ptr<ComputePipeline> m_pipeline;
+
+        // Sets refeitos a cada resize: [mip - 1] lê o mip anterior; o mip 0 lê a depth view
+        VkDescriptorPool m_descriptorPool = VK_NULL_HANDLE;
+        std::vector<VkDescriptorSet> m_mipSets;
+        std::unordered_map<VkImageView, VkDescriptorSet> m_depthSets;
+    };
+
+} // namespace vke
+
+#endif // VKE_HIZPYRAMID_H
@@ -0,0 +1,38 @@
+#ifndef VKE_INDEXBUFFER_H
+#define VKE_INDEXBUFFER_H
+
+#include "Buffer.h"
+#include <cstdint>
+#include <vector>
+
+namespace vke {
+
+    class IndexBuffer {
+    public:
+        explicit IndexBuffer(Device& device);
+        ~IndexBuffer();
+
+        // Com VK_INDEX_TYPE_UINT16 os índices são estreitados antes do upload
+        void create(const std::vector<uint32_t>& indices, VkIndexType indexType);
+        // Índices de 32 bits enviados como estão, sem cópia intermediária (ex.: de um arquivo mapeado)
+        void create(const uint32_t* indices, size_t count);
+        void bind(VkCommandBuffer commandBuffer) const;
+        void destroy();
+
+        [[nodiscard]] size_t getIndexCount() const { return m_indexCount; }
+        [[nodiscard]] VkIndexType getIndexType() const { return m_indexType; }
+        [[nodiscard]] VkBuffer getBuffer() const { return m_buffer.getBuffer(); }
+
+    private:
+        void upload(const void* data, size_t count, VkIndexType indexType);
+
+    private:
+        Device& m_device;
+        Buffer m_buffer;
+        size_t m_indexCount = 0;
+        VkIndexType m_indexType = VK_INDEX_TYPE_UINT32;
+    };
+
+} // namespace vke
+
+#endif // VKE_INDEXBUFFER_H
@@ -1,6 +1,8 @@
 #ifndef VKE_MESH_H
 #define VKE_MESH_H
 
+#include "Bounds.h"
+#include "IndexBuffer.h"
 #include "VertexBuffer.h"
 #include <vector>
 
@@ -8,15 +10,31 @@ namespace vke {
 
     class Mesh {
     public:
-        Mesh(VkDevice device, VkPhysicalDevice physicalDevice);
+        explicit Mesh(Device& device);
         ~Mesh();
 
+        // Lista de triângulos sem índices: os vértices duplicados são soldados antes do upload
         void load(const std::vector<Vertex>& vertices);
-        void recordDrawCommands(VkCommandBuffer commandBuffer) const;
+        // Geometria indexada; usa índices de 16 bits quando a contagem de vértices permite
+        void load(const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices);
+        // Geometria já pronta (ex.: de um MeshFile mapeado): índices de 32 bits e bounds
+        // pré-calculados sobem direto, sem vetores intermediários
+        void load(const Vertex* vertices, size_t vertexCount, const uint32_t* indices, size_t indexCount,
+                  const BoundingSphere& bounds);
+        // Um único drawIndexed; instanceCount > 1 exige o binding 1 (InstanceData) já vinculado
+        void recordDrawCommands(VkCommandBuffer commandBuffer, uint32_t instanceCount = 1, uint32_t firstInstance = 0) const;
         void destroy();
 
+        [[nodiscard]] size_t getVertexCount() const { return m_vertexBuffer.getVertexCount(); }
+        [[nodiscard]] size_t getIndexCount() const { return m_indexBuffer.getIndexCount(); }
+        [[nodiscard]] const BoundingSphere& getBounds() const { return m_bounds; }
+        [[nodiscard]] const VertexBuffer& getVertexBuffer() const { return m_vertexBuffer; }
+        [[nodiscard]] const IndexBuffer& getIndexBuffer() const { return m_indexBuffer; }
+
     private:
         VertexBuffer m_vertexBuffer;
+        IndexBuffer m_indexBuffer;
+        BoundingSphere m_bounds;
     };
 
 } // namespace vke
@@ -1,26 +1,112 @@
 #ifndef VKE_MODEL_H
 #define VKE_MODEL_H
 
+#include "gfx/Buffer.h"
+#include "gfx/GeometryPool.h"
 #include "gfx/Mesh.h"
+#include "gfx/RenderQueue.h"
 #include <memory>
+#include <string>
 #include <vector>
 
 namespace vke {
 
+class MeshFile;
+
 class Model {
   public:
-    Model(VkDevice device, VkPhysicalDevice physicalDevice);
+    // Cada mesh com seus próprios buffers e um draw por mesh
+    explicit Model(Device& device);
+    // Meshes empacotados no pool compartilhado: a faixa de meshes sai em um
+    // único vkCmdDrawIndexedIndirect lendo os comandos do indirect buffer
+    Model(Device& device, GeometryPool& geometry);
     ~Model();
 
-    void addMesh(const std::vector<Vertex>& vertices);
+    // Retornam o índice do mesh, usado para atribuir instâncias
+    size_t addMesh(const std::vector<Vertex>& vertices);
+    size_t addMesh(const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices);
+    // Geometria já preparada (bounds calculados), copiada direto para o staging
+    size_t addMesh(const Vertex* vertices, uint32_t vertexCount, const uint32_t* indices, uint32_t indexCount,
+                   const BoundingSphere& bounds);
+    // Adiciona todos os meshes de um arquivo .vkm (ver util/MeshFile.h), mapeado e
+    // enviado direto ao staging em um único lote. Retorna o índice do primeiro mesh.
+    size_t loadFromFile(const std::string& path);
+    // Mesma coisa com um arquivo já aberto (ex.: para dimensionar o pool antes)
+    size_t loadFromFile(const MeshFile& file);
     void recordDrawCommands(VkCommandBuffer commandBuffer) const;
+    // Grava apenas os meshes [firstMesh, endMesh), para dividir o model entre threads
+    void recordDrawCommands(VkCommandBuffer commandBuffer, size_t firstMesh, size_t endMesh) const;
+    // Um item por mesh [firstMesh, endMesh) na fila, com draw direto (sem indireto).
+    // base traz pipeline/layout/material; a geometria e as instâncias vêm do model e
+    // o campo mesh da chave é key.mesh + índice do mesh. pushData vale para todos os itens.
+    void enqueueDraws(RenderQueue& queue, const DrawItem& base, SortKey key, size_t firstMesh, size_t endMesh,
+                      const void* pushData = nullptr, uint32_t pushSize = 0,
+                      VkShaderStageFlags pushStages = VK_SHADER_STAGE_VERTEX_BIT) const;
+    // A geometria no pool compartilhado só é liberada com GeometryPool::reset()
     void destroy();
 
+    // Instâncias por mesh: todas as cópias de um mesh saem em um único draw instanciado
+    void setInstances(size_t meshIndex, const std::vector<InstanceData>& instances);
+    void addInstance(size_t meshIndex, const InstanceData& instance);
+    void clearInstances();
+
+    // Envia instâncias e, no modo empacotado, os comandos indiretos. Precisa ser
+    // chamado depois de adicionar meshes ou instâncias; reescreve buffers que
+    // frames em voo ainda podem ler, então o chamador garante que nenhum os usa.
+    void uploadDrawData();
+
+    // Instanciado: o pipeline precisa de Vertex::getInstancedVertexLayout() e
+    // meshes sem instâncias não desenham nada; senão cada mesh desenha uma vez
+    [[nodiscard]] bool isInstanced() const { return m_instanceBuffer.getBuffer() != VK_NULL_HANDLE; }
+    [[nodiscard]] bool isPacked() const { return m_geometry != nullptr; }
+    [[nodiscard]] size_t getMeshCount() const { return m_instances.size(); }
+    // Chamadas vkCmdDraw* gravadas para a faixa (1 com multi-draw indireto)
+    [[nodiscard]] uint32_t getDrawCallCount(size_t firstMesh, size_t endMesh) const;
+    [[nodiscard]] uint32_t getInstanceCount() const { return m_uploadedInstanceCount; }
+    // Um VkDrawIndexedIndirectCommand por mesh, na ordem dos meshes (modo empacotado)
+    [[nodiscard]] const Buffer& getIndirectBuffer() const { return m_indirectBuffer; }
+    // Uma esfera (vec4: centro xyz, raio w) por comando, cobrindo todas as instâncias do mesh
+    [[nodiscard]] const Buffer& getBoundsBuffer() const { return m_boundsBuffer; }
+
+    // Esfera do mesh cobrindo todas as suas instâncias, nos dois modos
+    [[nodiscard]] BoundingSphere getBounds(size_t meshIndex) const;
+    // Substitui o conteúdo de outBounds por uma esfera por mesh, para o culling na CPU
+    void gatherBounds(BoundsSoA& outBounds) const;
+
+    // Desenha comandos gerados na GPU (ex.: pelo culling) no formato de getIndirectBuffer().
+    // Com countBuffer a lista é compacta e o total vem do buffer (exige
+    // canDrawIndirectCount()); sem ele há um comando por mesh, na ordem original.
+    void recordIndirectDraws(VkCommandBuffer commandBuffer, VkBuffer commands, VkBuffer countBuffer) const;
+    // Lista compacta perde a posição do mesh, então instâncias exigem firstInstance no comando
+    [[nodiscard]] bool canDrawIndirectCount() const;
+
   private:
-    VkDevice m_device;
-    VkPhysicalDevice m_physicalDevice;
+    struct InstanceRange {
+      uint32_t first = 0;
+      uint32_t count = 0;
+    };
+
+    // Sem drawIndirectFirstInstance ou multiDrawIndirect, cada comando vira um draw próprio
+    [[nodiscard]] bool canMultiDraw() const;
+    void recordPackedDraws(VkCommandBuffer commandBuffer, VkBuffer commands, size_t firstMesh, size_t endMesh) const;
+    void uploadIndirectCommands();
+
+    Device& m_device;
 
+    // Modo por mesh
     std::vector<std::unique_ptr<Mesh>> m_meshes;
+
+    // Modo empacotado
+    GeometryPool* m_geometry = nullptr;
+    std::vector<MeshRange> m_ranges;
+    Buffer m_indirectBuffer;
+    Buffer m_boundsBuffer;
+
+    // Cópia na CPU por mesh e faixas no buffer enviado à GPU
+    std::vector<std::vector<InstanceData>> m_instances;
+    std::vector<InstanceRange> m_instanceRanges;
+    Buffer m_instanceBuffer;
+    uint32_t m_uploadedInstanceCount = 0;
   };
 
   } // namespace vke
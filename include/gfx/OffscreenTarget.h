@@ -0,0 +1,56 @@
+#ifndef VKE_OFFSCREENTARGET_H
+#define VKE_OFFSCREENTARGET_H
+
+#include <vulkan/vulkan.h>
+#include <vector>
+
+#include "core/MemoryAllocator.h"
+
+namespace vke {
+
+    class Device;
+
+    // Substituto da swapchain no modo headless: N imagens de cor DEVICE_LOCAL
+    // (uma por frame em voo) que podem ser copiadas de volta para o host.
+    // Expõe a mesma interface de consulta da SwapChain para o Renderer.
+    class OffscreenTarget {
+    public:
+        static constexpr VkFormat kDefaultFormat = VK_FORMAT_R8G8B8A8_UNORM;
+
+        OffscreenTarget(Device& device, uint32_t width, uint32_t height, uint32_t imageCount,
+                        VkFormat format = kDefaultFormat);
+        ~OffscreenTarget();
+
+        // Proíbe cópia
+        OffscreenTarget(const OffscreenTarget&) = delete;
+        OffscreenTarget& operator=(const OffscreenTarget&) = delete;
+
+        // Recria as imagens com a nova extensão; quem chama garante que nenhuma está em uso
+        void resize(uint32_t width, uint32_t height);
+
+        [[nodiscard]] VkFormat getImageFormat() const { return m_format; }
+        [[nodiscard]] VkExtent2D getExtent() const { return m_extent; }
+        [[nodiscard]] const std::vector<VkImageView>& getImageViews() const { return m_imageViews; }
+        [[nodiscard]] const std::vector<VkImage>& getImages() const { return m_images; }
+
+        // Tamanho em bytes de uma imagem lida de volta (pixels compactos, sem padding)
+        [[nodiscard]] VkDeviceSize getReadbackSize() const;
+
+    private:
+        void createImages();
+        void destroyImages();
+
+    private:
+        Device& m_device;
+        VkFormat m_format;
+        VkExtent2D m_extent;
+        uint32_t m_imageCount;
+
+        std::vector<VkImage> m_images;
+        std::vector<VkImageView> m_imageViews;
+        std::vector<MemoryAllocation> m_allocations;
+    };
+
+} // namespace vke
+
+#endif // VKE_OFFSCREENTARGET_H
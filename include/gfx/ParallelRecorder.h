@@ -0,0 +1,69 @@
+#ifndef VKE_PARALLELRECORDER_H
+#define VKE_PARALLELRECORDER_H
+
+#include <vulkan/vulkan.h>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace vke {
+
+    class Device;
+    class JobSystem;
+
+    // Grava uma lista de draws em command buffers secundários, dividida em faixas
+    // executadas como jobs do JobSystem. Cada worker tem um command pool próprio
+    // por frame em voo, então nenhuma sincronização é necessária durante a
+    // gravação; o primário só executa os secundários em ordem com vkCmdExecuteCommands.
+    class ParallelRecorder {
+    public:
+        // Abaixo disso por faixa, o custo de despachar o job supera o ganho
+        static constexpr uint32_t kMinDrawsPerThread = 256;
+
+        // Grava os draws [begin, end) no secundário já iniciado
+        using RecordFn = std::function<void(VkCommandBuffer commandBuffer, uint32_t begin, uint32_t end)>;
+
+        ParallelRecorder(Device& device, JobSystem& jobs, uint32_t queueFamilyIndex, uint32_t framesInFlight);
+        ~ParallelRecorder();
+
+        // Proíbe cópia
+        ParallelRecorder(const ParallelRecorder&) = delete;
+        ParallelRecorder& operator=(const ParallelRecorder&) = delete;
+
+        /**
+         * Reseta os pools do slot e grava [0, drawCount) em paralelo.
+         * A fence do slot precisa já ter sido esperada.
+         * @param inheritance: render pass/subpass/framebuffer onde os secundários executam
+         *        (ou, em pNext, os formatos do dynamic rendering)
+         * @return secundários na ordem dos draws, prontos para vkCmdExecuteCommands
+         */
+        const std::vector<VkCommandBuffer>& record(uint32_t frameSlot,
+                                                   const VkCommandBufferInheritanceInfo& inheritance,
+                                                   uint32_t drawCount,
+                                                   const RecordFn& recordFn);
+
+        [[nodiscard]] uint32_t getThreadCount() const { return static_cast<uint32_t>(m_workerFrames.size()); }
+
+    private:
+        // Um worker pode executar mais de uma faixa por frame; os secundários
+        // alocados crescem sob demanda e são reaproveitados nos frames seguintes
+        struct WorkerFrame {
+            VkCommandPool commandPool = VK_NULL_HANDLE;
+            std::vector<VkCommandBuffer> commandBuffers;
+            uint32_t used = 0;
+        };
+
+        VkCommandBuffer acquireCommandBuffer(WorkerFrame& frame) const;
+
+    private:
+        Device& m_device;
+        JobSystem& m_jobs;
+
+        // [worker][frame slot]
+        std::vector<std::vector<WorkerFrame>> m_workerFrames;
+        std::vector<VkCommandBuffer> m_executed;
+    };
+
+} // namespace vke
+
+#endif // VKE_PARALLELRECORDER_H
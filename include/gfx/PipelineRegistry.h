@@ -0,0 +1,210 @@
+#ifndef VKE_PIPELINEREGISTRY_H
+#define VKE_PIPELINEREGISTRY_H
+
+#include <vulkan/vulkan.h>
+#include <cstdint>
+#include <atomic>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#include "gfx/GraphicsPipeline.h"
+
+namespace vke {
+
+    class Device;
+
+    // Identificadores compactos devolvidos pelo registro
+    using ShaderId = uint32_t;
+    using VertexLayoutId = uint16_t;
+    using PipelineLayoutId = uint16_t;
+
+    // Chave compacta (32 bytes, sem padding) que descreve uma permutação de pipeline.
+    // Duas chaves iguais byte a byte sempre produzem o mesmo VkPipeline.
+    struct PipelineKey {
+        ShaderId vertexShader = 0;
+        ShaderId fragmentShader = 0;
+        VertexLayoutId vertexLayout = 0;
+        PipelineLayoutId pipelineLayout = 0;
+
+        uint8_t blend = static_cast<uint8_t>(BlendMode::Opaque);
+        uint8_t cullMode = VK_CULL_MODE_BACK_BIT;
+        uint8_t frontFace = VK_FRONT_FACE_CLOCKWISE;
+        uint8_t topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+
+        uint8_t depthTest = 0;
+        uint8_t depthWrite = 0;
+        uint8_t depthCompare = VK_COMPARE_OP_LESS;
+        uint8_t samples = VK_SAMPLE_COUNT_1_BIT;
+
+        // Compatibilidade de render pass: pipelines servem a qualquer render pass
+        // com os mesmos formatos de attachment e número de amostras
+        uint32_t colorFormat = VK_FORMAT_UNDEFINED;
+        uint32_t depthFormat = VK_FORMAT_UNDEFINED;
+
+        // Preenchido pelo registro: 1 quando o pipeline é pedido sem render pass
+        // (dynamic rendering), que não serve a render passes e vice-versa
+        uint8_t dynamicRendering = 0;
+        uint8_t reserved[3] = {};
+
+        bool operator==(const PipelineKey& other) const {
+            return std::memcmp(this, &other, sizeof(PipelineKey)) == 0;
+        }
+    };
+
+    static_assert(sizeof(PipelineKey) == 32 && std::has_unique_object_representations_v<PipelineKey>,
+                  "PipelineKey must stay compact and padding-free to be hashed as raw bytes");
+
+    struct PipelineKeyHash {
+        size_t operator()(const PipelineKey& key) const;
+    };
+
+    // Estado compartilhado entre o registro (que compila) e os handles (que consultam)
+    struct PipelineRequest {
+        enum class Status : uint8_t { Pending, Ready, Failed };
+
+        std::atomic<Status> status{ Status::Pending };
+        VkPipeline pipeline = VK_NULL_HANDLE; // publicado antes de status = Ready
+
+        std::mutex mutex;
+        std::condition_variable done;
+    };
+
+    // Handle "tipo future" de um pipeline pedido ao registro. Consultar é barato
+    // (uma leitura atômica), então pode ser feito a cada draw.
+    class PipelineHandle {
+    public:
+        PipelineHandle() = default;
+        explicit PipelineHandle(std::shared_ptr<PipelineRequest> request) : m_request(std::move(request)) {}
+
+        [[nodiscard]] bool valid() const { return m_request != nullptr; }
+        [[nodiscard]] bool ready() const {
+            return m_request && m_request->status.load(std::memory_order_acquire) == PipelineRequest::Status::Ready;
+        }
+        [[nodiscard]] bool failed() const {
+            return m_request && m_request->status.load(std::memory_order_acquire) == PipelineRequest::Status::Failed;
+        }
+
+        // VK_NULL_HANDLE enquanto a compilação não terminou: o chamador pula o draw
+        [[nodiscard]] VkPipeline get() const { return ready() ? m_request->pipeline : VK_NULL_HANDLE; }
+
+        // Pipeline pronto ou, até lá, um pipeline substituto compatível
+        [[nodiscard]] VkPipeline getOr(VkPipeline fallback) const { return ready() ? m_request->pipeline : fallback; }
+
+        // Bloqueia até a compilação terminar (com sucesso ou não)
+        void wait() const;
+
+    private:
+        std::shared_ptr<PipelineRequest> m_request;
+    };
+
+    struct PipelineRegistryStats {
+        uint64_t hits = 0;
+        uint64_t misses = 0;       // cada miss é uma compilação no driver
+        uint32_t pipelineCount = 0;
+        uint32_t shaderCount = 0;
+        uint32_t pendingCount = 0; // pedidos na fila ou compilando
+        double compileMs = 0.0;    // soma de vkCreateGraphicsPipelines
+    };
+
+    // Registro de pipeline state objects do device. Materiais descrevem seus
+    // pipelines por PipelineKey; permutações idênticas compartilham o mesmo
+    // VkPipeline, criado sob demanda usando o VkPipelineCache do device.
+    // Compilações novas podem ir para uma thread de fundo (requestPipeline),
+    // evitando travar o frame quando conteúdo novo chega.
+    class PipelineRegistry {
+    public:
+        explicit PipelineRegistry(Device& device);
+        ~PipelineRegistry();
+
+        // Proíbe cópia
+        PipelineRegistry(const PipelineRegistry&) = delete;
+        PipelineRegistry& operator=(const PipelineRegistry&) = delete;
+
+        // Carrega um SPIR-V uma única vez; o mesmo caminho devolve o mesmo id
+        ShaderId registerShader(const std::string& path);
+
+        // Módulo de um shader registrado (ex.: para pipelines de compute, que não passam pelo registro)
+        [[nodiscard]] VkShaderModule getShaderModule(ShaderId id) const;
+
+        // Layouts com bindings/atributos idênticos devolvem o mesmo id
+        VertexLayoutId registerVertexLayout(const VertexLayout& layout);
+
+        // O registro não assume a posse do layout. O id 0 é o layout vazio padrão.
+        PipelineLayoutId registerPipelineLayout(VkPipelineLayout layout);
+
+        // Retorna imediatamente; se a chave é nova, a compilação é enfileirada na
+        // thread de fundo. renderPass só é usada na criação, deve ser compatível
+        // com a chave e continuar viva até o pedido terminar (ver waitIdle).
+        // VK_NULL_HANDLE pede um pipeline de dynamic rendering, criado só com os
+        // formatos da chave (exige Device::features().dynamicRendering).
+        PipelineHandle requestPipeline(const PipelineKey& key, VkRenderPass renderPass);
+
+        // Versão síncrona: compila na hora (ou espera um pedido já em andamento)
+        VkPipeline getPipeline(const PipelineKey& key, VkRenderPass renderPass);
+
+        // Espera todas as compilações pendentes
+        void waitIdle();
+
+        // Resolve os ids da chave em handles, sem criar nada (útil para compilar
+        // fora do registro, ex.: medindo caches diferentes)
+        [[nodiscard]] GraphicsPipelineDesc describe(const PipelineKey& key, VkRenderPass renderPass) const;
+
+        [[nodiscard]] VkPipelineLayout getPipelineLayout(PipelineLayoutId id) const;
+        [[nodiscard]] PipelineRegistryStats getStats() const;
+
+        // Destrói todos os pipelines (ex.: após recarregar shaders); ids continuam válidos
+        void clearPipelines();
+
+    private:
+        struct Entry {
+            std::shared_ptr<PipelineRequest> request;
+            std::unique_ptr<GraphicsPipeline> pipeline;
+        };
+
+        struct CompileJob {
+            PipelineKey key;
+            GraphicsPipelineDesc desc;
+        };
+
+        // Cria a entrada da chave se ainda não existir; true se foi criada (miss)
+        bool findOrInsert(const PipelineKey& key, std::shared_ptr<PipelineRequest>& outRequest);
+        void compile(const CompileJob& job);
+        void workerLoop();
+
+        static std::vector<char> readFile(const std::string& filename);
+        VkShaderModule createShaderModule(const std::vector<char>& code) const;
+        GraphicsPipelineDesc resolve(const PipelineKey& key, VkRenderPass renderPass) const;
+        PipelineKey targetKey(const PipelineKey& key, VkRenderPass renderPass) const;
+
+    private:
+        Device& m_device;
+
+        std::vector<std::string> m_shaderPaths;
+        std::vector<VkShaderModule> m_shaderModules;
+        std::deque<VertexLayout> m_vertexLayouts; // deque: descs guardam ponteiros para os layouts
+        std::vector<VkPipelineLayout> m_pipelineLayouts;
+        VkPipelineLayout m_emptyLayout = VK_NULL_HANDLE;
+
+        std::unordered_map<PipelineKey, Entry, PipelineKeyHash> m_pipelines;
+        PipelineRegistryStats m_stats{};
+        mutable std::mutex m_mutex;
+
+        // Fila de compilação em segundo plano (protegida por m_mutex)
+        std::deque<CompileJob> m_queue;
+        std::condition_variable m_queueCv;
+        std::condition_variable m_idleCv;
+        bool m_stopping = false;
+        std::thread m_worker;
+    };
+
+} // namespace vke
+
+#endif // VKE_PIPELINEREGISTRY_H
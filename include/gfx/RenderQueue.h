@@ -0,0 +1,130 @@
+#ifndef VKE_RENDERQUEUE_H
+#define VKE_RENDERQUEUE_H
+
+#include <vulkan/vulkan.h>
+#include <cstdint>
+#include <vector>
+
+namespace vke {
+
+    // Campos da chave de ordenação, do mais ao menos significativo:
+    // pass (4 bits) | pipeline (12) | material (16) | mesh (16) | profundidade (16).
+    // Valores maiores que o campo são truncados.
+    struct SortKey {
+        uint32_t pass = 0;
+        uint32_t pipeline = 0;
+        uint32_t material = 0;
+        uint32_t mesh = 0;
+        uint32_t depth = 0;
+
+        [[nodiscard]] uint64_t pack() const;
+
+        // Profundidade normalizada [0, 1] em 16 bits; backToFront inverte a ordem (transparentes)
+        static uint32_t quantizeDepth(float depth, bool backToFront = false);
+    };
+
+    // Um draw completo: estado, geometria e constantes. Buffers de vértices
+    // são ligados com offset 0; o deslocamento do mesh vai em vertexOffset/firstIndex.
+    struct DrawItem {
+        uint64_t key = 0;
+
+        VkPipeline pipeline = VK_NULL_HANDLE;
+        VkPipelineLayout layout = VK_NULL_HANDLE;     // push constants e set do material
+        VkDescriptorSet materialSet = VK_NULL_HANDLE; // opcional
+
+        VkBuffer vertexBuffer = VK_NULL_HANDLE;       // binding 0
+        VkBuffer instanceBuffer = VK_NULL_HANDLE;     // binding 1, opcional
+        VkBuffer indexBuffer = VK_NULL_HANDLE;        // nulo: vkCmdDraw
+        VkIndexType indexType = VK_INDEX_TYPE_UINT32;
+
+        uint32_t count = 0;                           // índices (ou vértices sem index buffer)
+        uint32_t instanceCount = 1;
+        uint32_t first = 0;                           // primeiro índice (ou vértice)
+        int32_t vertexOffset = 0;
+        uint32_t firstInstance = 0;
+
+        // Preenchidos pelo submit() a partir das constantes do draw
+        VkShaderStageFlags pushStages = 0;
+        uint32_t pushOffset = 0;
+        uint32_t pushSize = 0;
+    };
+
+    // Binds gravados e evitados (o estado pedido já estava ligado) em um record()
+    struct RenderQueueStats {
+        uint32_t draws = 0;
+        uint32_t pipelineBinds = 0;
+        uint32_t descriptorBinds = 0;
+        uint32_t vertexBinds = 0;
+        uint32_t indexBinds = 0;
+        uint32_t pipelineBindsSkipped = 0;
+        uint32_t descriptorBindsSkipped = 0;
+        uint32_t vertexBindsSkipped = 0;
+        uint32_t indexBindsSkipped = 0;
+
+        [[nodiscard]] uint32_t getBinds() const { return pipelineBinds + descriptorBinds + vertexBinds + indexBinds; }
+        [[nodiscard]] uint32_t getBindsSkipped() const {
+            return pipelineBindsSkipped + descriptorBindsSkipped + vertexBindsSkipped + indexBindsSkipped;
+        }
+        RenderQueueStats& operator+=(const RenderQueueStats& other);
+    };
+
+    // Fila de draws de um frame: os itens chegam em qualquer ordem, são
+    // ordenados por radix sort na chave de 64 bits e gravados pulando binds
+    // de pipeline, material, vertex e index buffers que não mudaram em
+    // relação ao draw anterior. Constantes por draw vão por push constants.
+    class RenderQueue {
+    public:
+        // Set 0 fica com as constantes do frame (como no Renderer)
+        static constexpr uint32_t kDefaultMaterialSet = 1;
+
+        explicit RenderQueue(uint32_t materialSetIndex = kDefaultMaterialSet);
+
+        // Proíbe cópia
+        RenderQueue(const RenderQueue&) = delete;
+        RenderQueue& operator=(const RenderQueue&) = delete;
+
+        void reserve(size_t items);
+        // Descarta os itens; a memória fica para o próximo frame
+        void clear();
+
+        // pushData (opcional) é copiado; o layout do item precisa cobrir stages/tamanho
+        void submit(const DrawItem& item, const void* pushData = nullptr, uint32_t pushSize = 0,
+                    VkShaderStageFlags pushStages = VK_SHADER_STAGE_VERTEX_BIT);
+        template <typename T>
+        void submit(const DrawItem& item, const T& pushData, VkShaderStageFlags pushStages = VK_SHADER_STAGE_VERTEX_BIT) {
+            submit(item, &pushData, sizeof(T), pushStages);
+        }
+
+        // Ordenação estável por chave (radix LSD de 8 bits; bytes iguais em
+        // todos os itens não custam uma passada)
+        void sort();
+
+        /**
+         * Grava os itens [first, end) na ordem atual, dentro de uma render pass
+         * com viewport/scissor já definidos. Cada chamada começa sem estado
+         * conhecido, então faixas diferentes podem ir para secundários
+         * diferentes em paralelo.
+         */
+        RenderQueueStats record(VkCommandBuffer commandBuffer, uint32_t first = 0, uint32_t end = UINT32_MAX) const;
+
+        [[nodiscard]] uint32_t size() const { return static_cast<uint32_t>(m_entries.size()); }
+        [[nodiscard]] bool empty() const { return m_entries.empty(); }
+        // Item na posição atual da ordem
+        [[nodiscard]] const DrawItem& at(uint32_t position) const { return m_items[m_entries[position].item]; }
+
+    private:
+        struct Entry {
+            uint64_t key;
+            uint32_t item;
+        };
+
+        uint32_t m_materialSet;
+        std::vector<DrawItem> m_items;
+        std::vector<Entry> m_entries;
+        std::vector<Entry> m_scratch;
+        std::vector<uint8_t> m_pushData;
+    };
+
+} // namespace vke
+
+#endif // VKE_RENDERQUEUE_H
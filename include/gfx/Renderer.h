@@ -1,51 +1,210 @@
 #ifndef RENDERER_H
 #define RENDERER_H
 
+#include <array>
+#include <cstdint>
 #include <memory>
+#include <string>
 #include <vulkan/vulkan.h>
 #include <vector>
 
 #include "core/SwapChain.h"
-#include "GraphicsPipeline.h"
+#include "gfx/PipelineRegistry.h"
+
+namespace vke {
+    class Buffer;
+    class Device;
+    class FrameArena;
+    class GeometryPool;
+    class GpuCuller;
+    class GpuProfiler;
+    class JobSystem;
+    class Model;
+    class OffscreenTarget;
+    class ParallelRecorder;
+    class ResourceTable;
+}
+
+// Tempos de CPU do último frame, em milissegundos
+struct FrameStats {
+    double fenceWaitMs = 0.0;  // tempo bloqueado esperando o slot do frame liberar
+    double cpuMs = 0.0;        // acquire + gravação + submit + present, sem a espera da fence
+    uint64_t frameIndex = 0;
+    uint64_t skippedDrawFrames = 0; // frames sem draw porque o pipeline ainda compilava
+    uint32_t drawCalls = 0;    // draws gravados (um por mesh, instanciado ou não)
+    uint32_t instances = 0;    // instâncias desenhadas por esses draws
+    uint32_t gpuVisibleDraws = 0; // draws que passaram no culling da GPU (frame anterior do slot)
+    double gpuFrameMs = 0.0;   // tempo de GPU do frame lido mais recentemente (N frames atrás); 0 sem timestamps
+
+    // Recriações da swapchain (resize, OUT_OF_DATE, SUBOPTIMAL)
+    uint32_t swapChainRecreations = 0;
+    double lastRecreateMs = 0.0;
+    double maxRecreateMs = 0.0;
+};
 
 class Renderer {
 public:
+    static constexpr uint32_t kDefaultFramesInFlight = 2;
+
+    // jobs: escalonador usado para gravar cenas grandes em paralelo
     Renderer(
-        VkDevice device,
-        VkPhysicalDevice physicalDevice,
-        const SwapChain& swapChain,
+        vke::Device& device,
+        vke::JobSystem& jobs,
+        SwapChain& swapChain,
         VkQueue graphicsQueue,
         VkQueue presentQueue,
-        uint32_t graphicsQueueFamilyIndex
+        uint32_t graphicsQueueFamilyIndex,
+        uint32_t framesInFlight = kDefaultFramesInFlight
+    );
+
+    // Modo headless: renderiza em imagens offscreen (uma por frame em voo),
+    // sem acquire/present. O target precisa ter ao menos framesInFlight imagens.
+    Renderer(
+        vke::Device& device,
+        vke::JobSystem& jobs,
+        vke::OffscreenTarget& target,
+        VkQueue graphicsQueue,
+        uint32_t graphicsQueueFamilyIndex,
+        uint32_t framesInFlight = kDefaultFramesInFlight
     );
 
     ~Renderer();
 
     void createRenderPass();
     void createFramebuffers();
-    void createCommandPool();
-    void createCommandBuffers();
+    void createFrameResources();
     void createSyncObjects();
-    void drawFrame() const;
+    void drawFrame();
+
+    // Pede recriação da swapchain no próximo drawFrame (várias chamadas seguidas são agrupadas)
+    void requestResize(uint32_t width, uint32_t height);
+
+    // Culling por compute antes da render pass (só com model empacotado)
+    void setGpuCullingEnabled(bool enabled) { m_gpuCullingEnabled = enabled; }
+    // Matriz usada no culling, column-major; identidade enquanto não há câmera
+    void setViewProjection(const std::array<float, 16>& viewProjection) { m_viewProjection = viewProjection; }
+
+    // Troca o model pelos meshes de um arquivo .vkm (uma instância de cada na origem) ou
+    // de um .gltf/.glb (só meshes da cena padrão, uma instância por nó com mesh, com offset
+    // e escala do nó em mundo). O pool de geometria é dimensionado pelo arquivo.
+    // Espera a GPU ficar ociosa; lança std::runtime_error se o arquivo for inválido.
+    void loadModel(const std::string& path);
+
+    // Headless: copia cada frame renderizado para um buffer HOST_VISIBLE do seu slot
+    void setReadbackEnabled(bool enabled);
+
+    // Espera o último frame submetido e copia seus pixels (RGBA8, linhas compactas).
+    // Retorna false se não houver frame lido de volta disponível.
+    bool readbackLastFrame(std::vector<uint8_t>& outPixels) const;
+
+    [[nodiscard]] bool isHeadless() const { return m_offscreen != nullptr; }
+    // Sem VkRenderPass/VkFramebuffer (VK_KHR_dynamic_rendering); caso contrário o caminho clássico
+    [[nodiscard]] bool usesDynamicRendering() const { return m_dynamicRendering; }
+    [[nodiscard]] VkExtent2D getExtent() const;
+    [[nodiscard]] uint32_t getFramesInFlight() const { return static_cast<uint32_t>(m_frames.size()); }
+    [[nodiscard]] const FrameStats& getFrameStats() const { return m_frameStats; }
+    // Buffers e texturas endereçados por índice; ciclo de frames conduzido pelo drawFrame
+    [[nodiscard]] vke::ResourceTable& getResourceTable() const { return *m_resources; }
+    // Escopos de GPU por passe ("frame", "cull", "main_pass"); no-op sem suporte a timestamps
+    [[nodiscard]] vke::GpuProfiler& getGpuProfiler() const { return *m_gpuProfiler; }
 
 private:
-    VkDevice m_device;
-    VkPhysicalDevice m_physicalDevice;
-    const SwapChain& m_swapChain;
+    // Recursos exclusivos de um slot do ring de frames em voo
+    struct FrameData {
+        VkCommandPool commandPool = VK_NULL_HANDLE;
+        VkCommandBuffer commandBuffer = VK_NULL_HANDLE;
+        VkSemaphore imageAvailable = VK_NULL_HANDLE;
+        VkFence inFlight = VK_NULL_HANDLE;
+        std::unique_ptr<vke::Buffer> readback; // só no modo headless com readback ligado
+        bool culled = false;                   // o último frame do slot passou pelo culling da GPU
+    };
+
+    void init();
+    // Cria pool e model do tamanho das primitivas alcançáveis pela cena padrão
+    void loadGltf(const std::string& path, std::unique_ptr<vke::GeometryPool>& geometry,
+                  std::unique_ptr<vke::Model>& model);
+    void createFrameUniforms();
+    [[nodiscard]] VkFormat targetFormat() const;
+    [[nodiscard]] const std::vector<VkImageView>& targetImageViews() const;
+    [[nodiscard]] VkImage targetImage(uint32_t imageIndex) const;
+    bool acquireImage(FrameData& frame, uint32_t& outImageIndex);
+    void recordReadback(VkCommandBuffer commandBuffer, const FrameData& frame, uint32_t imageIndex) const;
+    // Retorna false se o pipeline ainda compila e o frame saiu só com o clear
+    bool recordCommandBuffer(uint32_t frameSlot, uint32_t imageIndex);
+    void recordDraws(VkCommandBuffer commandBuffer, VkPipeline pipeline, uint32_t frameUniformOffset,
+                     uint32_t firstMesh, uint32_t endMesh) const;
+    // Abre/fecha a render pass ou, com dynamic rendering, as barreiras de layout e o vkCmdBeginRendering
+    void beginRendering(VkCommandBuffer commandBuffer, uint32_t imageIndex, bool secondaries) const;
+    void endRendering(VkCommandBuffer commandBuffer, uint32_t imageIndex) const;
+    void transitionImage(VkCommandBuffer commandBuffer, uint32_t imageIndex,
+                         VkImageLayout oldLayout, VkImageLayout newLayout,
+                         VkPipelineStageFlags2KHR srcStage, VkAccessFlags2KHR srcAccess,
+                         VkPipelineStageFlags2KHR dstStage, VkAccessFlags2KHR dstAccess) const;
+    void recreateSwapChain();
+    void destroyFramebuffers();
+
+private:
+    vke::Device& m_device;
+    vke::JobSystem& m_jobs;
+
+    // Exatamente um dos dois alvos é não-nulo
+    SwapChain* m_swapChain = nullptr;
+    vke::OffscreenTarget* m_offscreen = nullptr;
+
     VkQueue m_graphicsQueue;
     VkQueue m_presentQueue;
     uint32_t m_graphicsQueueFamilyIndex;
 
+    // Só no caminho clássico; com dynamic rendering ficam vazios
+    bool m_dynamicRendering = false;
     VkRenderPass m_renderPass = VK_NULL_HANDLE;
     std::vector<VkFramebuffer> m_framebuffers;
-    VkCommandPool m_commandPool = VK_NULL_HANDLE;
-    std::vector<VkCommandBuffer> m_commandBuffers;
 
-    VkSemaphore m_imageAvailableSemaphore = VK_NULL_HANDLE;
-    VkSemaphore m_renderFinishedSemaphore = VK_NULL_HANDLE;
-    VkFence m_inFlightFence = VK_NULL_HANDLE;
+    // Ring de N frames em voo
+    std::vector<FrameData> m_frames;
+    uint32_t m_currentFrame = 0;
+
+    // Por imagem da swapchain: semáforo de fim de render (consumido pelo present,
+    // que não tem fence própria) e a fence do último frame que usou a imagem
+    std::vector<VkSemaphore> m_renderFinishedSemaphores;
+    std::vector<VkFence> m_imagesInFlight;
+
+    FrameStats m_frameStats{};
+
+    bool m_readbackEnabled = false;
+    int32_t m_lastReadbackFrame = -1;
+
+    bool m_resizeRequested = false;
+    VkExtent2D m_requestedExtent{};
+
+    vke::PipelineKey m_pipelineKey{};
+    vke::PipelineHandle m_pipelineHandle; // o VkPipeline pertence ao PipelineRegistry do device
+    std::unique_ptr<vke::GeometryPool> m_geometry; // vertex/index compartilhados pelos meshes do model
+    std::unique_ptr<vke::Model> m_model;
+
+    // Culling na GPU: a lista de draws do model é gerada por compute a cada frame
+    std::unique_ptr<vke::GpuCuller> m_culler;
+    bool m_gpuCullingEnabled = true;
+    std::array<float, 16> m_viewProjection{ 1.0f, 0.0f, 0.0f, 0.0f,
+                                            0.0f, 1.0f, 0.0f, 0.0f,
+                                            0.0f, 0.0f, 1.0f, 0.0f,
+                                            0.0f, 0.0f, 0.0f, 1.0f };
+
+    // Constantes por frame: ring mapeado + um descriptor dinâmico compartilhado por todos os slots
+    std::unique_ptr<vke::FrameArena> m_frameArena;
+    VkDescriptorSetLayout m_frameSetLayout = VK_NULL_HANDLE;
+    VkPipelineLayout m_framePipelineLayout = VK_NULL_HANDLE;
+    VkDescriptorPool m_frameDescriptorPool = VK_NULL_HANDLE;
+    VkDescriptorSet m_frameDescriptorSet = VK_NULL_HANDLE;
+
+    // Tabela global de recursos (bindless quando o device suporta)
+    std::unique_ptr<vke::ResourceTable> m_resources;
+
+    // Timestamps e estatísticas por passe, lidos quando o slot volta a ser gravado
+    std::unique_ptr<vke::GpuProfiler> m_gpuProfiler;
 
-    std::unique_ptr<vke::GraphicsPipeline> m_graphicsPipeline;
+    // Secundários por worker do JobSystem para cenas com muitos draws
+    std::unique_ptr<vke::ParallelRecorder> m_recorder;
 };
 
 #endif // RENDERER_H
@@ -0,0 +1,130 @@
+#ifndef VKE_RESOURCETABLE_H
+#define VKE_RESOURCETABLE_H
+
+#include <vulkan/vulkan.h>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace vke {
+
+    class Device;
+    class FrameDescriptorAllocator;
+
+    // Tabela global de recursos: um único descriptor set com um array de
+    // storage buffers (binding 0) e um de texturas combinadas (binding 1).
+    // Cada recurso registrado ganha um índice estável; o set é ligado uma vez
+    // por command buffer e os draws só passam índices por push constant.
+    //
+    // Com VK_EXT_descriptor_indexing o set é update-after-bind e parcialmente
+    // preenchido: registrar escreve direto no set, mesmo com frames em voo.
+    // Sem a extensão, cada frame que liga a tabela recebe um retrato dela,
+    // alocado de pools por frame. Nesse modo os arrays são pequenos e as
+    // entradas vazias repetem o primeiro recurso vivo do mesmo tipo, então o
+    // shader não pode ler um array enquanto ele não tiver nenhum recurso.
+    //
+    // No GLSL (tamanho dos arrays em getBufferCapacity()/getTextureCapacity()):
+    //   layout(set = 0, binding = 0) readonly buffer Data { ... } buffers[];
+    //   layout(set = 0, binding = 1) uniform sampler2D textures[];
+    class ResourceTable {
+    public:
+        static constexpr uint32_t kInvalidIndex = UINT32_MAX;
+        static constexpr uint32_t kBufferBinding = 0;
+        static constexpr uint32_t kTextureBinding = 1;
+        // Limitados pelos limites do device
+        static constexpr uint32_t kMaxBuffers = 16384;
+        static constexpr uint32_t kMaxTextures = 16384;
+        static constexpr uint32_t kFallbackBuffers = 64;
+        static constexpr uint32_t kFallbackTextures = 64;
+        // Mínimo garantido de maxPushConstantsSize; visível em todos os estágios
+        static constexpr uint32_t kPushConstantSize = 128;
+
+        ResourceTable(Device& device, uint32_t framesInFlight);
+        ~ResourceTable();
+
+        // Proíbe cópia
+        ResourceTable(const ResourceTable&) = delete;
+        ResourceTable& operator=(const ResourceTable&) = delete;
+
+        // Recicla os índices liberados no último uso do slot; depois da fence dele
+        void beginFrame(uint32_t frameSlot);
+
+        // Lançam std::runtime_error quando o array correspondente está cheio
+        uint32_t registerBuffer(VkBuffer buffer, VkDeviceSize offset = 0, VkDeviceSize range = VK_WHOLE_SIZE);
+        uint32_t registerTexture(VkImageView view, VkSampler sampler,
+                                 VkImageLayout layout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+        // O índice só volta a ser usado quando os frames em voo que podem lê-lo terminarem
+        void releaseBuffer(uint32_t index);
+        void releaseTexture(uint32_t index);
+
+        // Liga a tabela no set 0 de getPipelineLayout(); uma vez por command buffer
+        void bind(VkCommandBuffer commandBuffer, VkPipelineBindPoint bindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS);
+
+        // Índices e constantes do draw; size + offset <= kPushConstantSize
+        void push(VkCommandBuffer commandBuffer, const void* data, uint32_t size, uint32_t offset = 0) const;
+        template <typename T>
+        void push(VkCommandBuffer commandBuffer, const T& value) const {
+            static_assert(sizeof(T) <= kPushConstantSize, "Push constants exceed the resource table range");
+            push(commandBuffer, &value, sizeof(T));
+        }
+
+        // Pipelines que leem a tabela precisam ser criados com este layout
+        [[nodiscard]] VkPipelineLayout getPipelineLayout() const { return m_pipelineLayout; }
+        [[nodiscard]] VkDescriptorSetLayout getSetLayout() const { return m_setLayout; }
+        [[nodiscard]] bool isBindless() const { return m_bindless; }
+        [[nodiscard]] uint32_t getBufferCapacity() const { return m_buffers.capacity; }
+        [[nodiscard]] uint32_t getTextureCapacity() const { return m_textures.capacity; }
+        [[nodiscard]] uint32_t getBufferCount() const { return m_buffers.live; }
+        [[nodiscard]] uint32_t getTextureCount() const { return m_textures.live; }
+
+    private:
+        // Índices de um array: novos vêm do topo ou da lista livre; liberados
+        // esperam na lista do slot em que saíram
+        struct IndexPool {
+            uint32_t capacity = 0;
+            uint32_t top = 0;
+            uint32_t live = 0;
+            std::vector<uint32_t> free;
+            std::vector<std::vector<uint32_t>> retired;
+
+            uint32_t acquire();
+            void retire(uint32_t index, uint32_t frameSlot);
+            void recycle(uint32_t frameSlot);
+        };
+
+        void computeCapacities();
+        void createLayouts();
+        void createBindlessSet();
+        void writeBuffer(VkDescriptorSet set, uint32_t index);
+        void writeTexture(VkDescriptorSet set, uint32_t index);
+        // Fallback: retrato completo da tabela num set do frame atual
+        VkDescriptorSet snapshot();
+
+    private:
+        Device& m_device;
+        bool m_bindless = false;
+
+        VkDescriptorSetLayout m_setLayout = VK_NULL_HANDLE;
+        VkPipelineLayout m_pipelineLayout = VK_NULL_HANDLE;
+
+        IndexPool m_buffers;
+        IndexPool m_textures;
+        // Entradas vazias têm handle nulo
+        std::vector<VkDescriptorBufferInfo> m_bufferInfos;
+        std::vector<VkDescriptorImageInfo> m_textureInfos;
+        uint32_t m_frameSlot = 0;
+
+        // Bindless: set único, alocado de um pool update-after-bind
+        VkDescriptorPool m_descriptorPool = VK_NULL_HANDLE;
+        VkDescriptorSet m_descriptorSet = VK_NULL_HANDLE;
+
+        // Fallback: o retrato do frame é refeito quando a tabela muda
+        std::unique_ptr<FrameDescriptorAllocator> m_frameSets;
+        VkDescriptorSet m_frameSet = VK_NULL_HANDLE;
+        uint64_t m_version = 0;
+        uint64_t m_frameSetVersion = 0;
+    };
+
+} // namespace vke
+
+#endif // VKE_RESOURCETABLE_H
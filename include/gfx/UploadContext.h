@@ -0,0 +1,80 @@
+#ifndef VKE_UPLOADCONTEXT_H
+#define VKE_UPLOADCONTEXT_H
+
+#include <vulkan/vulkan.h>
+#include <mutex>
+
+#include "gfx/Buffer.h"
+
+namespace vke {
+
+    class Device;
+
+    struct UploadStats {
+        VkDeviceSize bytesUploaded = 0;
+        uint32_t copyCount = 0;    // vkCmdCopyBuffer gravados
+        uint32_t submitCount = 0;  // submissões (e esperas de fence)
+    };
+
+    // Serviço de upload: copia dados do host para buffers DEVICE_LOCAL através de
+    // um staging buffer persistente. Uploads feitos entre beginBatch()/endBatch()
+    // vão para um único command buffer, com uma única espera de fence no final.
+    class UploadContext {
+    public:
+        static constexpr VkDeviceSize kDefaultStagingSize = 32ull * 1024 * 1024;
+
+        explicit UploadContext(Device& device, VkDeviceSize stagingSize = kDefaultStagingSize);
+        ~UploadContext();
+
+        // Proíbe cópia
+        UploadContext(const UploadContext&) = delete;
+        UploadContext& operator=(const UploadContext&) = delete;
+
+        // Lotes podem ser aninhados; só o endBatch() mais externo submete
+        void beginBatch();
+        void endBatch();
+
+        // O buffer de destino precisa ter VK_BUFFER_USAGE_TRANSFER_DST_BIT. Os dados
+        // são copiados para o staging na hora, então srcData pode ser descartado em seguida.
+        void uploadToBuffer(const Buffer& dst, const void* srcData, VkDeviceSize size, VkDeviceSize dstOffset = 0);
+
+        [[nodiscard]] UploadStats getStats() const;
+        void resetStats();
+
+    private:
+        void ensureRecording();
+        void flush();
+
+    private:
+        Device& m_device;
+        VkQueue m_queue = VK_NULL_HANDLE;
+
+        Buffer m_staging;
+        VkDeviceSize m_stagingHead = 0;
+
+        VkCommandPool m_commandPool = VK_NULL_HANDLE;
+        VkCommandBuffer m_commandBuffer = VK_NULL_HANDLE;
+        VkFence m_fence = VK_NULL_HANDLE;
+        bool m_recording = false;
+        uint32_t m_batchDepth = 0;
+
+        UploadStats m_stats{};
+        mutable std::mutex m_mutex;
+    };
+
+    // Abre um lote de upload no escopo atual
+    class UploadBatch {
+    public:
+        explicit UploadBatch(UploadContext& context) : m_context(context) { m_context.beginBatch(); }
+        ~UploadBatch() { m_context.endBatch(); }
+
+        UploadBatch(const UploadBatch&) = delete;
+        UploadBatch& operator=(const UploadBatch&) = delete;
+
+    private:
+        UploadContext& m_context;
+    };
+
+} // namespace vke
+
+#endif // VKE_UPLOADCONTEXT_H
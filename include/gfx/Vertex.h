@@ -2,14 +2,33 @@
 #define VKE_VERTEX_H
 
 #include <array>
+#include <vector>
 #include <vulkan/vulkan.h>
 
 namespace vke {
 
+    // Layout de entrada de vértices (bindings + atributos) de um pipeline
+    struct VertexLayout {
+        std::vector<VkVertexInputBindingDescription> bindings;
+        std::vector<VkVertexInputAttributeDescription> attributes;
+    };
+
     struct Vertex {
         float position[2];
         float color[3];
 
+        static VkVertexInputBindingDescription getBindingDescription();
+        static std::array<VkVertexInputAttributeDescription, 2> getAttributeDescriptions();
+        static VertexLayout getVertexLayout();
+        // Vertex (binding 0) + InstanceData (binding 1, por instância)
+        static VertexLayout getInstancedVertexLayout();
+    };
+
+    // Dados por instância lidos no binding 1 com VK_VERTEX_INPUT_RATE_INSTANCE
+    struct InstanceData {
+        float offset[2];
+        float scale;
+
         static VkVertexInputBindingDescription getBindingDescription();
         static std::array<VkVertexInputAttributeDescription, 2> getAttributeDescriptions();
     };
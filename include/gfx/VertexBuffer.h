@@ -9,16 +9,20 @@ namespace vke {
 
     class VertexBuffer {
     public:
-        VertexBuffer(VkDevice device, VkPhysicalDevice physicalDevice);
+        explicit VertexBuffer(Device& device);
         ~VertexBuffer();
 
         void create(const std::vector<Vertex>& vertices);
+        // vertices pode apontar para memória mapeada: vai direto para o staging
+        void create(const Vertex* vertices, size_t count);
         void bind(VkCommandBuffer commandBuffer) const;
         void destroy();
 
         [[nodiscard]] size_t getVertexCount() const { return m_vertexCount; }
+        [[nodiscard]] VkBuffer getBuffer() const { return m_buffer.getBuffer(); }
 
     private:
+        Device& m_device;
         Buffer m_buffer;
         size_t m_vertexCount = 0;
     };
@@ -0,0 +1,124 @@
+#ifndef VKE_SCENE_H
+#define VKE_SCENE_H
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include "gfx/Bounds.h"
+
+namespace vke {
+
+    class JobSystem;
+
+    // Matriz 4x4 column-major, no formato esperado pelos shaders
+    using Mat4 = std::array<float, 16>;
+
+    // Transformação local: translação, rotação (quaternion xyzw) e escala uniforme
+    struct Transform {
+        float position[3] = { 0.0f, 0.0f, 0.0f };
+        float rotation[4] = { 0.0f, 0.0f, 0.0f, 1.0f };
+        float scale = 1.0f;
+    };
+
+    // Referência estável a um nó: índice de slot + geração, que continua válida
+    // quando o nó muda de posição nos arrays e é invalidada quando ele é destruído
+    struct SceneNode {
+        static constexpr uint32_t kInvalidSlot = UINT32_MAX;
+
+        uint32_t slot = kInvalidSlot;
+        uint32_t generation = 0;
+
+        [[nodiscard]] bool isNull() const { return slot == kInvalidSlot; }
+    };
+
+    // Hierarquia de transformações orientada a dados. Cada componente vive em um
+    // array contíguo próprio (SoA), ordenado por profundidade: pais sempre vêm
+    // antes dos filhos e cada nível é uma faixa contígua, então a atualização
+    // percorre os arrays em ordem e os nós de um nível podem ser processados em
+    // paralelo. Só nós marcados como sujos (e seus descendentes) são recalculados.
+    class Scene {
+    public:
+        static constexpr uint32_t kNoParent = UINT32_MAX;
+
+        Scene() = default;
+
+        // Proíbe cópia
+        Scene(const Scene&) = delete;
+        Scene& operator=(const Scene&) = delete;
+
+        // Pai nulo cria uma raiz
+        SceneNode create(SceneNode parent = {}, const Transform& local = {});
+        // Destrói o nó e toda a sua subárvore; O(n), prefira destruir em lote por subárvore
+        void destroy(SceneNode node);
+        [[nodiscard]] bool isAlive(SceneNode node) const;
+
+        // Reordena os arrays no próximo updateTransforms()
+        void setParent(SceneNode node, SceneNode parent);
+        [[nodiscard]] SceneNode getParent(SceneNode node) const;
+
+        void setLocalTransform(SceneNode node, const Transform& local);
+        void setPosition(SceneNode node, float x, float y, float z);
+        [[nodiscard]] Transform getLocalTransform(SceneNode node) const;
+        // Esfera em espaço local; a versão em mundo sai em getWorldBounds()
+        void setLocalBounds(SceneNode node, const BoundingSphere& bounds);
+
+        /**
+         * Propaga as transformações sujas para mundo (matrizes e esferas).
+         * @param jobs: com um JobSystem, níveis grandes são divididos entre as threads
+         * Depois da chamada nenhum nó fica sujo.
+         */
+        void updateTransforms(JobSystem* jobs = nullptr);
+
+        // Válidos depois de updateTransforms()
+        [[nodiscard]] const Mat4& getWorldMatrix(SceneNode node) const;
+        [[nodiscard]] BoundingSphere getWorldBounds(SceneNode node) const;
+
+        // Acesso denso (ordem por profundidade), para iterar sem passar por handles.
+        // Os índices densos mudam depois de destroy() e de reordenações.
+        [[nodiscard]] uint32_t size() const { return static_cast<uint32_t>(m_parent.size()); }
+        [[nodiscard]] const std::vector<Mat4>& worldMatrices() const { return m_world; }
+        [[nodiscard]] const BoundsSoA& worldBounds() const { return m_worldBounds; }
+        [[nodiscard]] SceneNode nodeAt(uint32_t denseIndex) const;
+        // Nós recalculados no último updateTransforms()
+        [[nodiscard]] uint32_t getLastUpdatedCount() const { return m_lastUpdatedCount; }
+
+    private:
+        struct Slot {
+            uint32_t dense = kNoParent; // kNoParent quando o slot está livre
+            uint32_t generation = 0;
+        };
+
+        [[nodiscard]] uint32_t denseIndex(SceneNode node) const;
+        void markDirty(uint32_t index);
+        void sortByDepth();
+        // Mantém os índices de order e descarta os demais; remapeia pais e slots
+        void applyOrder(const std::vector<uint32_t>& order);
+        uint32_t updateRange(uint32_t begin, uint32_t end);
+
+    private:
+        // Arrays densos, todos com size() elementos
+        std::vector<uint32_t> m_parent;   // índice denso do pai ou kNoParent
+        std::vector<uint32_t> m_depth;
+        std::vector<uint32_t> m_slotOf;   // índice denso -> slot do handle
+        std::vector<float> m_positionX, m_positionY, m_positionZ;
+        std::vector<float> m_rotationX, m_rotationY, m_rotationZ, m_rotationW;
+        std::vector<float> m_scale;
+        std::vector<uint8_t> m_dirty;
+        BoundsSoA m_localBounds;
+        BoundsSoA m_worldBounds;
+        std::vector<Mat4> m_world;
+
+        // Início de cada nível de profundidade nos arrays densos (+ sentinela)
+        std::vector<uint32_t> m_levelStart;
+        bool m_orderDirty = false;
+        uint32_t m_dirtyCount = 0;
+        uint32_t m_lastUpdatedCount = 0;
+
+        std::vector<Slot> m_slots;
+        std::vector<uint32_t> m_freeSlots;
+    };
+
+} // namespace vke
+
+#endif // VKE_SCENE_H
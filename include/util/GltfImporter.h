@@ -0,0 +1,74 @@
+#ifndef VKE_GLTFIMPORTER_H
+#define VKE_GLTFIMPORTER_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "gfx/Bounds.h"
+#include "gfx/Vertex.h"
+#include "scene/Scene.h"
+
+namespace vke {
+
+    class JobSystem;
+
+    // Primitiva glTF convertida para o layout do engine: lista de triângulos
+    // indexada em 32 bits, índices relativos aos próprios vértices
+    struct GltfPrimitive {
+        std::vector<Vertex> vertices;
+        std::vector<uint32_t> indices;
+        BoundingSphere bounds;
+    };
+
+    // Mesh glTF: faixa contígua em GltfAsset::primitives
+    struct GltfMesh {
+        std::string name;
+        uint32_t firstPrimitive = 0;
+        uint32_t primitiveCount = 0;
+    };
+
+    struct GltfNode {
+        static constexpr uint32_t kNoMesh = UINT32_MAX;
+
+        std::string name;
+        uint32_t parent = Scene::kNoParent; // índice em GltfAsset::nodes
+        uint32_t mesh = kNoMesh;
+        Transform local;
+    };
+
+    // Resultado da importação de um .gltf/.glb. Só geometria e hierarquia:
+    // materiais, texturas, skins e animações são ignorados.
+    struct GltfAsset {
+        std::vector<GltfPrimitive> primitives;
+        std::vector<GltfMesh> meshes;
+        std::vector<GltfNode> nodes;
+        // Raízes da cena padrão (ou de todos os nós sem pai, se o arquivo não tiver cenas)
+        std::vector<uint32_t> roots;
+
+        [[nodiscard]] size_t getTriangleCount() const;
+
+        /**
+         * Cria na cena a hierarquia alcançável a partir de roots, pais antes dos filhos.
+         * @return handle de cada nó de nodes (nulo para os que não fazem parte da cena)
+         */
+        std::vector<SceneNode> instantiate(Scene& scene) const;
+    };
+
+    class GltfImporter {
+    public:
+        /**
+         * Importa meshes, acessores e a hierarquia de nós de um glTF 2.0.
+         * .glb é mapeado e lido direto do chunk binário; .gltf aceita buffers em
+         * arquivos relativos ou URIs data: em base64.
+         * POSITION vira Vertex::position (xy; z é descartado pelo layout atual) e
+         * COLOR_0 vira Vertex::color (branco se ausente). Strips e fans viram listas.
+         * @param jobs: com um JobSystem, as primitivas são decodificadas em paralelo
+         * Lança std::runtime_error se o arquivo for inválido ou usar recursos não suportados.
+         */
+        static GltfAsset load(const std::string& path, JobSystem* jobs = nullptr);
+    };
+
+} // namespace vke
+
+#endif // VKE_GLTFIMPORTER_H
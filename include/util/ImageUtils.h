@@ -0,0 +1,20 @@
+#ifndef VKE_IMAGEUTILS_H
+#define VKE_IMAGEUTILS_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace vke {
+
+    /**
+     * Grava pixels RGBA8 (linhas compactas) como PPM binário (P6), descartando o alfa.
+     * Formato trivial de diffar em testes de regressão de imagem.
+     * @param path: arquivo de saída
+     * @param rgba: width * height * 4 bytes
+     */
+    void writePPM(const std::string& path, const std::vector<uint8_t>& rgba, uint32_t width, uint32_t height);
+
+} // namespace vke
+
+#endif // VKE_IMAGEUTILS_H
@@ -0,0 +1,70 @@
+#ifndef VKE_JSON_H
+#define VKE_JSON_H
+
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace vke {
+
+    // Documento JSON em árvore, só para leitura (baselines do vke_bench, metadados de glTF).
+    // Objetos guardam os membros em ordem, com busca linear: são pequenos e
+    // lidos poucas vezes. Depois de parse() o valor pode ser lido por várias
+    // threads ao mesmo tempo.
+    class JsonValue {
+    public:
+        enum class Type : uint8_t { Null, Bool, Number, String, Array, Object };
+
+        JsonValue() = default;
+
+        /**
+         * Interpreta um documento completo (RFC 8259, com escapes \uXXXX em UTF-8).
+         * @param source: nome usado nas mensagens de erro
+         * Lança std::runtime_error com o offset do primeiro erro.
+         */
+        static JsonValue parse(std::string_view text, const std::string& source);
+
+        [[nodiscard]] Type getType() const { return m_type; }
+        [[nodiscard]] bool isNull() const { return m_type == Type::Null; }
+        [[nodiscard]] bool isNumber() const { return m_type == Type::Number; }
+        [[nodiscard]] bool isString() const { return m_type == Type::String; }
+        [[nodiscard]] bool isArray() const { return m_type == Type::Array; }
+        [[nodiscard]] bool isObject() const { return m_type == Type::Object; }
+
+        // Valor do tipo pedido ou fallback se o tipo for outro (inclusive membro ausente)
+        [[nodiscard]] bool getBool(bool fallback = false) const { return m_type == Type::Bool ? m_bool : fallback; }
+        [[nodiscard]] double getNumber(double fallback = 0.0) const { return m_type == Type::Number ? m_number : fallback; }
+        [[nodiscard]] const std::string& getString() const { return m_string; }
+
+        // Elementos de um array ou membros de um objeto; 0 para os demais tipos
+        [[nodiscard]] size_t size() const;
+        // Elemento de um array; valor nulo fora dos limites
+        [[nodiscard]] const JsonValue& operator[](size_t index) const;
+        // Membro de um objeto; valor nulo se ausente
+        [[nodiscard]] const JsonValue& operator[](std::string_view key) const;
+        [[nodiscard]] bool contains(std::string_view key) const;
+
+        [[nodiscard]] const std::vector<JsonValue>& getArray() const { return m_array; }
+        [[nodiscard]] const std::vector<std::pair<std::string, JsonValue>>& getObject() const { return m_object; }
+
+    private:
+        friend class JsonParser;
+
+        Type m_type = Type::Null;
+        bool m_bool = false;
+        double m_number = 0.0;
+        std::string m_string;
+        std::vector<JsonValue> m_array;
+        std::vector<std::pair<std::string, JsonValue>> m_object;
+    };
+
+    // Grava text como string JSON entre aspas, escapando aspas, barras e caracteres de controle
+    void writeJsonString(std::ostream& out, std::string_view text);
+
+} // namespace vke
+
+#endif // VKE_JSON_H
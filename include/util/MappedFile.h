@@ -0,0 +1,43 @@
+#ifndef VKE_MAPPEDFILE_H
+#define VKE_MAPPEDFILE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace vke {
+
+    // Arquivo inteiro mapeado só para leitura (mmap / MapViewOfFile). As
+    // páginas são trazidas do disco (ou do page cache) conforme são lidas,
+    // então copiar uma seção para o staging é a única cópia no caminho.
+    class MappedFile {
+    public:
+        MappedFile() = default;
+        // Lança std::runtime_error se o arquivo não puder ser aberto ou mapeado
+        explicit MappedFile(const std::string& path);
+        ~MappedFile();
+
+        MappedFile(MappedFile&& other) noexcept;
+        MappedFile& operator=(MappedFile&& other) noexcept;
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        [[nodiscard]] const uint8_t* data() const { return m_data; }
+        [[nodiscard]] size_t size() const { return m_size; }
+        [[nodiscard]] bool isOpen() const { return m_opened; }
+
+        void close();
+
+    private:
+        const uint8_t* m_data = nullptr;
+        size_t m_size = 0;
+        bool m_opened = false;
+#ifdef _WIN32
+        void* m_file = nullptr;
+        void* m_mapping = nullptr;
+#endif
+    };
+
+} // namespace vke
+
+#endif // VKE_MAPPEDFILE_H
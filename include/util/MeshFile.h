@@ -0,0 +1,108 @@
+#ifndef VKE_MESHFILE_H
+#define VKE_MESHFILE_H
+
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "gfx/Bounds.h"
+#include "gfx/Vertex.h"
+#include "util/MappedFile.h"
+
+namespace vke {
+
+    // Formato .vkm (little-endian). Seções alinhadas a kMeshFileAlignment, na ordem:
+    //   MeshFileHeader | MeshFileEntry[meshCount] | MeshFileMeshlet[] | Vertex[] | uint32_t[] (índices)
+    // Tudo já no layout da memória: carregar é mapear, validar os limites e os índices e
+    // copiar as seções de vértices/índices para o staging.
+    constexpr uint32_t kMeshFileMagic = 0x314D4B56; // "VKM1"
+    constexpr uint32_t kMeshFileVersion = 1;
+    constexpr uint32_t kMeshFileAlignment = 16;
+    // Triângulos por meshlet gravado pelo cooker
+    constexpr uint32_t kMeshletMaxTriangles = 64;
+
+    struct MeshFileSection {
+        uint64_t offset = 0;  // desde o início do arquivo
+        uint64_t size = 0;    // em bytes
+    };
+
+    struct MeshFileHeader {
+        uint32_t magic = kMeshFileMagic;
+        uint32_t version = kMeshFileVersion;
+        uint32_t meshCount = 0;
+        uint32_t vertexStride = sizeof(Vertex); // o loader recusa layouts diferentes
+        MeshFileSection meshes;
+        MeshFileSection meshlets;
+        MeshFileSection vertices;
+        MeshFileSection indices;
+        BoundingSphere bounds;                  // união dos meshes
+    };
+
+    // Um mesh: faixas nas seções de vértices, índices e meshlets.
+    // Índices são relativos ao primeiro vértice do mesh (como vertexOffset num draw)
+    struct MeshFileEntry {
+        uint32_t firstVertex = 0;
+        uint32_t vertexCount = 0;
+        uint32_t firstIndex = 0;
+        uint32_t indexCount = 0;
+        uint32_t firstMeshlet = 0;
+        uint32_t meshletCount = 0;
+        BoundingSphere bounds;
+    };
+
+    // Faixa contígua de até kMeshletMaxTriangles triângulos dos índices do mesh,
+    // com esfera própria para culling mais fino que o mesh inteiro
+    struct MeshFileMeshlet {
+        uint32_t firstIndex = 0; // relativo ao firstIndex do mesh
+        uint32_t indexCount = 0;
+        BoundingSphere bounds;
+    };
+
+    static_assert(std::is_trivially_copyable_v<MeshFileHeader> && sizeof(MeshFileHeader) == 96);
+    static_assert(std::is_trivially_copyable_v<MeshFileEntry> && sizeof(MeshFileEntry) == 40);
+    static_assert(std::is_trivially_copyable_v<MeshFileMeshlet> && sizeof(MeshFileMeshlet) == 24);
+    static_assert(std::is_trivially_copyable_v<Vertex>);
+
+    // Geometria de entrada do cooker: índices relativos ao próprio mesh
+    struct MeshFileInput {
+        std::vector<Vertex> vertices;
+        std::vector<uint32_t> indices;
+    };
+
+    // Arquivo .vkm mapeado. Os ponteiros devolvidos apontam para o mapeamento
+    // e valem enquanto o MeshFile existir.
+    class MeshFile {
+    public:
+        // Mapeia e valida cabeçalho, limites das seções, meshlets e índices; lança std::runtime_error se inválido
+        explicit MeshFile(const std::string& path);
+
+        [[nodiscard]] uint32_t getMeshCount() const { return m_header->meshCount; }
+        [[nodiscard]] const MeshFileEntry& getMesh(uint32_t index) const { return m_meshes[index]; }
+        [[nodiscard]] const Vertex* getVertices(const MeshFileEntry& mesh) const { return m_vertices + mesh.firstVertex; }
+        [[nodiscard]] const uint32_t* getIndices(const MeshFileEntry& mesh) const { return m_indices + mesh.firstIndex; }
+        [[nodiscard]] const MeshFileMeshlet* getMeshlets(const MeshFileEntry& mesh) const {
+            return m_meshlets + mesh.firstMeshlet;
+        }
+        [[nodiscard]] const BoundingSphere& getBounds() const { return m_header->bounds; }
+        [[nodiscard]] size_t getFileSize() const { return m_file.size(); }
+
+        /**
+         * Grava meshes no formato .vkm, calculando bounds e meshlets.
+         * @param path: arquivo de saída (sobrescrito)
+         * @param meshes: geometria indexada; índices relativos ao mesh
+         */
+        static void write(const std::string& path, const std::vector<MeshFileInput>& meshes);
+
+    private:
+        MappedFile m_file;
+        const MeshFileHeader* m_header = nullptr;
+        const MeshFileEntry* m_meshes = nullptr;
+        const MeshFileMeshlet* m_meshlets = nullptr;
+        const Vertex* m_vertices = nullptr;
+        const uint32_t* m_indices = nullptr;
+    };
+
+} // namespace vke
+
+#endif // VKE_MESHFILE_H
@@ -0,0 +1,24 @@
+#ifndef VKE_MESHUTILS_H
+#define VKE_MESHUTILS_H
+
+#include <cstdint>
+#include <vector>
+
+#include "gfx/Vertex.h"
+
+namespace vke {
+
+    /**
+     * Solda vértices duplicados de uma lista de triângulos não indexada.
+     * Vértices com bytes idênticos viram um só; a ordem de primeira ocorrência é preservada.
+     * @param triangleList: vértices no formato atual (3 por triângulo, sem índices)
+     * @param outVertices: vértices únicos
+     * @param outIndices: um índice por vértice de entrada, apontando para outVertices
+     */
+    void weldVertices(const std::vector<Vertex>& triangleList,
+                      std::vector<Vertex>& outVertices,
+                      std::vector<uint32_t>& outIndices);
+
+} // namespace vke
+
+#endif // VKE_MESHUTILS_H
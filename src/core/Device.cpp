@@ -1,5 +1,8 @@
 #include "core/Device.h"
+#include "gfx/PipelineRegistry.h"
+#include "gfx/UploadContext.h"
 
+#include <cstring>
 #include <stdexcept>
 #include <set>
 #include <iostream>
@@ -8,23 +11,55 @@
 namespace vke {
 
     // Construtor: recebe a instância Vulkan e a surface criadas na Engine
-    Device::Device(VkInstance instance, VkSurfaceKHR surface)
+    Device::Device(VkInstance instance, VkSurfaceKHR surface, const std::string& pipelineCachePath)
         : m_instance(instance)
         , m_surface(surface)
     {
+        if (!headless()) {
+            m_requiredExtensions.push_back(VK_KHR_SWAPCHAIN_EXTENSION_NAME);
+        }
+
         // Seleciona a GPU física e cria o dispositivo lógico
         pickPhysicalDevice();
         createLogicalDevice();
+
+        // Guarda as propriedades da GPU para não consultá-las a cada alocação
+        vkGetPhysicalDeviceProperties(m_physicalDevice, &m_properties);
+        vkGetPhysicalDeviceMemoryProperties(m_physicalDevice, &m_memoryProperties);
+        m_allocator = std::make_unique<MemoryAllocator>(m_device, m_memoryProperties, m_properties.limits);
+        m_uploader = std::make_unique<UploadContext>(*this);
+        m_pipelineCache = std::make_unique<PipelineCache>(m_device, m_properties, pipelineCachePath);
+        m_pipelines = std::make_unique<PipelineRegistry>(*this);
     }
 
     // Destrutor: destrói o dispositivo lógico, se criado
     Device::~Device() {
+        // O cache é salvo no disco e o staging e os blocos de memória liberados antes do device
+        m_pipelines.reset();
+        m_pipelineCache.reset();
+        m_uploader.reset();
+        m_allocator.reset();
+
         if (m_device != VK_NULL_HANDLE) {
             vkDestroyDevice(m_device, nullptr);
             m_device = VK_NULL_HANDLE;
         }
     }
 
+    void Device::appendInstanceExtensions(std::vector<const char*>& extensions) {
+        uint32_t extensionCount = 0;
+        vkEnumerateInstanceExtensionProperties(nullptr, &extensionCount, nullptr);
+        std::vector<VkExtensionProperties> available(extensionCount);
+        vkEnumerateInstanceExtensionProperties(nullptr, &extensionCount, available.data());
+
+        for (const auto& ext : available) {
+            if (std::strcmp(ext.extensionName, VK_KHR_GET_PHYSICAL_DEVICE_PROPERTIES_2_EXTENSION_NAME) == 0) {
+                extensions.push_back(VK_KHR_GET_PHYSICAL_DEVICE_PROPERTIES_2_EXTENSION_NAME);
+                return;
+            }
+        }
+    }
+
     // Seleciona uma GPU física que seja adequada para o uso com Vulkan
     void Device::pickPhysicalDevice() {
         uint32_t deviceCount = 0;
@@ -52,7 +87,7 @@ namespace vke {
     // Verifica se a GPU física possui suporte para as filas necessárias e extensões requeridas
     bool Device::isDeviceSuitable(VkPhysicalDevice device) const {
         QueueFamilyIndices indices = findQueueFamilies(device);
-        bool indicesOk = indices.isComplete();
+        bool indicesOk = indices.isComplete(!headless());
         bool extensionsOk = checkDeviceExtensionSupport(device);
 
         // Aqui você pode adicionar verificações adicionais (por exemplo, suporte a swap-chain)
@@ -75,6 +110,21 @@ namespace vke {
         return required.empty();
     }
 
+    bool Device::isExtensionAvailable(VkPhysicalDevice device, const char* extensionName) const {
+        uint32_t extensionCount = 0;
+        vkEnumerateDeviceExtensionProperties(device, nullptr, &extensionCount, nullptr);
+
+        std::vector<VkExtensionProperties> availableExtensions(extensionCount);
+        vkEnumerateDeviceExtensionProperties(device, nullptr, &extensionCount, availableExtensions.data());
+
+        for (const auto& ext : availableExtensions) {
+            if (std::strcmp(ext.extensionName, extensionName) == 0) {
+                return true;
+            }
+        }
+        return false;
+    }
+
     // Procura pelas filas (queues) necessárias: gráficos e apresentação
     QueueFamilyIndices Device::findQueueFamilies(VkPhysicalDevice device) const {
         QueueFamilyIndices indices;
@@ -92,16 +142,18 @@ namespace vke {
                     indices.graphicsFamily = i;
                 }
             }
-            // Verifica se a fila suporta apresentação à surface
+            // Verifica se a fila suporta apresentação à surface (não há surface em modo headless)
             VkBool32 presentSupport = VK_FALSE;
-            vkGetPhysicalDeviceSurfaceSupportKHR(device, i, m_surface, &presentSupport);
+            if (!headless()) {
+                vkGetPhysicalDeviceSurfaceSupportKHR(device, i, m_surface, &presentSupport);
+            }
             if (presentSupport) {
                 if (!indices.presentFamily.has_value()) {
                     indices.presentFamily = i;
                 }
             }
             // Se ambos os índices foram encontrados, podemos sair do loop
-            if (indices.isComplete()) {
+            if (indices.isComplete(!headless())) {
                 break;
             }
         }
@@ -112,11 +164,12 @@ namespace vke {
     // Cria o dispositivo lógico a partir da GPU selecionada e configura as filas necessárias
     void Device::createLogicalDevice() {
         QueueFamilyIndices indices = findQueueFamilies(m_physicalDevice);
+        m_queueFamilies = indices;
         std::vector<VkDeviceQueueCreateInfo> queueInfos;
-        std::set<uint32_t> uniqueFamilies = {
-            indices.graphicsFamily.value(),
-            indices.presentFamily.value()
-        };
+        std::set<uint32_t> uniqueFamilies = { indices.graphicsFamily.value() };
+        if (indices.presentFamily.has_value()) {
+            uniqueFamilies.insert(indices.presentFamily.value());
+        }
 
         float queuePriority = 1.0f;
         for (uint32_t family : uniqueFamilies) {
@@ -128,26 +181,196 @@ namespace vke {
             queueInfos.push_back(queueInfo);
         }
 
+        // Desenho indireto: habilita o que a GPU oferece e registra para os caminhos de fallback
+        VkPhysicalDeviceFeatures supportedFeatures{};
+        vkGetPhysicalDeviceFeatures(m_physicalDevice, &supportedFeatures);
+
         VkPhysicalDeviceFeatures deviceFeatures{};
+        deviceFeatures.multiDrawIndirect = supportedFeatures.multiDrawIndirect;
+        deviceFeatures.drawIndirectFirstInstance = supportedFeatures.drawIndirectFirstInstance;
+        m_features.multiDrawIndirect = supportedFeatures.multiDrawIndirect == VK_TRUE;
+        m_features.drawIndirectFirstInstance = supportedFeatures.drawIndirectFirstInstance == VK_TRUE;
+
+        // Profiling na GPU: timestamps dependem da família da fila, estatísticas de uma feature
+        deviceFeatures.pipelineStatisticsQuery = supportedFeatures.pipelineStatisticsQuery;
+        m_features.pipelineStatisticsQuery = supportedFeatures.pipelineStatisticsQuery == VK_TRUE;
+        uint32_t familyCount = 0;
+        vkGetPhysicalDeviceQueueFamilyProperties(m_physicalDevice, &familyCount, nullptr);
+        std::vector<VkQueueFamilyProperties> families(familyCount);
+        vkGetPhysicalDeviceQueueFamilyProperties(m_physicalDevice, &familyCount, families.data());
+        m_timestampValidBits = families[indices.graphicsFamily.value()].timestampValidBits;
+        m_features.timestampQueries = m_timestampValidBits > 0;
+
+        // Extensões opcionais entram na lista só se existirem
+        std::vector<const char*> extensions = m_requiredExtensions;
+        m_features.drawIndirectCount = isExtensionAvailable(m_physicalDevice, VK_KHR_DRAW_INDIRECT_COUNT_EXTENSION_NAME);
+        if (m_features.drawIndirectCount) {
+            extensions.push_back(VK_KHR_DRAW_INDIRECT_COUNT_EXTENSION_NAME);
+        }
+
+        VkPhysicalDeviceDescriptorIndexingFeaturesEXT indexingFeatures{};
+        indexingFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES_EXT;
+        m_features.descriptorIndexing = queryDescriptorIndexing(indexingFeatures);
+        if (m_features.descriptorIndexing) {
+            extensions.push_back(VK_KHR_MAINTENANCE3_EXTENSION_NAME);
+            extensions.push_back(VK_EXT_DESCRIPTOR_INDEXING_EXTENSION_NAME);
+        }
+
+        // Instância em 1.0: dynamic rendering depende de depth_stencil_resolve e
+        // da cadeia create_renderpass2 -> multiview + maintenance2
+        VkPhysicalDeviceDynamicRenderingFeaturesKHR renderingFeatures{};
+        renderingFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DYNAMIC_RENDERING_FEATURES_KHR;
+        VkPhysicalDeviceSynchronization2FeaturesKHR synchronization2Features{};
+        synchronization2Features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SYNCHRONIZATION_2_FEATURES_KHR;
+        m_features.dynamicRendering = queryDynamicRendering(renderingFeatures, synchronization2Features);
+        if (m_features.dynamicRendering) {
+            extensions.push_back(VK_KHR_MULTIVIEW_EXTENSION_NAME);
+            extensions.push_back(VK_KHR_MAINTENANCE2_EXTENSION_NAME);
+            extensions.push_back(VK_KHR_CREATE_RENDERPASS_2_EXTENSION_NAME);
+            extensions.push_back(VK_KHR_DEPTH_STENCIL_RESOLVE_EXTENSION_NAME);
+            extensions.push_back(VK_KHR_DYNAMIC_RENDERING_EXTENSION_NAME);
+            extensions.push_back(VK_KHR_SYNCHRONIZATION_2_EXTENSION_NAME);
+        }
+
+        // Structs de features das extensões habilitadas, encadeadas em pNext
+        void* featureChain = nullptr;
+        if (m_features.descriptorIndexing) {
+            indexingFeatures.pNext = featureChain;
+            featureChain = &indexingFeatures;
+        }
+        if (m_features.dynamicRendering) {
+            synchronization2Features.pNext = featureChain;
+            renderingFeatures.pNext = &synchronization2Features;
+            featureChain = &renderingFeatures;
+        }
 
         VkDeviceCreateInfo createInfo{};
         createInfo.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
         createInfo.queueCreateInfoCount = static_cast<uint32_t>(queueInfos.size());
         createInfo.pQueueCreateInfos = queueInfos.data();
         createInfo.pEnabledFeatures = &deviceFeatures;
+        createInfo.pNext = featureChain;
 
-        // Configura as extensões necessárias (por exemplo, swap-chain)
-        createInfo.enabledExtensionCount = static_cast<uint32_t>(m_requiredExtensions.size());
-        createInfo.ppEnabledExtensionNames = m_requiredExtensions.data();
+        // Configura as extensões necessárias (por exemplo, swap-chain) e as opcionais encontradas
+        createInfo.enabledExtensionCount = static_cast<uint32_t>(extensions.size());
+        createInfo.ppEnabledExtensionNames = extensions.data();
 
         // Cria o dispositivo lógico
         if (vkCreateDevice(m_physicalDevice, &createInfo, nullptr, &m_device) != VK_SUCCESS) {
             throw std::runtime_error("Failed to create logical device!");
         }
 
+        if (m_features.drawIndirectCount) {
+            m_cmdDrawIndexedIndirectCount = reinterpret_cast<PFN_vkCmdDrawIndexedIndirectCountKHR>(
+                vkGetDeviceProcAddr(m_device, "vkCmdDrawIndexedIndirectCountKHR"));
+            m_features.drawIndirectCount = m_cmdDrawIndexedIndirectCount != nullptr;
+        }
+        if (m_features.dynamicRendering) {
+            m_cmdBeginRendering = reinterpret_cast<PFN_vkCmdBeginRenderingKHR>(
+                vkGetDeviceProcAddr(m_device, "vkCmdBeginRenderingKHR"));
+            m_cmdEndRendering = reinterpret_cast<PFN_vkCmdEndRenderingKHR>(
+                vkGetDeviceProcAddr(m_device, "vkCmdEndRenderingKHR"));
+            m_cmdPipelineBarrier2 = reinterpret_cast<PFN_vkCmdPipelineBarrier2KHR>(
+                vkGetDeviceProcAddr(m_device, "vkCmdPipelineBarrier2KHR"));
+            m_features.dynamicRendering = m_cmdBeginRendering != nullptr && m_cmdEndRendering != nullptr &&
+                                          m_cmdPipelineBarrier2 != nullptr;
+        }
+
         // Recupera as filas para gráficos e apresentação
         vkGetDeviceQueue(m_device, indices.graphicsFamily.value(), 0, &m_graphicsQueue);
-        vkGetDeviceQueue(m_device, indices.presentFamily.value(), 0, &m_presentQueue);
+        if (indices.presentFamily.has_value()) {
+            vkGetDeviceQueue(m_device, indices.presentFamily.value(), 0, &m_presentQueue);
+        }
+    }
+
+    // Consulta as features da cadeia via vkGetPhysicalDeviceFeatures2KHR; false se
+    // a instância não habilitou VK_KHR_get_physical_device_properties2
+    bool Device::queryFeatures2(void* chain) const {
+        auto getFeatures2 = reinterpret_cast<PFN_vkGetPhysicalDeviceFeatures2KHR>(
+            vkGetInstanceProcAddr(m_instance, "vkGetPhysicalDeviceFeatures2KHR"));
+        if (getFeatures2 == nullptr) {
+            return false;
+        }
+
+        VkPhysicalDeviceFeatures2KHR features2{};
+        features2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2_KHR;
+        features2.pNext = chain;
+        getFeatures2(m_physicalDevice, &features2);
+        return true;
+    }
+
+    // Tabela bindless: um array de storage buffers e outro de texturas, parcialmente
+    // preenchidos e atualizados depois do bind. Exige features2 na instância
+    // (appendInstanceExtensions) e VK_EXT_descriptor_indexing + VK_KHR_maintenance3
+    // no device; preenche em enabled só as features que a tabela usa.
+    bool Device::queryDescriptorIndexing(VkPhysicalDeviceDescriptorIndexingFeaturesEXT& enabled) {
+        if (!isExtensionAvailable(m_physicalDevice, VK_EXT_DESCRIPTOR_INDEXING_EXTENSION_NAME) ||
+            !isExtensionAvailable(m_physicalDevice, VK_KHR_MAINTENANCE3_EXTENSION_NAME)) {
+            return false;
+        }
+
+        auto getProperties2 = reinterpret_cast<PFN_vkGetPhysicalDeviceProperties2KHR>(
+            vkGetInstanceProcAddr(m_instance, "vkGetPhysicalDeviceProperties2KHR"));
+        VkPhysicalDeviceDescriptorIndexingFeaturesEXT supported{};
+        supported.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES_EXT;
+        if (getProperties2 == nullptr || !queryFeatures2(&supported)) {
+            return false;
+        }
+
+        if (!supported.runtimeDescriptorArray || !supported.descriptorBindingPartiallyBound ||
+            !supported.descriptorBindingUpdateUnusedWhilePending ||
+            !supported.descriptorBindingStorageBufferUpdateAfterBind ||
+            !supported.descriptorBindingSampledImageUpdateAfterBind) {
+            return false;
+        }
+
+        enabled.runtimeDescriptorArray = VK_TRUE;
+        enabled.descriptorBindingPartiallyBound = VK_TRUE;
+        enabled.descriptorBindingUpdateUnusedWhilePending = VK_TRUE;
+        enabled.descriptorBindingStorageBufferUpdateAfterBind = VK_TRUE;
+        enabled.descriptorBindingSampledImageUpdateAfterBind = VK_TRUE;
+        // Índices não uniformes dentro de um draw são opcionais para a tabela
+        enabled.shaderStorageBufferArrayNonUniformIndexing = supported.shaderStorageBufferArrayNonUniformIndexing;
+        enabled.shaderSampledImageArrayNonUniformIndexing = supported.shaderSampledImageArrayNonUniformIndexing;
+
+        m_descriptorIndexingProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_PROPERTIES_EXT;
+        VkPhysicalDeviceProperties2KHR properties2{};
+        properties2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2_KHR;
+        properties2.pNext = &m_descriptorIndexingProperties;
+        getProperties2(m_physicalDevice, &properties2);
+        m_descriptorIndexingProperties.pNext = nullptr;
+        return true;
+    }
+
+    // Renderização sem VkRenderPass/VkFramebuffer: attachments e layouts são
+    // declarados no próprio command buffer, com barreiras de imagem sync2.
+    // Os dois caminhos andam juntos no Renderer, então um sem o outro não conta.
+    bool Device::queryDynamicRendering(VkPhysicalDeviceDynamicRenderingFeaturesKHR& rendering,
+                                       VkPhysicalDeviceSynchronization2FeaturesKHR& synchronization2) const {
+        const char* required[] = {
+            VK_KHR_DYNAMIC_RENDERING_EXTENSION_NAME, VK_KHR_SYNCHRONIZATION_2_EXTENSION_NAME,
+            VK_KHR_DEPTH_STENCIL_RESOLVE_EXTENSION_NAME, VK_KHR_CREATE_RENDERPASS_2_EXTENSION_NAME,
+            VK_KHR_MULTIVIEW_EXTENSION_NAME, VK_KHR_MAINTENANCE2_EXTENSION_NAME
+        };
+        for (const char* extension : required) {
+            if (!isExtensionAvailable(m_physicalDevice, extension)) {
+                return false;
+            }
+        }
+
+        VkPhysicalDeviceSynchronization2FeaturesKHR supportedSync2{};
+        supportedSync2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SYNCHRONIZATION_2_FEATURES_KHR;
+        VkPhysicalDeviceDynamicRenderingFeaturesKHR supportedRendering{};
+        supportedRendering.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DYNAMIC_RENDERING_FEATURES_KHR;
+        supportedRendering.pNext = &supportedSync2;
+        if (!queryFeatures2(&supportedRendering) || !supportedRendering.dynamicRendering ||
+            !supportedSync2.synchronization2) {
+            return false;
+        }
+
+        rendering.dynamicRendering = VK_TRUE;
+        synchronization2.synchronization2 = VK_TRUE;
+        return true;
     }
 
 } // namespace vke
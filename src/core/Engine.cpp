@@ -1,6 +1,13 @@
 #include "core/Engine.h"
 #include "core/Device.h"
+#include "core/JobSystem.h"
+#include "core/Profiler.h"
+#include "gfx/GpuProfiler.h"
+#include "gfx/OffscreenTarget.h"
+#include "gfx/PipelineRegistry.h"
+#include "util/ImageUtils.h"
 
+#include <chrono>
 #include <stdexcept>
 #include <vector>
 #include <cstring>
@@ -9,12 +16,15 @@
 
 namespace vke {
 
-    Engine::Engine(std::string windowTitle, int width, int height)
+    Engine::Engine(std::string windowTitle, int width, int height, bool headless)
         : m_windowTitle(std::move(windowTitle))
         , m_width(width)
         , m_height(height)
+        , m_headless(headless)
     {
-        initWindow();
+        if (!m_headless) {
+            initWindow();
+        }
         initVulkan();
     }
 
@@ -23,9 +33,57 @@ namespace vke {
     }
 
     void Engine::run() const {
+        if (m_headless) {
+            throw std::runtime_error("Engine::run requires a window; use runHeadless instead!");
+        }
         mainLoop();
     }
 
+    void Engine::loadModel(const std::string& path) {
+        auto start = std::chrono::steady_clock::now();
+        m_renderer->loadModel(path);
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        std::cout << "Loaded " << path << " in " << ms << " ms\n";
+    }
+
+    double Engine::runHeadless(uint32_t frameCount, const std::string& dumpPath, const std::string& gpuTracePath) {
+        if (!m_headless) {
+            throw std::runtime_error("Engine::runHeadless requires headless mode!");
+        }
+        m_renderer->setReadbackEnabled(!dumpPath.empty());
+        GpuProfiler& gpuProfiler = m_renderer->getGpuProfiler();
+        gpuProfiler.setTraceCapture(!gpuTracePath.empty());
+
+        auto start = std::chrono::steady_clock::now();
+        for (uint32_t i = 0; i < frameCount; i++) {
+            m_renderer->drawFrame();
+            reportPipelineCache();
+            VKE_PROFILE_FRAME();
+        }
+        // Inclui o trabalho da GPU ainda em voo na medida
+        vkDeviceWaitIdle(m_device->device());
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        if (!dumpPath.empty()) {
+            std::vector<uint8_t> pixels;
+            if (m_renderer->readbackLastFrame(pixels)) {
+                VkExtent2D extent = m_renderer->getExtent();
+                writePPM(dumpPath, pixels, extent.width, extent.height);
+            }
+        }
+
+        // Com o device ocioso os últimos frames também podem ser lidos
+        gpuProfiler.flush();
+        reportGpuProfile();
+        if (!gpuTracePath.empty()) {
+            gpuProfiler.writeChromeTrace(gpuTracePath);
+            gpuProfiler.setTraceCapture(false);
+            std::cout << "GPU trace with " << gpuProfiler.getTraceEventCount() << " events written to "
+                      << gpuTracePath << "\n";
+        }
+        return seconds > 0.0 ? frameCount / seconds : 0.0;
+    }
+
     void Engine::initWindow() {
         if (!glfwInit()) {
             throw std::runtime_error("Failed to initialize GLFW!");
@@ -36,6 +94,19 @@ namespace vke {
         if (!m_window) {
             throw std::runtime_error("Failed to create GLFW window!");
         }
+
+        glfwSetWindowUserPointer(m_window, this);
+        glfwSetFramebufferSizeCallback(m_window, framebufferResizeCallback);
+    }
+
+    // Repassa o novo tamanho ao renderer; a recriação acontece no próximo drawFrame
+    void Engine::framebufferResizeCallback(GLFWwindow* window, int width, int height) {
+        auto* engine = static_cast<Engine*>(glfwGetWindowUserPointer(window));
+        engine->m_width = width;
+        engine->m_height = height;
+        if (engine->m_renderer && width > 0 && height > 0) {
+            engine->m_renderer->requestResize(static_cast<uint32_t>(width), static_cast<uint32_t>(height));
+        }
     }
 
     // Função opcional para verificar se a camada de validação desejada está disponível.
@@ -67,10 +138,14 @@ namespace vke {
         appInfo.engineVersion = VK_MAKE_VERSION(1, 0, 0);
         appInfo.apiVersion = VK_API_VERSION_1_0;
 
-        // Obtém as extensões necessárias a partir do GLFW
-        uint32_t glfwExtensionCount = 0;
-        const char** glfwExtensions = glfwGetRequiredInstanceExtensions(&glfwExtensionCount);
-        std::vector<const char*> extensions(glfwExtensions, glfwExtensions + glfwExtensionCount);
+        // Obtém as extensões necessárias a partir do GLFW (headless não precisa de nenhuma)
+        std::vector<const char*> extensions;
+        if (!m_headless) {
+            uint32_t glfwExtensionCount = 0;
+            const char** glfwExtensions = glfwGetRequiredInstanceExtensions(&glfwExtensionCount);
+            extensions.assign(glfwExtensions, glfwExtensions + glfwExtensionCount);
+        }
+        Device::appendInstanceExtensions(extensions);
 
         VkInstanceCreateInfo createInfo{};
         createInfo.sType = VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO;
@@ -102,12 +177,34 @@ namespace vke {
     }
 
     void Engine::initVulkan() {
+        VKE_PROFILE_THREAD("Main");
+        VKE_PROFILE_ZONE("initVulkan");
         createInstance();
+        m_jobs = std::make_unique<JobSystem>();
+        if (m_headless) {
+            // Sem surface o device dispensa a fila de apresentação e a extensão de swapchain
+            m_device = std::make_unique<Device>(m_instance, VK_NULL_HANDLE);
+            m_offscreenTarget = std::make_unique<OffscreenTarget>(
+                *m_device,
+                static_cast<uint32_t>(m_width),
+                static_cast<uint32_t>(m_height),
+                Renderer::kDefaultFramesInFlight
+            );
+            m_renderer = std::make_unique<Renderer>(
+                *m_device,
+                *m_jobs,
+                *m_offscreenTarget,
+                m_device->graphicsQueue(),
+                m_device->queueFamilies().graphicsFamily.value()
+            );
+            return;
+        }
+
         createSurface();
         // Cria o device a partir da instância e da surface criadas
         m_device = std::make_unique<Device>(m_instance, m_surface);
 
-        auto indices = m_device->findQueueFamilies(m_device->physicalDevice());
+        const auto& indices = m_device->queueFamilies();
         m_swapChain = std::make_unique<SwapChain>(
             m_device->device(),
             m_device->physicalDevice(),
@@ -119,27 +216,94 @@ namespace vke {
         );
 
         m_renderer = std::make_unique<Renderer>(
-            m_device->device(),
+            *m_device,
+            *m_jobs,
             *m_swapChain,
             m_device->graphicsQueue(),
             m_device->presentQueue(),
             indices.graphicsFamily.value()
         );
+    }
 
+    // Mostra o custo de criar os pipelines com o cache frio ou quente e já
+    // persiste o que foi compilado, sem esperar o shutdown. Chamado a cada frame:
+    // os pipelines iniciais compilam em segundo plano e os frames seguem sem eles,
+    // então o relatório sai uma vez, no primeiro frame com o registro ocioso
+    void Engine::reportPipelineCache() const {
+        if (m_pipelineCacheReported) {
+            return;
+        }
+        PipelineRegistryStats stats = m_device->pipelines().getStats();
+        if (stats.pendingCount > 0) {
+            return;
+        }
+        m_pipelineCacheReported = true;
+        const PipelineCache& cache = m_device->pipelineCache();
+        std::cout << stats.pipelineCount << " graphics pipeline(s) created in " << stats.compileMs << " ms ("
+                  << (cache.loadedFromDisk() ? "warm" : "cold") << " pipeline cache, "
+                  << cache.loadedBytes() << " bytes loaded, "
+                  << stats.hits << " registry hits / " << stats.misses << " misses)\n";
+        m_device->pipelineCache().save();
+    }
+
+    // Tempo de GPU por passe (e contadores, quando houver) do último frame lido
+    void Engine::reportGpuProfile() const {
+        const GpuProfiler& gpuProfiler = m_renderer->getGpuProfiler();
+        if (!gpuProfiler.isEnabled()) {
+            std::cout << "GPU profiler unavailable (no timestamp support on the graphics queue)\n";
+            return;
+        }
+        std::cout << "GPU passes of frame " << gpuProfiler.getLastResultsFrame() << ":\n";
+        for (const auto& scope : gpuProfiler.getLastResults()) {
+            std::cout << "  " << std::string(2 * scope.depth, ' ') << scope.name << ": " << scope.gpuMs << " ms";
+            if (scope.hasStatistics) {
+                const GpuPipelineStatistics& stats = scope.statistics;
+                std::cout << " (" << stats.inputPrimitives << " primitives, " << stats.vertexInvocations
+                          << " vertex / " << stats.fragmentInvocations << " fragment / "
+                          << stats.computeInvocations << " compute invocations)";
+            }
+            std::cout << "\n";
+        }
     }
 
     void Engine::mainLoop() const {
         while (!glfwWindowShouldClose(m_window)) {
-            glfwPollEvents();
+            {
+                VKE_PROFILE_ZONE("poll_events");
+                glfwPollEvents();
+            }
+
+            // Janela minimizada: não há swapchain válida com extensão zero
+            int width = 0, height = 0;
+            glfwGetFramebufferSize(m_window, &width, &height);
+            if (width == 0 || height == 0) {
+                glfwWaitEvents();
+                continue;
+            }
+
             // Chama o drawFrame do renderer
             m_renderer->drawFrame();
+            reportPipelineCache();
+            VKE_PROFILE_FRAME();
         }
     }
 
 
     void Engine::cleanup() {
+        // Sai antes de qualquer frame ter visto o registro ocioso: aqui já se pode esperar
+        if (m_device && m_renderer) {
+            m_device->pipelines().waitIdle();
+            reportPipelineCache();
+        }
+
+        // Renderer e swapchain dependem do device (e dos blocos do seu alocador)
+        m_renderer.reset();
+        m_swapChain.reset();
+        m_offscreenTarget.reset();
+
         // Destrói o device antes de destruir a surface e a instância
         m_device.reset();
+        m_jobs.reset();
 
         if (m_surface) {
             vkDestroySurfaceKHR(m_instance, m_surface, nullptr);
@@ -153,7 +317,9 @@ namespace vke {
             glfwDestroyWindow(m_window);
             m_window = nullptr;
         }
-        glfwTerminate();
+        if (!m_headless) {
+            glfwTerminate();
+        }
     }
 
 } // namespace vke
@@ -0,0 +1,224 @@
+#include "core/JobSystem.h"
+#include "core/Profiler.h"
+
+#include <algorithm>
+
+namespace vke {
+
+    namespace {
+
+        // Worker da thread atual (por sistema, caso existam vários)
+        thread_local const JobSystem* t_owner = nullptr;
+        thread_local uint32_t t_workerIndex = 0;
+
+        // Tentativas de roubo antes de um worker ocioso ir dormir
+        constexpr int kSpinsBeforeSleep = 64;
+
+    } // namespace
+
+    JobSystem::JobSystem(uint32_t threadCount) {
+        if (threadCount == 0) {
+            threadCount = std::max(1u, std::thread::hardware_concurrency());
+        }
+
+        m_queues.reserve(threadCount);
+        for (uint32_t i = 0; i < threadCount; i++) {
+            m_queues.push_back(std::make_unique<WorkerQueue>());
+        }
+
+        t_owner = this;
+        t_workerIndex = 0;
+        for (uint32_t i = 1; i < threadCount; i++) {
+            m_threads.emplace_back(&JobSystem::workerLoop, this, i);
+        }
+    }
+
+    JobSystem::~JobSystem() {
+        {
+            std::lock_guard lock(m_sleepMutex);
+            m_stopping.store(true);
+        }
+        m_sleepCv.notify_all();
+        for (auto& thread : m_threads) {
+            thread.join();
+        }
+        if (t_owner == this) {
+            t_owner = nullptr;
+        }
+    }
+
+    uint32_t JobSystem::currentWorkerIndex() const {
+        return t_owner == this ? t_workerIndex : 0;
+    }
+
+    void JobSystem::push(uint32_t worker, Job job, JobCounter* counter) {
+        {
+            std::lock_guard lock(m_queues[worker]->mutex);
+            m_queues[worker]->jobs.emplace_back(std::move(job), counter);
+        }
+        m_queuedJobs.fetch_add(1, std::memory_order_release);
+
+        // Par com a cerca de workerLoop: ou o worker que vai dormir já vê o job no
+        // predicado, ou aqui já se vê o worker dormindo. Só então o mutex é tocado,
+        // para que um worker entre o teste do predicado e o wait não perca o aviso.
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (m_sleepingWorkers.load(std::memory_order_relaxed) > 0) {
+            {
+                std::lock_guard sleepLock(m_sleepMutex);
+            }
+            m_sleepCv.notify_one();
+        }
+    }
+
+    void JobSystem::run(Job job, JobCounter* counter) {
+        if (counter) {
+            counter->m_value.fetch_add(1, std::memory_order_relaxed);
+        }
+        push(currentWorkerIndex(), std::move(job), counter);
+    }
+
+    void JobSystem::runAfter(JobCounter& dependency, Job job, JobCounter* counter) {
+        if (counter) {
+            counter->m_value.fetch_add(1, std::memory_order_relaxed);
+        }
+        {
+            // Sob o lock do contador: ou ele ainda não zerou e finish() vai ver a
+            // continuação, ou já zerou e o job é lançado agora
+            std::lock_guard lock(dependency.m_mutex);
+            if (!dependency.done()) {
+                dependency.m_continuations.emplace_back(std::move(job), counter);
+                return;
+            }
+        }
+        push(currentWorkerIndex(), std::move(job), counter);
+    }
+
+    void JobSystem::finish(JobCounter* counter) {
+        if (!counter) {
+            return;
+        }
+
+        // Decrementos intermediários não tocam o mutex
+        uint32_t value = counter->m_value.load(std::memory_order_relaxed);
+        while (value > 1) {
+            if (counter->m_value.compare_exchange_weak(value, value - 1, std::memory_order_acq_rel)) {
+                return;
+            }
+        }
+
+        // O último decremento acontece sob o lock: wait() passa pelo mesmo lock
+        // antes de retornar, então o contador não é destruído enquanto o usamos
+        std::vector<std::pair<Job, JobCounter*>> continuations;
+        {
+            std::lock_guard lock(counter->m_mutex);
+            counter->m_value.fetch_sub(1, std::memory_order_acq_rel);
+            continuations.swap(counter->m_continuations);
+        }
+        for (auto& [job, next] : continuations) {
+            push(currentWorkerIndex(), std::move(job), next);
+        }
+    }
+
+    bool JobSystem::tryExecuteOne(uint32_t worker) {
+        std::pair<Job, JobCounter*> entry;
+        bool found = false;
+
+        // Primeiro a própria fila, pelo fim (LIFO: dados ainda quentes no cache)
+        {
+            WorkerQueue& own = *m_queues[worker];
+            std::lock_guard lock(own.mutex);
+            if (!own.jobs.empty()) {
+                entry = std::move(own.jobs.back());
+                own.jobs.pop_back();
+                found = true;
+            }
+        }
+
+        // Depois rouba do início da fila dos outros (FIFO: os jobs mais antigos/maiores)
+        auto count = static_cast<uint32_t>(m_queues.size());
+        for (uint32_t i = 1; !found && i < count; i++) {
+            WorkerQueue& victim = *m_queues[(worker + i) % count];
+            std::lock_guard lock(victim.mutex);
+            if (!victim.jobs.empty()) {
+                entry = std::move(victim.jobs.front());
+                victim.jobs.pop_front();
+                found = true;
+                m_stolen.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+
+        if (!found) {
+            return false;
+        }
+
+        m_queuedJobs.fetch_sub(1, std::memory_order_relaxed);
+        entry.first();
+        m_executed.fetch_add(1, std::memory_order_relaxed);
+        finish(entry.second);
+        return true;
+    }
+
+    void JobSystem::wait(const JobCounter& counter) {
+        uint32_t worker = currentWorkerIndex();
+        while (!counter.done()) {
+            if (!tryExecuteOne(worker)) {
+                // Os jobs restantes estão rodando em outras threads
+                std::this_thread::yield();
+            }
+        }
+        // Sincroniza com o finish() que zerou o contador (ver acima)
+        std::lock_guard lock(counter.m_mutex);
+    }
+
+    void JobSystem::parallelFor(uint32_t count, uint32_t grainSize,
+                                const std::function<void(uint32_t, uint32_t)>& body) {
+        if (count == 0) {
+            return;
+        }
+        grainSize = std::max(grainSize, 1u);
+        if (count <= grainSize) {
+            body(0, count);
+            return;
+        }
+
+        JobCounter counter;
+        for (uint32_t begin = 0; begin < count; begin += grainSize) {
+            uint32_t end = std::min(begin + grainSize, count);
+            run([&body, begin, end] { body(begin, end); }, &counter);
+        }
+        wait(counter);
+    }
+
+    JobSystemStats JobSystem::getStats() const {
+        return JobSystemStats{ m_executed.load(std::memory_order_relaxed), m_stolen.load(std::memory_order_relaxed) };
+    }
+
+    void JobSystem::workerLoop(uint32_t worker) {
+        t_owner = this;
+        t_workerIndex = worker;
+        VKE_PROFILE_THREAD("Job worker " + std::to_string(worker));
+
+        int idleSpins = 0;
+        while (!m_stopping.load(std::memory_order_acquire)) {
+            if (tryExecuteOne(worker)) {
+                idleSpins = 0;
+                continue;
+            }
+            if (++idleSpins < kSpinsBeforeSleep) {
+                std::this_thread::yield();
+                continue;
+            }
+
+            std::unique_lock lock(m_sleepMutex);
+            m_sleepingWorkers.fetch_add(1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            m_sleepCv.wait(lock, [this] {
+                return m_stopping.load(std::memory_order_acquire) ||
+                       m_queuedJobs.load(std::memory_order_acquire) > 0;
+            });
+            m_sleepingWorkers.fetch_sub(1, std::memory_order_relaxed);
+            idleSpins = 0;
+        }
+    }
+
+} // namespace vke
@@ -0,0 +1,446 @@
+#include "core/MemoryAllocator.h"
+#include "core/Profiler.h"
+
+#include <algorithm>
+#include <bit>
+#include <stdexcept>
+
+namespace vke {
+
+    namespace {
+
+        VkDeviceSize alignUp(VkDeviceSize value, VkDeviceSize alignment) {
+            return alignment == 0 ? value : (value + alignment - 1) & ~(alignment - 1);
+        }
+
+        VkDeviceSize alignDown(VkDeviceSize value, VkDeviceSize alignment) {
+            return alignment == 0 ? value : value & ~(alignment - 1);
+        }
+
+    } // namespace
+
+    // ------------------------------------------------------
+    // LinearBlockAllocator
+    // ------------------------------------------------------
+    LinearBlockAllocator::LinearBlockAllocator(VkDeviceSize capacity)
+        : m_capacity(capacity)
+    {}
+
+    bool LinearBlockAllocator::allocate(VkDeviceSize size, VkDeviceSize alignment, VkDeviceSize& outOffset) {
+        VkDeviceSize offset = alignUp(m_head, alignment);
+        if (offset + size > m_capacity) {
+            return false;
+        }
+        outOffset = offset;
+        m_head = offset + size;
+        m_requested += size;
+        m_liveCount++;
+        return true;
+    }
+
+    void LinearBlockAllocator::free(VkDeviceSize /*offset*/, VkDeviceSize size) {
+        m_requested -= size;
+        // Só recicla o bloco inteiro quando a última alocação sai
+        if (--m_liveCount == 0) {
+            m_head = 0;
+        }
+    }
+
+    MemoryStats LinearBlockAllocator::stats() const {
+        MemoryStats stats{};
+        stats.blockCount = 1;
+        stats.allocationCount = m_liveCount;
+        stats.blockBytes = m_capacity;
+        stats.usedBytes = m_head;
+        stats.requestedBytes = m_requested;
+        stats.freeBytes = m_capacity - m_head;
+        stats.largestFreeRange = m_capacity - m_head;
+        return stats;
+    }
+
+    // ------------------------------------------------------
+    // BuddyBlockAllocator
+    // ------------------------------------------------------
+    BuddyBlockAllocator::BuddyBlockAllocator(VkDeviceSize capacity, VkDeviceSize minBlockSize)
+        : m_capacity(capacity)
+    {
+        if (!std::has_single_bit(capacity) || !std::has_single_bit(minBlockSize) || minBlockSize > capacity) {
+            throw std::runtime_error("Buddy allocator sizes must be powers of two!");
+        }
+
+        m_minShift = static_cast<uint32_t>(std::countr_zero(minBlockSize));
+        m_orderCount = static_cast<uint32_t>(std::countr_zero(capacity)) - m_minShift + 1;
+
+        m_freeLists.resize(m_orderCount);
+        m_freeBits.resize(m_orderCount);
+        for (uint32_t order = 0; order < m_orderCount; order++) {
+            VkDeviceSize blocksInOrder = capacity >> (m_minShift + order);
+            m_freeBits[order].assign((blocksInOrder + 63) / 64, 0);
+        }
+        m_allocOrder.assign(capacity >> m_minShift, 0xFF);
+
+        // Começa com um único bloco livre da maior ordem
+        setFree(m_orderCount - 1, 0, true);
+        m_freeLists[m_orderCount - 1].push_back(0);
+    }
+
+    bool BuddyBlockAllocator::isFree(uint32_t order, VkDeviceSize offset) const {
+        VkDeviceSize index = offset >> (m_minShift + order);
+        return (m_freeBits[order][index >> 6] >> (index & 63)) & 1u;
+    }
+
+    void BuddyBlockAllocator::setFree(uint32_t order, VkDeviceSize offset, bool value) {
+        VkDeviceSize index = offset >> (m_minShift + order);
+        uint64_t mask = 1ull << (index & 63);
+        if (value) {
+            m_freeBits[order][index >> 6] |= mask;
+        } else {
+            m_freeBits[order][index >> 6] &= ~mask;
+        }
+    }
+
+    bool BuddyBlockAllocator::allocate(VkDeviceSize size, VkDeviceSize alignment, VkDeviceSize& outOffset) {
+        // Blocos buddy são naturalmente alinhados ao próprio tamanho
+        VkDeviceSize needed = std::bit_ceil(std::max({ size, alignment, VkDeviceSize{1} << m_minShift }));
+        uint32_t order = static_cast<uint32_t>(std::countr_zero(needed)) - m_minShift;
+        if (order >= m_orderCount) {
+            return false;
+        }
+
+        // Procura a menor ordem com um bloco livre válido
+        uint32_t found = order;
+        VkDeviceSize offset = 0;
+        bool hasBlock = false;
+        for (; found < m_orderCount && !hasBlock; found++) {
+            auto& list = m_freeLists[found];
+            while (!list.empty()) {
+                VkDeviceSize candidate = list.back();
+                list.pop_back();
+                if (isFree(found, candidate)) {
+                    offset = candidate;
+                    hasBlock = true;
+                    break;
+                }
+            }
+        }
+        if (!hasBlock) {
+            return false;
+        }
+        found--;
+
+        // Divide até chegar na ordem pedida, devolvendo as metades superiores
+        setFree(found, offset, false);
+        while (found > order) {
+            found--;
+            VkDeviceSize buddy = offset + (VkDeviceSize{1} << (m_minShift + found));
+            setFree(found, buddy, true);
+            m_freeLists[found].push_back(buddy);
+        }
+
+        m_allocOrder[offset >> m_minShift] = static_cast<uint8_t>(order);
+        m_usedBytes += needed;
+        m_requested += size;
+        m_liveCount++;
+        outOffset = offset;
+        return true;
+    }
+
+    void BuddyBlockAllocator::free(VkDeviceSize offset, VkDeviceSize size) {
+        uint8_t& slot = m_allocOrder[offset >> m_minShift];
+        if (slot == 0xFF) {
+            throw std::runtime_error("Buddy allocator: double free or invalid offset!");
+        }
+        uint32_t order = slot;
+        slot = 0xFF;
+
+        m_usedBytes -= VkDeviceSize{1} << (m_minShift + order);
+        m_requested -= size;
+        m_liveCount--;
+
+        // Funde com o buddy enquanto ele também estiver livre
+        while (order + 1 < m_orderCount) {
+            VkDeviceSize buddy = offset ^ (VkDeviceSize{1} << (m_minShift + order));
+            if (!isFree(order, buddy)) {
+                break;
+            }
+            setFree(order, buddy, false);
+            offset = std::min(offset, buddy);
+            order++;
+        }
+
+        setFree(order, offset, true);
+        m_freeLists[order].push_back(offset);
+    }
+
+    MemoryStats BuddyBlockAllocator::stats() const {
+        MemoryStats stats{};
+        stats.blockCount = 1;
+        stats.allocationCount = m_liveCount;
+        stats.blockBytes = m_capacity;
+        stats.usedBytes = m_usedBytes;
+        stats.requestedBytes = m_requested;
+        stats.freeBytes = m_capacity - m_usedBytes;
+
+        for (uint32_t order = m_orderCount; order-- > 0;) {
+            const auto& bits = m_freeBits[order];
+            if (std::any_of(bits.begin(), bits.end(), [](uint64_t word) { return word != 0; })) {
+                stats.largestFreeRange = VkDeviceSize{1} << (m_minShift + order);
+                break;
+            }
+        }
+        return stats;
+    }
+
+    // ------------------------------------------------------
+    // MemoryAllocator
+    // ------------------------------------------------------
+    MemoryAllocator::MemoryAllocator(VkDevice device,
+                                     const VkPhysicalDeviceMemoryProperties& memoryProperties,
+                                     const VkPhysicalDeviceLimits& limits,
+                                     VkDeviceSize preferredBlockSize)
+        : m_device(device)
+        , m_memoryProperties(memoryProperties)
+        , m_nonCoherentAtomSize(std::max<VkDeviceSize>(limits.nonCoherentAtomSize, 1))
+        , m_bufferImageGranularity(std::max<VkDeviceSize>(limits.bufferImageGranularity, 1))
+        , m_preferredBlockSize(std::bit_floor(preferredBlockSize))
+        , m_pools(memoryProperties.memoryTypeCount)
+    {}
+
+    MemoryAllocator::~MemoryAllocator() {
+        // Alocações dedicadas ainda vivas são responsabilidade de quem as criou;
+        // aqui só liberamos os blocos que o próprio alocador reservou.
+        for (auto& pool : m_pools) {
+            for (auto& block : pool.blocks) {
+                if (block.memory != VK_NULL_HANDLE) {
+                    vkFreeMemory(m_device, block.memory, nullptr);
+                }
+            }
+        }
+    }
+
+    uint32_t MemoryAllocator::findMemoryType(uint32_t typeFilter, VkMemoryPropertyFlags properties) const {
+        for (uint32_t i = 0; i < m_memoryProperties.memoryTypeCount; ++i) {
+            if ((typeFilter & (1u << i)) &&
+                (m_memoryProperties.memoryTypes[i].propertyFlags & properties) == properties) {
+                return i;
+            }
+        }
+        throw std::runtime_error("Failed to find suitable memory type!");
+    }
+
+    // Heaps pequenos (ex.: a janela BAR de 256 MB) recebem blocos proporcionalmente menores
+    VkDeviceSize MemoryAllocator::blockSizeFor(uint32_t memoryType) const {
+        uint32_t heapIndex = m_memoryProperties.memoryTypes[memoryType].heapIndex;
+        VkDeviceSize heapSize = m_memoryProperties.memoryHeaps[heapIndex].size;
+        VkDeviceSize limit = std::bit_floor(std::max<VkDeviceSize>(heapSize / 8, 1024 * 1024));
+        return std::min(m_preferredBlockSize, limit);
+    }
+
+    VkDeviceMemory MemoryAllocator::allocateDeviceMemory(uint32_t memoryType, VkDeviceSize size, void** outMapped) {
+        VKE_PROFILE_ZONE("vkAllocateMemory");
+        VkMemoryAllocateInfo allocInfo{};
+        allocInfo.sType           = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+        allocInfo.allocationSize  = size;
+        allocInfo.memoryTypeIndex = memoryType;
+
+        VkDeviceMemory memory = VK_NULL_HANDLE;
+        if (vkAllocateMemory(m_device, &allocInfo, nullptr, &memory) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to allocate device memory block!");
+        }
+
+        // Memória visível ao host fica mapeada durante toda a vida do bloco:
+        // um VkDeviceMemory só pode ser mapeado uma vez, e as sub-alocações o compartilham
+        *outMapped = nullptr;
+        if (m_memoryProperties.memoryTypes[memoryType].propertyFlags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT) {
+            if (vkMapMemory(m_device, memory, 0, VK_WHOLE_SIZE, 0, outMapped) != VK_SUCCESS) {
+                vkFreeMemory(m_device, memory, nullptr);
+                throw std::runtime_error("Failed to map device memory block!");
+            }
+        }
+        return memory;
+    }
+
+    MemoryAllocation MemoryAllocator::allocate(const VkMemoryRequirements& requirements,
+                                               VkMemoryPropertyFlags properties,
+                                               AllocationStrategy strategy) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        MemoryAllocation allocation{};
+        allocation.memoryType = findMemoryType(requirements.memoryTypeBits, properties);
+        allocation.size = requirements.size;
+        allocation.strategy = strategy;
+
+        MemoryTypePool& pool = m_pools[allocation.memoryType];
+        VkDeviceSize blockSize = blockSizeFor(allocation.memoryType);
+
+        // Recursos grandes ganham uma alocação dedicada em vez de ocupar metade de um bloco
+        if (requirements.size > blockSize / 2) {
+            allocation.memory = allocateDeviceMemory(allocation.memoryType, requirements.size, &allocation.mapped);
+            allocation.blockIndex = UINT32_MAX;
+            pool.dedicatedCount++;
+            pool.dedicatedBytes += requirements.size;
+            return allocation;
+        }
+
+        auto tryBlock = [&](uint32_t index) {
+            MemoryBlock& block = pool.blocks[index];
+            VkDeviceSize offset = 0;
+            if (block.memory == VK_NULL_HANDLE || block.strategy != strategy ||
+                !block.allocator->allocate(requirements.size, requirements.alignment, offset)) {
+                return false;
+            }
+            allocation.memory = block.memory;
+            allocation.offset = offset;
+            allocation.blockIndex = index;
+            allocation.mapped = block.mapped ? static_cast<char*>(block.mapped) + offset : nullptr;
+            return true;
+        };
+
+        for (uint32_t i = 0; i < pool.blocks.size(); i++) {
+            if (tryBlock(i)) {
+                return allocation;
+            }
+        }
+
+        // Nenhum bloco comporta: reserva um novo (reaproveitando um slot liberado, se houver)
+        MemoryBlock block{};
+        block.size = blockSize;
+        block.strategy = strategy;
+        block.memory = allocateDeviceMemory(allocation.memoryType, blockSize, &block.mapped);
+        if (strategy == AllocationStrategy::Linear) {
+            block.allocator = std::make_unique<LinearBlockAllocator>(blockSize);
+        } else {
+            block.allocator = std::make_unique<BuddyBlockAllocator>(blockSize);
+        }
+
+        auto freeSlot = std::find_if(pool.blocks.begin(), pool.blocks.end(),
+                                     [](const MemoryBlock& b) { return b.memory == VK_NULL_HANDLE; });
+        uint32_t index = static_cast<uint32_t>(freeSlot - pool.blocks.begin());
+        if (freeSlot == pool.blocks.end()) {
+            pool.blocks.push_back(std::move(block));
+        } else {
+            *freeSlot = std::move(block);
+        }
+
+        if (!tryBlock(index)) {
+            throw std::runtime_error("Failed to sub-allocate from a fresh memory block!");
+        }
+        return allocation;
+    }
+
+    MemoryAllocation MemoryAllocator::allocateForImage(VkImage image, VkMemoryPropertyFlags properties) {
+        VkMemoryRequirements requirements;
+        vkGetImageMemoryRequirements(m_device, image, &requirements);
+
+        requirements.alignment = std::max(requirements.alignment, m_bufferImageGranularity);
+        requirements.size = alignUp(requirements.size, m_bufferImageGranularity);
+        return allocate(requirements, properties, AllocationStrategy::Buddy);
+    }
+
+    void MemoryAllocator::free(MemoryAllocation& allocation) {
+        if (!allocation.valid()) {
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        MemoryTypePool& pool = m_pools[allocation.memoryType];
+
+        if (allocation.blockIndex == UINT32_MAX) {
+            vkFreeMemory(m_device, allocation.memory, nullptr);
+            pool.dedicatedCount--;
+            pool.dedicatedBytes -= allocation.size;
+        } else {
+            MemoryBlock& block = pool.blocks[allocation.blockIndex];
+            block.allocator->free(allocation.offset, allocation.size);
+            if (block.allocator->empty()) {
+                releaseBlock(allocation.memoryType, allocation.blockIndex);
+            }
+        }
+
+        allocation = MemoryAllocation{};
+    }
+
+    // Mantém no máximo um bloco vazio por tipo para evitar ciclos de alocar/liberar
+    void MemoryAllocator::releaseBlock(uint32_t memoryType, uint32_t blockIndex) {
+        MemoryTypePool& pool = m_pools[memoryType];
+        bool hasOtherEmpty = false;
+        for (uint32_t i = 0; i < pool.blocks.size(); i++) {
+            const MemoryBlock& other = pool.blocks[i];
+            if (i != blockIndex && other.memory != VK_NULL_HANDLE && other.allocator->empty()) {
+                hasOtherEmpty = true;
+                break;
+            }
+        }
+        if (!hasOtherEmpty) {
+            return;
+        }
+
+        MemoryBlock& block = pool.blocks[blockIndex];
+        vkFreeMemory(m_device, block.memory, nullptr);
+        block = MemoryBlock{};
+    }
+
+    void MemoryAllocator::flush(const MemoryAllocation& allocation, VkDeviceSize offset, VkDeviceSize size) const {
+        const VkMemoryPropertyFlags flags = m_memoryProperties.memoryTypes[allocation.memoryType].propertyFlags;
+        if (!allocation.valid() || (flags & VK_MEMORY_PROPERTY_HOST_COHERENT_BIT)) {
+            return;
+        }
+
+        VkDeviceSize memorySize = allocation.size;
+        if (allocation.blockIndex != UINT32_MAX) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            memorySize = m_pools[allocation.memoryType].blocks[allocation.blockIndex].size;
+        }
+
+        // Faixas não coerentes precisam estar alinhadas a nonCoherentAtomSize
+        VkDeviceSize begin = alignDown(allocation.offset + offset, m_nonCoherentAtomSize);
+        VkDeviceSize end = alignUp(allocation.offset + offset + size, m_nonCoherentAtomSize);
+
+        VkMappedMemoryRange range{};
+        range.sType  = VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE;
+        range.memory = allocation.memory;
+        range.offset = begin;
+        range.size   = end >= memorySize ? VK_WHOLE_SIZE : end - begin;
+        vkFlushMappedMemoryRanges(m_device, 1, &range);
+    }
+
+    void MemoryAllocator::accumulateStats(uint32_t memoryType, MemoryStats& stats) const {
+        const MemoryTypePool& pool = m_pools[memoryType];
+        for (const auto& block : pool.blocks) {
+            if (block.memory == VK_NULL_HANDLE) {
+                continue;
+            }
+            MemoryStats blockStats = block.allocator->stats();
+            stats.blockCount++;
+            stats.allocationCount += blockStats.allocationCount;
+            stats.blockBytes += blockStats.blockBytes;
+            stats.usedBytes += blockStats.usedBytes;
+            stats.requestedBytes += blockStats.requestedBytes;
+            stats.freeBytes += blockStats.freeBytes;
+            stats.largestFreeRange = std::max(stats.largestFreeRange, blockStats.largestFreeRange);
+        }
+
+        stats.dedicatedCount += pool.dedicatedCount;
+        stats.allocationCount += pool.dedicatedCount;
+        stats.blockBytes += pool.dedicatedBytes;
+        stats.usedBytes += pool.dedicatedBytes;
+        stats.requestedBytes += pool.dedicatedBytes;
+    }
+
+    MemoryStats MemoryAllocator::getStats(uint32_t memoryType) const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        MemoryStats stats{};
+        accumulateStats(memoryType, stats);
+        return stats;
+    }
+
+    MemoryStats MemoryAllocator::getStats() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        MemoryStats stats{};
+        for (uint32_t type = 0; type < m_pools.size(); type++) {
+            accumulateStats(type, stats);
+        }
+        return stats;
+    }
+
+} // namespace vke
@@ -0,0 +1,176 @@
+#include "core/PipelineCache.h"
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+
+namespace vke {
+
+    namespace {
+
+        constexpr uint32_t kMagic = 0x43505856; // "VXPC"
+        constexpr uint32_t kFormatVersion = 1;
+
+        // Cabeçalho gravado antes do blob retornado por vkGetPipelineCacheData
+        struct FileHeader {
+            uint32_t magic;
+            uint32_t version;
+            uint32_t vendorID;
+            uint32_t deviceID;
+            uint32_t driverVersion;
+            uint8_t pipelineCacheUUID[VK_UUID_SIZE];
+            uint32_t reserved; // mantém os campos de 64 bits alinhados sem padding implícito
+            uint64_t dataSize;
+            uint64_t checksum;
+        };
+
+        // FNV-1a 64 bits: detecta arquivos truncados ou corrompidos
+        uint64_t checksum(const char* data, size_t size) {
+            uint64_t hash = 14695981039346656037ull;
+            for (size_t i = 0; i < size; i++) {
+                hash = (hash ^ static_cast<unsigned char>(data[i])) * 1099511628211ull;
+            }
+            return hash;
+        }
+
+    } // namespace
+
+    PipelineCache::PipelineCache(VkDevice device, const VkPhysicalDeviceProperties& properties, std::string path)
+        : m_device(device)
+        , m_properties(properties)
+        , m_path(std::move(path))
+    {
+        std::string initialData = readValidatedFile();
+
+        VkPipelineCacheCreateInfo createInfo{};
+        createInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+        createInfo.initialDataSize = initialData.size();
+        createInfo.pInitialData = initialData.empty() ? nullptr : initialData.data();
+
+        if (vkCreatePipelineCache(m_device, &createInfo, nullptr, &m_cache) != VK_SUCCESS) {
+            // O driver ainda pode recusar o blob; tenta de novo com o cache vazio
+            createInfo.initialDataSize = 0;
+            createInfo.pInitialData = nullptr;
+            if (vkCreatePipelineCache(m_device, &createInfo, nullptr, &m_cache) != VK_SUCCESS) {
+                throw std::runtime_error("Failed to create pipeline cache!");
+            }
+            initialData.clear();
+        }
+
+        m_loadedBytes = initialData.size();
+        m_savedBytes = initialData.size();
+    }
+
+    PipelineCache::~PipelineCache() {
+        if (m_cache == VK_NULL_HANDLE) {
+            return;
+        }
+        // Destrutor não pode lançar: uma falha ao salvar só custa o próximo warm start
+        try {
+            save();
+        } catch (const std::exception& e) {
+            std::cerr << "Pipeline cache not saved: " << e.what() << std::endl;
+        }
+        vkDestroyPipelineCache(m_device, m_cache, nullptr);
+    }
+
+    std::string PipelineCache::readValidatedFile() const {
+        if (m_path.empty()) {
+            return {};
+        }
+
+        std::ifstream file(m_path, std::ios::binary);
+        if (!file.is_open()) {
+            return {};
+        }
+
+        FileHeader header{};
+        if (!file.read(reinterpret_cast<char*>(&header), sizeof(header))) {
+            return {};
+        }
+
+        bool matches = header.magic == kMagic &&
+                       header.version == kFormatVersion &&
+                       header.vendorID == m_properties.vendorID &&
+                       header.deviceID == m_properties.deviceID &&
+                       header.driverVersion == m_properties.driverVersion &&
+                       std::memcmp(header.pipelineCacheUUID, m_properties.pipelineCacheUUID, VK_UUID_SIZE) == 0;
+        if (!matches) {
+            return {};
+        }
+
+        // O tamanho do cabeçalho só é confiável se bater com o arquivo: um arquivo
+        // truncado ou corrompido custa um cold start, não uma alocação gigante
+        std::error_code error;
+        uintmax_t fileSize = std::filesystem::file_size(m_path, error);
+        if (error || fileSize < sizeof(FileHeader) || header.dataSize != fileSize - sizeof(FileHeader)) {
+            return {};
+        }
+
+        std::string data(static_cast<size_t>(header.dataSize), '\0');
+        if (!file.read(data.data(), static_cast<std::streamsize>(data.size())) ||
+            checksum(data.data(), data.size()) != header.checksum) {
+            return {};
+        }
+        return data;
+    }
+
+    void PipelineCache::save() {
+        if (m_path.empty()) {
+            return;
+        }
+
+        size_t dataSize = 0;
+        if (vkGetPipelineCacheData(m_device, m_cache, &dataSize, nullptr) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to query pipeline cache size!");
+        }
+        // O cache só cresce; mesmo tamanho significa que nada novo foi compilado
+        if (dataSize == 0 || dataSize == m_savedBytes) {
+            return;
+        }
+
+        std::vector<char> data(dataSize);
+        if (vkGetPipelineCacheData(m_device, m_cache, &dataSize, data.data()) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to read pipeline cache data!");
+        }
+        data.resize(dataSize);
+
+        FileHeader header{};
+        header.magic = kMagic;
+        header.version = kFormatVersion;
+        header.vendorID = m_properties.vendorID;
+        header.deviceID = m_properties.deviceID;
+        header.driverVersion = m_properties.driverVersion;
+        std::memcpy(header.pipelineCacheUUID, m_properties.pipelineCacheUUID, VK_UUID_SIZE);
+        header.dataSize = dataSize;
+        header.checksum = checksum(data.data(), data.size());
+
+        std::string tempPath = m_path + ".tmp";
+        {
+            std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+            if (!file.is_open()) {
+                throw std::runtime_error("Failed to open " + tempPath + " for writing!");
+            }
+            file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            file.write(data.data(), static_cast<std::streamsize>(data.size()));
+            file.flush();
+            file.close();
+            if (!file) {
+                throw std::runtime_error("Failed to write " + tempPath + "!");
+            }
+        }
+
+        // rename substitui o arquivo antigo atomicamente
+        std::error_code error;
+        std::filesystem::rename(tempPath, m_path, error);
+        if (error) {
+            std::filesystem::remove(tempPath, error);
+            throw std::runtime_error("Failed to replace " + m_path + "!");
+        }
+        m_savedBytes = dataSize;
+    }
+
+} // namespace vke
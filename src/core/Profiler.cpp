@@ -0,0 +1,240 @@
+#include "core/Profiler.h"
+#include "util/Json.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+namespace vke {
+
+    std::atomic<bool> CpuProfiler::s_capturing{ false };
+
+    namespace {
+
+        enum class EventType : uint8_t { Zone, Counter, Frame };
+
+        struct Event {
+            const char* name;
+            uint64_t start;
+            uint64_t end;   // zonas
+            double value;   // contadores
+            EventType type;
+        };
+
+        // Ring de uma thread: só ela escreve (head), só quem drena lê (tail)
+        struct ThreadRing {
+            alignas(64) std::atomic<uint32_t> head{ 0 };
+            alignas(64) std::atomic<uint32_t> tail{ 0 };
+            std::atomic<uint64_t> dropped{ 0 };
+            uint32_t threadId = 0;
+            std::string name;   // protegido pelo mutex do registro
+            std::unique_ptr<Event[]> events{ new Event[CpuProfiler::kRingCapacity] };
+        };
+
+        struct CapturedEvent {
+            Event event;
+            uint32_t threadId;
+        };
+
+        // Rings de todas as threads que já gravaram algo; vivem até o fim do
+        // processo, então uma thread pode terminar com eventos ainda não drenados
+        struct Registry {
+            std::mutex mutex;
+            std::vector<std::unique_ptr<ThreadRing>> rings;
+            std::vector<CapturedEvent> captured;
+            size_t maxEvents = CpuProfiler::kDefaultMaxCapturedEvents;
+            uint64_t dropped = 0;
+            uint64_t captureStart = 0;
+
+            // Par (ticks, relógio) para converter ticks do rdtsc em microssegundos
+            uint64_t calibrationTicks = CpuProfiler::now();
+            std::chrono::steady_clock::time_point calibrationTime = std::chrono::steady_clock::now();
+        };
+
+        Registry& registry() {
+            static Registry instance;
+            return instance;
+        }
+
+        thread_local ThreadRing* t_ring = nullptr;
+
+        ThreadRing& threadRing() {
+            if (!t_ring) {
+                Registry& reg = registry();
+                std::lock_guard lock(reg.mutex);
+                reg.rings.push_back(std::make_unique<ThreadRing>());
+                t_ring = reg.rings.back().get();
+                t_ring->threadId = static_cast<uint32_t>(reg.rings.size());
+            }
+            return *t_ring;
+        }
+
+        void push(const Event& event) {
+            ThreadRing& ring = threadRing();
+            uint32_t head = ring.head.load(std::memory_order_relaxed);
+            if (head - ring.tail.load(std::memory_order_acquire) >= CpuProfiler::kRingCapacity) {
+                ring.dropped.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+            ring.events[head & (CpuProfiler::kRingCapacity - 1)] = event;
+            ring.head.store(head + 1, std::memory_order_release);
+        }
+
+        // Com o mutex do registro; keep = false só libera o espaço dos rings
+        void drain(Registry& reg, bool keep) {
+            for (auto& ring : reg.rings) {
+                uint32_t head = ring->head.load(std::memory_order_acquire);
+                uint32_t tail = ring->tail.load(std::memory_order_relaxed);
+                for (; keep && tail != head; tail++) {
+                    if (reg.captured.size() >= reg.maxEvents) {
+                        reg.dropped += head - tail;
+                        break;
+                    }
+                    reg.captured.push_back({ ring->events[tail & (CpuProfiler::kRingCapacity - 1)], ring->threadId });
+                }
+                ring->tail.store(head, std::memory_order_release);
+            }
+        }
+
+        double microsecondsPerTick(Registry& reg) {
+#if VKE_PROFILER_RDTSC
+            // Calibra contra o steady_clock desde a criação do registro; um
+            // intervalo curto demais daria uma razão imprecisa
+            using Clock = std::chrono::steady_clock;
+            while (Clock::now() - reg.calibrationTime < std::chrono::milliseconds(10)) {
+            }
+            uint64_t ticks = CpuProfiler::now();
+            double elapsedUs = std::chrono::duration<double, std::micro>(Clock::now() - reg.calibrationTime).count();
+            return ticks > reg.calibrationTicks ? elapsedUs / static_cast<double>(ticks - reg.calibrationTicks) : 0.0;
+#else
+            (void)reg;
+            using Period = std::chrono::steady_clock::period;
+            return 1e6 * static_cast<double>(Period::num) / static_cast<double>(Period::den);
+#endif
+        }
+
+    } // namespace
+
+    void CpuProfiler::setCapture(bool enabled, size_t maxEvents) {
+        Registry& reg = registry();
+        std::lock_guard lock(reg.mutex);
+        if (enabled) {
+            // Eventos de antes da captura não entram no trace
+            drain(reg, false);
+            reg.captured.clear();
+            reg.maxEvents = maxEvents;
+            reg.dropped = 0;
+            for (auto& ring : reg.rings) {
+                ring->dropped.store(0, std::memory_order_relaxed);
+            }
+            reg.captureStart = now();
+        } else {
+            drain(reg, true);
+        }
+        s_capturing.store(enabled, std::memory_order_relaxed);
+    }
+
+    void CpuProfiler::setThreadName(const std::string& name) {
+        ThreadRing& ring = threadRing();
+        std::lock_guard lock(registry().mutex);
+        ring.name = name;
+    }
+
+    void CpuProfiler::zone(const char* name, uint64_t start, uint64_t end) {
+        push({ name, start, end, 0.0, EventType::Zone });
+    }
+
+    void CpuProfiler::counter(const char* name, double value) {
+        push({ name, now(), 0, value, EventType::Counter });
+    }
+
+    void CpuProfiler::frameMark(const char* name) {
+        if (!isCapturing()) {
+            return;
+        }
+        push({ name, now(), 0, 0.0, EventType::Frame });
+        collect();
+    }
+
+    void CpuProfiler::collect() {
+        Registry& reg = registry();
+        std::lock_guard lock(reg.mutex);
+        drain(reg, true);
+    }
+
+    size_t CpuProfiler::getEventCount() {
+        Registry& reg = registry();
+        std::lock_guard lock(reg.mutex);
+        return reg.captured.size();
+    }
+
+    uint64_t CpuProfiler::getDroppedEvents() {
+        Registry& reg = registry();
+        std::lock_guard lock(reg.mutex);
+        uint64_t dropped = reg.dropped;
+        for (const auto& ring : reg.rings) {
+            dropped += ring->dropped.load(std::memory_order_relaxed);
+        }
+        return dropped;
+    }
+
+    void CpuProfiler::writeChromeTrace(const std::string& path) {
+        Registry& reg = registry();
+        std::lock_guard lock(reg.mutex);
+        drain(reg, true);
+
+        std::ofstream out(path, std::ios::trunc);
+        if (!out) {
+            throw std::runtime_error("Failed to open CPU trace file: " + path);
+        }
+
+        double usPerTick = microsecondsPerTick(reg);
+        auto toUs = [&](uint64_t ticks) {
+            return ticks > reg.captureStart ? static_cast<double>(ticks - reg.captureStart) * usPerTick : 0.0;
+        };
+        char number[64];
+
+        out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+        out << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"CPU\"}}";
+        for (const auto& ring : reg.rings) {
+            if (!ring->name.empty()) {
+                out << ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << ring->threadId
+                    << ",\"args\":{\"name\":";
+                writeJsonString(out, ring->name.c_str());
+                out << "}}";
+            }
+        }
+
+        for (const auto& captured : reg.captured) {
+            const Event& event = captured.event;
+            out << ",\n{\"name\":";
+            writeJsonString(out, event.name);
+            std::snprintf(number, sizeof(number), "%.3f", toUs(event.start));
+            out << ",\"pid\":1,\"tid\":" << captured.threadId << ",\"ts\":" << number;
+            switch (event.type) {
+                case EventType::Zone:
+                    std::snprintf(number, sizeof(number), "%.3f",
+                                  static_cast<double>(std::max(event.end, event.start) - event.start) * usPerTick);
+                    out << ",\"cat\":\"cpu\",\"ph\":\"X\",\"dur\":" << number << "}";
+                    break;
+                case EventType::Counter:
+                    std::snprintf(number, sizeof(number), "%.17g", event.value);
+                    out << ",\"ph\":\"C\",\"args\":{\"value\":" << number << "}}";
+                    break;
+                case EventType::Frame:
+                    out << ",\"cat\":\"frame\",\"ph\":\"i\",\"s\":\"g\"}";
+                    break;
+            }
+        }
+        out << "\n]}\n";
+
+        if (!out) {
+            throw std::runtime_error("Failed to write CPU trace file: " + path);
+        }
+    }
+
+} // namespace vke
@@ -27,10 +27,30 @@ SwapChain::SwapChain(VkDevice device,
 // Destrutor: destrói os image views e a swapchain
 // ---------------------------------------------------------------------
 SwapChain::~SwapChain() {
+    destroyImageViews();
+    vkDestroySwapchainKHR(m_device, m_swapChain, nullptr);
+}
+
+void SwapChain::destroyImageViews() {
     for (auto imageView : m_imageViews) {
         vkDestroyImageView(m_device, imageView, nullptr);
     }
-    vkDestroySwapchainKHR(m_device, m_swapChain, nullptr);
+    m_imageViews.clear();
+}
+
+// ---------------------------------------------------------------------
+// Recriação no lugar: só a swapchain e seus image views são refeitos
+// ---------------------------------------------------------------------
+void SwapChain::recreate(uint32_t width, uint32_t height) {
+    m_width = width;
+    m_height = height;
+
+    destroyImageViews();
+
+    // A swapchain antiga é "aposentada" na criação da nova e só então destruída
+    VkSwapchainKHR oldSwapChain = m_swapChain;
+    createSwapChain(oldSwapChain);
+    vkDestroySwapchainKHR(m_device, oldSwapChain, nullptr);
 }
 
 // ---------------------------------------------------------------------
@@ -103,20 +123,13 @@ VkExtent2D SwapChain::chooseSwapExtent(const VkSurfaceCapabilitiesKHR& capabilit
 // ---------------------------------------------------------------------
 // Criação efetiva da swapchain e dos image views
 // ---------------------------------------------------------------------
-void SwapChain::createSwapChain() {
-    // Cria a swapchain usando a função interna
-    m_swapChain = createSwapChainInternal();
+void SwapChain::createSwapChain(VkSwapchainKHR oldSwapChain) {
+    // Cria a swapchain usando a função interna (que também define formato e extensão)
+    m_swapChain = createSwapChainInternal(oldSwapChain);
 
     // Recupera as imagens da swapchain
     m_images = getSwapChainImages(m_swapChain);
 
-    // Define formato e extensão
-    SwapChainSupportDetails swapChainSupport = querySwapChainSupport(m_physicalDevice, m_surface);
-    VkSurfaceFormatKHR surfaceFormat = chooseSwapSurfaceFormat(swapChainSupport.formats);
-    VkExtent2D extent = chooseSwapExtent(swapChainSupport.capabilities, m_width, m_height);
-    m_imageFormat = surfaceFormat.format;
-    m_extent = extent;
-
     // Cria image views para cada imagem da swapchain
     for (auto image : m_images) {
         VkImageView imageView = createImageView(image, m_imageFormat);
@@ -127,7 +140,7 @@ void SwapChain::createSwapChain() {
 // ---------------------------------------------------------------------
 // Função que configura e chama vkCreateSwapchainKHR
 // ---------------------------------------------------------------------
-VkSwapchainKHR SwapChain::createSwapChainInternal() const {
+VkSwapchainKHR SwapChain::createSwapChainInternal(VkSwapchainKHR oldSwapChain) {
     SwapChainSupportDetails swapChainSupport = querySwapChainSupport(m_physicalDevice, m_surface);
 
     VkSurfaceFormatKHR surfaceFormat = chooseSwapSurfaceFormat(swapChainSupport.formats);
@@ -168,13 +181,17 @@ VkSwapchainKHR SwapChain::createSwapChainInternal() const {
     createInfo.compositeAlpha = VK_COMPOSITE_ALPHA_OPAQUE_BIT_KHR;
     createInfo.presentMode = presentMode;
     createInfo.clipped = VK_TRUE;
-    createInfo.oldSwapchain = VK_NULL_HANDLE;
+    createInfo.oldSwapchain = oldSwapChain;
 
     // Cria a swapchain
     VkSwapchainKHR swapChain;
     if (vkCreateSwapchainKHR(m_device, &createInfo, nullptr, &swapChain) != VK_SUCCESS) {
         throw std::runtime_error("Fail to create swap chain!");
     }
+
+    // Guarda exatamente o que foi usado na criação (a surface pode mudar entre consultas)
+    m_imageFormat = surfaceFormat.format;
+    m_extent = extent;
     return swapChain;
 }
 
@@ -0,0 +1,103 @@
+#include "gfx/Bounds.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace vke {
+
+BoundingSphere computeBounds(const std::vector<Vertex>& vertices) {
+  return computeBounds(vertices.data(), vertices.size());
+}
+
+BoundingSphere computeBounds(const Vertex* vertices, size_t count) {
+  BoundingSphere bounds;
+  if (count == 0) {
+    return bounds;
+  }
+
+  const Vertex* end = vertices + count;
+  float minX = vertices[0].position[0], maxX = minX;
+  float minY = vertices[0].position[1], maxY = minY;
+  for (const Vertex* vertex = vertices; vertex != end; vertex++) {
+    minX = std::min(minX, vertex->position[0]);
+    maxX = std::max(maxX, vertex->position[0]);
+    minY = std::min(minY, vertex->position[1]);
+    maxY = std::max(maxY, vertex->position[1]);
+  }
+  bounds.center[0] = 0.5f * (minX + maxX);
+  bounds.center[1] = 0.5f * (minY + maxY);
+
+  float radiusSq = 0.0f;
+  for (const Vertex* vertex = vertices; vertex != end; vertex++) {
+    float dx = vertex->position[0] - bounds.center[0];
+    float dy = vertex->position[1] - bounds.center[1];
+    radiusSq = std::max(radiusSq, dx * dx + dy * dy);
+  }
+  bounds.radius = std::sqrt(radiusSq);
+  return bounds;
+}
+
+// Gribb-Hartmann: cada plano é a soma/diferença da linha w com uma das outras;
+// normalizar deixa a distância comparável ao raio da esfera
+Frustum Frustum::fromViewProjection(const std::array<float, 16>& m) {
+  auto row = [&](int r, int c) { return m[c * 4 + r]; };
+
+  Frustum frustum;
+  for (int c = 0; c < 4; c++) {
+    frustum.planes[0][c] = row(3, c) + row(0, c); // esquerda
+    frustum.planes[1][c] = row(3, c) - row(0, c); // direita
+    frustum.planes[2][c] = row(3, c) + row(1, c); // baixo
+    frustum.planes[3][c] = row(3, c) - row(1, c); // cima
+    frustum.planes[4][c] = row(2, c);             // perto
+    frustum.planes[5][c] = row(3, c) - row(2, c); // longe
+  }
+  for (auto& plane : frustum.planes) {
+    float length = std::sqrt(plane[0] * plane[0] + plane[1] * plane[1] + plane[2] * plane[2]);
+    if (length > 0.0f) {
+      for (float& value : plane) {
+        value /= length;
+      }
+    }
+  }
+  return frustum;
+}
+
+uint32_t BoundsSoA::add(const BoundingSphere& sphere) {
+  m_centerX.push_back(sphere.center[0]);
+  m_centerY.push_back(sphere.center[1]);
+  m_centerZ.push_back(sphere.center[2]);
+  m_radius.push_back(sphere.radius);
+  return size() - 1;
+}
+
+void BoundsSoA::set(uint32_t index, const BoundingSphere& sphere) {
+  m_centerX[index] = sphere.center[0];
+  m_centerY[index] = sphere.center[1];
+  m_centerZ[index] = sphere.center[2];
+  m_radius[index] = sphere.radius;
+}
+
+BoundingSphere BoundsSoA::get(uint32_t index) const {
+  BoundingSphere sphere;
+  sphere.center[0] = m_centerX[index];
+  sphere.center[1] = m_centerY[index];
+  sphere.center[2] = m_centerZ[index];
+  sphere.radius = m_radius[index];
+  return sphere;
+}
+
+void BoundsSoA::reserve(size_t count) {
+  m_centerX.reserve(count);
+  m_centerY.reserve(count);
+  m_centerZ.reserve(count);
+  m_radius.reserve(count);
+}
+
+void BoundsSoA::clear() {
+  m_centerX.clear();
+  m_centerY.clear();
+  m_centerZ.clear();
+  m_radius.clear();
+}
+
+} // namespace vke
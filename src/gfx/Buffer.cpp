@@ -1,15 +1,19 @@
 #include "gfx/Buffer.h"
+#include "core/Device.h"
+#include "core/Profiler.h"
 #include <stdexcept>
 #include <cstring> // memcpy
 
 namespace vke {
 
-Buffer::Buffer(VkDevice device, VkPhysicalDevice physicalDevice)
-    : m_device(device), m_physicalDevice(physicalDevice) {}
+Buffer::Buffer(Device& device)
+    : m_device(device) {}
 
 Buffer::~Buffer() { destroy(); }
 
-void Buffer::create(VkDeviceSize size, VkBufferUsageFlags usage, VkMemoryPropertyFlags properties) {
+void Buffer::create(VkDeviceSize size, VkBufferUsageFlags usage, VkMemoryPropertyFlags properties,
+                    AllocationStrategy strategy) {
+    VKE_PROFILE_ZONE("Buffer::create");
   // Creates the buffer
     VkBufferCreateInfo bufferInfo{};
     bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
@@ -17,57 +21,42 @@ void Buffer::create(VkDeviceSize size, VkBufferUsageFlags usage, VkMemoryPropert
     bufferInfo.usage = usage;
     bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
 
-    if (vkCreateBuffer(m_device, &bufferInfo, nullptr, &m_buffer) != VK_SUCCESS) {
+    if (vkCreateBuffer(m_device.device(), &bufferInfo, nullptr, &m_buffer) != VK_SUCCESS) {
       throw std::runtime_error("Failed to create buffer!");
     }
+    m_size = size;
 
-    // Allocates memory for the buffer
+    // Sub-allocates memory for the buffer from the device allocator
     VkMemoryRequirements memRequirements;
-    vkGetBufferMemoryRequirements(m_device, m_buffer, &memRequirements);
+    vkGetBufferMemoryRequirements(m_device.device(), m_buffer, &memRequirements);
 
-    VkMemoryAllocateInfo allocInfo{};
-    allocInfo.sType                       = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-    allocInfo.allocationSize              = memRequirements.size;
-    allocInfo.memoryTypeIndex             = findMemoryType(memRequirements.memoryTypeBits, properties);
+    m_allocation = m_device.allocator().allocate(memRequirements, properties, strategy);
 
-    if (vkAllocateMemory(m_device, &allocInfo, nullptr, &m_memory) != VK_SUCCESS) {
-        throw std::runtime_error("Failed to allocate buffer memory!");
-    }
-
-    // Binds the buffer to the allocated memory
-    vkBindBufferMemory(m_device, m_buffer, m_memory, 0);
+    // Binds the buffer to its range inside the shared memory block
+    vkBindBufferMemory(m_device.device(), m_buffer, m_allocation.memory, m_allocation.offset);
 }
 
-void Buffer::uploadData(const void* srcData, VkDeviceSize size) {
-  void* dstData;
-  if (vkMapMemory(m_device, m_memory, 0, size, 0, &dstData) != VK_SUCCESS) {
-    throw std::runtime_error("Failed to map buffer memory!");
+void Buffer::uploadData(const void* srcData, VkDeviceSize size, VkDeviceSize dstOffset) {
+  // Host-visible blocks stay persistently mapped by the allocator
+  if (m_allocation.mapped == nullptr) {
+    throw std::runtime_error("Buffer memory is not host visible!");
   }
 
-  std::memcpy(dstData, srcData, static_cast<size_t>(size));
-  vkUnmapMemory(m_device, m_memory);
+  std::memcpy(static_cast<char*>(m_allocation.mapped) + dstOffset, srcData, static_cast<size_t>(size));
+  m_device.allocator().flush(m_allocation, dstOffset, size);
+}
+
+void Buffer::flush(VkDeviceSize offset, VkDeviceSize size) const {
+  m_device.allocator().flush(m_allocation, offset, size);
 }
 
 void Buffer::destroy() {
-  if (m_memory != VK_NULL_HANDLE) {
-    vkFreeMemory(m_device, m_memory, nullptr);
-    m_memory = VK_NULL_HANDLE;
-  }
   if (m_buffer != VK_NULL_HANDLE) {
-    vkDestroyBuffer(m_device, m_buffer, nullptr);
+    vkDestroyBuffer(m_device.device(), m_buffer, nullptr);
     m_buffer = VK_NULL_HANDLE;
   }
+  m_device.allocator().free(m_allocation);
+  m_size = 0;
 }
 
-uint32_t Buffer::findMemoryType(uint32_t typeFilter, VkMemoryPropertyFlags properties) {
-  VkPhysicalDeviceMemoryProperties memProperties;
-  vkGetPhysicalDeviceMemoryProperties(m_physicalDevice, &memProperties);
-
-  for (uint32_t i = 0; i < memProperties.memoryTypeCount; ++i) {
-    if ((typeFilter & (1 << i)) &&(memProperties.memoryTypes[i].propertyFlags & properties) == properties) { return i; }
-  }
-
-  throw std::runtime_error("Failed to find suitable memory type!");
 }
-
-}
\ No newline at end of file
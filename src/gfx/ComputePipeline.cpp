@@ -0,0 +1,44 @@
+#include "gfx/ComputePipeline.h"
+#include <chrono>
+#include <stdexcept>
+
+namespace vke {
+
+ComputePipeline::ComputePipeline(VkDevice device, VkShaderModule shader, VkPipelineLayout layout,
+                                 VkPipelineCache pipelineCache)
+    : m_device(device)
+    , m_pipelineLayout(layout)
+{
+    if (shader == VK_NULL_HANDLE || layout == VK_NULL_HANDLE) {
+        throw std::runtime_error("Incomplete compute pipeline description!");
+    }
+
+    VkPipelineShaderStageCreateInfo stageInfo{};
+    stageInfo.sType  = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+    stageInfo.stage  = VK_SHADER_STAGE_COMPUTE_BIT;
+    stageInfo.module = shader;
+    stageInfo.pName  = "main";
+
+    VkComputePipelineCreateInfo pipelineInfo{};
+    pipelineInfo.sType  = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+    pipelineInfo.stage  = stageInfo;
+    pipelineInfo.layout = layout;
+
+    auto start = std::chrono::steady_clock::now();
+    if (vkCreateComputePipelines(m_device, pipelineCache, 1, &pipelineInfo, nullptr, &m_pipeline) != VK_SUCCESS) {
+        throw std::runtime_error("Failed to create compute pipeline!");
+    }
+    m_creationMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+ComputePipeline::~ComputePipeline() {
+    if (m_pipeline != VK_NULL_HANDLE) {
+        vkDestroyPipeline(m_device, m_pipeline, nullptr);
+    }
+}
+
+void ComputePipeline::bind(VkCommandBuffer commandBuffer) const {
+    vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, m_pipeline);
+}
+
+} // namespace vke
@@ -0,0 +1,91 @@
+#include "gfx/DescriptorAllocator.h"
+#include "core/Device.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+namespace vke {
+
+    FrameDescriptorAllocator::FrameDescriptorAllocator(Device& device, uint32_t framesInFlight,
+                                                       std::vector<VkDescriptorPoolSize> poolSizes, uint32_t setsPerPool)
+        : m_device(device)
+        , m_poolSizes(std::move(poolSizes))
+        , m_setsPerPool(std::max(setsPerPool, 1u))
+        , m_frames(std::max(framesInFlight, 1u))
+    {
+    }
+
+    FrameDescriptorAllocator::~FrameDescriptorAllocator() {
+        for (auto& frame : m_frames) {
+            for (VkDescriptorPool pool : frame.pools) {
+                vkDestroyDescriptorPool(m_device.device(), pool, nullptr);
+            }
+        }
+    }
+
+    void FrameDescriptorAllocator::beginFrame(uint32_t frameSlot) {
+        m_frameSlot = frameSlot;
+        m_allocatedThisFrame = 0;
+
+        FramePools& frame = m_frames[frameSlot];
+        // Pools além de current não foram tocados no último uso do slot
+        uint32_t used = std::min(frame.current + 1, static_cast<uint32_t>(frame.pools.size()));
+        for (uint32_t i = 0; i < used; i++) {
+            vkResetDescriptorPool(m_device.device(), frame.pools[i], 0);
+        }
+        frame.current = 0;
+    }
+
+    VkDescriptorSet FrameDescriptorAllocator::allocate(VkDescriptorSetLayout layout) {
+        FramePools& frame = m_frames[m_frameSlot];
+
+        VkDescriptorSetAllocateInfo allocInfo{};
+        allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+        allocInfo.descriptorSetCount = 1;
+        allocInfo.pSetLayouts = &layout;
+
+        while (true) {
+            bool freshPool = frame.current == frame.pools.size();
+            if (freshPool) {
+                frame.pools.push_back(createPool());
+            }
+            allocInfo.descriptorPool = frame.pools[frame.current];
+
+            VkDescriptorSet set = VK_NULL_HANDLE;
+            VkResult result = vkAllocateDescriptorSets(m_device.device(), &allocInfo, &set);
+            if (result == VK_SUCCESS) {
+                m_allocatedThisFrame++;
+                return set;
+            }
+            if ((result != VK_ERROR_OUT_OF_POOL_MEMORY && result != VK_ERROR_FRAGMENTED_POOL) || freshPool) {
+                throw std::runtime_error("Failed to allocate per-frame descriptor set!");
+            }
+            // Pool cheio: segue para o próximo do slot
+            frame.current++;
+        }
+    }
+
+    uint32_t FrameDescriptorAllocator::getPoolCount() const {
+        uint32_t count = 0;
+        for (const auto& frame : m_frames) {
+            count += static_cast<uint32_t>(frame.pools.size());
+        }
+        return count;
+    }
+
+    VkDescriptorPool FrameDescriptorAllocator::createPool() {
+        VkDescriptorPoolCreateInfo poolInfo{};
+        poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+        poolInfo.maxSets = m_setsPerPool;
+        poolInfo.poolSizeCount = static_cast<uint32_t>(m_poolSizes.size());
+        poolInfo.pPoolSizes = m_poolSizes.data();
+
+        VkDescriptorPool pool = VK_NULL_HANDLE;
+        if (vkCreateDescriptorPool(m_device.device(), &poolInfo, nullptr, &pool) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to create per-frame descriptor pool!");
+        }
+        return pool;
+    }
+
+} // namespace vke
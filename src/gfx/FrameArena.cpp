@@ -0,0 +1,55 @@
+#include "gfx/FrameArena.h"
+#include "core/Device.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace vke {
+
+namespace {
+
+  VkDeviceSize alignUp(VkDeviceSize value, VkDeviceSize alignment) {
+    return (value + alignment - 1) / alignment * alignment;
+  }
+
+} // namespace
+
+FrameArena::FrameArena(Device& device, uint32_t framesInFlight, VkDeviceSize capacityPerFrame)
+    : m_buffer(device)
+{
+  const VkPhysicalDeviceLimits& limits = device.properties().limits;
+  m_uniformAlignment = std::max<VkDeviceSize>(limits.minUniformBufferOffsetAlignment, 1);
+  m_storageAlignment = std::max<VkDeviceSize>(limits.minStorageBufferOffsetAlignment, 1);
+
+  // Regiões começam alinhadas para qualquer tipo de alocação
+  VkDeviceSize regionAlignment = std::max({ m_uniformAlignment, m_storageAlignment, VkDeviceSize{ 16 } });
+  m_capacityPerFrame = alignUp(capacityPerFrame, regionAlignment);
+
+  m_buffer.create(m_capacityPerFrame * std::max(framesInFlight, 1u),
+                  VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT |
+                  VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT,
+                  VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+}
+
+void FrameArena::beginFrame(uint32_t frameSlot) {
+  m_frameBegin = m_capacityPerFrame * frameSlot;
+  m_head = m_frameBegin;
+}
+
+void FrameArena::flush() const {
+  if (m_head > m_frameBegin) {
+    m_buffer.flush(m_frameBegin, m_head - m_frameBegin);
+  }
+}
+
+FrameAllocation FrameArena::allocate(VkDeviceSize size, VkDeviceSize alignment) {
+  VkDeviceSize offset = alignUp(m_head, std::max<VkDeviceSize>(alignment, 1));
+  if (offset + size > m_frameBegin + m_capacityPerFrame) {
+    throw std::runtime_error("Frame arena is full!");
+  }
+  m_head = offset + size;
+  m_peakUsed = std::max(m_peakUsed, m_head - m_frameBegin);
+  return { m_buffer.getBuffer(), offset, static_cast<char*>(m_buffer.getMappedData()) + offset };
+}
+
+} // namespace vke
@@ -0,0 +1,257 @@
+#include "gfx/FrustumCulling.h"
+
+#include <algorithm>
+#include <bit>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define VKE_CULL_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define VKE_CULL_NEON 1
+#include <arm_neon.h>
+#endif
+
+// GCC/Clang só emitem AVX2 em funções marcadas; o MSVC aceita os intrínsecos em qualquer função
+#if defined(VKE_CULL_X86) && (defined(__GNUC__) || defined(__clang__))
+#define VKE_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define VKE_TARGET_AVX2
+#endif
+
+namespace vke {
+
+namespace {
+
+  // Mesma ordem de operações dos kernels SIMD (sem FMA), para resultados idênticos
+  uint32_t cullScalar(const Frustum& frustum, const BoundsSoA& bounds, uint32_t first, uint32_t end,
+                      uint32_t* outVisible) {
+    const float* cx = bounds.centersX();
+    const float* cy = bounds.centersY();
+    const float* cz = bounds.centersZ();
+    const float* radius = bounds.radii();
+
+    uint32_t count = 0;
+    for (uint32_t i = first; i < end; i++) {
+      bool inside = true;
+      for (const auto& plane : frustum.planes) {
+        float distance = plane[0] * cx[i] + plane[1] * cy[i] + plane[2] * cz[i] + plane[3] + radius[i];
+        inside &= distance >= 0.0f;
+      }
+      outVisible[count] = i;
+      count += inside ? 1 : 0;
+    }
+    return count;
+  }
+
+  // Índices dos bits ligados da máscara de lanes visíveis
+  inline uint32_t emitVisible(uint32_t mask, uint32_t base, uint32_t* outVisible) {
+    uint32_t count = 0;
+    while (mask != 0) {
+      outVisible[count++] = base + static_cast<uint32_t>(std::countr_zero(mask));
+      mask &= mask - 1;
+    }
+    return count;
+  }
+
+#if defined(VKE_CULL_X86)
+
+  uint32_t cullSSE(const Frustum& frustum, const BoundsSoA& bounds, uint32_t first, uint32_t end,
+                   uint32_t* outVisible) {
+    __m128 planes[6][4];
+    for (int p = 0; p < 6; p++) {
+      for (int c = 0; c < 4; c++) {
+        planes[p][c] = _mm_set1_ps(frustum.planes[p][c]);
+      }
+    }
+    const __m128 zero = _mm_setzero_ps();
+
+    uint32_t count = 0;
+    uint32_t i = first;
+    for (; i + 4 <= end; i += 4) {
+      __m128 cx = _mm_loadu_ps(bounds.centersX() + i);
+      __m128 cy = _mm_loadu_ps(bounds.centersY() + i);
+      __m128 cz = _mm_loadu_ps(bounds.centersZ() + i);
+      __m128 radius = _mm_loadu_ps(bounds.radii() + i);
+
+      __m128 inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+      for (const auto& plane : planes) {
+        __m128 distance = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_add_ps(
+            _mm_mul_ps(plane[0], cx), _mm_mul_ps(plane[1], cy)), _mm_mul_ps(plane[2], cz)), plane[3]), radius);
+        inside = _mm_and_ps(inside, _mm_cmpge_ps(distance, zero));
+      }
+      count += emitVisible(static_cast<uint32_t>(_mm_movemask_ps(inside)), i, outVisible + count);
+    }
+    return count + cullScalar(frustum, bounds, i, end, outVisible + count);
+  }
+
+  VKE_TARGET_AVX2
+  uint32_t cullAVX2(const Frustum& frustum, const BoundsSoA& bounds, uint32_t first, uint32_t end,
+                    uint32_t* outVisible) {
+    __m256 planes[6][4];
+    for (int p = 0; p < 6; p++) {
+      for (int c = 0; c < 4; c++) {
+        planes[p][c] = _mm256_set1_ps(frustum.planes[p][c]);
+      }
+    }
+    const __m256 zero = _mm256_setzero_ps();
+
+    uint32_t count = 0;
+    uint32_t i = first;
+    for (; i + 8 <= end; i += 8) {
+      __m256 cx = _mm256_loadu_ps(bounds.centersX() + i);
+      __m256 cy = _mm256_loadu_ps(bounds.centersY() + i);
+      __m256 cz = _mm256_loadu_ps(bounds.centersZ() + i);
+      __m256 radius = _mm256_loadu_ps(bounds.radii() + i);
+
+      __m256 inside = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+      for (const auto& plane : planes) {
+        __m256 distance = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(_mm256_add_ps(
+            _mm256_mul_ps(plane[0], cx), _mm256_mul_ps(plane[1], cy)), _mm256_mul_ps(plane[2], cz)), plane[3]), radius);
+        inside = _mm256_and_ps(inside, _mm256_cmp_ps(distance, zero, _CMP_GE_OQ));
+      }
+      count += emitVisible(static_cast<uint32_t>(_mm256_movemask_ps(inside)), i, outVisible + count);
+    }
+    // O resto (< 8) ainda aproveita 4 lanes
+    return count + cullSSE(frustum, bounds, i, end, outVisible + count);
+  }
+
+  bool cpuHasAVX2() {
+#if defined(__GNUC__) || defined(__clang__)
+    // Também confere se o SO salva os registradores YMM
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+#elif defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7) {
+      return false;
+    }
+    __cpuid(info, 1);
+    bool osxsave = (info[2] & (1 << 27)) != 0;
+    bool avx = (info[2] & (1 << 28)) != 0;
+    if (!osxsave || !avx || (_xgetbv(0) & 0x6) != 0x6) {
+      return false;
+    }
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#else
+    return false;
+#endif
+  }
+
+#endif // VKE_CULL_X86
+
+#if defined(VKE_CULL_NEON)
+
+  uint32_t cullNEON(const Frustum& frustum, const BoundsSoA& bounds, uint32_t first, uint32_t end,
+                    uint32_t* outVisible) {
+    float32x4_t planes[6][4];
+    for (int p = 0; p < 6; p++) {
+      for (int c = 0; c < 4; c++) {
+        planes[p][c] = vdupq_n_f32(frustum.planes[p][c]);
+      }
+    }
+    const float32x4_t zero = vdupq_n_f32(0.0f);
+    const uint32_t laneBitsData[4] = { 1, 2, 4, 8 };
+    const uint32x4_t laneBits = vld1q_u32(laneBitsData);
+
+    uint32_t count = 0;
+    uint32_t i = first;
+    for (; i + 4 <= end; i += 4) {
+      float32x4_t cx = vld1q_f32(bounds.centersX() + i);
+      float32x4_t cy = vld1q_f32(bounds.centersY() + i);
+      float32x4_t cz = vld1q_f32(bounds.centersZ() + i);
+      float32x4_t radius = vld1q_f32(bounds.radii() + i);
+
+      uint32x4_t inside = vdupq_n_u32(0xFFFFFFFFu);
+      for (const auto& plane : planes) {
+        float32x4_t distance = vaddq_f32(vaddq_f32(vaddq_f32(vaddq_f32(
+            vmulq_f32(plane[0], cx), vmulq_f32(plane[1], cy)), vmulq_f32(plane[2], cz)), plane[3]), radius);
+        inside = vandq_u32(inside, vcgeq_f32(distance, zero));
+      }
+      count += emitVisible(vaddvq_u32(vandq_u32(inside, laneBits)), i, outVisible + count);
+    }
+    return count + cullScalar(frustum, bounds, i, end, outVisible + count);
+  }
+
+#endif // VKE_CULL_NEON
+
+} // namespace
+
+const char* cullKernelName(CullKernel kernel) {
+  switch (kernel) {
+    case CullKernel::Scalar: return "scalar";
+    case CullKernel::SSE: return "sse";
+    case CullKernel::AVX2: return "avx2";
+    case CullKernel::NEON: return "neon";
+  }
+  return "unknown";
+}
+
+bool isCullKernelSupported(CullKernel kernel) {
+  switch (kernel) {
+    case CullKernel::Scalar:
+      return true;
+#if defined(VKE_CULL_X86)
+    case CullKernel::SSE:
+      return true; // SSE2 faz parte da base do x86-64
+    case CullKernel::AVX2: {
+      static const bool hasAVX2 = cpuHasAVX2();
+      return hasAVX2;
+    }
+#endif
+#if defined(VKE_CULL_NEON)
+    case CullKernel::NEON:
+      return true; // obrigatório no AArch64
+#endif
+    default:
+      return false;
+  }
+}
+
+CullKernel bestCullKernel() {
+  static const CullKernel best = [] {
+    for (CullKernel kernel : { CullKernel::AVX2, CullKernel::NEON, CullKernel::SSE }) {
+      if (isCullKernelSupported(kernel)) {
+        return kernel;
+      }
+    }
+    return CullKernel::Scalar;
+  }();
+  return best;
+}
+
+uint32_t cullSpheres(const Frustum& frustum, const BoundsSoA& bounds, uint32_t first, uint32_t end,
+                     uint32_t* outVisible, CullKernel kernel) {
+  end = std::min(end, bounds.size());
+  if (first >= end) {
+    return 0;
+  }
+  if (!isCullKernelSupported(kernel)) {
+    kernel = CullKernel::Scalar;
+  }
+
+  switch (kernel) {
+#if defined(VKE_CULL_X86)
+    case CullKernel::SSE:
+      return cullSSE(frustum, bounds, first, end, outVisible);
+    case CullKernel::AVX2:
+      return cullAVX2(frustum, bounds, first, end, outVisible);
+#endif
+#if defined(VKE_CULL_NEON)
+    case CullKernel::NEON:
+      return cullNEON(frustum, bounds, first, end, outVisible);
+#endif
+    default:
+      return cullScalar(frustum, bounds, first, end, outVisible);
+  }
+}
+
+uint32_t cullSpheres(const Frustum& frustum, const BoundsSoA& bounds, uint32_t* outVisible) {
+  return cullSpheres(frustum, bounds, 0, bounds.size(), outVisible, bestCullKernel());
+}
+
+} // namespace vke
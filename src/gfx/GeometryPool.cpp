@@ -0,0 +1,73 @@
+#include "gfx/GeometryPool.h"
+#include "core/Device.h"
+#include "gfx/UploadContext.h"
+#include "util/MeshUtils.h"
+
+#include <stdexcept>
+
+namespace vke {
+
+GeometryPool::GeometryPool(Device& device, uint32_t vertexCapacity, uint32_t indexCapacity)
+    : m_device(device),
+      m_vertexBuffer(device),
+      m_indexBuffer(device),
+      m_vertexCapacity(vertexCapacity),
+      m_indexCapacity(indexCapacity)
+{
+  m_vertexBuffer.create(sizeof(Vertex) * static_cast<VkDeviceSize>(vertexCapacity),
+                        VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                        VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+  m_indexBuffer.create(sizeof(uint32_t) * static_cast<VkDeviceSize>(indexCapacity),
+                       VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                       VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+}
+
+MeshRange GeometryPool::add(const std::vector<Vertex>& vertices) {
+  std::vector<Vertex> uniqueVertices;
+  std::vector<uint32_t> indices;
+  weldVertices(vertices, uniqueVertices, indices);
+  return add(uniqueVertices, indices);
+}
+
+MeshRange GeometryPool::add(const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices) {
+  return add(vertices.data(), static_cast<uint32_t>(vertices.size()),
+             indices.data(), static_cast<uint32_t>(indices.size()), computeBounds(vertices));
+}
+
+MeshRange GeometryPool::add(const Vertex* vertices, uint32_t vertexCount, const uint32_t* indices, uint32_t indexCount,
+                            const BoundingSphere& bounds) {
+  if (vertexCount > m_vertexCapacity - m_vertexCount || indexCount > m_indexCapacity - m_indexCount) {
+    throw std::runtime_error("Geometry pool is full!");
+  }
+
+  MeshRange range;
+  range.firstIndex = m_indexCount;
+  range.indexCount = indexCount;
+  range.vertexOffset = static_cast<int32_t>(m_vertexCount);
+  range.vertexCount = vertexCount;
+  range.bounds = bounds;
+
+  // Uploads vão para o lote aberto, se houver, junto com o resto da cena
+  m_device.uploader().uploadToBuffer(m_vertexBuffer, vertices, sizeof(Vertex) * static_cast<VkDeviceSize>(vertexCount),
+                                     sizeof(Vertex) * static_cast<VkDeviceSize>(m_vertexCount));
+  m_device.uploader().uploadToBuffer(m_indexBuffer, indices, sizeof(uint32_t) * static_cast<VkDeviceSize>(indexCount),
+                                     sizeof(uint32_t) * static_cast<VkDeviceSize>(m_indexCount));
+
+  m_vertexCount += range.vertexCount;
+  m_indexCount += range.indexCount;
+  return range;
+}
+
+void GeometryPool::bind(VkCommandBuffer commandBuffer) const {
+  VkBuffer buffers[] = { m_vertexBuffer.getBuffer() };
+  VkDeviceSize offsets[] = { 0 };
+  vkCmdBindVertexBuffers(commandBuffer, 0, 1, buffers, offsets);
+  vkCmdBindIndexBuffer(commandBuffer, m_indexBuffer.getBuffer(), 0, VK_INDEX_TYPE_UINT32);
+}
+
+void GeometryPool::reset() {
+  m_vertexCount = 0;
+  m_indexCount = 0;
+}
+
+} // namespace vke
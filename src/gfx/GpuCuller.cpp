@@ -0,0 +1,332 @@
+#include "gfx/GpuCuller.h"
+#include "core/Device.h"
+#include "gfx/Bounds.h"
+#include "gfx/Buffer.h"
+#include "gfx/ComputePipeline.h"
+#include "gfx/HiZPyramid.h"
+#include "gfx/Model.h"
+#include "gfx/PipelineRegistry.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+namespace vke {
+
+    namespace {
+
+        constexpr uint32_t kGroupSize = 64;
+        constexpr uint32_t kBindingCount = 6;
+
+        // Espelha as flags de cull.glsl
+        constexpr uint32_t kFlagFrustum = 1u;
+        constexpr uint32_t kFlagOcclusion = 2u;
+        constexpr uint32_t kFlagCompact = 4u;
+
+        // Layout std140 do bloco Params de cull.glsl
+        struct CullParams {
+            float viewProjection[16];
+            float planes[6][4];
+            float hizSize[2];
+            float hizLevels;
+            uint32_t drawCount;
+            uint32_t flags;
+            uint32_t padding[3];
+        };
+        static_assert(sizeof(CullParams) == 192, "CullParams must match the std140 layout of cull.glsl");
+
+    } // namespace
+
+    GpuCuller::GpuCuller(Device& device, uint32_t framesInFlight)
+        : m_device(device)
+    {
+        createDescriptors(framesInFlight);
+        createDummyHiZ();
+
+        VkPipelineLayoutCreateInfo layoutInfo{};
+        layoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+        layoutInfo.setLayoutCount = 1;
+        layoutInfo.pSetLayouts = &m_setLayout;
+        if (vkCreatePipelineLayout(m_device.device(), &layoutInfo, nullptr, &m_pipelineLayout) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to create culling pipeline layout!");
+        }
+
+        PipelineRegistry& pipelines = m_device.pipelines();
+        VkShaderModule shader = pipelines.getShaderModule(pipelines.registerShader("shaders/cull.spv"));
+        m_pipeline = std::make_unique<ComputePipeline>(m_device.device(), shader, m_pipelineLayout,
+                                                       m_device.pipelineCache().handle());
+
+        for (auto& slot : m_slots) {
+            slot.params = std::make_unique<Buffer>(m_device);
+            slot.params->create(sizeof(CullParams), VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
+                                VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+
+            slot.count = std::make_unique<Buffer>(m_device);
+            slot.count->create(sizeof(uint32_t),
+                               VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT |
+                               VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+                               VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+
+            slot.countReadback = std::make_unique<Buffer>(m_device);
+            slot.countReadback->create(sizeof(uint32_t), VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                                       VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+            std::memset(slot.countReadback->getMappedData(), 0, sizeof(uint32_t));
+        }
+    }
+
+    GpuCuller::~GpuCuller() {
+        // Buffers dos slots voltam ao alocador nos seus destrutores
+        m_slots.clear();
+        m_pipeline.reset();
+        vkDestroyPipelineLayout(m_device.device(), m_pipelineLayout, nullptr);
+        vkDestroyDescriptorPool(m_device.device(), m_descriptorPool, nullptr);
+        vkDestroyDescriptorSetLayout(m_device.device(), m_setLayout, nullptr);
+
+        vkDestroySampler(m_device.device(), m_dummySampler, nullptr);
+        vkDestroyImageView(m_device.device(), m_dummyView, nullptr);
+        vkDestroyImage(m_device.device(), m_dummyImage, nullptr);
+        m_device.allocator().free(m_dummyAllocation);
+    }
+
+    void GpuCuller::createDescriptors(uint32_t framesInFlight) {
+        m_slots.resize(std::max(framesInFlight, 1u));
+        auto slotCount = static_cast<uint32_t>(m_slots.size());
+
+        // 0 comandos, 1 esferas, 2 visíveis, 3 contador, 4 Hi-Z, 5 parâmetros
+        VkDescriptorSetLayoutBinding bindings[kBindingCount]{};
+        for (uint32_t i = 0; i < kBindingCount; i++) {
+            bindings[i].binding = i;
+            bindings[i].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+            bindings[i].descriptorCount = 1;
+            bindings[i].stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+        }
+        bindings[4].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+        bindings[5].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+
+        VkDescriptorSetLayoutCreateInfo setLayoutInfo{};
+        setLayoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+        setLayoutInfo.bindingCount = kBindingCount;
+        setLayoutInfo.pBindings = bindings;
+        if (vkCreateDescriptorSetLayout(m_device.device(), &setLayoutInfo, nullptr, &m_setLayout) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to create culling descriptor set layout!");
+        }
+
+        VkDescriptorPoolSize poolSizes[] = {
+            { VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 4 * slotCount },
+            { VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, slotCount },
+            { VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, slotCount },
+        };
+        VkDescriptorPoolCreateInfo poolInfo{};
+        poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+        poolInfo.maxSets = slotCount;
+        poolInfo.poolSizeCount = 3;
+        poolInfo.pPoolSizes = poolSizes;
+        if (vkCreateDescriptorPool(m_device.device(), &poolInfo, nullptr, &m_descriptorPool) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to create culling descriptor pool!");
+        }
+
+        std::vector<VkDescriptorSetLayout> layouts(slotCount, m_setLayout);
+        std::vector<VkDescriptorSet> sets(slotCount);
+        VkDescriptorSetAllocateInfo allocInfo{};
+        allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+        allocInfo.descriptorPool = m_descriptorPool;
+        allocInfo.descriptorSetCount = slotCount;
+        allocInfo.pSetLayouts = layouts.data();
+        if (vkAllocateDescriptorSets(m_device.device(), &allocInfo, sets.data()) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to allocate culling descriptor sets!");
+        }
+        for (uint32_t i = 0; i < slotCount; i++) {
+            m_slots[i].descriptorSet = sets[i];
+        }
+    }
+
+    void GpuCuller::createDummyHiZ() {
+        VkImageCreateInfo imageInfo{};
+        imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+        imageInfo.imageType = VK_IMAGE_TYPE_2D;
+        imageInfo.format = VK_FORMAT_R32_SFLOAT;
+        imageInfo.extent = { 1, 1, 1 };
+        imageInfo.mipLevels = 1;
+        imageInfo.arrayLayers = 1;
+        imageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+        imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+        imageInfo.usage = VK_IMAGE_USAGE_SAMPLED_BIT;
+        imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+        imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+        if (vkCreateImage(m_device.device(), &imageInfo, nullptr, &m_dummyImage) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to create culling placeholder image!");
+        }
+        m_dummyAllocation = m_device.allocator().allocateForImage(m_dummyImage, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+        vkBindImageMemory(m_device.device(), m_dummyImage, m_dummyAllocation.memory, m_dummyAllocation.offset);
+
+        VkImageViewCreateInfo viewInfo{};
+        viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+        viewInfo.image = m_dummyImage;
+        viewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
+        viewInfo.format = VK_FORMAT_R32_SFLOAT;
+        viewInfo.subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1 };
+        if (vkCreateImageView(m_device.device(), &viewInfo, nullptr, &m_dummyView) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to create culling placeholder view!");
+        }
+
+        VkSamplerCreateInfo samplerInfo{};
+        samplerInfo.sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
+        samplerInfo.magFilter = VK_FILTER_NEAREST;
+        samplerInfo.minFilter = VK_FILTER_NEAREST;
+        samplerInfo.mipmapMode = VK_SAMPLER_MIPMAP_MODE_NEAREST;
+        samplerInfo.addressModeU = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+        samplerInfo.addressModeV = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+        samplerInfo.addressModeW = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+        if (vkCreateSampler(m_device.device(), &samplerInfo, nullptr, &m_dummySampler) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to create culling placeholder sampler!");
+        }
+    }
+
+    // O conteúdo nunca é lido (a flag de oclusão fica desligada); só o layout importa
+    void GpuCuller::initializeDummyHiZ(VkCommandBuffer commandBuffer) {
+        VkImageMemoryBarrier barrier{};
+        barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+        barrier.srcAccessMask = 0;
+        barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+        barrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+        barrier.newLayout = VK_IMAGE_LAYOUT_GENERAL;
+        barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.image = m_dummyImage;
+        barrier.subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1 };
+        vkCmdPipelineBarrier(commandBuffer,
+                             VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                             0, 0, nullptr, 0, nullptr, 1, &barrier);
+        m_dummyInitialized = true;
+    }
+
+    void GpuCuller::record(VkCommandBuffer commandBuffer, uint32_t frameSlot, const Model& model, const CullView& view) {
+        if (!model.isPacked()) {
+            throw std::runtime_error("GPU culling requires a packed model!");
+        }
+        SlotData& slot = m_slots[frameSlot];
+        auto drawCount = static_cast<uint32_t>(model.getMeshCount());
+        if (drawCount == 0) {
+            return;
+        }
+        if (!m_dummyInitialized) {
+            initializeDummyHiZ(commandBuffer);
+        }
+
+        // A lista de saída cresce com o model; o slot não está em voo
+        VkDeviceSize visibleSize = drawCount * sizeof(VkDrawIndexedIndirectCommand);
+        if (!slot.visible || slot.visible->getSize() < visibleSize) {
+            slot.visible = std::make_unique<Buffer>(m_device);
+            slot.visible->create(visibleSize, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT,
+                                 VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+        }
+        slot.compact = model.canDrawIndirectCount();
+
+        CullParams params{};
+        std::memcpy(params.viewProjection, view.viewProjection.data(), sizeof(params.viewProjection));
+        Frustum frustum = Frustum::fromViewProjection(view.viewProjection);
+        std::memcpy(params.planes, frustum.planes, sizeof(params.planes));
+        params.drawCount = drawCount;
+        params.flags = (view.frustum ? kFlagFrustum : 0u) | (slot.compact ? kFlagCompact : 0u);
+        if (view.occlusion) {
+            VkExtent2D extent = view.occlusion->getExtent();
+            params.hizSize[0] = static_cast<float>(extent.width);
+            params.hizSize[1] = static_cast<float>(extent.height);
+            params.hizLevels = static_cast<float>(view.occlusion->getLevelCount());
+            params.flags |= kFlagOcclusion;
+        }
+        slot.params->uploadData(&params, sizeof(params));
+
+        VkDescriptorBufferInfo bufferInfos[] = {
+            { model.getIndirectBuffer().getBuffer(), 0, VK_WHOLE_SIZE },
+            { model.getBoundsBuffer().getBuffer(), 0, VK_WHOLE_SIZE },
+            { slot.visible->getBuffer(), 0, VK_WHOLE_SIZE },
+            { slot.count->getBuffer(), 0, VK_WHOLE_SIZE },
+            { slot.params->getBuffer(), 0, sizeof(CullParams) },
+        };
+        VkDescriptorImageInfo hizInfo{
+            view.occlusion ? view.occlusion->getSampler() : m_dummySampler,
+            view.occlusion ? view.occlusion->getView() : m_dummyView,
+            VK_IMAGE_LAYOUT_GENERAL
+        };
+
+        VkWriteDescriptorSet writes[kBindingCount]{};
+        for (uint32_t i = 0; i < kBindingCount; i++) {
+            writes[i].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+            writes[i].dstSet = slot.descriptorSet;
+            writes[i].dstBinding = i;
+            writes[i].descriptorCount = 1;
+            writes[i].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+        }
+        for (uint32_t i = 0; i < 4; i++) {
+            writes[i].pBufferInfo = &bufferInfos[i];
+        }
+        writes[4].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+        writes[4].pImageInfo = &hizInfo;
+        writes[5].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+        writes[5].pBufferInfo = &bufferInfos[4];
+        vkUpdateDescriptorSets(m_device.device(), kBindingCount, writes, 0, nullptr);
+
+        // Zera o contador antes dos atomics do shader
+        vkCmdFillBuffer(commandBuffer, slot.count->getBuffer(), 0, sizeof(uint32_t), 0);
+        VkBufferMemoryBarrier toCompute{};
+        toCompute.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+        toCompute.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        toCompute.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+        toCompute.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        toCompute.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        toCompute.buffer = slot.count->getBuffer();
+        toCompute.offset = 0;
+        toCompute.size = VK_WHOLE_SIZE;
+        vkCmdPipelineBarrier(commandBuffer,
+                             VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                             0, 0, nullptr, 1, &toCompute, 0, nullptr);
+
+        m_pipeline->bind(commandBuffer);
+        vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, m_pipelineLayout,
+                                0, 1, &slot.descriptorSet, 0, nullptr);
+        vkCmdDispatch(commandBuffer, (drawCount + kGroupSize - 1) / kGroupSize, 1, 1);
+
+        // Lista e contador viram argumentos do draw indireto e origem da cópia de leitura
+        VkMemoryBarrier toIndirect{};
+        toIndirect.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+        toIndirect.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+        toIndirect.dstAccessMask = VK_ACCESS_INDIRECT_COMMAND_READ_BIT | VK_ACCESS_TRANSFER_READ_BIT;
+        vkCmdPipelineBarrier(commandBuffer,
+                             VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                             VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_TRANSFER_BIT,
+                             0, 1, &toIndirect, 0, nullptr, 0, nullptr);
+
+        VkBufferCopy region{ 0, 0, sizeof(uint32_t) };
+        vkCmdCopyBuffer(commandBuffer, slot.count->getBuffer(), slot.countReadback->getBuffer(), 1, &region);
+
+        VkBufferMemoryBarrier toHost{};
+        toHost.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+        toHost.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        toHost.dstAccessMask = VK_ACCESS_HOST_READ_BIT;
+        toHost.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        toHost.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        toHost.buffer = slot.countReadback->getBuffer();
+        toHost.offset = 0;
+        toHost.size = VK_WHOLE_SIZE;
+        vkCmdPipelineBarrier(commandBuffer,
+                             VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_HOST_BIT,
+                             0, 0, nullptr, 1, &toHost, 0, nullptr);
+    }
+
+    void GpuCuller::draw(VkCommandBuffer commandBuffer, uint32_t frameSlot, const Model& model) const {
+        const SlotData& slot = m_slots[frameSlot];
+        if (!slot.visible || model.getMeshCount() == 0) {
+            return;
+        }
+        model.recordIndirectDraws(commandBuffer, slot.visible->getBuffer(),
+                                  slot.compact ? slot.count->getBuffer() : VK_NULL_HANDLE);
+    }
+
+    uint32_t GpuCuller::getVisibleCount(uint32_t frameSlot) const {
+        uint32_t count = 0;
+        std::memcpy(&count, m_slots[frameSlot].countReadback->getMappedData(), sizeof(count));
+        return count;
+    }
+
+} // namespace vke
@@ -0,0 +1,277 @@
+#include "gfx/GpuProfiler.h"
+#include "core/Device.h"
+#include "util/Json.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+namespace vke {
+
+    namespace {
+
+        // Ordem dos contadores no resultado = ordem crescente dos bits
+        constexpr VkQueryPipelineStatisticFlags kStatisticFlags =
+            VK_QUERY_PIPELINE_STATISTIC_INPUT_ASSEMBLY_PRIMITIVES_BIT |
+            VK_QUERY_PIPELINE_STATISTIC_VERTEX_SHADER_INVOCATIONS_BIT |
+            VK_QUERY_PIPELINE_STATISTIC_CLIPPING_PRIMITIVES_BIT |
+            VK_QUERY_PIPELINE_STATISTIC_FRAGMENT_SHADER_INVOCATIONS_BIT |
+            VK_QUERY_PIPELINE_STATISTIC_COMPUTE_SHADER_INVOCATIONS_BIT;
+        constexpr uint32_t kStatisticCount = 5;
+
+        VkQueryPool createQueryPool(VkDevice device, VkQueryType type, uint32_t count,
+                                    VkQueryPipelineStatisticFlags statistics) {
+            VkQueryPoolCreateInfo poolInfo{};
+            poolInfo.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+            poolInfo.queryType = type;
+            poolInfo.queryCount = count;
+            poolInfo.pipelineStatistics = statistics;
+            VkQueryPool pool = VK_NULL_HANDLE;
+            if (vkCreateQueryPool(device, &poolInfo, nullptr, &pool) != VK_SUCCESS) {
+                throw std::runtime_error("Failed to create GPU profiler query pool!");
+            }
+            return pool;
+        }
+
+    } // namespace
+
+    GpuProfiler::GpuProfiler(Device& device, uint32_t framesInFlight, uint32_t maxScopes, bool statistics)
+        : m_device(device)
+        , m_maxScopes(std::max(maxScopes, 1u))
+    {
+        if (!device.features().timestampQueries) {
+            return;
+        }
+
+        uint32_t validBits = device.timestampValidBits();
+        m_timestampMask = validBits >= 64 ? ~0ull : (1ull << validBits) - 1;
+        // timestampPeriod é em nanossegundos por tick
+        m_msPerTick = static_cast<double>(device.properties().limits.timestampPeriod) * 1e-6;
+        m_statistics = statistics && device.features().pipelineStatisticsQuery;
+
+        m_slots.resize(std::max(framesInFlight, 1u));
+        for (auto& slot : m_slots) {
+            slot.timestamps = createQueryPool(m_device.device(), VK_QUERY_TYPE_TIMESTAMP, 2 * m_maxScopes, 0);
+            if (m_statistics) {
+                slot.statistics = createQueryPool(m_device.device(), VK_QUERY_TYPE_PIPELINE_STATISTICS,
+                                                  m_maxScopes, kStatisticFlags);
+            }
+            slot.scopes.reserve(m_maxScopes);
+        }
+        m_timestampData.resize(2 * static_cast<size_t>(m_maxScopes));
+        m_statisticsData.resize(kStatisticCount);
+    }
+
+    GpuProfiler::~GpuProfiler() {
+        for (auto& slot : m_slots) {
+            vkDestroyQueryPool(m_device.device(), slot.timestamps, nullptr);
+            if (slot.statistics != VK_NULL_HANDLE) {
+                vkDestroyQueryPool(m_device.device(), slot.statistics, nullptr);
+            }
+        }
+    }
+
+    void GpuProfiler::beginFrame(VkCommandBuffer commandBuffer, uint32_t frameSlot) {
+        if (!isEnabled()) {
+            return;
+        }
+        SlotData& slot = m_slots[frameSlot % m_slots.size()];
+        collect(slot);
+
+        // Reset no próprio command buffer (host reset exige Vulkan 1.2)
+        vkCmdResetQueryPool(commandBuffer, slot.timestamps, 0, 2 * m_maxScopes);
+        if (slot.statistics != VK_NULL_HANDLE) {
+            vkCmdResetQueryPool(commandBuffer, slot.statistics, 0, m_maxScopes);
+        }
+
+        slot.scopes.clear();
+        slot.frame = ++m_frameCounter;
+        slot.pending = true;
+        m_current = &slot;
+        m_depth = 0;
+        m_statisticsActive = false;
+    }
+
+    uint32_t GpuProfiler::beginScope(VkCommandBuffer commandBuffer, const char* name, bool statistics) {
+        if (m_current == nullptr) {
+            return kInvalidScope;
+        }
+        if (m_current->scopes.size() >= m_maxScopes) {
+            m_droppedScopes++;
+            return kInvalidScope;
+        }
+
+        auto scope = static_cast<uint32_t>(m_current->scopes.size());
+        // Queries do mesmo tipo não podem ficar ativas ao mesmo tempo: só o escopo de fora conta
+        bool withStatistics = statistics && m_statistics && !m_statisticsActive;
+        m_current->scopes.push_back({ name, m_depth, withStatistics, false });
+        m_depth++;
+
+        vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, m_current->timestamps, 2 * scope);
+        if (withStatistics) {
+            vkCmdBeginQuery(commandBuffer, m_current->statistics, scope, 0);
+            m_statisticsActive = true;
+        }
+        return scope;
+    }
+
+    void GpuProfiler::endScope(VkCommandBuffer commandBuffer, uint32_t scope) {
+        if (m_current == nullptr || scope >= m_current->scopes.size() || m_current->scopes[scope].closed) {
+            return;
+        }
+
+        ScopeRecord& record = m_current->scopes[scope];
+        if (record.statistics) {
+            vkCmdEndQuery(commandBuffer, m_current->statistics, scope);
+            m_statisticsActive = false;
+        }
+        vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, m_current->timestamps, 2 * scope + 1);
+        record.closed = true;
+        m_depth = record.depth;
+    }
+
+    // ------------------------------------------------------
+    // Lê as queries de um slot cujo frame a GPU já terminou (fence esperada),
+    // então vkGetQueryPoolResults não bloqueia. VK_NOT_READY ou escopos sem
+    // endScope descartam o frame em vez de esperar.
+    // ------------------------------------------------------
+    void GpuProfiler::collect(SlotData& slot) {
+        if (!slot.pending) {
+            return;
+        }
+        slot.pending = false;
+        if (&slot == m_current) {
+            m_current = nullptr;
+        }
+
+        auto count = static_cast<uint32_t>(slot.scopes.size());
+        if (count == 0 || std::any_of(slot.scopes.begin(), slot.scopes.end(),
+                                      [](const ScopeRecord& record) { return !record.closed; })) {
+            return;
+        }
+
+        VkResult result = vkGetQueryPoolResults(m_device.device(), slot.timestamps, 0, 2 * count,
+                                                2 * count * sizeof(uint64_t), m_timestampData.data(),
+                                                sizeof(uint64_t), VK_QUERY_RESULT_64_BIT);
+        if (result != VK_SUCCESS) {
+            return;
+        }
+
+        std::vector<GpuScopeTiming>& results = m_collected;
+        results.assign(count, GpuScopeTiming{});
+        uint64_t base = m_timestampData[0];
+        for (uint32_t i = 0; i < count; i++) {
+            const ScopeRecord& record = slot.scopes[i];
+            uint64_t begin = m_timestampData[2 * i];
+            uint64_t end = m_timestampData[2 * i + 1];
+            // A máscara trata o contador que dá a volta com menos de 64 bits válidos
+            uint64_t duration = (end - begin) & m_timestampMask;
+
+            GpuScopeTiming& timing = results[i];
+            timing.name = record.name;
+            timing.depth = record.depth;
+            timing.startMs = static_cast<double>((begin - base) & m_timestampMask) * m_msPerTick;
+            timing.gpuMs = static_cast<double>(duration) * m_msPerTick;
+
+            // Uma query por escopo: as não usadas nunca ficam disponíveis
+            if (record.statistics &&
+                vkGetQueryPoolResults(m_device.device(), slot.statistics, i, 1, kStatisticCount * sizeof(uint64_t),
+                                      m_statisticsData.data(), kStatisticCount * sizeof(uint64_t),
+                                      VK_QUERY_RESULT_64_BIT) == VK_SUCCESS) {
+                timing.hasStatistics = true;
+                timing.statistics.inputPrimitives = m_statisticsData[0];
+                timing.statistics.vertexInvocations = m_statisticsData[1];
+                timing.statistics.clippingPrimitives = m_statisticsData[2];
+                timing.statistics.fragmentInvocations = m_statisticsData[3];
+                timing.statistics.computeInvocations = m_statisticsData[4];
+            }
+
+            if (m_traceCapture) {
+                m_trace.push_back({ timing.name, slot.frame, timing.depth, begin & m_timestampMask, duration,
+                                    timing.hasStatistics, timing.statistics });
+            }
+        }
+
+        // flush() pode ler slots fora de ordem: mantém sempre o frame mais novo
+        if (slot.frame > m_lastCollectedFrame) {
+            m_lastCollectedFrame = slot.frame;
+            m_lastResultsFrame = slot.frame;
+            std::swap(m_lastResults, m_collected);
+        }
+    }
+
+    void GpuProfiler::flush() {
+        // Do frame mais antigo ao mais novo, para o trace sair em ordem
+        std::vector<SlotData*> pending;
+        for (auto& slot : m_slots) {
+            if (slot.pending) {
+                pending.push_back(&slot);
+            }
+        }
+        std::sort(pending.begin(), pending.end(),
+                  [](const SlotData* a, const SlotData* b) { return a->frame < b->frame; });
+        for (SlotData* slot : pending) {
+            collect(*slot);
+        }
+    }
+
+    double GpuProfiler::getScopeMs(const char* name) const {
+        double total = 0.0;
+        for (const auto& timing : m_lastResults) {
+            if (std::strcmp(timing.name, name) == 0) {
+                total += timing.gpuMs;
+            }
+        }
+        return total;
+    }
+
+    void GpuProfiler::setTraceCapture(bool enabled) {
+        if (enabled && !m_traceCapture) {
+            m_trace.clear();
+        }
+        m_traceCapture = enabled;
+    }
+
+    // ------------------------------------------------------
+    // Exporta os escopos como eventos completos ("ph": "X") numa trilha "GPU".
+    // Os tempos saem em microssegundos a partir do primeiro evento capturado.
+    // ------------------------------------------------------
+    void GpuProfiler::writeChromeTrace(const std::string& path) const {
+        std::ofstream out(path, std::ios::trunc);
+        if (!out) {
+            throw std::runtime_error("Failed to open GPU trace file: " + path);
+        }
+
+        uint64_t base = m_trace.empty() ? 0 : m_trace.front().startTicks;
+        double usPerTick = m_msPerTick * 1e3;
+        char number[64];
+
+        out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+        out << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":1,\"args\":{\"name\":\"GPU\"}}";
+        for (const auto& event : m_trace) {
+            out << ",\n{\"name\":";
+            writeJsonString(out, event.name);
+            std::snprintf(number, sizeof(number), "%.3f", static_cast<double>((event.startTicks - base) & m_timestampMask) * usPerTick);
+            out << ",\"cat\":\"gpu\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":" << number;
+            std::snprintf(number, sizeof(number), "%.3f", static_cast<double>(event.durationTicks) * usPerTick);
+            out << ",\"dur\":" << number << ",\"args\":{\"frame\":" << event.frame << ",\"depth\":" << event.depth;
+            if (event.hasStatistics) {
+                const GpuPipelineStatistics& s = event.statistics;
+                out << ",\"inputPrimitives\":" << s.inputPrimitives
+                    << ",\"vertexInvocations\":" << s.vertexInvocations
+                    << ",\"clippingPrimitives\":" << s.clippingPrimitives
+                    << ",\"fragmentInvocations\":" << s.fragmentInvocations
+                    << ",\"computeInvocations\":" << s.computeInvocations;
+            }
+            out << "}}";
+        }
+        out << "\n]}\n";
+
+        if (!out) {
+            throw std::runtime_error("Failed to write GPU trace file: " + path);
+        }
+    }
+
+} // namespace vke
@@ -1,116 +1,73 @@
 #include "gfx/GraphicsPipeline.h"
-#include "gfx/Vertex.h"
-#include <fstream>
+#include <chrono>
 #include <stdexcept>
 
 namespace vke {
 
-std::vector<char> GraphicsPipeline::readFile(const std::string& filename) {
-    // Opens the file in binary mode and at the end to determine its size
-    std::ifstream file(filename, std::ios::ate | std::ios::binary);
-    if (!file.is_open()) {
-        throw std::runtime_error("Failed to open file: " + filename);
-    }
-
-    size_t fileSize = static_cast<size_t>(file.tellg());
-    std::vector<char> buffer(fileSize);
-
-    file.seekg(0);
-    file.read(buffer.data(), fileSize);
-    file.close();
-
-    return buffer;
-}
-
-VkShaderModule GraphicsPipeline::createShaderModule(const std::vector<char>& code) {
-    VkShaderModuleCreateInfo createInfo{};
-    createInfo.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
-    createInfo.codeSize = code.size();
-    createInfo.pCode = reinterpret_cast<const uint32_t*>(code.data());
-
-    VkShaderModule shaderModule;
-    if (vkCreateShaderModule(m_device, &createInfo, nullptr, &shaderModule) != VK_SUCCESS) {
-        throw std::runtime_error("Failed to create shader module!");
-    }
-
-    return shaderModule;
-}
-
-GraphicsPipeline::GraphicsPipeline(VkDevice device, VkRenderPass renderPass, VkExtent2D swapChainExtent)
+GraphicsPipeline::GraphicsPipeline(VkDevice device, const GraphicsPipelineDesc& desc, VkPipelineCache pipelineCache)
     : m_device(device)
+    , m_pipelineLayout(desc.layout)
 {
-    createPipeline(renderPass, swapChainExtent);
+    createPipeline(desc, pipelineCache);
 }
 
 GraphicsPipeline::~GraphicsPipeline() {
     if (m_graphicsPipeline != VK_NULL_HANDLE) {
         vkDestroyPipeline(m_device, m_graphicsPipeline, nullptr);
     }
-    if (m_pipelineLayout != VK_NULL_HANDLE) {
-        vkDestroyPipelineLayout(m_device, m_pipelineLayout, nullptr);
-    }
 }
 
-void GraphicsPipeline::createPipeline(VkRenderPass renderPass, VkExtent2D swapChainExtent) {
-    // Carrega os shaders compilados (SPIR-V)
-    auto vertShaderCode = readFile("shaders/vert.spv");
-    auto fragShaderCode = readFile("shaders/frag.spv");
-
-    VkShaderModule vertShaderModule = createShaderModule(vertShaderCode);
-    VkShaderModule fragShaderModule = createShaderModule(fragShaderCode);
+void GraphicsPipeline::createPipeline(const GraphicsPipelineDesc& desc, VkPipelineCache pipelineCache) {
+    if (desc.vertexShader == VK_NULL_HANDLE || desc.fragmentShader == VK_NULL_HANDLE ||
+        desc.vertexLayout == nullptr || desc.layout == VK_NULL_HANDLE ||
+        (desc.renderPass == VK_NULL_HANDLE && desc.colorFormat == VK_FORMAT_UNDEFINED)) {
+        throw std::runtime_error("Incomplete graphics pipeline description!");
+    }
 
     // Configuração dos estágios dos shaders
     VkPipelineShaderStageCreateInfo vertShaderStageInfo{};
     vertShaderStageInfo.sType  = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
     vertShaderStageInfo.stage  = VK_SHADER_STAGE_VERTEX_BIT;
-    vertShaderStageInfo.module = vertShaderModule;
+    vertShaderStageInfo.module = desc.vertexShader;
     vertShaderStageInfo.pName  = "main";
 
     VkPipelineShaderStageCreateInfo fragShaderStageInfo{};
     fragShaderStageInfo.sType  = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
     fragShaderStageInfo.stage  = VK_SHADER_STAGE_FRAGMENT_BIT;
-    fragShaderStageInfo.module = fragShaderModule;
+    fragShaderStageInfo.module = desc.fragmentShader;
     fragShaderStageInfo.pName  = "main";
 
     VkPipelineShaderStageCreateInfo shaderStages[] = { vertShaderStageInfo, fragShaderStageInfo };
 
-    // Estado de entrada de vértices (ainda vazio)
+    // Estado de entrada de vértices
     VkPipelineVertexInputStateCreateInfo vertexInputInfo{};
     vertexInputInfo.sType                           = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
 
-    auto bindingDescription = Vertex::getBindingDescription();
-    auto attributeDescriptions = Vertex::getAttributeDescriptions();
+    const auto& bindingDescriptions = desc.vertexLayout->bindings;
+    const auto& attributeDescriptions = desc.vertexLayout->attributes;
 
-    vertexInputInfo.vertexBindingDescriptionCount   = 1;
-    vertexInputInfo.pVertexBindingDescriptions      = &bindingDescription;
+    vertexInputInfo.vertexBindingDescriptionCount   = static_cast<uint32_t>(bindingDescriptions.size());
+    vertexInputInfo.pVertexBindingDescriptions      = bindingDescriptions.data();
     vertexInputInfo.vertexAttributeDescriptionCount = static_cast<uint32_t>(attributeDescriptions.size());
     vertexInputInfo.pVertexAttributeDescriptions    = attributeDescriptions.data();
 
     // Configuração de montagem de primitivas
     VkPipelineInputAssemblyStateCreateInfo inputAssembly{};
     inputAssembly.sType                  = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO;
-    inputAssembly.topology               = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+    inputAssembly.topology               = desc.topology;
     inputAssembly.primitiveRestartEnable = VK_FALSE;
 
-    // Viewport e scissor
-    VkViewport viewport{};
-    viewport.x        = 0.0f;
-    viewport.y        = 0.0f;
-    viewport.width    = static_cast<float>(swapChainExtent.width);
-    viewport.height   = static_cast<float>(swapChainExtent.height);
-    viewport.minDepth = 0.0f;
-    viewport.maxDepth = 1.0f;
-
-    VkRect2D scissor{};
-    scissor.offset = { 0, 0 };
-    scissor.extent = swapChainExtent;
-
+    // Viewport e scissor dinâmicos: definidos no command buffer a cada frame
     VkPipelineViewportStateCreateInfo viewportState{};
     viewportState.sType                         = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO;
     viewportState.viewportCount                 = 1;
-    viewportState.pViewports                    = &viewport;
     viewportState.scissorCount                  = 1;
-    viewportState.pScissors                     = &scissor;
+
+    VkDynamicState dynamicStates[] = { VK_DYNAMIC_STATE_VIEWPORT, VK_DYNAMIC_STATE_SCISSOR };
+    VkPipelineDynamicStateCreateInfo dynamicState{};
+    dynamicState.sType                          = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO;
+    dynamicState.dynamicStateCount              = 2;
+    dynamicState.pDynamicStates                 = dynamicStates;
 
     // Configuração do rasterizador
     VkPipelineRasterizationStateCreateInfo rasterizer{};
@@ -119,21 +76,28 @@ void GraphicsPipeline::createPipeline(VkRenderPass renderPass, VkExtent2D swapCh
     rasterizer.rasterizerDiscardEnable          = VK_FALSE;
     rasterizer.polygonMode                      = VK_POLYGON_MODE_FILL;
     rasterizer.lineWidth                        = 1.0f;
-    rasterizer.cullMode                         = VK_CULL_MODE_BACK_BIT;
-    rasterizer.frontFace                        = VK_FRONT_FACE_CLOCKWISE;
+    rasterizer.cullMode                         = desc.cullMode;
+    rasterizer.frontFace                        = desc.frontFace;
     rasterizer.depthBiasEnable                  = VK_FALSE;
 
     // Configuração do multisample
     VkPipelineMultisampleStateCreateInfo multisampling{};
     multisampling.sType                         = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO;
     multisampling.sampleShadingEnable           = VK_FALSE;
-    multisampling.rasterizationSamples          = VK_SAMPLE_COUNT_1_BIT;
+    multisampling.rasterizationSamples          = desc.samples;
 
     // Configuração do color blending
     VkPipelineColorBlendAttachmentState colorBlendAttachment{};
     colorBlendAttachment.colorWriteMask         = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT |
                                                 VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT;
-    colorBlendAttachment.blendEnable            = VK_FALSE;
+    colorBlendAttachment.blendEnable            = desc.blend == BlendMode::Opaque ? VK_FALSE : VK_TRUE;
+    colorBlendAttachment.srcColorBlendFactor    = VK_BLEND_FACTOR_SRC_ALPHA;
+    colorBlendAttachment.dstColorBlendFactor    = desc.blend == BlendMode::Additive ? VK_BLEND_FACTOR_ONE
+                                                                                    : VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
+    colorBlendAttachment.colorBlendOp           = VK_BLEND_OP_ADD;
+    colorBlendAttachment.srcAlphaBlendFactor    = VK_BLEND_FACTOR_ONE;
+    colorBlendAttachment.dstAlphaBlendFactor    = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
+    colorBlendAttachment.alphaBlendOp           = VK_BLEND_OP_ADD;
 
     VkPipelineColorBlendStateCreateInfo colorBlending{};
     colorBlending.sType                         = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO;
@@ -141,19 +105,27 @@ void GraphicsPipeline::createPipeline(VkRenderPass renderPass, VkExtent2D swapCh
     colorBlending.attachmentCount               = 1;
     colorBlending.pAttachments                  = &colorBlendAttachment;
 
-    // Criação do pipeline layout (sem descritores por enquanto)
-    VkPipelineLayoutCreateInfo pipelineLayoutInfo{};
-    pipelineLayoutInfo.sType                    = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
-    pipelineLayoutInfo.setLayoutCount           = 0;
-    pipelineLayoutInfo.pushConstantRangeCount   = 0;
-
-    if (vkCreatePipelineLayout(m_device, &pipelineLayoutInfo, nullptr, &m_pipelineLayout) != VK_SUCCESS) {
-        throw std::runtime_error("Failed to create pipeline layout!");
-    }
+    // Profundidade (apenas se a render pass ou o dynamic rendering tiver o attachment)
+    VkPipelineDepthStencilStateCreateInfo depthStencil{};
+    depthStencil.sType                          = VK_STRUCTURE_TYPE_PIPELINE_DEPTH_STENCIL_STATE_CREATE_INFO;
+    depthStencil.depthTestEnable                = desc.depthTest ? VK_TRUE : VK_FALSE;
+    depthStencil.depthWriteEnable               = desc.depthWrite ? VK_TRUE : VK_FALSE;
+    depthStencil.depthCompareOp                 = desc.depthCompare;
+    depthStencil.depthBoundsTestEnable          = VK_FALSE;
+    depthStencil.stencilTestEnable              = VK_FALSE;
+
+    // Dynamic rendering: os formatos dos attachments substituem a render pass
+    VkPipelineRenderingCreateInfoKHR renderingInfo{};
+    renderingInfo.sType                         = VK_STRUCTURE_TYPE_PIPELINE_RENDERING_CREATE_INFO_KHR;
+    renderingInfo.colorAttachmentCount          = 1;
+    renderingInfo.pColorAttachmentFormats       = &desc.colorFormat;
+    renderingInfo.depthAttachmentFormat         = desc.depthFormat;
+    renderingInfo.stencilAttachmentFormat       = VK_FORMAT_UNDEFINED;
 
     // Configuração final para a criação do pipeline gráfico
     VkGraphicsPipelineCreateInfo pipelineInfo{};
     pipelineInfo.sType               = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
+    pipelineInfo.pNext               = desc.renderPass == VK_NULL_HANDLE ? &renderingInfo : nullptr;
     pipelineInfo.stageCount          = 2;
     pipelineInfo.pStages             = shaderStages;
     pipelineInfo.pVertexInputState   = &vertexInputInfo;
@@ -161,19 +133,19 @@ void GraphicsPipeline::createPipeline(VkRenderPass renderPass, VkExtent2D swapCh
     pipelineInfo.pViewportState      = &viewportState;
     pipelineInfo.pRasterizationState = &rasterizer;
     pipelineInfo.pMultisampleState   = &multisampling;
+    pipelineInfo.pDepthStencilState  = desc.hasDepthAttachment ? &depthStencil : nullptr;
     pipelineInfo.pColorBlendState    = &colorBlending;
+    pipelineInfo.pDynamicState       = &dynamicState;
     pipelineInfo.layout              = m_pipelineLayout;
-    pipelineInfo.renderPass          = renderPass;
+    pipelineInfo.renderPass          = desc.renderPass;
     pipelineInfo.subpass             = 0;
     pipelineInfo.basePipelineHandle  = VK_NULL_HANDLE;
 
-    if (vkCreateGraphicsPipelines(m_device, VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &m_graphicsPipeline) != VK_SUCCESS) {
+    auto start = std::chrono::steady_clock::now();
+    if (vkCreateGraphicsPipelines(m_device, pipelineCache, 1, &pipelineInfo, nullptr, &m_graphicsPipeline) != VK_SUCCESS) {
         throw std::runtime_error("Failed to create graphics pipeline!");
     }
-
-    // Depois de criar o pipeline, destruímos os módulos de shader
-    vkDestroyShaderModule(m_device, vertShaderModule, nullptr);
-    vkDestroyShaderModule(m_device, fragShaderModule, nullptr);
+    m_creationMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
 }
 
 } // namespace vke
@@ -0,0 +1,272 @@
+#include "gfx/HiZPyramid.h"
+#include "core/Device.h"
+#include "gfx/ComputePipeline.h"
+#include "gfx/PipelineRegistry.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace vke {
+
+    namespace {
+
+        constexpr uint32_t kGroupSize = 8;
+
+        struct ReduceParams {
+            int32_t srcSize[2];
+            int32_t dstSize[2];
+            int32_t scale;
+        };
+
+    } // namespace
+
+    HiZPyramid::HiZPyramid(Device& device, uint32_t width, uint32_t height)
+        : m_device(device)
+        , m_extent{ std::max(width, 1u), std::max(height, 1u) }
+    {
+        // Leituras com texelFetch (redução) e textureLod por mip (culling): sem filtragem
+        VkSamplerCreateInfo samplerInfo{};
+        samplerInfo.sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
+        samplerInfo.magFilter = VK_FILTER_NEAREST;
+        samplerInfo.minFilter = VK_FILTER_NEAREST;
+        samplerInfo.mipmapMode = VK_SAMPLER_MIPMAP_MODE_NEAREST;
+        samplerInfo.addressModeU = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+        samplerInfo.addressModeV = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+        samplerInfo.addressModeW = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+        samplerInfo.maxLod = VK_LOD_CLAMP_NONE;
+        if (vkCreateSampler(m_device.device(), &samplerInfo, nullptr, &m_sampler) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to create Hi-Z sampler!");
+        }
+
+        VkDescriptorSetLayoutBinding bindings[2]{};
+        bindings[0].binding = 0;
+        bindings[0].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+        bindings[0].descriptorCount = 1;
+        bindings[0].stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+        bindings[1].binding = 1;
+        bindings[1].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+        bindings[1].descriptorCount = 1;
+        bindings[1].stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+
+        VkDescriptorSetLayoutCreateInfo setLayoutInfo{};
+        setLayoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+        setLayoutInfo.bindingCount = 2;
+        setLayoutInfo.pBindings = bindings;
+        if (vkCreateDescriptorSetLayout(m_device.device(), &setLayoutInfo, nullptr, &m_setLayout) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to create Hi-Z descriptor set layout!");
+        }
+
+        VkPushConstantRange pushRange{ VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(ReduceParams) };
+        VkPipelineLayoutCreateInfo layoutInfo{};
+        layoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+        layoutInfo.setLayoutCount = 1;
+        layoutInfo.pSetLayouts = &m_setLayout;
+        layoutInfo.pushConstantRangeCount = 1;
+        layoutInfo.pPushConstantRanges = &pushRange;
+        if (vkCreatePipelineLayout(m_device.device(), &layoutInfo, nullptr, &m_pipelineLayout) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to create Hi-Z pipeline layout!");
+        }
+
+        PipelineRegistry& pipelines = m_device.pipelines();
+        VkShaderModule shader = pipelines.getShaderModule(pipelines.registerShader("shaders/hiz.spv"));
+        m_pipeline = std::make_unique<ComputePipeline>(m_device.device(), shader, m_pipelineLayout,
+                                                       m_device.pipelineCache().handle());
+
+        createImage();
+    }
+
+    HiZPyramid::~HiZPyramid() {
+        destroyImage();
+        m_pipeline.reset();
+        vkDestroyPipelineLayout(m_device.device(), m_pipelineLayout, nullptr);
+        vkDestroyDescriptorSetLayout(m_device.device(), m_setLayout, nullptr);
+        vkDestroySampler(m_device.device(), m_sampler, nullptr);
+    }
+
+    void HiZPyramid::resize(uint32_t width, uint32_t height) {
+        destroyImage();
+        m_extent = { std::max(width, 1u), std::max(height, 1u) };
+        createImage();
+    }
+
+    VkExtent2D HiZPyramid::levelExtent(uint32_t level) const {
+        return { std::max(m_extent.width >> level, 1u), std::max(m_extent.height >> level, 1u) };
+    }
+
+    void HiZPyramid::createImage() {
+        uint32_t levels = 1;
+        while ((std::max(m_extent.width, m_extent.height) >> levels) > 0) {
+            levels++;
+        }
+
+        VkImageCreateInfo imageInfo{};
+        imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+        imageInfo.imageType = VK_IMAGE_TYPE_2D;
+        imageInfo.format = VK_FORMAT_R32_SFLOAT;
+        imageInfo.extent = { m_extent.width, m_extent.height, 1 };
+        imageInfo.mipLevels = levels;
+        imageInfo.arrayLayers = 1;
+        imageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+        imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+        imageInfo.usage = VK_IMAGE_USAGE_STORAGE_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;
+        imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+        imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+        if (vkCreateImage(m_device.device(), &imageInfo, nullptr, &m_image) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to create Hi-Z image!");
+        }
+
+        m_allocation = m_device.allocator().allocateForImage(m_image, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+        vkBindImageMemory(m_device.device(), m_image, m_allocation.memory, m_allocation.offset);
+
+        VkImageViewCreateInfo viewInfo{};
+        viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+        viewInfo.image = m_image;
+        viewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
+        viewInfo.format = VK_FORMAT_R32_SFLOAT;
+        viewInfo.subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT, 0, levels, 0, 1 };
+        if (vkCreateImageView(m_device.device(), &viewInfo, nullptr, &m_view) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to create Hi-Z image view!");
+        }
+
+        m_mipViews.resize(levels);
+        for (uint32_t level = 0; level < levels; level++) {
+            viewInfo.subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT, level, 1, 0, 1 };
+            if (vkCreateImageView(m_device.device(), &viewInfo, nullptr, &m_mipViews[level]) != VK_SUCCESS) {
+                throw std::runtime_error("Failed to create Hi-Z mip view!");
+            }
+        }
+
+        // Um set por mip a partir do 1 e até kMaxDepthViews para o mip 0
+        VkDescriptorPoolSize poolSizes[] = {
+            { VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, levels + kMaxDepthViews },
+            { VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, levels + kMaxDepthViews },
+        };
+        VkDescriptorPoolCreateInfo poolInfo{};
+        poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+        poolInfo.maxSets = levels + kMaxDepthViews;
+        poolInfo.poolSizeCount = 2;
+        poolInfo.pPoolSizes = poolSizes;
+        if (vkCreateDescriptorPool(m_device.device(), &poolInfo, nullptr, &m_descriptorPool) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to create Hi-Z descriptor pool!");
+        }
+
+        m_mipSets.clear();
+        for (uint32_t level = 1; level < levels; level++) {
+            m_mipSets.push_back(allocateSet(m_mipViews[level - 1], VK_IMAGE_LAYOUT_GENERAL, level));
+        }
+        m_initialized = false;
+    }
+
+    void HiZPyramid::destroyImage() {
+        // Os sets morrem junto com o pool
+        if (m_descriptorPool != VK_NULL_HANDLE) {
+            vkDestroyDescriptorPool(m_device.device(), m_descriptorPool, nullptr);
+            m_descriptorPool = VK_NULL_HANDLE;
+        }
+        m_mipSets.clear();
+        m_depthSets.clear();
+
+        for (auto view : m_mipViews) {
+            vkDestroyImageView(m_device.device(), view, nullptr);
+        }
+        m_mipViews.clear();
+        if (m_view != VK_NULL_HANDLE) {
+            vkDestroyImageView(m_device.device(), m_view, nullptr);
+            m_view = VK_NULL_HANDLE;
+        }
+        if (m_image != VK_NULL_HANDLE) {
+            vkDestroyImage(m_device.device(), m_image, nullptr);
+            m_image = VK_NULL_HANDLE;
+        }
+        m_device.allocator().free(m_allocation);
+    }
+
+    VkDescriptorSet HiZPyramid::allocateSet(VkImageView source, VkImageLayout sourceLayout, uint32_t dstLevel) {
+        VkDescriptorSetAllocateInfo allocInfo{};
+        allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+        allocInfo.descriptorPool = m_descriptorPool;
+        allocInfo.descriptorSetCount = 1;
+        allocInfo.pSetLayouts = &m_setLayout;
+
+        VkDescriptorSet set = VK_NULL_HANDLE;
+        if (vkAllocateDescriptorSets(m_device.device(), &allocInfo, &set) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to allocate Hi-Z descriptor set!");
+        }
+
+        VkDescriptorImageInfo sourceInfo{ m_sampler, source, sourceLayout };
+        VkDescriptorImageInfo targetInfo{ VK_NULL_HANDLE, m_mipViews[dstLevel], VK_IMAGE_LAYOUT_GENERAL };
+
+        VkWriteDescriptorSet writes[2]{};
+        writes[0].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        writes[0].dstSet = set;
+        writes[0].dstBinding = 0;
+        writes[0].descriptorCount = 1;
+        writes[0].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+        writes[0].pImageInfo = &sourceInfo;
+        writes[1].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        writes[1].dstSet = set;
+        writes[1].dstBinding = 1;
+        writes[1].descriptorCount = 1;
+        writes[1].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+        writes[1].pImageInfo = &targetInfo;
+        vkUpdateDescriptorSets(m_device.device(), 2, writes, 0, nullptr);
+        return set;
+    }
+
+    void HiZPyramid::build(VkCommandBuffer commandBuffer, VkImageView depthView, VkImageLayout depthLayout) {
+        // Sets do mip 0 são criados uma vez por depth view e nunca reescritos,
+        // então frames em voo continuam com descritores válidos
+        auto found = m_depthSets.find(depthView);
+        if (found == m_depthSets.end()) {
+            if (m_depthSets.size() >= kMaxDepthViews) {
+                throw std::runtime_error("Too many depth views for the Hi-Z pyramid!");
+            }
+            found = m_depthSets.emplace(depthView, allocateSet(depthView, depthLayout, 0)).first;
+        }
+
+        // Leituras do culling anterior terminam antes de sobrescrever os mips
+        VkImageMemoryBarrier barrier{};
+        barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+        barrier.srcAccessMask = VK_ACCESS_SHADER_READ_BIT;
+        barrier.dstAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+        barrier.oldLayout = m_initialized ? VK_IMAGE_LAYOUT_GENERAL : VK_IMAGE_LAYOUT_UNDEFINED;
+        barrier.newLayout = VK_IMAGE_LAYOUT_GENERAL;
+        barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.image = m_image;
+        barrier.subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT, 0, getLevelCount(), 0, 1 };
+        vkCmdPipelineBarrier(commandBuffer,
+                             VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                             0, 0, nullptr, 0, nullptr, 1, &barrier);
+        m_initialized = true;
+
+        m_pipeline->bind(commandBuffer);
+        for (uint32_t level = 0; level < getLevelCount(); level++) {
+            VkDescriptorSet set = level == 0 ? found->second : m_mipSets[level - 1];
+            vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, m_pipelineLayout,
+                                    0, 1, &set, 0, nullptr);
+
+            VkExtent2D src = levelExtent(level == 0 ? 0 : level - 1);
+            VkExtent2D dst = levelExtent(level);
+            ReduceParams params{
+                { static_cast<int32_t>(src.width), static_cast<int32_t>(src.height) },
+                { static_cast<int32_t>(dst.width), static_cast<int32_t>(dst.height) },
+                level == 0 ? 1 : 2
+            };
+            vkCmdPushConstants(commandBuffer, m_pipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT,
+                               0, sizeof(ReduceParams), &params);
+            vkCmdDispatch(commandBuffer, (dst.width + kGroupSize - 1) / kGroupSize,
+                          (dst.height + kGroupSize - 1) / kGroupSize, 1);
+
+            // O mip recém-escrito é a origem do próximo (e lido pelo culling no fim)
+            barrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+            barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+            barrier.oldLayout = VK_IMAGE_LAYOUT_GENERAL;
+            barrier.subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT, level, 1, 0, 1 };
+            vkCmdPipelineBarrier(commandBuffer,
+                                 VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                                 0, 0, nullptr, 0, nullptr, 1, &barrier);
+        }
+    }
+
+} // namespace vke
@@ -0,0 +1,50 @@
+#include "gfx/IndexBuffer.h"
+#include "core/Device.h"
+#include "gfx/UploadContext.h"
+
+namespace vke {
+
+IndexBuffer::IndexBuffer(Device& device)
+    : m_device(device), m_buffer(device) {}
+
+IndexBuffer::~IndexBuffer() {
+    destroy();
+}
+
+void IndexBuffer::create(const std::vector<uint32_t>& indices, VkIndexType indexType) {
+  if (indexType != VK_INDEX_TYPE_UINT16) {
+    create(indices.data(), indices.size());
+    return;
+  }
+
+  // 16-bit indices halve the index memory and bandwidth when the mesh allows it
+  std::vector<uint16_t> narrowed(indices.begin(), indices.end());
+  upload(narrowed.data(), narrowed.size(), VK_INDEX_TYPE_UINT16);
+}
+
+void IndexBuffer::create(const uint32_t* indices, size_t count) {
+  upload(indices, count, VK_INDEX_TYPE_UINT32);
+}
+
+void IndexBuffer::upload(const void* data, size_t count, VkIndexType indexType) {
+  m_indexCount = count;
+  m_indexType = indexType;
+  VkDeviceSize size = (indexType == VK_INDEX_TYPE_UINT16 ? sizeof(uint16_t) : sizeof(uint32_t)) * count;
+
+  m_buffer.create(size,
+                  VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                  VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+
+  m_device.uploader().uploadToBuffer(m_buffer, data, size);
+}
+
+void IndexBuffer::bind(VkCommandBuffer commandBuffer) const {
+  vkCmdBindIndexBuffer(commandBuffer, m_buffer.getBuffer(), 0, m_indexType);
+}
+
+void IndexBuffer::destroy() {
+  m_buffer.destroy();
+  m_indexCount = 0;
+}
+
+} // namespace vke
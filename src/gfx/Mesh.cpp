@@ -1,9 +1,13 @@
 #include "gfx/Mesh.h"
+#include "util/MeshUtils.h"
+
+#include <limits>
 
 namespace vke {
 
-Mesh::Mesh(VkDevice device, VkPhysicalDevice physicalDevice)
-    : m_vertexBuffer(device, physicalDevice)
+Mesh::Mesh(Device& device)
+    : m_vertexBuffer(device),
+      m_indexBuffer(device)
 {}
 
 Mesh::~Mesh() {
@@ -11,15 +15,37 @@ Mesh::~Mesh() {
 }
 
 void Mesh::load(const std::vector<Vertex>& vertices) {
+  std::vector<Vertex> uniqueVertices;
+  std::vector<uint32_t> indices;
+  weldVertices(vertices, uniqueVertices, indices);
+  load(uniqueVertices, indices);
+}
+
+void Mesh::load(const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices) {
+  // Primitive restart is disabled, so every 16-bit value is a valid index
+  const bool fitsUint16 = vertices.size() <= size_t{std::numeric_limits<uint16_t>::max()} + 1;
+
   m_vertexBuffer.create(vertices);
+  m_indexBuffer.create(indices, fitsUint16 ? VK_INDEX_TYPE_UINT16 : VK_INDEX_TYPE_UINT32);
+  m_bounds = computeBounds(vertices);
 }
 
-void Mesh::recordDrawCommands(VkCommandBuffer commandBuffer) const {
-  m_vertexBuffer.bind(commandBuffer);
-  vkCmdDraw(commandBuffer, static_cast<uint32_t>(m_vertexBuffer.getVertexCount()), 1, 0, 0);
+void Mesh::load(const Vertex* vertices, size_t vertexCount, const uint32_t* indices, size_t indexCount,
+                const BoundingSphere& bounds) {
+  m_vertexBuffer.create(vertices, vertexCount);
+  m_indexBuffer.create(indices, indexCount);
+  m_bounds = bounds;
+}
 
+void Mesh::recordDrawCommands(VkCommandBuffer commandBuffer, uint32_t instanceCount, uint32_t firstInstance) const {
+  m_vertexBuffer.bind(commandBuffer);
+  m_indexBuffer.bind(commandBuffer);
+  vkCmdDrawIndexed(commandBuffer, static_cast<uint32_t>(m_indexBuffer.getIndexCount()), instanceCount, 0, 0, firstInstance);
 }
 
-void Mesh::destroy() { m_vertexBuffer.destroy();}
+void Mesh::destroy() {
+  m_indexBuffer.destroy();
+  m_vertexBuffer.destroy();
+}
 
-} // namespace vke
\ No newline at end of file
+} // namespace vke
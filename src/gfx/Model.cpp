@@ -1,23 +1,380 @@
 #include "gfx/Model.h"
+#include "core/Device.h"
+#include "gfx/UploadContext.h"
+#include "util/MeshFile.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
 
 namespace vke {
 
-Model::Model(VkDevice device, VkPhysicalDevice physicalDevice)
-    : m_device(device), m_physicalDevice(physicalDevice) {}
+namespace {
+
+  // Esfera que cobre todas as instâncias (offset + escala) de um mesh
+  BoundingSphere instanceBounds(const BoundingSphere& mesh, const std::vector<InstanceData>& instances) {
+    if (instances.empty()) {
+      return mesh;
+    }
+
+    auto centerOf = [&](const InstanceData& instance, int axis) {
+      float offset = axis < 2 ? instance.offset[axis] : 0.0f;
+      return mesh.center[axis] * instance.scale + offset;
+    };
+
+    float lo[3], hi[3];
+    for (int axis = 0; axis < 3; axis++) {
+      lo[axis] = hi[axis] = centerOf(instances[0], axis);
+    }
+    for (const auto& instance : instances) {
+      float radius = mesh.radius * std::abs(instance.scale);
+      for (int axis = 0; axis < 3; axis++) {
+        lo[axis] = std::min(lo[axis], centerOf(instance, axis) - radius);
+        hi[axis] = std::max(hi[axis], centerOf(instance, axis) + radius);
+      }
+    }
+
+    BoundingSphere bounds;
+    for (int axis = 0; axis < 3; axis++) {
+      bounds.center[axis] = 0.5f * (lo[axis] + hi[axis]);
+    }
+    for (const auto& instance : instances) {
+      float dx = centerOf(instance, 0) - bounds.center[0];
+      float dy = centerOf(instance, 1) - bounds.center[1];
+      float dz = centerOf(instance, 2) - bounds.center[2];
+      bounds.radius = std::max(bounds.radius, std::sqrt(dx * dx + dy * dy + dz * dz) + mesh.radius * std::abs(instance.scale));
+    }
+    return bounds;
+  }
+
+} // namespace
+
+Model::Model(Device& device)
+    : m_device(device),
+      m_indirectBuffer(device),
+      m_boundsBuffer(device),
+      m_instanceBuffer(device) {}
+
+Model::Model(Device& device, GeometryPool& geometry)
+    : m_device(device),
+      m_geometry(&geometry),
+      m_indirectBuffer(device),
+      m_boundsBuffer(device),
+      m_instanceBuffer(device) {}
 
 Model::~Model() {
   destroy();
 }
 
-void Model::addMesh(const std::vector<Vertex>& vertices) {
-  auto mesh = std::make_unique<Mesh>(m_device, m_physicalDevice);
-  mesh->load(vertices);
-  m_meshes.push_back(std::move(mesh));
+size_t Model::addMesh(const std::vector<Vertex>& vertices) {
+  if (isPacked()) {
+    m_ranges.push_back(m_geometry->add(vertices));
+  } else {
+    auto mesh = std::make_unique<Mesh>(m_device);
+    mesh->load(vertices);
+    m_meshes.push_back(std::move(mesh));
+  }
+  m_instances.emplace_back();
+  return m_instances.size() - 1;
+}
+
+size_t Model::addMesh(const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices) {
+  if (isPacked()) {
+    m_ranges.push_back(m_geometry->add(vertices, indices));
+  } else {
+    auto mesh = std::make_unique<Mesh>(m_device);
+    mesh->load(vertices, indices);
+    m_meshes.push_back(std::move(mesh));
+  }
+  m_instances.emplace_back();
+  return m_instances.size() - 1;
+}
+
+size_t Model::addMesh(const Vertex* vertices, uint32_t vertexCount, const uint32_t* indices, uint32_t indexCount,
+                      const BoundingSphere& bounds) {
+  if (isPacked()) {
+    m_ranges.push_back(m_geometry->add(vertices, vertexCount, indices, indexCount, bounds));
+  } else {
+    auto mesh = std::make_unique<Mesh>(m_device);
+    mesh->load(vertices, vertexCount, indices, indexCount, bounds);
+    m_meshes.push_back(std::move(mesh));
+  }
+  m_instances.emplace_back();
+  return m_instances.size() - 1;
+}
+
+size_t Model::loadFromFile(const std::string& path) {
+  return loadFromFile(MeshFile(path));
+}
+
+size_t Model::loadFromFile(const MeshFile& file) {
+  size_t first = m_instances.size();
+
+  // O staging copia direto do mapeamento; o arquivo pode ser fechado ao fim do lote
+  UploadBatch batch(m_device.uploader());
+  for (uint32_t i = 0; i < file.getMeshCount(); i++) {
+    const MeshFileEntry& entry = file.getMesh(i);
+    addMesh(file.getVertices(entry), entry.vertexCount, file.getIndices(entry), entry.indexCount, entry.bounds);
+  }
+  return first;
 }
 
 void Model::recordDrawCommands(VkCommandBuffer commandBuffer) const {
-  for (const auto& mesh : m_meshes) {
-    mesh->recordDrawCommands(commandBuffer);
+  recordDrawCommands(commandBuffer, 0, getMeshCount());
+}
+
+void Model::recordDrawCommands(VkCommandBuffer commandBuffer, size_t firstMesh, size_t endMesh) const {
+  endMesh = std::min(endMesh, getMeshCount());
+  if (firstMesh >= endMesh) {
+    return;
+  }
+
+  if (isPacked()) {
+    recordPackedDraws(commandBuffer, m_indirectBuffer.getBuffer(), firstMesh, endMesh);
+    return;
+  }
+
+  if (!isInstanced()) {
+    for (size_t i = firstMesh; i < endMesh; i++) {
+      m_meshes[i]->recordDrawCommands(commandBuffer);
+    }
+    return;
+  }
+
+  // O instance buffer fica no binding 1 e não é trocado entre meshes;
+  // cada mesh aponta para sua faixa via firstInstance
+  VkBuffer instanceBuffers[] = { m_instanceBuffer.getBuffer() };
+  VkDeviceSize instanceOffsets[] = { 0 };
+  vkCmdBindVertexBuffers(commandBuffer, 1, 1, instanceBuffers, instanceOffsets);
+
+  for (size_t i = firstMesh; i < endMesh; i++) {
+    const InstanceRange& range = m_instanceRanges[i];
+    if (range.count > 0) {
+      m_meshes[i]->recordDrawCommands(commandBuffer, range.count, range.first);
+    }
+  }
+}
+
+void Model::enqueueDraws(RenderQueue& queue, const DrawItem& base, SortKey key, size_t firstMesh, size_t endMesh,
+                         const void* pushData, uint32_t pushSize, VkShaderStageFlags pushStages) const {
+  endMesh = std::min(endMesh, getMeshCount());
+  uint32_t meshBase = key.mesh;
+
+  for (size_t i = firstMesh; i < endMesh; i++) {
+    DrawItem item = base;
+    if (isPacked()) {
+      const MeshRange& range = m_ranges[i];
+      item.vertexBuffer = m_geometry->getVertexBuffer();
+      item.indexBuffer = m_geometry->getIndexBuffer();
+      item.indexType = VK_INDEX_TYPE_UINT32;
+      item.count = range.indexCount;
+      item.first = range.firstIndex;
+      item.vertexOffset = range.vertexOffset;
+    } else {
+      const Mesh& mesh = *m_meshes[i];
+      item.vertexBuffer = mesh.getVertexBuffer().getBuffer();
+      item.indexBuffer = mesh.getIndexBuffer().getBuffer();
+      item.indexType = mesh.getIndexBuffer().getIndexType();
+      item.count = static_cast<uint32_t>(mesh.getIndexCount());
+      item.first = 0;
+      item.vertexOffset = 0;
+    }
+
+    if (isInstanced()) {
+      const InstanceRange& range = m_instanceRanges[i];
+      if (range.count == 0) {
+        continue;
+      }
+      item.instanceBuffer = m_instanceBuffer.getBuffer();
+      item.instanceCount = range.count;
+      item.firstInstance = range.first;
+    }
+
+    key.mesh = meshBase + static_cast<uint32_t>(i);
+    item.key = key.pack();
+    queue.submit(item, pushData, pushSize, pushStages);
+  }
+}
+
+void Model::recordIndirectDraws(VkCommandBuffer commandBuffer, VkBuffer commands, VkBuffer countBuffer) const {
+  if (countBuffer == VK_NULL_HANDLE) {
+    recordPackedDraws(commandBuffer, commands, 0, getMeshCount());
+    return;
+  }
+  if (!canDrawIndirectCount()) {
+    throw std::runtime_error("Draw indirect count is not available for this model!");
+  }
+
+  VkBuffer instanceBuffers[] = { m_instanceBuffer.getBuffer() };
+  VkDeviceSize instanceOffsets[] = { 0 };
+  if (isInstanced()) {
+    vkCmdBindVertexBuffers(commandBuffer, 1, 1, instanceBuffers, instanceOffsets);
+  }
+  m_geometry->bind(commandBuffer);
+  m_device.cmdDrawIndexedIndirectCount()(commandBuffer, commands, 0, countBuffer, 0,
+                                         static_cast<uint32_t>(getMeshCount()),
+                                         static_cast<uint32_t>(sizeof(VkDrawIndexedIndirectCommand)));
+}
+
+void Model::recordPackedDraws(VkCommandBuffer commandBuffer, VkBuffer commands, size_t firstMesh, size_t endMesh) const {
+  // O instance buffer fica no binding 1 e não é trocado entre meshes;
+  // cada comando aponta para sua faixa via firstInstance
+  VkBuffer instanceBuffers[] = { m_instanceBuffer.getBuffer() };
+  VkDeviceSize instanceOffsets[] = { 0 };
+  if (isInstanced()) {
+    vkCmdBindVertexBuffers(commandBuffer, 1, 1, instanceBuffers, instanceOffsets);
+  }
+
+  // Geometria compartilhada: um bind para todos os meshes
+  m_geometry->bind(commandBuffer);
+  constexpr auto stride = static_cast<uint32_t>(sizeof(VkDrawIndexedIndirectCommand));
+
+  if (canMultiDraw()) {
+    vkCmdDrawIndexedIndirect(commandBuffer, commands, firstMesh * stride,
+                             static_cast<uint32_t>(endMesh - firstMesh), stride);
+    return;
+  }
+
+  // Fallback: um draw indireto por mesh; sem drawIndirectFirstInstance o
+  // comando traz firstInstance = 0 e a faixa é escolhida pelo offset do binding
+  for (size_t i = firstMesh; i < endMesh; i++) {
+    if (isInstanced()) {
+      const InstanceRange& range = m_instanceRanges[i];
+      if (range.count == 0) {
+        continue;
+      }
+      if (!m_device.features().drawIndirectFirstInstance) {
+        instanceOffsets[0] = sizeof(InstanceData) * static_cast<VkDeviceSize>(range.first);
+        vkCmdBindVertexBuffers(commandBuffer, 1, 1, instanceBuffers, instanceOffsets);
+      }
+    }
+    vkCmdDrawIndexedIndirect(commandBuffer, commands, i * stride, 1, stride);
+  }
+}
+
+bool Model::canDrawIndirectCount() const {
+  return isPacked() && m_device.features().drawIndirectCount &&
+         (!isInstanced() || m_device.features().drawIndirectFirstInstance);
+}
+
+bool Model::canMultiDraw() const {
+  return m_device.features().multiDrawIndirect &&
+         (!isInstanced() || m_device.features().drawIndirectFirstInstance);
+}
+
+uint32_t Model::getDrawCallCount(size_t firstMesh, size_t endMesh) const {
+  endMesh = std::min(endMesh, getMeshCount());
+  if (firstMesh >= endMesh) {
+    return 0;
+  }
+  if (isPacked() && canMultiDraw()) {
+    return 1;
+  }
+
+  uint32_t draws = 0;
+  for (size_t i = firstMesh; i < endMesh; i++) {
+    draws += !isInstanced() || m_instanceRanges[i].count > 0 ? 1 : 0;
+  }
+  return draws;
+}
+
+void Model::setInstances(size_t meshIndex, const std::vector<InstanceData>& instances) {
+  m_instances.at(meshIndex) = instances;
+}
+
+void Model::addInstance(size_t meshIndex, const InstanceData& instance) {
+  m_instances.at(meshIndex).push_back(instance);
+}
+
+void Model::clearInstances() {
+  for (auto& instances : m_instances) {
+    instances.clear();
+  }
+}
+
+void Model::uploadDrawData() {
+  // Instâncias de todos os meshes contíguas em um só buffer
+  std::vector<InstanceData> packed;
+  m_instanceRanges.assign(getMeshCount(), {});
+  for (size_t i = 0; i < m_instances.size(); i++) {
+    m_instanceRanges[i] = { static_cast<uint32_t>(packed.size()), static_cast<uint32_t>(m_instances[i].size()) };
+    packed.insert(packed.end(), m_instances[i].begin(), m_instances[i].end());
+  }
+  m_uploadedInstanceCount = static_cast<uint32_t>(packed.size());
+
+  if (packed.empty()) {
+    // Sem instâncias o model volta a desenhar cada mesh uma vez
+    m_instanceBuffer.destroy();
+  } else {
+    VkDeviceSize size = sizeof(InstanceData) * packed.size();
+    if (m_instanceBuffer.getSize() < size) {
+      m_instanceBuffer.destroy();
+      m_instanceBuffer.create(size,
+                              VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                              VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+    }
+    m_device.uploader().uploadToBuffer(m_instanceBuffer, packed.data(), size);
+  }
+
+  if (isPacked()) {
+    uploadIndirectCommands();
+  }
+}
+
+void Model::uploadIndirectCommands() {
+  std::vector<VkDrawIndexedIndirectCommand> commands(getMeshCount());
+  for (size_t i = 0; i < commands.size(); i++) {
+    const MeshRange& mesh = m_ranges[i];
+    VkDrawIndexedIndirectCommand& command = commands[i];
+    command.indexCount = mesh.indexCount;
+    command.firstIndex = mesh.firstIndex;
+    command.vertexOffset = mesh.vertexOffset;
+    command.instanceCount = isInstanced() ? m_instanceRanges[i].count : 1;
+    command.firstInstance = isInstanced() && m_device.features().drawIndirectFirstInstance
+                                ? m_instanceRanges[i].first : 0;
+  }
+
+  if (commands.empty()) {
+    m_indirectBuffer.destroy();
+    m_boundsBuffer.destroy();
+    return;
+  }
+
+  // Lidos também como storage buffers pelo culling na GPU
+  VkDeviceSize size = sizeof(VkDrawIndexedIndirectCommand) * commands.size();
+  if (m_indirectBuffer.getSize() < size) {
+    m_indirectBuffer.destroy();
+    m_indirectBuffer.create(size,
+                            VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT |
+                            VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                            VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+  }
+  m_device.uploader().uploadToBuffer(m_indirectBuffer, commands.data(), size);
+
+  std::vector<BoundingSphere> bounds(commands.size());
+  for (size_t i = 0; i < bounds.size(); i++) {
+    bounds[i] = getBounds(i);
+  }
+  VkDeviceSize boundsSize = sizeof(BoundingSphere) * bounds.size();
+  if (m_boundsBuffer.getSize() < boundsSize) {
+    m_boundsBuffer.destroy();
+    m_boundsBuffer.create(boundsSize,
+                          VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                          VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+  }
+  m_device.uploader().uploadToBuffer(m_boundsBuffer, bounds.data(), boundsSize);
+}
+
+BoundingSphere Model::getBounds(size_t meshIndex) const {
+  const BoundingSphere& mesh = isPacked() ? m_ranges[meshIndex].bounds : m_meshes[meshIndex]->getBounds();
+  return instanceBounds(mesh, m_instances[meshIndex]);
+}
+
+void Model::gatherBounds(BoundsSoA& outBounds) const {
+  outBounds.clear();
+  outBounds.reserve(getMeshCount());
+  for (size_t i = 0; i < getMeshCount(); i++) {
+    outBounds.add(getBounds(i));
   }
 }
 
@@ -26,6 +383,13 @@ void Model::destroy() {
     mesh->destroy();
   }
   m_meshes.clear();
+  m_ranges.clear();
+  m_instances.clear();
+  m_instanceRanges.clear();
+  m_indirectBuffer.destroy();
+  m_boundsBuffer.destroy();
+  m_instanceBuffer.destroy();
+  m_uploadedInstanceCount = 0;
 }
 
-} // namespace vke
\ No newline at end of file
+} // namespace vke
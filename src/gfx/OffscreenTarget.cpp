@@ -0,0 +1,93 @@
+#include "gfx/OffscreenTarget.h"
+#include "core/Device.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace vke {
+
+    OffscreenTarget::OffscreenTarget(Device& device, uint32_t width, uint32_t height, uint32_t imageCount,
+                                     VkFormat format)
+        : m_device(device)
+        , m_format(format)
+        , m_extent{ width, height }
+        , m_imageCount(std::max(imageCount, 1u))
+    {
+        createImages();
+    }
+
+    OffscreenTarget::~OffscreenTarget() {
+        destroyImages();
+    }
+
+    void OffscreenTarget::resize(uint32_t width, uint32_t height) {
+        destroyImages();
+        m_extent = { width, height };
+        createImages();
+    }
+
+    VkDeviceSize OffscreenTarget::getReadbackSize() const {
+        // Só formatos de 4 bytes por pixel são usados como alvo offscreen
+        return static_cast<VkDeviceSize>(m_extent.width) * m_extent.height * 4;
+    }
+
+    void OffscreenTarget::createImages() {
+        m_images.resize(m_imageCount);
+        m_imageViews.resize(m_imageCount);
+        m_allocations.resize(m_imageCount);
+
+        for (uint32_t i = 0; i < m_imageCount; i++) {
+            VkImageCreateInfo imageInfo{};
+            imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+            imageInfo.imageType = VK_IMAGE_TYPE_2D;
+            imageInfo.format = m_format;
+            imageInfo.extent = { m_extent.width, m_extent.height, 1 };
+            imageInfo.mipLevels = 1;
+            imageInfo.arrayLayers = 1;
+            imageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+            imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+            // TRANSFER_SRC permite copiar o frame de volta para o host
+            imageInfo.usage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
+            imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+            imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+
+            if (vkCreateImage(m_device.device(), &imageInfo, nullptr, &m_images[i]) != VK_SUCCESS) {
+                throw std::runtime_error("Failed to create offscreen image!");
+            }
+
+            m_allocations[i] = m_device.allocator().allocateForImage(m_images[i], VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+            vkBindImageMemory(m_device.device(), m_images[i], m_allocations[i].memory, m_allocations[i].offset);
+
+            VkImageViewCreateInfo viewInfo{};
+            viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+            viewInfo.image = m_images[i];
+            viewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
+            viewInfo.format = m_format;
+            viewInfo.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+            viewInfo.subresourceRange.baseMipLevel = 0;
+            viewInfo.subresourceRange.levelCount = 1;
+            viewInfo.subresourceRange.baseArrayLayer = 0;
+            viewInfo.subresourceRange.layerCount = 1;
+
+            if (vkCreateImageView(m_device.device(), &viewInfo, nullptr, &m_imageViews[i]) != VK_SUCCESS) {
+                throw std::runtime_error("Failed to create offscreen image view!");
+            }
+        }
+    }
+
+    void OffscreenTarget::destroyImages() {
+        for (auto imageView : m_imageViews) {
+            vkDestroyImageView(m_device.device(), imageView, nullptr);
+        }
+        for (auto image : m_images) {
+            vkDestroyImage(m_device.device(), image, nullptr);
+        }
+        for (auto& allocation : m_allocations) {
+            m_device.allocator().free(allocation);
+        }
+        m_imageViews.clear();
+        m_images.clear();
+        m_allocations.clear();
+    }
+
+} // namespace vke
@@ -0,0 +1,120 @@
+#include "gfx/ParallelRecorder.h"
+#include "core/Device.h"
+#include "core/JobSystem.h"
+
+#include <algorithm>
+#include <exception>
+#include <mutex>
+#include <stdexcept>
+
+namespace vke {
+
+    ParallelRecorder::ParallelRecorder(Device& device, JobSystem& jobs, uint32_t queueFamilyIndex,
+                                       uint32_t framesInFlight)
+        : m_device(device)
+        , m_jobs(jobs)
+    {
+        m_workerFrames.resize(m_jobs.getWorkerCount());
+        for (auto& frames : m_workerFrames) {
+            frames.resize(std::max(framesInFlight, 1u));
+            for (auto& frame : frames) {
+                VkCommandPoolCreateInfo poolInfo{};
+                poolInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+                poolInfo.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+                poolInfo.queueFamilyIndex = queueFamilyIndex;
+
+                if (vkCreateCommandPool(m_device.device(), &poolInfo, nullptr, &frame.commandPool) != VK_SUCCESS) {
+                    throw std::runtime_error("Failed to create command pool!");
+                }
+            }
+        }
+    }
+
+    ParallelRecorder::~ParallelRecorder() {
+        for (auto& frames : m_workerFrames) {
+            for (auto& frame : frames) {
+                vkDestroyCommandPool(m_device.device(), frame.commandPool, nullptr);
+            }
+        }
+    }
+
+    VkCommandBuffer ParallelRecorder::acquireCommandBuffer(WorkerFrame& frame) const {
+        if (frame.used == frame.commandBuffers.size()) {
+            VkCommandBufferAllocateInfo allocInfo{};
+            allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+            allocInfo.commandPool = frame.commandPool;
+            allocInfo.level = VK_COMMAND_BUFFER_LEVEL_SECONDARY;
+            allocInfo.commandBufferCount = 1;
+
+            VkCommandBuffer commandBuffer = VK_NULL_HANDLE;
+            if (vkAllocateCommandBuffers(m_device.device(), &allocInfo, &commandBuffer) != VK_SUCCESS) {
+                throw std::runtime_error("Failed to allocate secondary command buffer!");
+            }
+            frame.commandBuffers.push_back(commandBuffer);
+        }
+        return frame.commandBuffers[frame.used++];
+    }
+
+    const std::vector<VkCommandBuffer>& ParallelRecorder::record(uint32_t frameSlot,
+                                                                 const VkCommandBufferInheritanceInfo& inheritance,
+                                                                 uint32_t drawCount,
+                                                                 const RecordFn& recordFn) {
+        // Nenhum job deste slot está em execução: os pools podem ser resetados daqui
+        for (auto& frames : m_workerFrames) {
+            WorkerFrame& frame = frames[frameSlot];
+            if (frame.used > 0) {
+                vkResetCommandPool(m_device.device(), frame.commandPool, 0);
+                frame.used = 0;
+            }
+        }
+
+        // Faixas contíguas preservam a ordem original dos draws; cada faixa
+        // escreve seu secundário no próprio índice de m_executed
+        uint32_t chunkCount = std::clamp(drawCount / kMinDrawsPerThread, 1u, getThreadCount());
+        uint32_t chunkSize = (drawCount + chunkCount - 1) / chunkCount;
+        m_executed.assign(chunkCount, VK_NULL_HANDLE);
+
+        std::mutex errorMutex;
+        std::exception_ptr error;
+
+        m_jobs.parallelFor(chunkCount, 1, [&](uint32_t firstChunk, uint32_t endChunk) {
+            try {
+                // O worker que executa a faixa grava no seu próprio pool
+                WorkerFrame& frame = m_workerFrames[m_jobs.currentWorkerIndex()][frameSlot];
+                for (uint32_t chunk = firstChunk; chunk < endChunk; chunk++) {
+                    uint32_t begin = std::min(chunk * chunkSize, drawCount);
+                    uint32_t end = std::min(begin + chunkSize, drawCount);
+
+                    VkCommandBuffer commandBuffer = acquireCommandBuffer(frame);
+
+                    VkCommandBufferBeginInfo beginInfo{};
+                    beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+                    beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT |
+                                      VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT;
+                    beginInfo.pInheritanceInfo = &inheritance;
+
+                    if (vkBeginCommandBuffer(commandBuffer, &beginInfo) != VK_SUCCESS) {
+                        throw std::runtime_error("Failed to begin secondary command buffer!");
+                    }
+                    recordFn(commandBuffer, begin, end);
+                    if (vkEndCommandBuffer(commandBuffer) != VK_SUCCESS) {
+                        throw std::runtime_error("Failed to record secondary command buffer!");
+                    }
+                    m_executed[chunk] = commandBuffer;
+                }
+            } catch (...) {
+                // Jobs não podem lançar exceções; a primeira é relançada na thread chamadora
+                std::lock_guard lock(errorMutex);
+                if (!error) {
+                    error = std::current_exception();
+                }
+            }
+        });
+
+        if (error) {
+            std::rethrow_exception(error);
+        }
+        return m_executed;
+    }
+
+} // namespace vke
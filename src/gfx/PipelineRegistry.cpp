@@ -0,0 +1,337 @@
+#include "gfx/PipelineRegistry.h"
+#include "core/Device.h"
+#include "core/Profiler.h"
+
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+
+namespace vke {
+
+    void PipelineHandle::wait() const {
+        if (!m_request) {
+            return;
+        }
+        std::unique_lock lock(m_request->mutex);
+        m_request->done.wait(lock, [this] {
+            return m_request->status.load(std::memory_order_acquire) != PipelineRequest::Status::Pending;
+        });
+    }
+
+    size_t PipelineKeyHash::operator()(const PipelineKey& key) const {
+        // FNV-1a sobre os bytes da chave (sem padding, ver static_assert)
+        const auto* bytes = reinterpret_cast<const unsigned char*>(&key);
+        uint64_t hash = 14695981039346656037ull;
+        for (size_t i = 0; i < sizeof(PipelineKey); i++) {
+            hash = (hash ^ bytes[i]) * 1099511628211ull;
+        }
+        return static_cast<size_t>(hash);
+    }
+
+    PipelineRegistry::PipelineRegistry(Device& device)
+        : m_device(device)
+    {
+        // Layout vazio (sem descritores nem push constants) como id 0
+        VkPipelineLayoutCreateInfo pipelineLayoutInfo{};
+        pipelineLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+        pipelineLayoutInfo.setLayoutCount = 0;
+        pipelineLayoutInfo.pushConstantRangeCount = 0;
+
+        if (vkCreatePipelineLayout(m_device.device(), &pipelineLayoutInfo, nullptr, &m_emptyLayout) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to create pipeline layout!");
+        }
+        m_pipelineLayouts.push_back(m_emptyLayout);
+
+        m_worker = std::thread(&PipelineRegistry::workerLoop, this);
+    }
+
+    PipelineRegistry::~PipelineRegistry() {
+        {
+            std::lock_guard lock(m_mutex);
+            m_stopping = true;
+        }
+        m_queueCv.notify_all();
+        m_worker.join();
+
+        // Pedidos que nunca foram compilados são marcados como falhos
+        for (const auto& job : m_queue) {
+            auto it = m_pipelines.find(job.key);
+            if (it != m_pipelines.end()) {
+                std::lock_guard requestLock(it->second.request->mutex);
+                it->second.request->status.store(PipelineRequest::Status::Failed, std::memory_order_release);
+                it->second.request->done.notify_all();
+            }
+        }
+        m_queue.clear();
+        m_pipelines.clear();
+        for (auto module : m_shaderModules) {
+            vkDestroyShaderModule(m_device.device(), module, nullptr);
+        }
+        vkDestroyPipelineLayout(m_device.device(), m_emptyLayout, nullptr);
+    }
+
+    std::vector<char> PipelineRegistry::readFile(const std::string& filename) {
+        // Opens the file in binary mode and at the end to determine its size
+        std::ifstream file(filename, std::ios::ate | std::ios::binary);
+        if (!file.is_open()) {
+            throw std::runtime_error("Failed to open file: " + filename);
+        }
+
+        size_t fileSize = static_cast<size_t>(file.tellg());
+        std::vector<char> buffer(fileSize);
+
+        file.seekg(0);
+        file.read(buffer.data(), static_cast<std::streamsize>(fileSize));
+        return buffer;
+    }
+
+    VkShaderModule PipelineRegistry::createShaderModule(const std::vector<char>& code) const {
+        VkShaderModuleCreateInfo createInfo{};
+        createInfo.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
+        createInfo.codeSize = code.size();
+        createInfo.pCode = reinterpret_cast<const uint32_t*>(code.data());
+
+        VkShaderModule shaderModule;
+        if (vkCreateShaderModule(m_device.device(), &createInfo, nullptr, &shaderModule) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to create shader module!");
+        }
+        return shaderModule;
+    }
+
+    ShaderId PipelineRegistry::registerShader(const std::string& path) {
+        std::lock_guard lock(m_mutex);
+        for (size_t i = 0; i < m_shaderPaths.size(); i++) {
+            if (m_shaderPaths[i] == path) {
+                return static_cast<ShaderId>(i);
+            }
+        }
+
+        // Os módulos ficam vivos enquanto o registro existir: são reaproveitados
+        // por todas as permutações que usam o shader
+        m_shaderModules.push_back(createShaderModule(readFile(path)));
+        m_shaderPaths.push_back(path);
+        m_stats.shaderCount = static_cast<uint32_t>(m_shaderModules.size());
+        return static_cast<ShaderId>(m_shaderModules.size() - 1);
+    }
+
+    VkShaderModule PipelineRegistry::getShaderModule(ShaderId id) const {
+        std::lock_guard lock(m_mutex);
+        return m_shaderModules.at(id);
+    }
+
+    VertexLayoutId PipelineRegistry::registerVertexLayout(const VertexLayout& layout) {
+        auto sameBytes = [](const auto& a, const auto& b) {
+            return a.size() == b.size() &&
+                   (a.empty() || std::memcmp(a.data(), b.data(), a.size() * sizeof(a[0])) == 0);
+        };
+
+        std::lock_guard lock(m_mutex);
+        for (size_t i = 0; i < m_vertexLayouts.size(); i++) {
+            if (sameBytes(m_vertexLayouts[i].bindings, layout.bindings) &&
+                sameBytes(m_vertexLayouts[i].attributes, layout.attributes)) {
+                return static_cast<VertexLayoutId>(i);
+            }
+        }
+        m_vertexLayouts.push_back(layout);
+        return static_cast<VertexLayoutId>(m_vertexLayouts.size() - 1);
+    }
+
+    PipelineLayoutId PipelineRegistry::registerPipelineLayout(VkPipelineLayout layout) {
+        std::lock_guard lock(m_mutex);
+        for (size_t i = 0; i < m_pipelineLayouts.size(); i++) {
+            if (m_pipelineLayouts[i] == layout) {
+                return static_cast<PipelineLayoutId>(i);
+            }
+        }
+        m_pipelineLayouts.push_back(layout);
+        return static_cast<PipelineLayoutId>(m_pipelineLayouts.size() - 1);
+    }
+
+    VkPipelineLayout PipelineRegistry::getPipelineLayout(PipelineLayoutId id) const {
+        std::lock_guard lock(m_mutex);
+        return m_pipelineLayouts.at(id);
+    }
+
+    GraphicsPipelineDesc PipelineRegistry::resolve(const PipelineKey& key, VkRenderPass renderPass) const {
+        if (key.vertexShader >= m_shaderModules.size() || key.fragmentShader >= m_shaderModules.size() ||
+            key.vertexLayout >= m_vertexLayouts.size() || key.pipelineLayout >= m_pipelineLayouts.size()) {
+            throw std::runtime_error("Pipeline key references an unregistered id!");
+        }
+
+        GraphicsPipelineDesc desc{};
+        desc.vertexShader = m_shaderModules[key.vertexShader];
+        desc.fragmentShader = m_shaderModules[key.fragmentShader];
+        desc.vertexLayout = &m_vertexLayouts[key.vertexLayout];
+        desc.topology = static_cast<VkPrimitiveTopology>(key.topology);
+        desc.cullMode = key.cullMode;
+        desc.frontFace = static_cast<VkFrontFace>(key.frontFace);
+        desc.blend = static_cast<BlendMode>(key.blend);
+        desc.hasDepthAttachment = key.depthFormat != VK_FORMAT_UNDEFINED;
+        desc.depthTest = key.depthTest != 0;
+        desc.depthWrite = key.depthWrite != 0;
+        desc.depthCompare = static_cast<VkCompareOp>(key.depthCompare);
+        desc.samples = static_cast<VkSampleCountFlagBits>(key.samples);
+        desc.layout = m_pipelineLayouts[key.pipelineLayout];
+        desc.renderPass = renderPass;
+        if (renderPass == VK_NULL_HANDLE) {
+            desc.colorFormat = static_cast<VkFormat>(key.colorFormat);
+            desc.depthFormat = static_cast<VkFormat>(key.depthFormat);
+        }
+        return desc;
+    }
+
+    GraphicsPipelineDesc PipelineRegistry::describe(const PipelineKey& key, VkRenderPass renderPass) const {
+        PipelineKey target = targetKey(key, renderPass);
+        std::lock_guard lock(m_mutex);
+        return resolve(target, renderPass);
+    }
+
+    PipelineKey PipelineRegistry::targetKey(const PipelineKey& key, VkRenderPass renderPass) const {
+        // Validado antes de inserir a entrada, para não deixar um pedido pendente para sempre
+        if (renderPass == VK_NULL_HANDLE && !m_device.features().dynamicRendering) {
+            throw std::runtime_error("Pipeline requested without a render pass, but dynamic rendering is not enabled!");
+        }
+
+        // O mesmo material pedido com e sem render pass vira dois pipelines distintos
+        PipelineKey target = key;
+        target.dynamicRendering = renderPass == VK_NULL_HANDLE ? 1 : 0;
+        std::memset(target.reserved, 0, sizeof(target.reserved));
+        return target;
+    }
+
+    bool PipelineRegistry::findOrInsert(const PipelineKey& key, std::shared_ptr<PipelineRequest>& outRequest) {
+        auto it = m_pipelines.find(key);
+        if (it != m_pipelines.end()) {
+            m_stats.hits++;
+            outRequest = it->second.request;
+            return false;
+        }
+
+        outRequest = std::make_shared<PipelineRequest>();
+        m_pipelines.emplace(key, Entry{ outRequest, nullptr });
+        m_stats.misses++;
+        m_stats.pendingCount++;
+        return true;
+    }
+
+    PipelineHandle PipelineRegistry::requestPipeline(const PipelineKey& requested, VkRenderPass renderPass) {
+        PipelineKey key = targetKey(requested, renderPass);
+        std::shared_ptr<PipelineRequest> request;
+        {
+            std::lock_guard lock(m_mutex);
+            if (findOrInsert(key, request)) {
+                m_queue.push_back(CompileJob{ key, resolve(key, renderPass) });
+            }
+        }
+        m_queueCv.notify_one();
+        return PipelineHandle(std::move(request));
+    }
+
+    VkPipeline PipelineRegistry::getPipeline(const PipelineKey& requested, VkRenderPass renderPass) {
+        PipelineKey key = targetKey(requested, renderPass);
+        std::shared_ptr<PipelineRequest> request;
+        CompileJob job{};
+        bool compileHere;
+        {
+            std::lock_guard lock(m_mutex);
+            compileHere = findOrInsert(key, request);
+            if (compileHere) {
+                job = CompileJob{ key, resolve(key, renderPass) };
+            }
+        }
+
+        // Miss: compila nesta thread em vez de esperar a fila
+        if (compileHere) {
+            compile(job);
+        }
+
+        PipelineHandle handle(std::move(request));
+        handle.wait();
+        if (!handle.ready()) {
+            throw std::runtime_error("Failed to create graphics pipeline!");
+        }
+        return handle.get();
+    }
+
+    void PipelineRegistry::compile(const CompileJob& job) {
+        VKE_PROFILE_ZONE("compile_pipeline");
+        // A compilação roda fora do lock: vkCreateGraphicsPipelines e o
+        // VkPipelineCache podem ser usados de várias threads ao mesmo tempo
+        std::unique_ptr<GraphicsPipeline> pipeline;
+        try {
+            pipeline = std::make_unique<GraphicsPipeline>(m_device.device(), job.desc, m_device.pipelineCache().handle());
+        } catch (const std::exception& e) {
+            std::cerr << "Pipeline compilation failed: " << e.what() << std::endl;
+        }
+
+        std::shared_ptr<PipelineRequest> request;
+        {
+            std::lock_guard lock(m_mutex);
+            auto it = m_pipelines.find(job.key);
+            if (it == m_pipelines.end()) {
+                // Entrada apagada por clearPipelines(): não há a quem entregar o resultado
+                m_stats.pendingCount--;
+                m_idleCv.notify_all();
+                return;
+            }
+            request = it->second.request;
+            if (pipeline) {
+                request->pipeline = pipeline->getPipeline();
+                m_stats.compileMs += pipeline->getCreationMs();
+                it->second.pipeline = std::move(pipeline);
+            } else {
+                // Remove a entrada para que um pedido futuro tente de novo
+                m_pipelines.erase(it);
+            }
+            m_stats.pipelineCount = static_cast<uint32_t>(m_pipelines.size());
+            m_stats.pendingCount--;
+        }
+
+        {
+            std::lock_guard requestLock(request->mutex);
+            request->status.store(request->pipeline != VK_NULL_HANDLE ? PipelineRequest::Status::Ready
+                                                                      : PipelineRequest::Status::Failed,
+                                  std::memory_order_release);
+        }
+        request->done.notify_all();
+        m_idleCv.notify_all();
+    }
+
+    void PipelineRegistry::workerLoop() {
+        VKE_PROFILE_THREAD("Pipeline compiler");
+        while (true) {
+            CompileJob job;
+            {
+                std::unique_lock lock(m_mutex);
+                m_queueCv.wait(lock, [this] { return m_stopping || !m_queue.empty(); });
+                if (m_stopping) {
+                    return;
+                }
+                job = m_queue.front();
+                m_queue.pop_front();
+            }
+            compile(job);
+        }
+    }
+
+    void PipelineRegistry::waitIdle() {
+        std::unique_lock lock(m_mutex);
+        m_idleCv.wait(lock, [this] { return m_stats.pendingCount == 0; });
+    }
+
+    PipelineRegistryStats PipelineRegistry::getStats() const {
+        std::lock_guard lock(m_mutex);
+        return m_stats;
+    }
+
+    void PipelineRegistry::clearPipelines() {
+        // Nenhuma compilação pode estar escrevendo numa entrada que vamos apagar. Espera
+        // e limpa sob o mesmo lock, senão um requestPipeline no meio enfileira um job
+        // cuja entrada some
+        std::unique_lock lock(m_mutex);
+        m_idleCv.wait(lock, [this] { return m_stats.pendingCount == 0; });
+        m_pipelines.clear();
+        m_stats.pipelineCount = 0;
+    }
+
+} // namespace vke
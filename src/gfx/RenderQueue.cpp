@@ -0,0 +1,204 @@
+#include "gfx/RenderQueue.h"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+
+namespace vke {
+
+    namespace {
+
+        constexpr int kRadixBits = 8;
+        constexpr int kRadixPasses = 64 / kRadixBits;
+        constexpr uint32_t kBuckets = 1u << kRadixBits;
+
+        // Push constants exigem offset e tamanho múltiplos de 4
+        constexpr uint32_t kPushAlignment = 4;
+
+        uint64_t field(uint32_t value, uint32_t bits, uint32_t shift) {
+            return (static_cast<uint64_t>(value) & ((1ull << bits) - 1)) << shift;
+        }
+
+    } // namespace
+
+    uint64_t SortKey::pack() const {
+        return field(pass, 4, 60) | field(pipeline, 12, 48) | field(material, 16, 32) |
+               field(mesh, 16, 16) | field(depth, 16, 0);
+    }
+
+    uint32_t SortKey::quantizeDepth(float depth, bool backToFront) {
+        auto quantized = static_cast<uint32_t>(std::clamp(depth, 0.0f, 1.0f) * 65535.0f + 0.5f);
+        return backToFront ? 65535u - quantized : quantized;
+    }
+
+    RenderQueueStats& RenderQueueStats::operator+=(const RenderQueueStats& other) {
+        draws += other.draws;
+        pipelineBinds += other.pipelineBinds;
+        descriptorBinds += other.descriptorBinds;
+        vertexBinds += other.vertexBinds;
+        indexBinds += other.indexBinds;
+        pipelineBindsSkipped += other.pipelineBindsSkipped;
+        descriptorBindsSkipped += other.descriptorBindsSkipped;
+        vertexBindsSkipped += other.vertexBindsSkipped;
+        indexBindsSkipped += other.indexBindsSkipped;
+        return *this;
+    }
+
+    RenderQueue::RenderQueue(uint32_t materialSetIndex)
+        : m_materialSet(materialSetIndex)
+    {
+    }
+
+    void RenderQueue::reserve(size_t items) {
+        m_items.reserve(items);
+        m_entries.reserve(items);
+        m_scratch.reserve(items);
+    }
+
+    void RenderQueue::clear() {
+        m_items.clear();
+        m_entries.clear();
+        m_pushData.clear();
+    }
+
+    void RenderQueue::submit(const DrawItem& item, const void* pushData, uint32_t pushSize, VkShaderStageFlags pushStages) {
+        auto index = static_cast<uint32_t>(m_items.size());
+        m_items.push_back(item);
+        m_entries.push_back({ item.key, index });
+
+        DrawItem& stored = m_items.back();
+        stored.pushStages = pushData != nullptr ? pushStages : 0;
+        stored.pushOffset = static_cast<uint32_t>(m_pushData.size());
+        stored.pushSize = pushData != nullptr ? pushSize : 0;
+        if (stored.pushSize > 0) {
+            uint32_t padded = (pushSize + kPushAlignment - 1) / kPushAlignment * kPushAlignment;
+            m_pushData.resize(m_pushData.size() + padded);
+            std::memcpy(m_pushData.data() + stored.pushOffset, pushData, pushSize);
+        }
+    }
+
+    void RenderQueue::sort() {
+        size_t count = m_entries.size();
+        if (count < 2) {
+            return;
+        }
+        m_scratch.resize(count);
+
+        // Histogramas de todos os bytes numa única leitura das chaves
+        std::array<std::array<uint32_t, kBuckets>, kRadixPasses> histograms{};
+        for (const Entry& entry : m_entries) {
+            for (int pass = 0; pass < kRadixPasses; pass++) {
+                histograms[pass][(entry.key >> (pass * kRadixBits)) & (kBuckets - 1)]++;
+            }
+        }
+
+        Entry* source = m_entries.data();
+        Entry* destination = m_scratch.data();
+        for (int pass = 0; pass < kRadixPasses; pass++) {
+            std::array<uint32_t, kBuckets>& histogram = histograms[pass];
+            int shift = pass * kRadixBits;
+
+            // Byte igual em todas as chaves: a passada não mudaria a ordem
+            if (histogram[(source[0].key >> shift) & (kBuckets - 1)] == count) {
+                continue;
+            }
+
+            uint32_t offset = 0;
+            for (uint32_t bucket = 0; bucket < kBuckets; bucket++) {
+                uint32_t bucketCount = histogram[bucket];
+                histogram[bucket] = offset;
+                offset += bucketCount;
+            }
+            for (size_t i = 0; i < count; i++) {
+                destination[histogram[(source[i].key >> shift) & (kBuckets - 1)]++] = source[i];
+            }
+            std::swap(source, destination);
+        }
+
+        if (source != m_entries.data()) {
+            m_entries.swap(m_scratch);
+        }
+    }
+
+    RenderQueueStats RenderQueue::record(VkCommandBuffer commandBuffer, uint32_t first, uint32_t end) const {
+        RenderQueueStats stats;
+        end = std::min(end, size());
+
+        VkPipeline pipeline = VK_NULL_HANDLE;
+        VkPipelineLayout layout = VK_NULL_HANDLE;
+        VkDescriptorSet materialSet = VK_NULL_HANDLE;
+        VkBuffer vertexBuffer = VK_NULL_HANDLE;
+        VkBuffer instanceBuffer = VK_NULL_HANDLE;
+        VkBuffer indexBuffer = VK_NULL_HANDLE;
+        VkIndexType indexType = VK_INDEX_TYPE_UINT32;
+        constexpr VkDeviceSize kZeroOffset = 0;
+
+        for (uint32_t position = first; position < end; position++) {
+            const DrawItem& item = at(position);
+
+            if (item.pipeline != pipeline) {
+                vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, item.pipeline);
+                pipeline = item.pipeline;
+                stats.pipelineBinds++;
+            } else {
+                stats.pipelineBindsSkipped++;
+            }
+
+            // Outro layout pode não ser compatível no set do material: liga de novo
+            if (item.layout != layout) {
+                layout = item.layout;
+                materialSet = VK_NULL_HANDLE;
+            }
+            if (item.materialSet != VK_NULL_HANDLE) {
+                if (item.materialSet != materialSet) {
+                    vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, item.layout,
+                                            m_materialSet, 1, &item.materialSet, 0, nullptr);
+                    materialSet = item.materialSet;
+                    stats.descriptorBinds++;
+                } else {
+                    stats.descriptorBindsSkipped++;
+                }
+            }
+
+            if (item.vertexBuffer != vertexBuffer) {
+                vkCmdBindVertexBuffers(commandBuffer, 0, 1, &item.vertexBuffer, &kZeroOffset);
+                vertexBuffer = item.vertexBuffer;
+                stats.vertexBinds++;
+            } else {
+                stats.vertexBindsSkipped++;
+            }
+            if (item.instanceBuffer != VK_NULL_HANDLE) {
+                if (item.instanceBuffer != instanceBuffer) {
+                    vkCmdBindVertexBuffers(commandBuffer, 1, 1, &item.instanceBuffer, &kZeroOffset);
+                    instanceBuffer = item.instanceBuffer;
+                    stats.vertexBinds++;
+                } else {
+                    stats.vertexBindsSkipped++;
+                }
+            }
+
+            if (item.pushSize > 0) {
+                vkCmdPushConstants(commandBuffer, item.layout, item.pushStages, 0, item.pushSize,
+                                   m_pushData.data() + item.pushOffset);
+            }
+
+            if (item.indexBuffer == VK_NULL_HANDLE) {
+                vkCmdDraw(commandBuffer, item.count, item.instanceCount, item.first, item.firstInstance);
+            } else {
+                if (item.indexBuffer != indexBuffer || item.indexType != indexType) {
+                    vkCmdBindIndexBuffer(commandBuffer, item.indexBuffer, 0, item.indexType);
+                    indexBuffer = item.indexBuffer;
+                    indexType = item.indexType;
+                    stats.indexBinds++;
+                } else {
+                    stats.indexBindsSkipped++;
+                }
+                vkCmdDrawIndexed(commandBuffer, item.count, item.instanceCount, item.first, item.vertexOffset,
+                                 item.firstInstance);
+            }
+            stats.draws++;
+        }
+        return stats;
+    }
+
+} // namespace vke
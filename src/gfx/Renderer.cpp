@@ -1,70 +1,280 @@
 #include "gfx/Renderer.h"
-#include "gfx/GraphicsPipeline.h"
+#include "core/Device.h"
+#include "core/Profiler.h"
+#include "gfx/Buffer.h"
+#include "gfx/FrameArena.h"
+#include "gfx/GeometryPool.h"
+#include "gfx/GpuCuller.h"
+#include "gfx/GpuProfiler.h"
 #include "gfx/Model.h"
+#include "gfx/OffscreenTarget.h"
+#include "gfx/ParallelRecorder.h"
+#include "gfx/PipelineRegistry.h"
+#include "gfx/ResourceTable.h"
+#include "gfx/UploadContext.h"
 #include "gfx/Vertex.h"
+#include "scene/Scene.h"
+#include "util/GltfImporter.h"
+#include "util/MeshFile.h"
 
+#include <algorithm>
 #include <array>
+#include <cctype>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <stdexcept>
 #include <vector>
 
+namespace {
+
+    // Bloco uniform Frame de vert_scene.glsl (std140)
+    struct FrameUniforms {
+        std::array<float, 16> viewProjection;
+    };
+
+    // Pool do tamanho exato do model carregado: o padrão de GeometryPool não
+    // comporta cenas grandes e o pool não cresce depois de criado
+    std::unique_ptr<vke::GeometryPool> createGeometryPool(vke::Device& device, uint64_t vertexCount, uint64_t indexCount) {
+        if (vertexCount > UINT32_MAX || indexCount > UINT32_MAX) {
+            throw std::runtime_error("Model is too large for the geometry pool!");
+        }
+        // Buffers Vulkan não podem ter tamanho zero
+        return std::make_unique<vke::GeometryPool>(device, std::max<uint32_t>(static_cast<uint32_t>(vertexCount), 1),
+                                                   std::max<uint32_t>(static_cast<uint32_t>(indexCount), 1));
+    }
+
+} // namespace
+
 Renderer::Renderer(
-    VkDevice device,
-    VkPhysicalDevice physicalDevice,
-    const SwapChain& swapChain,
+    vke::Device& device,
+    vke::JobSystem& jobs,
+    SwapChain& swapChain,
     VkQueue graphicsQueue,
     VkQueue presentQueue,
-    uint32_t graphicsQueueFamilyIndex
+    uint32_t graphicsQueueFamilyIndex,
+    uint32_t framesInFlight
 )
     : m_device(device),
-      m_physicalDevice(physicalDevice),
-      m_swapChain(swapChain),
+      m_jobs(jobs),
+      m_swapChain(&swapChain),
       m_graphicsQueue(graphicsQueue),
       m_presentQueue(presentQueue),
-      m_graphicsQueueFamilyIndex(graphicsQueueFamilyIndex)
+      m_graphicsQueueFamilyIndex(graphicsQueueFamilyIndex),
+      m_frames(std::max(framesInFlight, 1u))
 {
-    // Creates a render pass,
-    createRenderPass();
-    createFramebuffers();
-    createCommandPool();
-
-    // Creates a model and a graphics pipeline
-    m_graphicsPipeline = std::make_unique<vke::GraphicsPipeline>(m_device, m_renderPass, m_swapChain.getExtent());
-
-    //
-    m_model = std::make_unique<vke::Model>(m_device, m_physicalDevice);
-    std::vector<vke::Vertex> triangleVertices = {
-        { { 0.0f,  -0.5f }, { 1.0f, 0.0f, 0.0f } },
-        { { 0.5f,   0.5f }, { 0.0f, 1.0f, 0.0f } },
-        { { -0.5f, -0.5f }, { 0.0f, 0.0f, 1.0f } }
-    };
-    m_model->addMesh(triangleVertices);
+    init();
+}
+
+Renderer::Renderer(
+    vke::Device& device,
+    vke::JobSystem& jobs,
+    vke::OffscreenTarget& target,
+    VkQueue graphicsQueue,
+    uint32_t graphicsQueueFamilyIndex,
+    uint32_t framesInFlight
+)
+    : m_device(device),
+      m_jobs(jobs),
+      m_offscreen(&target),
+      m_graphicsQueue(graphicsQueue),
+      m_presentQueue(VK_NULL_HANDLE),
+      m_graphicsQueueFamilyIndex(graphicsQueueFamilyIndex),
+      m_frames(std::max(framesInFlight, 1u))
+{
+    // Cada slot renderiza sempre na sua própria imagem
+    if (target.getImages().size() < m_frames.size()) {
+        throw std::runtime_error("Offscreen target needs one image per frame in flight!");
+    }
+    init();
+}
+
+void Renderer::init() {
+    // Com dynamic rendering não há render pass nem framebuffers a manter
+    // (nem a recriar no resize): os attachments vão direto no command buffer
+    m_dynamicRendering = m_device.features().dynamicRendering;
+    if (!m_dynamicRendering) {
+        createRenderPass();
+        createFramebuffers();
+    }
+    createFrameResources();
+    createFrameUniforms();
+    m_recorder = std::make_unique<vke::ParallelRecorder>(m_device, m_jobs, m_graphicsQueueFamilyIndex,
+                                                         static_cast<uint32_t>(m_frames.size()));
 
-    // Create command buffers and synchronization objects
-    createCommandBuffers();
+    // Descreve o pipeline do model como chave do registro; materiais com a
+    // mesma permutação compartilham o VkPipeline. A compilação vai para a
+    // thread de fundo e se sobrepõe ao upload do model logo abaixo.
+    vke::PipelineRegistry& pipelines = m_device.pipelines();
+    m_pipelineKey.vertexShader = pipelines.registerShader("shaders/vert_scene.spv");
+    m_pipelineKey.fragmentShader = pipelines.registerShader("shaders/frag.spv");
+    m_pipelineKey.vertexLayout = pipelines.registerVertexLayout(vke::Vertex::getInstancedVertexLayout());
+    m_pipelineKey.pipelineLayout = pipelines.registerPipelineLayout(m_framePipelineLayout);
+    m_pipelineKey.colorFormat = targetFormat();
+    // Sem render pass (VK_NULL_HANDLE) o pipeline é criado contra os formatos da chave
+    m_pipelineHandle = pipelines.requestPipeline(m_pipelineKey, m_renderPass);
+
+    // Todos os meshes do model sobem em um único lote de upload, para dentro
+    // do pool compartilhado: a cena inteira sai em um draw indireto
+    m_geometry = std::make_unique<vke::GeometryPool>(m_device);
+    m_model = std::make_unique<vke::Model>(m_device, *m_geometry);
+    {
+        vke::UploadBatch uploadBatch(m_device.uploader());
+        std::vector<vke::Vertex> triangleVertices = {
+            { { 0.0f,  -0.5f }, { 1.0f, 0.0f, 0.0f } },
+            { { 0.5f,   0.5f }, { 0.0f, 1.0f, 0.0f } },
+            { { -0.5f, -0.5f }, { 0.0f, 0.0f, 1.0f } }
+        };
+        // Cópias do mesmo mesh viram instâncias de um único draw
+        size_t triangle = m_model->addMesh(triangleVertices);
+        m_model->addInstance(triangle, { { 0.0f, 0.0f }, 1.0f });
+        m_model->uploadDrawData();
+    }
+
+    // Sem depth buffer ainda não há pirâmide Hi-Z: o culling roda só contra o frustum
+    m_culler = std::make_unique<vke::GpuCuller>(m_device, static_cast<uint32_t>(m_frames.size()));
+    m_resources = std::make_unique<vke::ResourceTable>(m_device, static_cast<uint32_t>(m_frames.size()));
+    m_gpuProfiler = std::make_unique<vke::GpuProfiler>(m_device, static_cast<uint32_t>(m_frames.size()));
+
+    // Command buffers são gravados a cada frame; aqui só a sincronização
     createSyncObjects();
 }
 
-Renderer::~Renderer() {
-    // Espera a fila terminar antes de destruir recursos
-    vkDeviceWaitIdle(m_device);
+void Renderer::loadModel(const std::string& path) {
+    VKE_PROFILE_ZONE("Renderer::loadModel");
+    // Frames em voo ainda leem o pool e os buffers de desenho do model atual
+    vkDeviceWaitIdle(m_device.device());
 
-    // Limpa sincronização
-    vkDestroySemaphore(m_device, m_imageAvailableSemaphore, nullptr);
-    vkDestroySemaphore(m_device, m_renderFinishedSemaphore, nullptr);
-    vkDestroyFence(m_device, m_inFlightFence, nullptr);
+    std::unique_ptr<vke::GeometryPool> geometry;
+    std::unique_ptr<vke::Model> model;
+    std::string extension = std::filesystem::path(path).extension().string();
+    std::transform(extension.begin(), extension.end(), extension.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    if (extension == ".gltf" || extension == ".glb") {
+        loadGltf(path, geometry, model);
+    } else {
+        vke::MeshFile file(path);
+        uint64_t vertexCount = 0;
+        uint64_t indexCount = 0;
+        for (uint32_t i = 0; i < file.getMeshCount(); i++) {
+            vertexCount += file.getMesh(i).vertexCount;
+            indexCount += file.getMesh(i).indexCount;
+        }
+        geometry = createGeometryPool(m_device, vertexCount, indexCount);
+        model = std::make_unique<vke::Model>(m_device, *geometry);
+        size_t first = model->loadFromFile(file);
+        for (size_t mesh = first; mesh < model->getMeshCount(); mesh++) {
+            model->addInstance(mesh, { { 0.0f, 0.0f }, 1.0f });
+        }
+    }
+    model->uploadDrawData();
+
+    // O model referencia o pool: sai antes dele
+    m_model = std::move(model);
+    m_geometry = std::move(geometry);
+}
 
-    // Destrói command pool (isso libera command buffers também)
-    if (m_commandPool != VK_NULL_HANDLE) {
-        vkDestroyCommandPool(m_device, m_commandPool, nullptr);
+void Renderer::loadGltf(const std::string& path, std::unique_ptr<vke::GeometryPool>& geometry,
+                        std::unique_ptr<vke::Model>& model) {
+    // Primitivas decodificadas em paralelo; o upload sai em um lote só
+    vke::GltfAsset asset = vke::GltfImporter::load(path, &m_jobs);
+
+    // Só desenha o que a cena padrão alcança: meshes de outras cenas, LODs e
+    // meshes soltos não sobem para a GPU
+    vke::Scene scene;
+    std::vector<vke::SceneNode> handles = asset.instantiate(scene);
+    scene.updateTransforms(&m_jobs);
+    std::vector<uint8_t> meshUsed(asset.meshes.size(), 0);
+    for (size_t node = 0; node < asset.nodes.size(); node++) {
+        if (asset.nodes[node].mesh != vke::GltfNode::kNoMesh && !handles[node].isNull()) {
+            meshUsed[asset.nodes[node].mesh] = 1;
+        }
     }
 
-    // Destrói framebuffers
-    for (auto framebuffer : m_framebuffers) {
-        vkDestroyFramebuffer(m_device, framebuffer, nullptr);
+    uint64_t vertexCount = 0;
+    uint64_t indexCount = 0;
+    for (size_t mesh = 0; mesh < asset.meshes.size(); mesh++) {
+        if (!meshUsed[mesh]) {
+            continue;
+        }
+        const vke::GltfMesh& gltfMesh = asset.meshes[mesh];
+        for (uint32_t p = gltfMesh.firstPrimitive; p < gltfMesh.firstPrimitive + gltfMesh.primitiveCount; p++) {
+            if (!asset.primitives[p].indices.empty()) {
+                vertexCount += asset.primitives[p].vertices.size();
+                indexCount += asset.primitives[p].indices.size();
+            }
+        }
+    }
+    geometry = createGeometryPool(m_device, vertexCount, indexCount);
+    model = std::make_unique<vke::Model>(m_device, *geometry);
+
+    std::vector<size_t> meshOfPrimitive(asset.primitives.size(), SIZE_MAX);
+    {
+        vke::UploadBatch uploadBatch(m_device.uploader());
+        for (size_t mesh = 0; mesh < asset.meshes.size(); mesh++) {
+            if (!meshUsed[mesh]) {
+                continue;
+            }
+            const vke::GltfMesh& gltfMesh = asset.meshes[mesh];
+            for (uint32_t p = gltfMesh.firstPrimitive; p < gltfMesh.firstPrimitive + gltfMesh.primitiveCount; p++) {
+                const vke::GltfPrimitive& primitive = asset.primitives[p];
+                if (!primitive.indices.empty()) {
+                    meshOfPrimitive[p] = model->addMesh(primitive.vertices.data(),
+                                                        static_cast<uint32_t>(primitive.vertices.size()),
+                                                        primitive.indices.data(),
+                                                        static_cast<uint32_t>(primitive.indices.size()),
+                                                        primitive.bounds);
+                }
+            }
+        }
     }
 
+    // InstanceData só tem offset 2D e escala: rotação e z dos nós são descartados.
+    // Todo mesh enviado tem ao menos um nó na cena, logo ao menos uma instância
+    for (size_t node = 0; node < asset.nodes.size(); node++) {
+        uint32_t meshIndex = asset.nodes[node].mesh;
+        if (meshIndex == vke::GltfNode::kNoMesh || handles[node].isNull()) {
+            continue;
+        }
+        const vke::Mat4& world = scene.getWorldMatrix(handles[node]);
+        float scale = std::sqrt(world[0] * world[0] + world[1] * world[1] + world[2] * world[2]);
+        const vke::GltfMesh& mesh = asset.meshes[meshIndex];
+        for (uint32_t p = mesh.firstPrimitive; p < mesh.firstPrimitive + mesh.primitiveCount; p++) {
+            if (meshOfPrimitive[p] != SIZE_MAX) {
+                model->addInstance(meshOfPrimitive[p], { { world[12], world[13] }, scale });
+            }
+        }
+    }
+}
+
+Renderer::~Renderer() {
+    // Espera a fila e as compilações que usam a render pass terminarem antes de destruir recursos
+    vkDeviceWaitIdle(m_device.device());
+    m_device.pipelines().waitIdle();
+
+    // Limpa sincronização e os pools de cada frame (isso libera command buffers também)
+    for (auto& frame : m_frames) {
+        vkDestroySemaphore(m_device.device(), frame.imageAvailable, nullptr);
+        vkDestroyFence(m_device.device(), frame.inFlight, nullptr);
+        if (frame.commandPool != VK_NULL_HANDLE) {
+            vkDestroyCommandPool(m_device.device(), frame.commandPool, nullptr);
+        }
+    }
+    for (auto semaphore : m_renderFinishedSemaphores) {
+        vkDestroySemaphore(m_device.device(), semaphore, nullptr);
+    }
+
+    destroyFramebuffers();
+
+    vkDestroyDescriptorPool(m_device.device(), m_frameDescriptorPool, nullptr);
+    vkDestroyPipelineLayout(m_device.device(), m_framePipelineLayout, nullptr);
+    vkDestroyDescriptorSetLayout(m_device.device(), m_frameSetLayout, nullptr);
+
     // Destrói render pass
     if (m_renderPass != VK_NULL_HANDLE) {
-        vkDestroyRenderPass(m_device, m_renderPass, nullptr);
+        vkDestroyRenderPass(m_device.device(), m_renderPass, nullptr);
     }
 }
 
@@ -73,14 +283,16 @@ Renderer::~Renderer() {
 // ------------------------------------------------------
 void Renderer::createRenderPass() {
     VkAttachmentDescription colorAttachment{};
-    colorAttachment.format = m_swapChain.getImageFormat();
+    colorAttachment.format = targetFormat();
     colorAttachment.samples = VK_SAMPLE_COUNT_1_BIT;
     colorAttachment.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;     // Limpa antes de desenhar
     colorAttachment.storeOp = VK_ATTACHMENT_STORE_OP_STORE;   // Armazena para apresentar
     colorAttachment.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
     colorAttachment.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
     colorAttachment.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-    colorAttachment.finalLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+    // Headless: a imagem termina pronta para ser copiada de volta ao host
+    colorAttachment.finalLayout = isHeadless() ? VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL
+                                               : VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
 
     VkAttachmentReference colorAttachmentRef{};
     colorAttachmentRef.attachment = 0; // Índice do attachment no vetor de attachments
@@ -109,16 +321,33 @@ void Renderer::createRenderPass() {
     renderPassInfo.dependencyCount = 1;
     renderPassInfo.pDependencies = &dependency;
 
-    if (vkCreateRenderPass(m_device, &renderPassInfo, nullptr, &m_renderPass) != VK_SUCCESS) {
+    if (vkCreateRenderPass(m_device.device(), &renderPassInfo, nullptr, &m_renderPass) != VK_SUCCESS) {
         throw std::runtime_error("Failed to create render pass!");
     }
 }
 
+VkExtent2D Renderer::getExtent() const {
+    return m_swapChain ? m_swapChain->getExtent() : m_offscreen->getExtent();
+}
+
+VkFormat Renderer::targetFormat() const {
+    return m_swapChain ? m_swapChain->getImageFormat() : m_offscreen->getImageFormat();
+}
+
+const std::vector<VkImageView>& Renderer::targetImageViews() const {
+    return m_swapChain ? m_swapChain->getImageViews() : m_offscreen->getImageViews();
+}
+
+VkImage Renderer::targetImage(uint32_t imageIndex) const {
+    return m_swapChain ? m_swapChain->getImages()[imageIndex] : m_offscreen->getImages()[imageIndex];
+}
+
 // ------------------------------------------------------
-// Cria um framebuffer para cada image view da swapchain
+// Cria um framebuffer para cada image view do alvo (swapchain ou offscreen)
 // ------------------------------------------------------
 void Renderer::createFramebuffers() {
-    const auto& imageViews = m_swapChain.getImageViews();
+    const auto& imageViews = targetImageViews();
+    VkExtent2D extent = getExtent();
     m_framebuffers.resize(imageViews.size());
 
     for (size_t i = 0; i < imageViews.size(); i++) {
@@ -129,89 +358,323 @@ void Renderer::createFramebuffers() {
         framebufferInfo.renderPass = m_renderPass;
         framebufferInfo.attachmentCount = 1;
         framebufferInfo.pAttachments = attachments;
-        framebufferInfo.width = m_swapChain.getExtent().width;
-        framebufferInfo.height = m_swapChain.getExtent().height;
+        framebufferInfo.width = extent.width;
+        framebufferInfo.height = extent.height;
         framebufferInfo.layers = 1;
 
-        if (vkCreateFramebuffer(m_device, &framebufferInfo, nullptr, &m_framebuffers[i]) != VK_SUCCESS) {
+        if (vkCreateFramebuffer(m_device.device(), &framebufferInfo, nullptr, &m_framebuffers[i]) != VK_SUCCESS) {
             throw std::runtime_error("Failed to create framebuffer!");
         }
     }
 }
 
 // ------------------------------------------------------
-// Cria command pool para alocar command buffers
+// Cria, para cada frame em voo, um command pool próprio e seu command buffer.
+// Resetar o pool inteiro a cada frame é mais barato que resetar buffers avulsos.
+// ------------------------------------------------------
+void Renderer::createFrameResources() {
+    for (auto& frame : m_frames) {
+        VkCommandPoolCreateInfo poolInfo{};
+        poolInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+        poolInfo.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+        poolInfo.queueFamilyIndex = m_graphicsQueueFamilyIndex;
+
+        if (vkCreateCommandPool(m_device.device(), &poolInfo, nullptr, &frame.commandPool) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to create command pool!");
+        }
+
+        VkCommandBufferAllocateInfo allocInfo{};
+        allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+        allocInfo.commandPool = frame.commandPool;
+        allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+        allocInfo.commandBufferCount = 1;
+
+        if (vkAllocateCommandBuffers(m_device.device(), &allocInfo, &frame.commandBuffer) != VK_SUCCESS) {
+            throw std::runtime_error("Falha ao alocar command buffers!");
+        }
+    }
+}
+
+// ------------------------------------------------------
+// Cria o arena de constantes por frame e o descriptor que o expõe ao vertex
+// shader. O set é um só: o offset de cada frame vai como dynamic offset.
 // ------------------------------------------------------
-void Renderer::createCommandPool() {
-    VkCommandPoolCreateInfo poolInfo{};
-    poolInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
-    // Se quiser resetar command buffers individualmente, use:
-    // poolInfo.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
-    poolInfo.queueFamilyIndex = m_graphicsQueueFamilyIndex;
+void Renderer::createFrameUniforms() {
+    m_frameArena = std::make_unique<vke::FrameArena>(m_device, static_cast<uint32_t>(m_frames.size()));
+
+    VkDescriptorSetLayoutBinding binding{};
+    binding.binding = 0;
+    binding.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+    binding.descriptorCount = 1;
+    binding.stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
 
-    if (vkCreateCommandPool(m_device, &poolInfo, nullptr, &m_commandPool) != VK_SUCCESS) {
-        throw std::runtime_error("Failed to create command pool!");
+    VkDescriptorSetLayoutCreateInfo setLayoutInfo{};
+    setLayoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+    setLayoutInfo.bindingCount = 1;
+    setLayoutInfo.pBindings = &binding;
+    if (vkCreateDescriptorSetLayout(m_device.device(), &setLayoutInfo, nullptr, &m_frameSetLayout) != VK_SUCCESS) {
+        throw std::runtime_error("Failed to create frame descriptor set layout!");
     }
+
+    VkPipelineLayoutCreateInfo layoutInfo{};
+    layoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+    layoutInfo.setLayoutCount = 1;
+    layoutInfo.pSetLayouts = &m_frameSetLayout;
+    if (vkCreatePipelineLayout(m_device.device(), &layoutInfo, nullptr, &m_framePipelineLayout) != VK_SUCCESS) {
+        throw std::runtime_error("Failed to create frame pipeline layout!");
+    }
+
+    VkDescriptorPoolSize poolSize{ VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, 1 };
+    VkDescriptorPoolCreateInfo poolInfo{};
+    poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+    poolInfo.maxSets = 1;
+    poolInfo.poolSizeCount = 1;
+    poolInfo.pPoolSizes = &poolSize;
+    if (vkCreateDescriptorPool(m_device.device(), &poolInfo, nullptr, &m_frameDescriptorPool) != VK_SUCCESS) {
+        throw std::runtime_error("Failed to create frame descriptor pool!");
+    }
+
+    VkDescriptorSetAllocateInfo allocInfo{};
+    allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+    allocInfo.descriptorPool = m_frameDescriptorPool;
+    allocInfo.descriptorSetCount = 1;
+    allocInfo.pSetLayouts = &m_frameSetLayout;
+    if (vkAllocateDescriptorSets(m_device.device(), &allocInfo, &m_frameDescriptorSet) != VK_SUCCESS) {
+        throw std::runtime_error("Failed to allocate frame descriptor set!");
+    }
+
+    VkDescriptorBufferInfo bufferInfo = m_frameArena->getDescriptorInfo(sizeof(FrameUniforms));
+    VkWriteDescriptorSet write{};
+    write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+    write.dstSet = m_frameDescriptorSet;
+    write.dstBinding = 0;
+    write.descriptorCount = 1;
+    write.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+    write.pBufferInfo = &bufferInfo;
+    vkUpdateDescriptorSets(m_device.device(), 1, &write, 0, nullptr);
 }
 
 // ------------------------------------------------------
-// Cria e grava command buffers para cada framebuffer
+// Grava o command buffer do frame atual para a imagem adquirida
 // ------------------------------------------------------
-void Renderer::createCommandBuffers() {
-    m_commandBuffers.resize(m_framebuffers.size());
+bool Renderer::recordCommandBuffer(uint32_t frameSlot, uint32_t imageIndex) {
+    FrameData& frame = m_frames[frameSlot];
+    VkCommandBuffer commandBuffer = frame.commandBuffer;
 
-    VkCommandBufferAllocateInfo allocInfo{};
-    allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
-    allocInfo.commandPool = m_commandPool;
-    allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
-    allocInfo.commandBufferCount = static_cast<uint32_t>(m_commandBuffers.size());
+    VkCommandBufferBeginInfo beginInfo{};
+    beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
 
-    if (vkAllocateCommandBuffers(m_device, &allocInfo, m_commandBuffers.data()) != VK_SUCCESS) {
-        throw std::runtime_error("Falha ao alocar command buffers!");
+    if (vkBeginCommandBuffer(commandBuffer, &beginInfo) != VK_SUCCESS) {
+        throw std::runtime_error("Falha ao iniciar gravação do command buffer!");
     }
 
-    // Para cada command buffer, vamos iniciar a render pass e encerrar
-    for (size_t i = 0; i < m_commandBuffers.size(); i++) {
-        VkCommandBufferBeginInfo beginInfo{};
-        beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
-        beginInfo.flags = VK_COMMAND_BUFFER_USAGE_SIMULTANEOUS_USE_BIT;
-        // (Pode ser necessário ajustar conforme seu caso)
+    // Lê os tempos do frame que usou este slot antes (a fence já foi esperada) e reseta as queries
+    m_gpuProfiler->beginFrame(commandBuffer, frameSlot);
+    m_frameStats.gpuFrameMs = m_gpuProfiler->getScopeMs("frame");
+    uint32_t frameScope = m_gpuProfiler->beginScope(commandBuffer, "frame", false);
 
-        if (vkBeginCommandBuffer(m_commandBuffers[i], &beginInfo) != VK_SUCCESS) {
-            throw std::runtime_error("Falha ao iniciar gravação do command buffer!");
+    // Enquanto o pipeline compila em segundo plano, o frame sai só com o clear
+    // em vez de travar esperando o driver
+    VkPipeline pipeline = m_pipelineHandle.get();
+    auto meshCount = static_cast<uint32_t>(m_model->getMeshCount());
+
+    // Constantes do frame: um memcpy no arena já mapeado, sem alocação nem map
+    uint32_t frameUniformOffset = m_frameArena->pushUniform(FrameUniforms{ m_viewProjection });
+
+    // A lista de draws já sai da GPU num único comando indireto: não há o que dividir entre threads
+    bool culled = pipeline != VK_NULL_HANDLE && m_culler && m_gpuCullingEnabled && m_model->isPacked();
+    frame.culled = culled;
+    if (culled) {
+        vke::GpuProfiler::Scope cullScope(*m_gpuProfiler, commandBuffer, "cull");
+        vke::CullView view{};
+        view.viewProjection = m_viewProjection;
+        m_culler->record(commandBuffer, frameSlot, *m_model, view);
+    }
+
+    bool parallel = !culled && pipeline != VK_NULL_HANDLE && m_recorder->getThreadCount() > 1 &&
+                    meshCount >= 2 * vke::ParallelRecorder::kMinDrawsPerThread;
+
+    // Estatísticas com secundários exigiriam inheritedQueries: no caminho paralelo só o tempo
+    uint32_t passScope = m_gpuProfiler->beginScope(commandBuffer, "main_pass", !parallel);
+    if (parallel) {
+        // Cenas grandes: cada thread grava uma faixa de meshes num secundário próprio
+        beginRendering(commandBuffer, imageIndex, true);
+
+        VkCommandBufferInheritanceInfo inheritance{};
+        inheritance.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+        inheritance.renderPass = m_renderPass;
+        inheritance.subpass = 0;
+        inheritance.framebuffer = m_dynamicRendering ? VK_NULL_HANDLE : m_framebuffers[imageIndex];
+
+        // Dynamic rendering: os secundários herdam os formatos em vez da render pass
+        VkFormat colorFormat = targetFormat();
+        VkCommandBufferInheritanceRenderingInfoKHR inheritanceRendering{};
+        inheritanceRendering.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_RENDERING_INFO_KHR;
+        inheritanceRendering.colorAttachmentCount = 1;
+        inheritanceRendering.pColorAttachmentFormats = &colorFormat;
+        inheritanceRendering.rasterizationSamples = VK_SAMPLE_COUNT_1_BIT;
+        if (m_dynamicRendering) {
+            inheritance.pNext = &inheritanceRendering;
         }
 
-        // Início da render pass
+        const auto& secondaries = m_recorder->record(
+            frameSlot, inheritance, meshCount,
+            [&](VkCommandBuffer secondary, uint32_t begin, uint32_t end) {
+                recordDraws(secondary, pipeline, frameUniformOffset, begin, end);
+            });
+        vkCmdExecuteCommands(commandBuffer, static_cast<uint32_t>(secondaries.size()), secondaries.data());
+    } else {
+        beginRendering(commandBuffer, imageIndex, false);
+        if (culled) {
+            // Faixa vazia: só vincula pipeline e estado dinâmico; os draws vêm da lista do culling
+            recordDraws(commandBuffer, pipeline, frameUniformOffset, 0, 0);
+            m_culler->draw(commandBuffer, frameSlot, *m_model);
+        } else if (pipeline != VK_NULL_HANDLE) {
+            recordDraws(commandBuffer, pipeline, frameUniformOffset, 0, meshCount);
+        }
+    }
+
+    endRendering(commandBuffer, imageIndex);
+    m_gpuProfiler->endScope(commandBuffer, passScope);
+
+    bool drew = pipeline != VK_NULL_HANDLE;
+    m_frameStats.drawCalls = drew ? m_model->getDrawCallCount(0, meshCount) : 0;
+    m_frameStats.instances = drew ? (m_model->isInstanced() ? m_model->getInstanceCount() : meshCount) : 0;
+
+    if (frame.readback) {
+        vke::GpuProfiler::Scope readbackScope(*m_gpuProfiler, commandBuffer, "readback", false);
+        recordReadback(commandBuffer, frame, imageIndex);
+    }
+    m_gpuProfiler->endScope(commandBuffer, frameScope);
+
+    // Encerra gravação
+    if (vkEndCommandBuffer(commandBuffer) != VK_SUCCESS) {
+        throw std::runtime_error("Falha ao gravar command buffer!");
+    }
+    return drew;
+}
+
+// ------------------------------------------------------
+// Início do desenho na imagem do frame, sempre limpando para preto.
+// Clássico: a render pass faz as transições de layout (UNDEFINED -> final).
+// Dynamic rendering: a transição para COLOR_ATTACHMENT é uma barreira explícita
+// no estágio em que o submit espera o acquire.
+// ------------------------------------------------------
+void Renderer::beginRendering(VkCommandBuffer commandBuffer, uint32_t imageIndex, bool secondaries) const {
+    VkClearValue clearColor = { {{0.0f, 0.0f, 0.0f, 1.0f}} };
+    VkExtent2D extent = getExtent();
+
+    if (!m_dynamicRendering) {
         VkRenderPassBeginInfo renderPassInfo{};
         renderPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
         renderPassInfo.renderPass = m_renderPass;
-        renderPassInfo.framebuffer = m_framebuffers[i];
+        renderPassInfo.framebuffer = m_framebuffers[imageIndex];
         renderPassInfo.renderArea.offset = { 0, 0 };
-        renderPassInfo.renderArea.extent = m_swapChain.getExtent();
-
-        VkClearValue clearColor = { {{0.0f, 0.0f, 0.0f, 1.0f}} };
+        renderPassInfo.renderArea.extent = extent;
         renderPassInfo.clearValueCount = 1;
         renderPassInfo.pClearValues = &clearColor;
+        vkCmdBeginRenderPass(commandBuffer, &renderPassInfo,
+                             secondaries ? VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS : VK_SUBPASS_CONTENTS_INLINE);
+        return;
+    }
 
-        vkCmdBeginRenderPass(m_commandBuffers[i], &renderPassInfo, VK_SUBPASS_CONTENTS_INLINE);
+    // O conteúdo anterior é descartado (loadOp CLEAR), então oldLayout UNDEFINED
+    transitionImage(commandBuffer, imageIndex,
+                    VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
+                    VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT_KHR, VK_ACCESS_2_NONE_KHR,
+                    VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT_KHR, VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT_KHR);
 
-        // Vincula o pipeline gráfico
-        vkCmdBindPipeline(m_commandBuffers[i], VK_PIPELINE_BIND_POINT_GRAPHICS, m_graphicsPipeline->getPipeline());
+    VkRenderingAttachmentInfoKHR colorAttachment{};
+    colorAttachment.sType = VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO_KHR;
+    colorAttachment.imageView = targetImageViews()[imageIndex];
+    colorAttachment.imageLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+    colorAttachment.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
+    colorAttachment.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
+    colorAttachment.clearValue = clearColor;
 
-        // Para teste, desenha um triângulo simples (3 vértices, 1 instância)
-        m_model->recordDrawCommands(m_commandBuffers[i]);
+    VkRenderingInfoKHR renderingInfo{};
+    renderingInfo.sType = VK_STRUCTURE_TYPE_RENDERING_INFO_KHR;
+    renderingInfo.flags = secondaries ? VK_RENDERING_CONTENTS_SECONDARY_COMMAND_BUFFERS_BIT_KHR : 0;
+    renderingInfo.renderArea = { { 0, 0 }, extent };
+    renderingInfo.layerCount = 1;
+    renderingInfo.colorAttachmentCount = 1;
+    renderingInfo.pColorAttachments = &colorAttachment;
+    m_device.cmdBeginRendering()(commandBuffer, &renderingInfo);
+}
 
-        vkCmdEndRenderPass(m_commandBuffers[i]);
+void Renderer::endRendering(VkCommandBuffer commandBuffer, uint32_t imageIndex) const {
+    if (!m_dynamicRendering) {
+        vkCmdEndRenderPass(commandBuffer);
+        return;
+    }
 
-        // Encerra gravação
-        if (vkEndCommandBuffer(m_commandBuffers[i]) != VK_SUCCESS) {
-            throw std::runtime_error("Falha ao gravar command buffer!");
-        }
+    m_device.cmdEndRendering()(commandBuffer);
+
+    // Headless: pronta para a cópia de readback; swapchain: para o present,
+    // que espera o semáforo do submit e não precisa de estágio de destino
+    if (isHeadless()) {
+        transitionImage(commandBuffer, imageIndex,
+                        VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                        VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT_KHR, VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT_KHR,
+                        VK_PIPELINE_STAGE_2_TRANSFER_BIT_KHR, VK_ACCESS_2_TRANSFER_READ_BIT_KHR);
+    } else {
+        transitionImage(commandBuffer, imageIndex,
+                        VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL, VK_IMAGE_LAYOUT_PRESENT_SRC_KHR,
+                        VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT_KHR, VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT_KHR,
+                        VK_PIPELINE_STAGE_2_NONE_KHR, VK_ACCESS_2_NONE_KHR);
     }
 }
 
+// Barreira de layout sync2 na imagem de cor do frame
+void Renderer::transitionImage(VkCommandBuffer commandBuffer, uint32_t imageIndex,
+                               VkImageLayout oldLayout, VkImageLayout newLayout,
+                               VkPipelineStageFlags2KHR srcStage, VkAccessFlags2KHR srcAccess,
+                               VkPipelineStageFlags2KHR dstStage, VkAccessFlags2KHR dstAccess) const {
+    VkImageMemoryBarrier2KHR barrier{};
+    barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2_KHR;
+    barrier.srcStageMask = srcStage;
+    barrier.srcAccessMask = srcAccess;
+    barrier.dstStageMask = dstStage;
+    barrier.dstAccessMask = dstAccess;
+    barrier.oldLayout = oldLayout;
+    barrier.newLayout = newLayout;
+    barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.image = targetImage(imageIndex);
+    barrier.subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1 };
+
+    VkDependencyInfoKHR dependency{};
+    dependency.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO_KHR;
+    dependency.imageMemoryBarrierCount = 1;
+    dependency.pImageMemoryBarriers = &barrier;
+    m_device.cmdPipelineBarrier2()(commandBuffer, &dependency);
+}
+
 // ------------------------------------------------------
-// Cria semáforos e fence para sincronizar renderização
+// Grava os draws dos meshes [firstMesh, endMesh). Estado dinâmico não é
+// herdado por secundários, então cada faixa vincula pipeline/viewport/scissor
+// e o descriptor do frame.
+// ------------------------------------------------------
+void Renderer::recordDraws(VkCommandBuffer commandBuffer, VkPipeline pipeline, uint32_t frameUniformOffset,
+                           uint32_t firstMesh, uint32_t endMesh) const {
+    // Vincula o pipeline gráfico
+    vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline);
+    vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, m_framePipelineLayout,
+                            0, 1, &m_frameDescriptorSet, 1, &frameUniformOffset);
+
+    // Viewport e scissor são dinâmicos e acompanham a extensão atual do alvo
+    VkExtent2D extent = getExtent();
+    VkViewport viewport{ 0.0f, 0.0f, static_cast<float>(extent.width), static_cast<float>(extent.height), 0.0f, 1.0f };
+    VkRect2D scissor{ { 0, 0 }, extent };
+    vkCmdSetViewport(commandBuffer, 0, 1, &viewport);
+    vkCmdSetScissor(commandBuffer, 0, 1, &scissor);
+
+    m_model->recordDrawCommands(commandBuffer, firstMesh, endMesh);
+}
+
+// ------------------------------------------------------
+// Cria semáforos e fences para sincronizar renderização
 // ------------------------------------------------------
 void Renderer::createSyncObjects() {
     VkSemaphoreCreateInfo semaphoreInfo{};
@@ -221,84 +684,358 @@ void Renderer::createSyncObjects() {
     fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
     fenceInfo.flags = VK_FENCE_CREATE_SIGNALED_BIT; // já sinalizada pra evitar deadlock inicial
 
-    if (vkCreateSemaphore(m_device, &semaphoreInfo, nullptr, &m_imageAvailableSemaphore) != VK_SUCCESS ||
-        vkCreateSemaphore(m_device, &semaphoreInfo, nullptr, &m_renderFinishedSemaphore) != VK_SUCCESS ||
-        vkCreateFence(m_device, &fenceInfo, nullptr, &m_inFlightFence) != VK_SUCCESS) {
-        throw std::runtime_error("Falha ao criar semáforos/fence!");
+    for (auto& frame : m_frames) {
+        if (vkCreateSemaphore(m_device.device(), &semaphoreInfo, nullptr, &frame.imageAvailable) != VK_SUCCESS ||
+            vkCreateFence(m_device.device(), &fenceInfo, nullptr, &frame.inFlight) != VK_SUCCESS) {
+            throw std::runtime_error("Falha ao criar semáforos/fence!");
+        }
+    }
+
+    m_renderFinishedSemaphores.resize(targetImageViews().size());
+    for (auto& semaphore : m_renderFinishedSemaphores) {
+        if (vkCreateSemaphore(m_device.device(), &semaphoreInfo, nullptr, &semaphore) != VK_SUCCESS) {
+            throw std::runtime_error("Falha ao criar semáforos/fence!");
+        }
     }
+    m_imagesInFlight.assign(targetImageViews().size(), VK_NULL_HANDLE);
 }
 
 // ------------------------------------------------------
-// Realiza o desenho de um frame (adquire imagem, submete
-// command buffer, apresenta na tela)
+// Copia a imagem renderizada para o buffer de readback do slot
 // ------------------------------------------------------
-void Renderer::drawFrame() const {
-    // Espera o frame anterior terminar
-    vkWaitForFences(m_device, 1, &m_inFlightFence, VK_TRUE, UINT64_MAX);
-    vkResetFences(m_device, 1, &m_inFlightFence);
+void Renderer::recordReadback(VkCommandBuffer commandBuffer, const FrameData& frame, uint32_t imageIndex) const {
+    VkImage image = m_offscreen->getImages()[imageIndex];
+
+    // A transição para TRANSFER_SRC acontece no fim da render pass; aqui só
+    // garantimos que as escritas de cor terminaram antes da cópia. Com dynamic
+    // rendering a barreira de endRendering já cobre as duas coisas.
+    if (!m_dynamicRendering) {
+        VkImageMemoryBarrier toTransfer{};
+        toTransfer.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+        toTransfer.srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+        toTransfer.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+        toTransfer.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+        toTransfer.newLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+        toTransfer.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        toTransfer.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        toTransfer.image = image;
+        toTransfer.subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1 };
+        vkCmdPipelineBarrier(commandBuffer,
+                             VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
+                             0, 0, nullptr, 0, nullptr, 1, &toTransfer);
+    }
+
+    VkExtent2D extent = getExtent();
+    VkBufferImageCopy region{};
+    region.bufferOffset = 0;
+    region.bufferRowLength = 0;   // linhas compactas
+    region.bufferImageHeight = 0;
+    region.imageSubresource = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1 };
+    region.imageOffset = { 0, 0, 0 };
+    region.imageExtent = { extent.width, extent.height, 1 };
+    vkCmdCopyImageToBuffer(commandBuffer, image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                           frame.readback->getBuffer(), 1, &region);
+
+    // Torna a cópia visível ao host depois da espera na fence do slot
+    VkBufferMemoryBarrier toHost{};
+    toHost.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+    toHost.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    toHost.dstAccessMask = VK_ACCESS_HOST_READ_BIT;
+    toHost.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    toHost.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    toHost.buffer = frame.readback->getBuffer();
+    toHost.offset = 0;
+    toHost.size = VK_WHOLE_SIZE;
+    vkCmdPipelineBarrier(commandBuffer,
+                         VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_HOST_BIT,
+                         0, 0, nullptr, 1, &toHost, 0, nullptr);
+}
+
+void Renderer::setReadbackEnabled(bool enabled) {
+    if (!isHeadless()) {
+        throw std::runtime_error("Readback is only available in headless mode!");
+    }
+    m_readbackEnabled = enabled;
+    m_lastReadbackFrame = -1;
+    if (!enabled) {
+        // Os buffers podem ainda estar em uso por frames em voo
+        vkDeviceWaitIdle(m_device.device());
+        for (auto& frame : m_frames) {
+            frame.readback.reset();
+        }
+    }
+}
+
+bool Renderer::readbackLastFrame(std::vector<uint8_t>& outPixels) const {
+    if (m_lastReadbackFrame < 0) {
+        return false;
+    }
+    const FrameData& frame = m_frames[static_cast<size_t>(m_lastReadbackFrame)];
+    vkWaitForFences(m_device.device(), 1, &frame.inFlight, VK_TRUE, UINT64_MAX);
+
+    // Memória HOST_COHERENT: após a fence e a barreira para HOST_READ basta copiar
+    auto size = static_cast<size_t>(m_offscreen->getReadbackSize());
+    outPixels.resize(size);
+    std::memcpy(outPixels.data(), frame.readback->getMappedData(), size);
+    return true;
+}
+
+// ------------------------------------------------------
+// Obtém a imagem do frame. Com swapchain, adquire a próxima imagem
+// (false se ela precisou ser recriada); offscreen, cada slot tem a sua.
+// ------------------------------------------------------
+bool Renderer::acquireImage(FrameData& frame, uint32_t& outImageIndex) {
+    if (isHeadless()) {
+        outImageIndex = m_currentFrame;
+        return true;
+    }
 
-    // Adquire índice da próxima imagem da swapchain
-    uint32_t imageIndex;
     VkResult result = vkAcquireNextImageKHR(
-        m_device,
-        m_swapChain.getSwapChain(),
+        m_device.device(),
+        m_swapChain->getSwapChain(),
         UINT64_MAX,
-        m_imageAvailableSemaphore,   // sinalizado quando a swapchain está pronta
+        frame.imageAvailable,   // sinalizado quando a swapchain está pronta
         VK_NULL_HANDLE,
-        &imageIndex
+        &outImageIndex
     );
 
-    // Exemplos de tratamento
     if (result == VK_ERROR_OUT_OF_DATE_KHR) {
-        // SwapChain precisa ser recriada (janela redimensionada, etc.)
-        // (Você chamaria uma função de recriação da swapchain)
-        return;
+        // SwapChain precisa ser recriada (janela redimensionada, etc.); o semáforo
+        // não foi sinalizado e a fence não foi resetada, então basta tentar de novo
+        recreateSwapChain();
+        return false;
     } else if (result != VK_SUCCESS && result != VK_SUBOPTIMAL_KHR) {
         throw std::runtime_error("Falha ao adquirir imagem da swapchain!");
     }
+    return true;
+}
+
+// ------------------------------------------------------
+// Realiza o desenho de um frame (adquire imagem, submete
+// command buffer, apresenta na tela)
+// ------------------------------------------------------
+void Renderer::drawFrame() {
+    using Clock = std::chrono::steady_clock;
+    VKE_PROFILE_ZONE("drawFrame");
+
+    if (m_resizeRequested) {
+        recreateSwapChain();
+    }
+    // Compilação pendente só atrasa o draw; uma que falhou nunca vai desenhar
+    if (m_pipelineHandle.failed()) {
+        throw std::runtime_error("Failed to create graphics pipeline!");
+    }
+
+    FrameData& frame = m_frames[m_currentFrame];
+
+    // Espera apenas o frame que usou este slot N frames atrás; os demais seguem na GPU
+    auto waitStart = Clock::now();
+    {
+        VKE_PROFILE_ZONE("wait_fence");
+        vkWaitForFences(m_device.device(), 1, &frame.inFlight, VK_TRUE, UINT64_MAX);
+    }
+    auto cpuStart = Clock::now();
+
+    // A região do arena deste slot não é mais lida pela GPU, nem os índices liberados nele
+    m_frameArena->beginFrame(m_currentFrame);
+    m_resources->beginFrame(m_currentFrame);
+
+    // A contagem do culling foi copiada ao host pelo frame que acabou de terminar
+    if (frame.culled) {
+        m_frameStats.gpuVisibleDraws = m_culler->getVisibleCount(m_currentFrame);
+    }
+
+    uint32_t imageIndex;
+    {
+        VKE_PROFILE_ZONE("acquire");
+        if (!acquireImage(frame, imageIndex)) {
+            return;
+        }
+    }
+
+    // A imagem pode ter vindo fora de ordem e ainda estar em uso por outro slot
+    if (m_imagesInFlight[imageIndex] != VK_NULL_HANDLE && m_imagesInFlight[imageIndex] != frame.inFlight) {
+        VKE_PROFILE_ZONE("wait_image_fence");
+        vkWaitForFences(m_device.device(), 1, &m_imagesInFlight[imageIndex], VK_TRUE, UINT64_MAX);
+    }
+    m_imagesInFlight[imageIndex] = frame.inFlight;
+
+    // Só reseta a fence quando há trabalho garantido para sinalizá-la
+    vkResetFences(m_device.device(), 1, &frame.inFlight);
+
+    // Buffer de readback criado sob demanda (e refeito se a extensão mudou)
+    if (m_readbackEnabled && (!frame.readback || frame.readback->getSize() != m_offscreen->getReadbackSize())) {
+        frame.readback = std::make_unique<vke::Buffer>(m_device);
+        frame.readback->create(m_offscreen->getReadbackSize(), VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                               VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+    }
+
+    // A GPU terminou com o slot: recicla o pool e regrava
+    vkResetCommandPool(m_device.device(), frame.commandPool, 0);
+    {
+        VKE_PROFILE_ZONE("record");
+        if (!recordCommandBuffer(m_currentFrame, imageIndex)) {
+            m_frameStats.skippedDrawFrames++;
+        }
+    }
+
+    m_frameArena->flush();
 
     // Prepara a submissão do command buffer
     VkSubmitInfo submitInfo{};
     submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
 
-    // Esperamos até a imagem estar disponível
-    VkSemaphore waitSemaphores[] = { m_imageAvailableSemaphore };
+    // Esperamos até a imagem estar disponível (offscreen não há acquire a esperar)
+    VkSemaphore waitSemaphores[] = { frame.imageAvailable };
     VkPipelineStageFlags waitStages[] = { VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT };
-    submitInfo.waitSemaphoreCount = 1;
-    submitInfo.pWaitSemaphores = waitSemaphores;
-    submitInfo.pWaitDstStageMask = waitStages;
+    if (!isHeadless()) {
+        submitInfo.waitSemaphoreCount = 1;
+        submitInfo.pWaitSemaphores = waitSemaphores;
+        submitInfo.pWaitDstStageMask = waitStages;
+    }
 
-    // Enviamos para a GPU o command buffer correspondente ao imageIndex
     submitInfo.commandBufferCount = 1;
-    submitInfo.pCommandBuffers = &m_commandBuffers[imageIndex];
+    submitInfo.pCommandBuffers = &frame.commandBuffer;
 
-    // Sinalizamos que terminamos de desenhar
-    VkSemaphore signalSemaphores[] = { m_renderFinishedSemaphore };
-    submitInfo.signalSemaphoreCount = 1;
-    submitInfo.pSignalSemaphores = signalSemaphores;
+    // Sinalizamos que terminamos de desenhar (consumido pelo present)
+    VkSemaphore signalSemaphores[] = { m_renderFinishedSemaphores[imageIndex] };
+    if (!isHeadless()) {
+        submitInfo.signalSemaphoreCount = 1;
+        submitInfo.pSignalSemaphores = signalSemaphores;
+    }
 
     // Submete à fila gráfica
-    if (vkQueueSubmit(m_graphicsQueue, 1, &submitInfo, m_inFlightFence) != VK_SUCCESS) {
-        throw std::runtime_error("Falha ao submeter draw command buffer!");
+    {
+        VKE_PROFILE_ZONE("submit");
+        if (vkQueueSubmit(m_graphicsQueue, 1, &submitInfo, frame.inFlight) != VK_SUCCESS) {
+            throw std::runtime_error("Falha ao submeter draw command buffer!");
+        }
+    }
+
+    bool needsRecreate = false;
+    if (!isHeadless()) {
+        // Apresenta a imagem na tela
+        VkPresentInfoKHR presentInfo{};
+        presentInfo.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
+        presentInfo.waitSemaphoreCount = 1;
+        presentInfo.pWaitSemaphores = signalSemaphores; // espera a renderização acabar
+
+        VkSwapchainKHR swapChains[] = { m_swapChain->getSwapChain() };
+        presentInfo.swapchainCount = 1;
+        presentInfo.pSwapchains = swapChains;
+        presentInfo.pImageIndices = &imageIndex;
+
+        VkResult result;
+        {
+            VKE_PROFILE_ZONE("present");
+            result = vkQueuePresentKHR(m_presentQueue, &presentInfo);
+        }
+
+        // Novamente, podemos tratar VK_ERROR_OUT_OF_DATE_KHR (swapchain desatualizada)
+        needsRecreate = result == VK_ERROR_OUT_OF_DATE_KHR || result == VK_SUBOPTIMAL_KHR;
+        if (!needsRecreate && result != VK_SUCCESS) {
+            throw std::runtime_error("Falha ao apresentar imagem na swapchain!");
+        }
+    } else if (frame.readback) {
+        m_lastReadbackFrame = static_cast<int32_t>(m_currentFrame);
     }
 
-    // Apresenta a imagem na tela
-    VkPresentInfoKHR presentInfo{};
-    presentInfo.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
-    presentInfo.waitSemaphoreCount = 1;
-    presentInfo.pWaitSemaphores = signalSemaphores; // espera a renderização acabar
+    auto cpuEnd = Clock::now();
+    m_frameStats.fenceWaitMs = std::chrono::duration<double, std::milli>(cpuStart - waitStart).count();
+    m_frameStats.cpuMs = std::chrono::duration<double, std::milli>(cpuEnd - cpuStart).count();
+    m_frameStats.frameIndex++;
+    VKE_PROFILE_COUNTER("fence_wait_ms", m_frameStats.fenceWaitMs);
+    VKE_PROFILE_COUNTER("gpu_frame_ms", m_frameStats.gpuFrameMs);
 
-    VkSwapchainKHR swapChains[] = { m_swapChain.getSwapChain() };
-    presentInfo.swapchainCount = 1;
-    presentInfo.pSwapchains = swapChains;
-    presentInfo.pImageIndices = &imageIndex;
+    m_currentFrame = (m_currentFrame + 1) % static_cast<uint32_t>(m_frames.size());
 
-    result = vkQueuePresentKHR(m_presentQueue, &presentInfo);
+    // Recria depois do present para não perder o frame já submetido
+    if (needsRecreate) {
+        recreateSwapChain();
+    }
+}
+
+void Renderer::requestResize(uint32_t width, uint32_t height) {
+    m_requestedExtent = { width, height };
+    m_resizeRequested = true;
+}
 
-    // Novamente, podemos tratar VK_ERROR_OUT_OF_DATE_KHR (swapchain desatualizada)
-    if (result == VK_ERROR_OUT_OF_DATE_KHR || result == VK_SUBOPTIMAL_KHR) {
-        // Recria swapchain se necessário
-    } else if (result != VK_SUCCESS) {
-        throw std::runtime_error("Falha ao apresentar imagem na swapchain!");
+void Renderer::destroyFramebuffers() {
+    for (auto framebuffer : m_framebuffers) {
+        vkDestroyFramebuffer(m_device.device(), framebuffer, nullptr);
     }
+    m_framebuffers.clear();
+}
+
+// ------------------------------------------------------
+// Recria a swapchain e apenas o que depende da extensão/imagens:
+// framebuffers e semáforos por imagem. Pipelines usam viewport/scissor
+// dinâmicos e sobrevivem; render pass só é refeita se o formato mudar.
+// Com dynamic rendering não há framebuffers nem render pass a refazer.
+// ------------------------------------------------------
+void Renderer::recreateSwapChain() {
+    VKE_PROFILE_ZONE("recreateSwapChain");
+    auto start = std::chrono::steady_clock::now();
+
+    // Espera só o trabalho ainda em voo (no máximo N frames) e o present pendente,
+    // em vez de drenar o device inteiro
+    std::vector<VkFence> fences;
+    for (const auto& frame : m_frames) {
+        fences.push_back(frame.inFlight);
+    }
+    vkWaitForFences(m_device.device(), static_cast<uint32_t>(fences.size()), fences.data(), VK_TRUE, UINT64_MAX);
+    if (m_presentQueue != VK_NULL_HANDLE) {
+        vkQueueWaitIdle(m_presentQueue);
+    }
+
+    VkExtent2D extent = m_resizeRequested ? m_requestedExtent : getExtent();
+    m_resizeRequested = false;
+
+    VkFormat oldFormat = targetFormat();
+    size_t oldImageCount = targetImageViews().size();
+
+    destroyFramebuffers();
+    if (m_swapChain) {
+        m_swapChain->recreate(extent.width, extent.height);
+    } else {
+        // O frame lido de volta tinha a extensão antiga
+        m_offscreen->resize(extent.width, extent.height);
+        m_lastReadbackFrame = -1;
+    }
+
+    if (targetFormat() != oldFormat) {
+        if (!m_dynamicRendering) {
+            // Uma compilação pendente ainda pode estar usando a render pass antiga
+            m_device.pipelines().waitIdle();
+            vkDestroyRenderPass(m_device.device(), m_renderPass, nullptr);
+            createRenderPass();
+        }
+        m_pipelineKey.colorFormat = targetFormat();
+        m_pipelineHandle = m_device.pipelines().requestPipeline(m_pipelineKey, m_renderPass);
+    }
+    if (!m_dynamicRendering) {
+        createFramebuffers();
+    }
+
+    // A quantidade de imagens pode mudar junto com a swapchain
+    size_t imageCount = targetImageViews().size();
+    if (imageCount != oldImageCount) {
+        for (auto semaphore : m_renderFinishedSemaphores) {
+            vkDestroySemaphore(m_device.device(), semaphore, nullptr);
+        }
+        VkSemaphoreCreateInfo semaphoreInfo{};
+        semaphoreInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+        m_renderFinishedSemaphores.resize(imageCount);
+        for (auto& semaphore : m_renderFinishedSemaphores) {
+            if (vkCreateSemaphore(m_device.device(), &semaphoreInfo, nullptr, &semaphore) != VK_SUCCESS) {
+                throw std::runtime_error("Falha ao criar semáforos/fence!");
+            }
+        }
+    }
+    m_imagesInFlight.assign(imageCount, VK_NULL_HANDLE);
+
+    double elapsedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    m_frameStats.swapChainRecreations++;
+    m_frameStats.lastRecreateMs = elapsedMs;
+    m_frameStats.maxRecreateMs = std::max(m_frameStats.maxRecreateMs, elapsedMs);
 }
@@ -0,0 +1,326 @@
+#include "gfx/ResourceTable.h"
+#include "core/Device.h"
+#include "gfx/DescriptorAllocator.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace vke {
+
+    namespace {
+
+        // Sets de fallback por pool: poucos retratos por frame são esperados
+        constexpr uint32_t kFallbackSetsPerPool = 4;
+
+        // Divide o orçamento de recursos por estágio entre os dois arrays
+        void clampToResourceBudget(uint32_t& buffers, uint32_t& textures, uint32_t budget) {
+            if (buffers + textures > budget) {
+                buffers = std::min(buffers, budget / 2);
+                textures = std::min(textures, budget - buffers);
+            }
+        }
+
+    } // namespace
+
+    uint32_t ResourceTable::IndexPool::acquire() {
+        if (!free.empty()) {
+            uint32_t index = free.back();
+            free.pop_back();
+            live++;
+            return index;
+        }
+        if (top == capacity) {
+            return kInvalidIndex;
+        }
+        live++;
+        return top++;
+    }
+
+    void ResourceTable::IndexPool::retire(uint32_t index, uint32_t frameSlot) {
+        retired[frameSlot].push_back(index);
+        live--;
+    }
+
+    void ResourceTable::IndexPool::recycle(uint32_t frameSlot) {
+        free.insert(free.end(), retired[frameSlot].begin(), retired[frameSlot].end());
+        retired[frameSlot].clear();
+    }
+
+    ResourceTable::ResourceTable(Device& device, uint32_t framesInFlight)
+        : m_device(device)
+        , m_bindless(device.features().descriptorIndexing)
+    {
+        framesInFlight = std::max(framesInFlight, 1u);
+        m_buffers.retired.resize(framesInFlight);
+        m_textures.retired.resize(framesInFlight);
+
+        computeCapacities();
+        m_bufferInfos.resize(m_buffers.capacity, VkDescriptorBufferInfo{});
+        m_textureInfos.resize(m_textures.capacity, VkDescriptorImageInfo{});
+        createLayouts();
+
+        if (m_bindless) {
+            createBindlessSet();
+        } else {
+            std::vector<VkDescriptorPoolSize> poolSizes = {
+                { VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, m_buffers.capacity * kFallbackSetsPerPool },
+                { VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, m_textures.capacity * kFallbackSetsPerPool },
+            };
+            m_frameSets = std::make_unique<FrameDescriptorAllocator>(m_device, framesInFlight, std::move(poolSizes),
+                                                                     kFallbackSetsPerPool);
+        }
+    }
+
+    ResourceTable::~ResourceTable() {
+        m_frameSets.reset();
+        vkDestroyDescriptorPool(m_device.device(), m_descriptorPool, nullptr);
+        vkDestroyPipelineLayout(m_device.device(), m_pipelineLayout, nullptr);
+        vkDestroyDescriptorSetLayout(m_device.device(), m_setLayout, nullptr);
+    }
+
+    void ResourceTable::computeCapacities() {
+        uint32_t buffers = 0;
+        uint32_t textures = 0;
+        if (m_bindless) {
+            const VkPhysicalDeviceDescriptorIndexingPropertiesEXT& limits = m_device.descriptorIndexingProperties();
+            buffers = std::min({ kMaxBuffers, limits.maxPerStageDescriptorUpdateAfterBindStorageBuffers,
+                                 limits.maxDescriptorSetUpdateAfterBindStorageBuffers });
+            textures = std::min({ kMaxTextures, limits.maxPerStageDescriptorUpdateAfterBindSampledImages,
+                                  limits.maxPerStageDescriptorUpdateAfterBindSamplers,
+                                  limits.maxDescriptorSetUpdateAfterBindSampledImages,
+                                  limits.maxDescriptorSetUpdateAfterBindSamplers });
+            clampToResourceBudget(buffers, textures, std::min(limits.maxPerStageUpdateAfterBindResources,
+                                                              limits.maxUpdateAfterBindDescriptorsInAllPools));
+        } else {
+            const VkPhysicalDeviceLimits& limits = m_device.properties().limits;
+            buffers = std::min({ kFallbackBuffers, limits.maxPerStageDescriptorStorageBuffers,
+                                 limits.maxDescriptorSetStorageBuffers });
+            textures = std::min({ kFallbackTextures, limits.maxPerStageDescriptorSampledImages,
+                                  limits.maxPerStageDescriptorSamplers, limits.maxDescriptorSetSampledImages,
+                                  limits.maxDescriptorSetSamplers });
+            clampToResourceBudget(buffers, textures, limits.maxPerStageResources);
+        }
+
+        if (buffers == 0 || textures == 0) {
+            throw std::runtime_error("Device limits leave no room for the resource table!");
+        }
+        m_buffers.capacity = buffers;
+        m_textures.capacity = textures;
+    }
+
+    void ResourceTable::createLayouts() {
+        VkDescriptorSetLayoutBinding bindings[2]{};
+        bindings[0].binding = kBufferBinding;
+        bindings[0].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+        bindings[0].descriptorCount = m_buffers.capacity;
+        bindings[0].stageFlags = VK_SHADER_STAGE_ALL;
+        bindings[1].binding = kTextureBinding;
+        bindings[1].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+        bindings[1].descriptorCount = m_textures.capacity;
+        bindings[1].stageFlags = VK_SHADER_STAGE_ALL;
+
+        VkDescriptorSetLayoutCreateInfo setLayoutInfo{};
+        setLayoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+        setLayoutInfo.bindingCount = 2;
+        setLayoutInfo.pBindings = bindings;
+
+        // Entradas vazias são permitidas e escritas não invalidam command buffers já gravados
+        VkDescriptorBindingFlagsEXT bindingFlags[2] = {};
+        VkDescriptorSetLayoutBindingFlagsCreateInfoEXT flagsInfo{};
+        if (m_bindless) {
+            bindingFlags[0] = bindingFlags[1] = VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT_EXT |
+                                                VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT_EXT |
+                                                VK_DESCRIPTOR_BINDING_UPDATE_UNUSED_WHILE_PENDING_BIT_EXT;
+            flagsInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO_EXT;
+            flagsInfo.bindingCount = 2;
+            flagsInfo.pBindingFlags = bindingFlags;
+            setLayoutInfo.pNext = &flagsInfo;
+            setLayoutInfo.flags = VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT_EXT;
+        }
+
+        if (vkCreateDescriptorSetLayout(m_device.device(), &setLayoutInfo, nullptr, &m_setLayout) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to create resource table descriptor set layout!");
+        }
+
+        VkPushConstantRange pushRange{};
+        pushRange.stageFlags = VK_SHADER_STAGE_ALL;
+        pushRange.offset = 0;
+        pushRange.size = kPushConstantSize;
+
+        VkPipelineLayoutCreateInfo layoutInfo{};
+        layoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+        layoutInfo.setLayoutCount = 1;
+        layoutInfo.pSetLayouts = &m_setLayout;
+        layoutInfo.pushConstantRangeCount = 1;
+        layoutInfo.pPushConstantRanges = &pushRange;
+        if (vkCreatePipelineLayout(m_device.device(), &layoutInfo, nullptr, &m_pipelineLayout) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to create resource table pipeline layout!");
+        }
+    }
+
+    void ResourceTable::createBindlessSet() {
+        VkDescriptorPoolSize poolSizes[] = {
+            { VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, m_buffers.capacity },
+            { VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, m_textures.capacity },
+        };
+        VkDescriptorPoolCreateInfo poolInfo{};
+        poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+        poolInfo.flags = VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT_EXT;
+        poolInfo.maxSets = 1;
+        poolInfo.poolSizeCount = 2;
+        poolInfo.pPoolSizes = poolSizes;
+        if (vkCreateDescriptorPool(m_device.device(), &poolInfo, nullptr, &m_descriptorPool) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to create resource table descriptor pool!");
+        }
+
+        VkDescriptorSetAllocateInfo allocInfo{};
+        allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+        allocInfo.descriptorPool = m_descriptorPool;
+        allocInfo.descriptorSetCount = 1;
+        allocInfo.pSetLayouts = &m_setLayout;
+        if (vkAllocateDescriptorSets(m_device.device(), &allocInfo, &m_descriptorSet) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to allocate resource table descriptor set!");
+        }
+    }
+
+    void ResourceTable::beginFrame(uint32_t frameSlot) {
+        m_frameSlot = frameSlot;
+        m_buffers.recycle(frameSlot);
+        m_textures.recycle(frameSlot);
+
+        if (!m_bindless) {
+            m_frameSets->beginFrame(frameSlot);
+            m_frameSet = VK_NULL_HANDLE;
+        }
+    }
+
+    uint32_t ResourceTable::registerBuffer(VkBuffer buffer, VkDeviceSize offset, VkDeviceSize range) {
+        uint32_t index = m_buffers.acquire();
+        if (index == kInvalidIndex) {
+            throw std::runtime_error("Resource table has no free buffer slots!");
+        }
+        m_bufferInfos[index] = { buffer, offset, range };
+        if (m_bindless) {
+            writeBuffer(m_descriptorSet, index);
+        }
+        m_version++;
+        return index;
+    }
+
+    uint32_t ResourceTable::registerTexture(VkImageView view, VkSampler sampler, VkImageLayout layout) {
+        uint32_t index = m_textures.acquire();
+        if (index == kInvalidIndex) {
+            throw std::runtime_error("Resource table has no free texture slots!");
+        }
+        m_textureInfos[index] = { sampler, view, layout };
+        if (m_bindless) {
+            writeTexture(m_descriptorSet, index);
+        }
+        m_version++;
+        return index;
+    }
+
+    void ResourceTable::releaseBuffer(uint32_t index) {
+        // O descriptor antigo fica no set: sem acesso dinâmico, não precisa ser válido
+        m_bufferInfos[index] = {};
+        m_buffers.retire(index, m_frameSlot);
+        m_version++;
+    }
+
+    void ResourceTable::releaseTexture(uint32_t index) {
+        m_textureInfos[index] = {};
+        m_textures.retire(index, m_frameSlot);
+        m_version++;
+    }
+
+    void ResourceTable::bind(VkCommandBuffer commandBuffer, VkPipelineBindPoint bindPoint) {
+        VkDescriptorSet set = m_descriptorSet;
+        if (!m_bindless) {
+            // Um set já ligado não pode ser reescrito; mudanças no meio do frame geram outro retrato
+            if (m_frameSet == VK_NULL_HANDLE || m_frameSetVersion != m_version) {
+                m_frameSet = snapshot();
+                m_frameSetVersion = m_version;
+            }
+            set = m_frameSet;
+        }
+        vkCmdBindDescriptorSets(commandBuffer, bindPoint, m_pipelineLayout, 0, 1, &set, 0, nullptr);
+    }
+
+    void ResourceTable::push(VkCommandBuffer commandBuffer, const void* data, uint32_t size, uint32_t offset) const {
+        vkCmdPushConstants(commandBuffer, m_pipelineLayout, VK_SHADER_STAGE_ALL, offset, size, data);
+    }
+
+    void ResourceTable::writeBuffer(VkDescriptorSet set, uint32_t index) {
+        VkWriteDescriptorSet write{};
+        write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        write.dstSet = set;
+        write.dstBinding = kBufferBinding;
+        write.dstArrayElement = index;
+        write.descriptorCount = 1;
+        write.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+        write.pBufferInfo = &m_bufferInfos[index];
+        vkUpdateDescriptorSets(m_device.device(), 1, &write, 0, nullptr);
+    }
+
+    void ResourceTable::writeTexture(VkDescriptorSet set, uint32_t index) {
+        VkWriteDescriptorSet write{};
+        write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        write.dstSet = set;
+        write.dstBinding = kTextureBinding;
+        write.dstArrayElement = index;
+        write.descriptorCount = 1;
+        write.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+        write.pImageInfo = &m_textureInfos[index];
+        vkUpdateDescriptorSets(m_device.device(), 1, &write, 0, nullptr);
+    }
+
+    VkDescriptorSet ResourceTable::snapshot() {
+        VkDescriptorSet set = m_frameSets->allocate(m_setLayout);
+
+        // Sem partially bound, todo o array precisa ser válido: vazios repetem o primeiro vivo
+        std::vector<VkDescriptorBufferInfo> buffers = m_bufferInfos;
+        auto firstBuffer = std::find_if(buffers.begin(), buffers.end(),
+                                        [](const VkDescriptorBufferInfo& info) { return info.buffer != VK_NULL_HANDLE; });
+        std::vector<VkDescriptorImageInfo> textures = m_textureInfos;
+        auto firstTexture = std::find_if(textures.begin(), textures.end(),
+                                         [](const VkDescriptorImageInfo& info) { return info.imageView != VK_NULL_HANDLE; });
+
+        VkWriteDescriptorSet writes[2]{};
+        uint32_t writeCount = 0;
+        if (firstBuffer != buffers.end()) {
+            VkDescriptorBufferInfo fill = *firstBuffer;
+            for (auto& info : buffers) {
+                if (info.buffer == VK_NULL_HANDLE) {
+                    info = fill;
+                }
+            }
+            VkWriteDescriptorSet& write = writes[writeCount++];
+            write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+            write.dstSet = set;
+            write.dstBinding = kBufferBinding;
+            write.descriptorCount = m_buffers.capacity;
+            write.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+            write.pBufferInfo = buffers.data();
+        }
+        if (firstTexture != textures.end()) {
+            VkDescriptorImageInfo fill = *firstTexture;
+            for (auto& info : textures) {
+                if (info.imageView == VK_NULL_HANDLE) {
+                    info = fill;
+                }
+            }
+            VkWriteDescriptorSet& write = writes[writeCount++];
+            write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+            write.dstSet = set;
+            write.dstBinding = kTextureBinding;
+            write.descriptorCount = m_textures.capacity;
+            write.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+            write.pImageInfo = textures.data();
+        }
+        if (writeCount > 0) {
+            vkUpdateDescriptorSets(m_device.device(), writeCount, writes, 0, nullptr);
+        }
+        return set;
+    }
+
+} // namespace vke
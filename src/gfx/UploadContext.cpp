@@ -0,0 +1,186 @@
+#include "gfx/UploadContext.h"
+#include "core/Device.h"
+#include "core/Profiler.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+namespace vke {
+
+UploadContext::UploadContext(Device& device, VkDeviceSize stagingSize)
+    : m_device(device),
+      m_queue(device.graphicsQueue()),
+      m_staging(device)
+{
+    // Staging fica em um bloco linear próprio, sempre mapeado
+    m_staging.create(stagingSize,
+                     VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+                     VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                     AllocationStrategy::Linear);
+
+    VkCommandPoolCreateInfo poolInfo{};
+    poolInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+    poolInfo.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT | VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+    poolInfo.queueFamilyIndex = device.queueFamilies().graphicsFamily.value();
+
+    if (vkCreateCommandPool(m_device.device(), &poolInfo, nullptr, &m_commandPool) != VK_SUCCESS) {
+        throw std::runtime_error("Failed to create upload command pool!");
+    }
+
+    VkCommandBufferAllocateInfo allocInfo{};
+    allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+    allocInfo.commandPool = m_commandPool;
+    allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+    allocInfo.commandBufferCount = 1;
+
+    if (vkAllocateCommandBuffers(m_device.device(), &allocInfo, &m_commandBuffer) != VK_SUCCESS) {
+        throw std::runtime_error("Failed to allocate upload command buffer!");
+    }
+
+    VkFenceCreateInfo fenceInfo{};
+    fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+    if (vkCreateFence(m_device.device(), &fenceInfo, nullptr, &m_fence) != VK_SUCCESS) {
+        throw std::runtime_error("Failed to create upload fence!");
+    }
+}
+
+UploadContext::~UploadContext() {
+    // Garante que nada pendente fique para trás
+    if (m_recording) {
+        flush();
+    }
+    vkDestroyFence(m_device.device(), m_fence, nullptr);
+    vkDestroyCommandPool(m_device.device(), m_commandPool, nullptr);
+}
+
+void UploadContext::beginBatch() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_batchDepth++;
+}
+
+void UploadContext::endBatch() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_batchDepth == 0) {
+        throw std::runtime_error("UploadContext::endBatch without beginBatch!");
+    }
+    if (--m_batchDepth == 0 && m_recording) {
+        flush();
+    }
+}
+
+void UploadContext::uploadToBuffer(const Buffer& dst, const void* srcData, VkDeviceSize size, VkDeviceSize dstOffset) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    const auto* src = static_cast<const char*>(srcData);
+    const VkDeviceSize capacity = m_staging.getSize();
+
+    // Uploads maiores que o staging são quebrados em pedaços
+    while (size > 0) {
+        VkDeviceSize head = (m_stagingHead + 15) & ~VkDeviceSize{15};
+        if (head >= capacity) {
+            flush();
+            head = 0;
+        }
+
+        VkDeviceSize chunk = std::min(size, capacity - head);
+        if (chunk < size && head > 0) {
+            // Melhor esvaziar o staging que fragmentar uploads pequenos
+            flush();
+            head = 0;
+            chunk = std::min(size, capacity);
+        }
+
+        ensureRecording();
+        std::memcpy(static_cast<char*>(m_staging.getMappedData()) + head, src, static_cast<size_t>(chunk));
+
+        VkBufferCopy region{};
+        region.srcOffset = head;
+        region.dstOffset = dstOffset;
+        region.size = chunk;
+        vkCmdCopyBuffer(m_commandBuffer, m_staging.getBuffer(), dst.getBuffer(), 1, &region);
+
+        m_stagingHead = head + chunk;
+        m_stats.bytesUploaded += chunk;
+        m_stats.copyCount++;
+
+        src += chunk;
+        dstOffset += chunk;
+        size -= chunk;
+    }
+
+    // Fora de um lote, cada upload é submetido imediatamente
+    if (m_batchDepth == 0) {
+        flush();
+    }
+}
+
+void UploadContext::ensureRecording() {
+    if (m_recording) {
+        return;
+    }
+
+    VkCommandBufferBeginInfo beginInfo{};
+    beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+
+    if (vkBeginCommandBuffer(m_commandBuffer, &beginInfo) != VK_SUCCESS) {
+        throw std::runtime_error("Failed to begin upload command buffer!");
+    }
+    m_recording = true;
+}
+
+// ------------------------------------------------------
+// Submete as cópias gravadas, espera a fence e recicla o staging
+// ------------------------------------------------------
+void UploadContext::flush() {
+    VKE_PROFILE_ZONE("upload_flush");
+    if (!m_recording) {
+        m_stagingHead = 0;
+        return;
+    }
+
+    // Torna as cópias visíveis para leituras de vértice/índice e shaders nas submissões seguintes
+    VkMemoryBarrier barrier{};
+    barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+    barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    barrier.dstAccessMask = VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT | VK_ACCESS_INDEX_READ_BIT |
+                            VK_ACCESS_INDIRECT_COMMAND_READ_BIT | VK_ACCESS_UNIFORM_READ_BIT |
+                            VK_ACCESS_SHADER_READ_BIT;
+    vkCmdPipelineBarrier(m_commandBuffer,
+                         VK_PIPELINE_STAGE_TRANSFER_BIT,
+                         VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+                         0, 1, &barrier, 0, nullptr, 0, nullptr);
+
+    if (vkEndCommandBuffer(m_commandBuffer) != VK_SUCCESS) {
+        throw std::runtime_error("Failed to record upload command buffer!");
+    }
+
+    VkSubmitInfo submitInfo{};
+    submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+    submitInfo.commandBufferCount = 1;
+    submitInfo.pCommandBuffers = &m_commandBuffer;
+
+    if (vkQueueSubmit(m_queue, 1, &submitInfo, m_fence) != VK_SUCCESS) {
+        throw std::runtime_error("Failed to submit upload command buffer!");
+    }
+    vkWaitForFences(m_device.device(), 1, &m_fence, VK_TRUE, UINT64_MAX);
+    vkResetFences(m_device.device(), 1, &m_fence);
+    vkResetCommandBuffer(m_commandBuffer, 0);
+
+    m_recording = false;
+    m_stagingHead = 0;
+    m_stats.submitCount++;
+}
+
+UploadStats UploadContext::getStats() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_stats;
+}
+
+void UploadContext::resetStats() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stats = UploadStats{};
+}
+
+} // namespace vke
@@ -27,4 +27,43 @@ std::array<VkVertexInputAttributeDescription, 2> Vertex::getAttributeDescription
 
     return attributeDescriptions;
   }
-}
\ No newline at end of file
+
+VertexLayout Vertex::getVertexLayout() {
+  auto attributes = getAttributeDescriptions();
+  return VertexLayout{ { getBindingDescription() }, { attributes.begin(), attributes.end() } };
+}
+
+VertexLayout Vertex::getInstancedVertexLayout() {
+  VertexLayout layout = getVertexLayout();
+  auto attributes = InstanceData::getAttributeDescriptions();
+  layout.bindings.push_back(InstanceData::getBindingDescription());
+  layout.attributes.insert(layout.attributes.end(), attributes.begin(), attributes.end());
+  return layout;
+}
+
+VkVertexInputBindingDescription InstanceData::getBindingDescription() {
+  VkVertexInputBindingDescription bindingDescription{};
+    bindingDescription.binding = 1;
+    bindingDescription.stride = sizeof(InstanceData);
+    bindingDescription.inputRate = VK_VERTEX_INPUT_RATE_INSTANCE;
+    return bindingDescription;
+}
+
+std::array<VkVertexInputAttributeDescription, 2> InstanceData::getAttributeDescriptions() {
+  std::array<VkVertexInputAttributeDescription, 2> attributeDescriptions{};
+
+    // offset (vec2)
+    attributeDescriptions[0].binding = 1;
+    attributeDescriptions[0].location = 2;
+    attributeDescriptions[0].format = VK_FORMAT_R32G32_SFLOAT;
+    attributeDescriptions[0].offset = offsetof(InstanceData, offset);
+
+    // scale (float)
+    attributeDescriptions[1].binding = 1;
+    attributeDescriptions[1].location = 3;
+    attributeDescriptions[1].format = VK_FORMAT_R32_SFLOAT;
+    attributeDescriptions[1].offset = offsetof(InstanceData, scale);
+
+    return attributeDescriptions;
+}
+}
@@ -1,25 +1,31 @@
 #include "gfx/VertexBuffer.h"
+#include "core/Device.h"
+#include "gfx/UploadContext.h"
 
 namespace vke {
 
-VertexBuffer::VertexBuffer(VkDevice device, VkPhysicalDevice physicalDevice)
-    : m_buffer(device, physicalDevice) {}
+VertexBuffer::VertexBuffer(Device& device)
+    : m_device(device), m_buffer(device) {}
 
 VertexBuffer::~VertexBuffer() {
     destroy();
 }
 
 void VertexBuffer::create(const std::vector<Vertex>& vertices) {
-  m_vertexCount = vertices.size();
+  create(vertices.data(), vertices.size());
+}
+
+void VertexBuffer::create(const Vertex* vertices, size_t count) {
+  m_vertexCount = count;
   VkDeviceSize size = sizeof(Vertex) * m_vertexCount;
 
-  // Create the buffer with vertex data
+  // Create the buffer in device-local memory so the vertex shader doesn't read over PCIe
   m_buffer.create(size,
-                  VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
-                  VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+                  VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                  VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
 
-  // Upload the vertex data to the buffer
-  m_buffer.uploadData(vertices.data(), size);
+  // Upload the vertex data through the staging buffer (batched if a batch is open)
+  m_device.uploader().uploadToBuffer(m_buffer, vertices, size);
 }
 
 void VertexBuffer::bind(VkCommandBuffer commandBuffer) const {
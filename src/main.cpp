@@ -1,13 +1,71 @@
 #include "../include/core/Engine.h"
+#include "../include/core/Profiler.h"
 #include <iostream>
 #include <cstdlib>
+#include <cstring>
+#include <string>
+
+int main(int argc, char** argv) {
+    // --headless [--frames N] [--dump arquivo.ppm] [--gpu-trace arquivo.json]: roda sem janela (CI)
+    // --cpu-trace arquivo.json: zonas de CPU desde a inicialização (com ou sem janela)
+    // --mesh arquivo.vkm/.gltf/.glb: desenha os meshes do arquivo no lugar do triângulo padrão
+    bool headless = false;
+    uint32_t frameCount = 600;
+    std::string dumpPath;
+    std::string gpuTracePath;
+    std::string cpuTracePath;
+    std::string meshPath;
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--headless") == 0) {
+            headless = true;
+        } else if (std::strcmp(argv[i], "--frames") == 0 && i + 1 < argc) {
+            frameCount = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (std::strcmp(argv[i], "--dump") == 0 && i + 1 < argc) {
+            dumpPath = argv[++i];
+        } else if (std::strcmp(argv[i], "--gpu-trace") == 0 && i + 1 < argc) {
+            gpuTracePath = argv[++i];
+        } else if (std::strcmp(argv[i], "--cpu-trace") == 0 && i + 1 < argc) {
+            cpuTracePath = argv[++i];
+        } else if (std::strcmp(argv[i], "--mesh") == 0 && i + 1 < argc) {
+            meshPath = argv[++i];
+        } else {
+            std::cerr << "Usage: " << argv[0]
+                      << " [--mesh file.vkm|file.gltf|file.glb] [--cpu-trace file.json] [--headless [--frames N] [--dump file.ppm] [--gpu-trace file.json]]\n";
+            return EXIT_FAILURE;
+        }
+    }
+
+    if (!cpuTracePath.empty()) {
+        if (!VKE_PROFILING) {
+            std::cerr << "--cpu-trace ignored: built without VKE_ENABLE_PROFILING\n";
+            cpuTracePath.clear();
+        }
+        vke::CpuProfiler::setCapture(!cpuTracePath.empty());
+    }
 
-int main() {
     std::cout << "Starting Vulkan application...\n";
     try {
-        // Cria engine com título e dimensões de janela
-        vke::Engine engine("Vulkan Window", 800, 600);
-        engine.run();
+        {
+            // Cria engine com título e dimensões de janela
+            vke::Engine engine("Vulkan Window", 800, 600, headless);
+            if (!meshPath.empty()) {
+                engine.loadModel(meshPath);
+            }
+            if (headless) {
+                double fps = engine.runHeadless(frameCount, dumpPath, gpuTracePath);
+                std::cout << "Rendered " << frameCount << " headless frames at " << fps << " frames/s\n";
+            } else {
+                engine.run();
+            }
+        }
+
+        // Depois do destrutor da engine, para o trace incluir o shutdown
+        if (!cpuTracePath.empty()) {
+            vke::CpuProfiler::setCapture(false);
+            vke::CpuProfiler::writeChromeTrace(cpuTracePath);
+            std::cout << "CPU trace with " << vke::CpuProfiler::getEventCount() << " events ("
+                      << vke::CpuProfiler::getDroppedEvents() << " dropped) written to " << cpuTracePath << "\n";
+        }
     } catch (const std::exception& e) {
         std::cerr << "Fatal error: " << e.what() << std::endl;
         return EXIT_FAILURE;
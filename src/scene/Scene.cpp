@@ -0,0 +1,379 @@
+#include "scene/Scene.h"
+#include "core/JobSystem.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <stdexcept>
+#include <type_traits>
+
+namespace vke {
+
+    namespace {
+
+        // Nós por job quando um nível é dividido entre threads
+        constexpr uint32_t kParallelGrain = 4096;
+
+        constexpr Mat4 kIdentity = { 1.0f, 0.0f, 0.0f, 0.0f,
+                                     0.0f, 1.0f, 0.0f, 0.0f,
+                                     0.0f, 0.0f, 1.0f, 0.0f,
+                                     0.0f, 0.0f, 0.0f, 1.0f };
+
+        // T * R * S em column-major; o quaternion é assumido normalizado
+        Mat4 composeLocal(float tx, float ty, float tz, float x, float y, float z, float w, float s) {
+            float xx = x * x, yy = y * y, zz = z * z;
+            float xy = x * y, xz = x * z, yz = y * z;
+            float wx = w * x, wy = w * y, wz = w * z;
+            return { (1.0f - 2.0f * (yy + zz)) * s, 2.0f * (xy + wz) * s,          2.0f * (xz - wy) * s,          0.0f,
+                     2.0f * (xy - wz) * s,          (1.0f - 2.0f * (xx + zz)) * s, 2.0f * (yz + wx) * s,          0.0f,
+                     2.0f * (xz + wy) * s,          2.0f * (yz - wx) * s,          (1.0f - 2.0f * (xx + yy)) * s, 0.0f,
+                     tx,                            ty,                            tz,                            1.0f };
+        }
+
+        // Produto de duas matrizes afins (última linha 0 0 0 1), sem a linha constante
+        Mat4 multiplyAffine(const Mat4& a, const Mat4& b) {
+            Mat4 result;
+            for (int c = 0; c < 4; c++) {
+                for (int r = 0; r < 3; r++) {
+                    result[c * 4 + r] = a[r] * b[c * 4] + a[4 + r] * b[c * 4 + 1] + a[8 + r] * b[c * 4 + 2];
+                }
+                result[c * 4 + 3] = c == 3 ? 1.0f : 0.0f;
+            }
+            result[12] += a[12];
+            result[13] += a[13];
+            result[14] += a[14];
+            return result;
+        }
+
+        // Centro transformado como ponto; o raio cresce com a maior escala dos eixos
+        BoundingSphere transformSphere(const Mat4& m, const BoundingSphere& local) {
+            BoundingSphere world;
+            for (int r = 0; r < 3; r++) {
+                world.center[r] = m[r] * local.center[0] + m[4 + r] * local.center[1] + m[8 + r] * local.center[2] + m[12 + r];
+            }
+            float maxScaleSq = 0.0f;
+            for (int c = 0; c < 3; c++) {
+                maxScaleSq = std::max(maxScaleSq, m[c * 4] * m[c * 4] + m[c * 4 + 1] * m[c * 4 + 1] + m[c * 4 + 2] * m[c * 4 + 2]);
+            }
+            world.radius = local.radius * std::sqrt(maxScaleSq);
+            return world;
+        }
+
+    } // namespace
+
+    SceneNode Scene::create(SceneNode parent, const Transform& local) {
+        uint32_t parentIndex = parent.isNull() ? kNoParent : denseIndex(parent);
+        uint32_t depth = parentIndex == kNoParent ? 0 : m_depth[parentIndex] + 1;
+        auto index = size();
+
+        // Anexar no fim só preserva a ordem se o nível não for anterior ao último
+        if (!m_orderDirty) {
+            uint32_t levelCount = static_cast<uint32_t>(m_levelStart.empty() ? 0 : m_levelStart.size() - 1);
+            if (depth + 1 == levelCount) {
+                m_levelStart.back() = index + 1;
+            } else if (depth == levelCount) {
+                if (m_levelStart.empty()) {
+                    m_levelStart.push_back(0);
+                }
+                m_levelStart.push_back(index + 1);
+            } else {
+                m_orderDirty = true;
+            }
+        }
+
+        uint32_t slot;
+        if (!m_freeSlots.empty()) {
+            slot = m_freeSlots.back();
+            m_freeSlots.pop_back();
+        } else {
+            slot = static_cast<uint32_t>(m_slots.size());
+            m_slots.emplace_back();
+        }
+        m_slots[slot].dense = index;
+
+        m_parent.push_back(parentIndex);
+        m_depth.push_back(depth);
+        m_slotOf.push_back(slot);
+        m_positionX.push_back(local.position[0]);
+        m_positionY.push_back(local.position[1]);
+        m_positionZ.push_back(local.position[2]);
+        m_rotationX.push_back(local.rotation[0]);
+        m_rotationY.push_back(local.rotation[1]);
+        m_rotationZ.push_back(local.rotation[2]);
+        m_rotationW.push_back(local.rotation[3]);
+        m_scale.push_back(local.scale);
+        m_dirty.push_back(1);
+        m_dirtyCount++;
+        m_localBounds.add({});
+        m_worldBounds.add({});
+        m_world.push_back(kIdentity);
+
+        return { slot, m_slots[slot].generation };
+    }
+
+    void Scene::destroy(SceneNode node) {
+        uint32_t root = denseIndex(node);
+        if (m_orderDirty) {
+            sortByDepth();
+            root = denseIndex(node);
+        }
+
+        // Pais vêm antes: uma passada a partir da raiz acha a subárvore inteira
+        std::vector<uint8_t> removed(size(), 0);
+        removed[root] = 1;
+        for (uint32_t i = root + 1; i < size(); i++) {
+            removed[i] = m_parent[i] != kNoParent && removed[m_parent[i]];
+        }
+
+        std::vector<uint32_t> order;
+        order.reserve(size());
+        for (uint32_t i = 0; i < size(); i++) {
+            if (!removed[i]) {
+                order.push_back(i);
+                continue;
+            }
+            Slot& slot = m_slots[m_slotOf[i]];
+            slot.dense = kNoParent;
+            slot.generation++;
+            m_freeSlots.push_back(m_slotOf[i]);
+        }
+        applyOrder(order);
+    }
+
+    bool Scene::isAlive(SceneNode node) const {
+        return node.slot < m_slots.size() && m_slots[node.slot].generation == node.generation &&
+               m_slots[node.slot].dense != kNoParent;
+    }
+
+    uint32_t Scene::denseIndex(SceneNode node) const {
+        if (!isAlive(node)) {
+            throw std::runtime_error("Invalid scene node handle!");
+        }
+        return m_slots[node.slot].dense;
+    }
+
+    SceneNode Scene::nodeAt(uint32_t index) const {
+        uint32_t slot = m_slotOf[index];
+        return { slot, m_slots[slot].generation };
+    }
+
+    void Scene::setParent(SceneNode node, SceneNode parent) {
+        uint32_t index = denseIndex(node);
+        uint32_t parentIndex = parent.isNull() ? kNoParent : denseIndex(parent);
+        for (uint32_t ancestor = parentIndex; ancestor != kNoParent; ancestor = m_parent[ancestor]) {
+            if (ancestor == index) {
+                throw std::runtime_error("Scene node cannot be parented to its own descendant!");
+            }
+        }
+
+        m_parent[index] = parentIndex;
+        m_orderDirty = true;
+        markDirty(index);
+    }
+
+    SceneNode Scene::getParent(SceneNode node) const {
+        uint32_t parentIndex = m_parent[denseIndex(node)];
+        return parentIndex == kNoParent ? SceneNode{} : nodeAt(parentIndex);
+    }
+
+    void Scene::setLocalTransform(SceneNode node, const Transform& local) {
+        uint32_t index = denseIndex(node);
+        m_positionX[index] = local.position[0];
+        m_positionY[index] = local.position[1];
+        m_positionZ[index] = local.position[2];
+        m_rotationX[index] = local.rotation[0];
+        m_rotationY[index] = local.rotation[1];
+        m_rotationZ[index] = local.rotation[2];
+        m_rotationW[index] = local.rotation[3];
+        m_scale[index] = local.scale;
+        markDirty(index);
+    }
+
+    void Scene::setPosition(SceneNode node, float x, float y, float z) {
+        uint32_t index = denseIndex(node);
+        m_positionX[index] = x;
+        m_positionY[index] = y;
+        m_positionZ[index] = z;
+        markDirty(index);
+    }
+
+    Transform Scene::getLocalTransform(SceneNode node) const {
+        uint32_t index = denseIndex(node);
+        Transform local;
+        local.position[0] = m_positionX[index];
+        local.position[1] = m_positionY[index];
+        local.position[2] = m_positionZ[index];
+        local.rotation[0] = m_rotationX[index];
+        local.rotation[1] = m_rotationY[index];
+        local.rotation[2] = m_rotationZ[index];
+        local.rotation[3] = m_rotationW[index];
+        local.scale = m_scale[index];
+        return local;
+    }
+
+    void Scene::setLocalBounds(SceneNode node, const BoundingSphere& bounds) {
+        uint32_t index = denseIndex(node);
+        m_localBounds.set(index, bounds);
+        markDirty(index);
+    }
+
+    const Mat4& Scene::getWorldMatrix(SceneNode node) const {
+        return m_world[denseIndex(node)];
+    }
+
+    BoundingSphere Scene::getWorldBounds(SceneNode node) const {
+        return m_worldBounds.get(denseIndex(node));
+    }
+
+    void Scene::markDirty(uint32_t index) {
+        if (!m_dirty[index]) {
+            m_dirty[index] = 1;
+            m_dirtyCount++;
+        }
+    }
+
+    // Recalcula profundidades (setParent pode ter mudado subárvores inteiras) e
+    // reordena com counting sort estável, preservando a ordem dentro de cada nível
+    void Scene::sortByDepth() {
+        constexpr uint32_t kUnknown = UINT32_MAX;
+        std::vector<uint32_t> depth(size(), kUnknown);
+        std::vector<uint32_t> chain;
+        uint32_t maxDepth = 0;
+        for (uint32_t i = 0; i < size(); i++) {
+            uint32_t node = i;
+            while (node != kNoParent && depth[node] == kUnknown) {
+                chain.push_back(node);
+                node = m_parent[node];
+            }
+            uint32_t d = node == kNoParent ? 0 : depth[node] + 1;
+            while (!chain.empty()) {
+                depth[chain.back()] = d++;
+                chain.pop_back();
+            }
+            maxDepth = std::max(maxDepth, depth[i]);
+        }
+        m_depth = std::move(depth);
+
+        std::vector<uint32_t> offsets(maxDepth + 2, 0);
+        for (uint32_t i = 0; i < size(); i++) {
+            offsets[m_depth[i] + 1]++;
+        }
+        for (size_t level = 1; level < offsets.size(); level++) {
+            offsets[level] += offsets[level - 1];
+        }
+        std::vector<uint32_t> order(size());
+        for (uint32_t i = 0; i < size(); i++) {
+            order[offsets[m_depth[i]]++] = i;
+        }
+        applyOrder(order);
+        m_orderDirty = false;
+    }
+
+    void Scene::applyOrder(const std::vector<uint32_t>& order) {
+        std::vector<uint32_t> newIndex(size(), kNoParent);
+        for (uint32_t i = 0; i < order.size(); i++) {
+            newIndex[order[i]] = i;
+        }
+
+        auto permute = [&](auto& values) {
+            std::remove_reference_t<decltype(values)> result;
+            result.reserve(order.size());
+            for (uint32_t old : order) {
+                result.push_back(values[old]);
+            }
+            values = std::move(result);
+        };
+        permute(m_parent);
+        permute(m_depth);
+        permute(m_slotOf);
+        permute(m_positionX);
+        permute(m_positionY);
+        permute(m_positionZ);
+        permute(m_rotationX);
+        permute(m_rotationY);
+        permute(m_rotationZ);
+        permute(m_rotationW);
+        permute(m_scale);
+        permute(m_dirty);
+        permute(m_world);
+
+        BoundsSoA localBounds;
+        BoundsSoA worldBounds;
+        localBounds.reserve(order.size());
+        worldBounds.reserve(order.size());
+        for (uint32_t old : order) {
+            localBounds.add(m_localBounds.get(old));
+            worldBounds.add(m_worldBounds.get(old));
+        }
+        m_localBounds = std::move(localBounds);
+        m_worldBounds = std::move(worldBounds);
+
+        m_dirtyCount = 0;
+        for (uint32_t i = 0; i < size(); i++) {
+            if (m_parent[i] != kNoParent) {
+                m_parent[i] = newIndex[m_parent[i]];
+            }
+            m_slots[m_slotOf[i]].dense = i;
+            m_dirtyCount += m_dirty[i];
+        }
+
+        // Ordem por profundidade: os níveis são as faixas de mesmo m_depth
+        m_levelStart.clear();
+        for (uint32_t i = 0; i < size(); i++) {
+            while (m_levelStart.size() <= m_depth[i]) {
+                m_levelStart.push_back(i);
+            }
+        }
+        if (size() > 0) {
+            m_levelStart.push_back(size());
+        }
+    }
+
+    uint32_t Scene::updateRange(uint32_t begin, uint32_t end) {
+        uint32_t updated = 0;
+        for (uint32_t i = begin; i < end; i++) {
+            uint32_t parent = m_parent[i];
+            // O pai está num nível anterior, já propagado
+            if (!m_dirty[i] && (parent == kNoParent || !m_dirty[parent])) {
+                continue;
+            }
+            m_dirty[i] = 1;
+
+            Mat4 local = composeLocal(m_positionX[i], m_positionY[i], m_positionZ[i],
+                                      m_rotationX[i], m_rotationY[i], m_rotationZ[i], m_rotationW[i], m_scale[i]);
+            m_world[i] = parent == kNoParent ? local : multiplyAffine(m_world[parent], local);
+            m_worldBounds.set(i, transformSphere(m_world[i], m_localBounds.get(i)));
+            updated++;
+        }
+        return updated;
+    }
+
+    void Scene::updateTransforms(JobSystem* jobs) {
+        if (m_orderDirty) {
+            sortByDepth();
+        }
+        if (m_dirtyCount == 0) {
+            m_lastUpdatedCount = 0;
+            return;
+        }
+
+        // Níveis em sequência; dentro de um nível os nós são independentes
+        std::atomic<uint32_t> updated{ 0 };
+        for (size_t level = 0; level + 1 < m_levelStart.size(); level++) {
+            uint32_t begin = m_levelStart[level];
+            uint32_t end = m_levelStart[level + 1];
+            if (jobs && end - begin >= 2 * kParallelGrain) {
+                jobs->parallelFor(end - begin, kParallelGrain, [&](uint32_t first, uint32_t last) {
+                    updated.fetch_add(updateRange(begin + first, begin + last), std::memory_order_relaxed);
+                });
+            } else {
+                updated.fetch_add(updateRange(begin, end), std::memory_order_relaxed);
+            }
+        }
+
+        std::fill(m_dirty.begin(), m_dirty.end(), 0);
+        m_dirtyCount = 0;
+        m_lastUpdatedCount = updated.load();
+    }
+
+} // namespace vke
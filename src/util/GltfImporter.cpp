@@ -0,0 +1,619 @@
+#include "util/GltfImporter.h"
+#include "core/JobSystem.h"
+#include "core/Profiler.h"
+#include "util/Json.h"
+#include "util/MappedFile.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <stdexcept>
+#include <string_view>
+
+namespace vke {
+
+    namespace {
+
+        constexpr uint32_t kGlbMagic = 0x46546C67;     // "glTF"
+        constexpr uint32_t kGlbChunkJson = 0x4E4F534A; // "JSON"
+        constexpr uint32_t kGlbChunkBin = 0x004E4942;  // "BIN\0"
+
+        constexpr uint32_t kComponentByte = 5120;
+        constexpr uint32_t kComponentUnsignedByte = 5121;
+        constexpr uint32_t kComponentShort = 5122;
+        constexpr uint32_t kComponentUnsignedShort = 5123;
+        constexpr uint32_t kComponentUnsignedInt = 5125;
+        constexpr uint32_t kComponentFloat = 5126;
+
+        constexpr uint32_t kModeTriangles = 4;
+        constexpr uint32_t kModeTriangleStrip = 5;
+        constexpr uint32_t kModeTriangleFan = 6;
+
+        struct BufferData {
+            const uint8_t* data = nullptr;
+            size_t size = 0;
+        };
+
+        // Origem dos bytes dos buffers: mapeamentos (.glb, .bin) ou URIs data: decodificadas.
+        // Mover os contêineres não invalida os ponteiros de BufferData
+        struct BufferSources {
+            std::vector<MappedFile> files;
+            std::vector<std::vector<uint8_t>> decoded;
+            std::vector<BufferData> buffers;
+        };
+
+        // Acessor resolvido: elemento i começa em data + i * stride; data nulo lê zeros
+        struct AccessorView {
+            const uint8_t* data = nullptr;
+            size_t stride = 0;
+            uint32_t count = 0;
+            uint32_t componentType = 0;
+            uint32_t components = 0;
+            bool normalized = false;
+        };
+
+        uint32_t readU32(const uint8_t* bytes) {
+            uint32_t value;
+            std::memcpy(&value, bytes, sizeof(value));
+            return value;
+        }
+
+        uint32_t componentSize(uint32_t componentType) {
+            switch (componentType) {
+                case kComponentByte:
+                case kComponentUnsignedByte:
+                    return 1;
+                case kComponentShort:
+                case kComponentUnsignedShort:
+                    return 2;
+                case kComponentUnsignedInt:
+                case kComponentFloat:
+                    return 4;
+                default:
+                    return 0;
+            }
+        }
+
+        uint32_t componentCount(const std::string& type) {
+            if (type == "SCALAR") return 1;
+            if (type == "VEC2") return 2;
+            if (type == "VEC3") return 3;
+            if (type == "VEC4" || type == "MAT2") return 4;
+            if (type == "MAT3") return 9;
+            if (type == "MAT4") return 16;
+            return 0;
+        }
+
+        uint32_t toIndex(const JsonValue& value, const char* what) {
+            double number = value.getNumber(-1.0);
+            if (number < 0.0 || number >= static_cast<double>(UINT32_MAX) || number != std::floor(number)) {
+                throw std::runtime_error(std::string("glTF has an invalid ") + what + " index!");
+            }
+            return static_cast<uint32_t>(number);
+        }
+
+        // Componente c do elemento i convertido para float (normalizado quando pedido)
+        float readComponent(const AccessorView& view, uint32_t i, uint32_t c) {
+            if (!view.data) {
+                return 0.0f;
+            }
+            const uint8_t* src = view.data + i * view.stride + c * componentSize(view.componentType);
+            switch (view.componentType) {
+                case kComponentFloat: {
+                    float value;
+                    std::memcpy(&value, src, sizeof(value));
+                    return value;
+                }
+                case kComponentUnsignedByte:
+                    return view.normalized ? *src / 255.0f : static_cast<float>(*src);
+                case kComponentByte: {
+                    auto value = static_cast<int8_t>(*src);
+                    return view.normalized ? std::max(value / 127.0f, -1.0f) : static_cast<float>(value);
+                }
+                case kComponentUnsignedShort: {
+                    uint16_t value;
+                    std::memcpy(&value, src, sizeof(value));
+                    return view.normalized ? value / 65535.0f : static_cast<float>(value);
+                }
+                case kComponentShort: {
+                    int16_t value;
+                    std::memcpy(&value, src, sizeof(value));
+                    return view.normalized ? std::max(value / 32767.0f, -1.0f) : static_cast<float>(value);
+                }
+                default:
+                    return static_cast<float>(readU32(src));
+            }
+        }
+
+        template <typename T>
+        void decodeIndices(const AccessorView& view, uint32_t vertexCount, uint32_t* out) {
+            for (uint32_t i = 0; i < view.count; i++) {
+                T value;
+                std::memcpy(&value, view.data + i * view.stride, sizeof(T));
+                if (value >= vertexCount) {
+                    throw std::runtime_error("glTF primitive has an index out of range!");
+                }
+                out[i] = value;
+            }
+        }
+
+        int base64Value(char c) {
+            if (c >= 'A' && c <= 'Z') return c - 'A';
+            if (c >= 'a' && c <= 'z') return c - 'a' + 26;
+            if (c >= '0' && c <= '9') return c - '0' + 52;
+            if (c == '+') return 62;
+            if (c == '/') return 63;
+            return -1;
+        }
+
+        std::vector<uint8_t> decodeBase64(std::string_view text) {
+            std::vector<uint8_t> out;
+            out.reserve(text.size() / 4 * 3);
+            uint32_t bits = 0;
+            int bitCount = 0;
+            for (char c : text) {
+                if (c == '=') {
+                    break;
+                }
+                int value = base64Value(c);
+                if (value < 0) {
+                    throw std::runtime_error("glTF data URI is not valid base64!");
+                }
+                bits = (bits << 6) | static_cast<uint32_t>(value);
+                bitCount += 6;
+                if (bitCount >= 8) {
+                    bitCount -= 8;
+                    out.push_back(static_cast<uint8_t>(bits >> bitCount));
+                }
+            }
+            return out;
+        }
+
+        // Caminhos relativos em URIs vêm com escapes %XX (ex.: espaços)
+        std::string decodeUri(const std::string& uri) {
+            std::string out;
+            for (size_t i = 0; i < uri.size(); i++) {
+                int high = i + 2 < uri.size() ? std::isxdigit(static_cast<unsigned char>(uri[i + 1])) : 0;
+                int low = i + 2 < uri.size() ? std::isxdigit(static_cast<unsigned char>(uri[i + 2])) : 0;
+                if (uri[i] == '%' && high && low) {
+                    out += static_cast<char>(std::stoi(uri.substr(i + 1, 2), nullptr, 16));
+                    i += 2;
+                } else {
+                    out += uri[i];
+                }
+            }
+            return out;
+        }
+
+        void loadBuffers(const JsonValue& document, const std::string& path, BufferData glbChunk, BufferSources& sources) {
+            const JsonValue& buffers = document["buffers"];
+            std::filesystem::path directory = std::filesystem::path(path).parent_path();
+            sources.buffers.reserve(buffers.size());
+            for (size_t i = 0; i < buffers.size(); i++) {
+                const JsonValue& buffer = buffers[i];
+                auto byteLength = static_cast<size_t>(buffer["byteLength"].getNumber());
+                BufferData data;
+                if (!buffer.contains("uri")) {
+                    // Sem URI só o primeiro buffer de um .glb, apontando para o chunk BIN
+                    if (i != 0 || !glbChunk.data) {
+                        throw std::runtime_error("glTF buffer without uri outside a .glb: " + path);
+                    }
+                    data = glbChunk;
+                } else {
+                    const std::string& uri = buffer["uri"].getString();
+                    if (uri.rfind("data:", 0) == 0) {
+                        size_t comma = uri.find(',');
+                        if (comma == std::string::npos || comma < 12 || uri.compare(comma - 7, 7, ";base64") != 0) {
+                            throw std::runtime_error("glTF data URI must be base64: " + path);
+                        }
+                        auto& decoded = sources.decoded.emplace_back(decodeBase64(std::string_view(uri).substr(comma + 1)));
+                        data = { decoded.data(), decoded.size() };
+                    } else {
+                        std::string file = (directory / decodeUri(uri)).string();
+                        auto& mapped = sources.files.emplace_back(file);
+                        data = { mapped.data(), mapped.size() };
+                    }
+                }
+                if (data.size < byteLength) {
+                    throw std::runtime_error("glTF buffer is shorter than its byteLength: " + path);
+                }
+                data.size = byteLength;
+                sources.buffers.push_back(data);
+            }
+        }
+
+        AccessorView resolveAccessor(const JsonValue& document, const BufferSources& sources, uint32_t index) {
+            const JsonValue& accessor = document["accessors"][index];
+            if (!accessor.isObject()) {
+                throw std::runtime_error("glTF accessor index out of range!");
+            }
+            if (accessor.contains("sparse")) {
+                throw std::runtime_error("glTF sparse accessors are not supported!");
+            }
+
+            AccessorView view;
+            view.count = toIndex(accessor["count"], "accessor count");
+            view.componentType = static_cast<uint32_t>(accessor["componentType"].getNumber());
+            view.components = componentCount(accessor["type"].getString());
+            view.normalized = accessor["normalized"].getBool();
+            uint32_t size = componentSize(view.componentType);
+            if (size == 0 || view.components == 0) {
+                throw std::runtime_error("glTF accessor has an invalid componentType or type!");
+            }
+            size_t elementSize = static_cast<size_t>(size) * view.components;
+            view.stride = elementSize;
+            if (!accessor.contains("bufferView")) {
+                return view;
+            }
+
+            const JsonValue& bufferView = document["bufferViews"][toIndex(accessor["bufferView"], "bufferView")];
+            uint32_t bufferIndex = toIndex(bufferView["buffer"], "buffer");
+            if (!bufferView.isObject() || bufferIndex >= sources.buffers.size()) {
+                throw std::runtime_error("glTF bufferView or buffer index out of range!");
+            }
+            const BufferData& buffer = sources.buffers[bufferIndex];
+            auto viewOffset = static_cast<size_t>(bufferView["byteOffset"].getNumber());
+            auto viewLength = static_cast<size_t>(bufferView["byteLength"].getNumber());
+            auto accessorOffset = static_cast<size_t>(accessor["byteOffset"].getNumber());
+            view.stride = static_cast<size_t>(bufferView["byteStride"].getNumber(static_cast<double>(elementSize)));
+            if (view.stride < elementSize || viewOffset > buffer.size || viewLength > buffer.size - viewOffset) {
+                throw std::runtime_error("glTF bufferView is outside its buffer!");
+            }
+            // Último elemento precisa caber na view
+            if (view.count > 0 && accessorOffset + (view.count - 1) * view.stride + elementSize > viewLength) {
+                throw std::runtime_error("glTF accessor is outside its bufferView!");
+            }
+            view.data = buffer.data + viewOffset + accessorOffset;
+            return view;
+        }
+
+        // Decodifica uma primitiva direto nos vetores finais, dimensionados uma única vez
+        void decodePrimitive(const JsonValue& document, const BufferSources& sources, const JsonValue& primitive,
+                             GltfPrimitive& out) {
+            VKE_PROFILE_ZONE("gltf_decode_primitive");
+            auto mode = static_cast<uint32_t>(primitive["mode"].getNumber(kModeTriangles));
+            if (mode != kModeTriangles && mode != kModeTriangleStrip && mode != kModeTriangleFan) {
+                return; // pontos e linhas: o engine só desenha triângulos, a primitiva fica vazia
+            }
+            const JsonValue& attributes = primitive["attributes"];
+            if (!attributes.contains("POSITION")) {
+                throw std::runtime_error("glTF primitive has no POSITION attribute!");
+            }
+
+            AccessorView positions = resolveAccessor(document, sources, toIndex(attributes["POSITION"], "POSITION"));
+            if (positions.componentType != kComponentFloat || positions.components != 3) {
+                throw std::runtime_error("glTF POSITION must be a float VEC3!");
+            }
+            out.vertices.resize(positions.count);
+            Vertex* vertices = out.vertices.data();
+            for (uint32_t i = 0; i < positions.count; i++) {
+                if (positions.data) {
+                    std::memcpy(vertices[i].position, positions.data + i * positions.stride, sizeof(vertices[i].position));
+                } else {
+                    vertices[i].position[0] = vertices[i].position[1] = 0.0f;
+                }
+            }
+
+            if (attributes.contains("COLOR_0")) {
+                AccessorView colors = resolveAccessor(document, sources, toIndex(attributes["COLOR_0"], "COLOR_0"));
+                if (colors.count != positions.count || (colors.components != 3 && colors.components != 4)) {
+                    throw std::runtime_error("glTF COLOR_0 must be a VEC3/VEC4 with one color per vertex!");
+                }
+                for (uint32_t i = 0; i < colors.count; i++) {
+                    for (uint32_t c = 0; c < 3; c++) {
+                        vertices[i].color[c] = readComponent(colors, i, c);
+                    }
+                }
+            } else {
+                for (uint32_t i = 0; i < positions.count; i++) {
+                    vertices[i].color[0] = vertices[i].color[1] = vertices[i].color[2] = 1.0f;
+                }
+            }
+
+            // Índices do arquivo (ou 0..n-1 sem acessor), já validados contra os vértices
+            std::vector<uint32_t> source;
+            std::vector<uint32_t>& indices = mode == kModeTriangles ? out.indices : source;
+            if (primitive.contains("indices")) {
+                AccessorView view = resolveAccessor(document, sources, toIndex(primitive["indices"], "indices"));
+                if (view.components != 1) {
+                    throw std::runtime_error("glTF indices must be SCALAR!");
+                }
+                indices.resize(view.count);
+                if (!view.data) {
+                    std::fill(indices.begin(), indices.end(), 0u);
+                } else if (view.componentType == kComponentUnsignedByte) {
+                    decodeIndices<uint8_t>(view, positions.count, indices.data());
+                } else if (view.componentType == kComponentUnsignedShort) {
+                    decodeIndices<uint16_t>(view, positions.count, indices.data());
+                } else if (view.componentType == kComponentUnsignedInt) {
+                    decodeIndices<uint32_t>(view, positions.count, indices.data());
+                } else {
+                    throw std::runtime_error("glTF indices must be unsigned integers!");
+                }
+            } else {
+                indices.resize(positions.count);
+                for (uint32_t i = 0; i < positions.count; i++) {
+                    indices[i] = i;
+                }
+            }
+
+            if (mode == kModeTriangles) {
+                if (indices.size() % 3 != 0) {
+                    throw std::runtime_error("glTF triangle list has a partial triangle!");
+                }
+            } else if (source.size() >= 3) {
+                // Strip (ordem alternada para manter o winding) e fan viram lista
+                size_t triangleCount = source.size() - 2;
+                out.indices.resize(triangleCount * 3);
+                uint32_t* dst = out.indices.data();
+                for (size_t i = 0; i < triangleCount; i++, dst += 3) {
+                    if (mode == kModeTriangleFan) {
+                        dst[0] = source[0], dst[1] = source[i + 1], dst[2] = source[i + 2];
+                    } else if (i % 2 == 0) {
+                        dst[0] = source[i], dst[1] = source[i + 1], dst[2] = source[i + 2];
+                    } else {
+                        dst[0] = source[i + 1], dst[1] = source[i], dst[2] = source[i + 2];
+                    }
+                }
+            }
+
+            out.bounds = computeBounds(out.vertices.data(), out.vertices.size());
+        }
+
+        // Transform do Scene tem escala uniforme: usa a maior escala por eixo, para as
+        // esferas de culling continuarem conservadoras
+        Transform decomposeMatrix(const JsonValue& matrix) {
+            float m[16];
+            for (size_t i = 0; i < 16; i++) {
+                m[i] = static_cast<float>(matrix[i].getNumber(i % 5 == 0 ? 1.0 : 0.0));
+            }
+            Transform local;
+            local.position[0] = m[12];
+            local.position[1] = m[13];
+            local.position[2] = m[14];
+
+            float axis[3];
+            for (int c = 0; c < 3; c++) {
+                axis[c] = std::sqrt(m[c * 4] * m[c * 4] + m[c * 4 + 1] * m[c * 4 + 1] + m[c * 4 + 2] * m[c * 4 + 2]);
+                if (axis[c] > 0.0f) {
+                    for (int r = 0; r < 3; r++) {
+                        m[c * 4 + r] /= axis[c];
+                    }
+                }
+            }
+            local.scale = std::max({ axis[0], axis[1], axis[2] });
+
+            // r(linha, coluna) da rotação normalizada, column-major
+            auto r = [&m](int row, int column) { return m[column * 4 + row]; };
+            float* q = local.rotation;
+            float trace = r(0, 0) + r(1, 1) + r(2, 2);
+            if (trace > 0.0f) {
+                float s = std::sqrt(trace + 1.0f) * 2.0f;
+                q[3] = 0.25f * s;
+                q[0] = (r(2, 1) - r(1, 2)) / s;
+                q[1] = (r(0, 2) - r(2, 0)) / s;
+                q[2] = (r(1, 0) - r(0, 1)) / s;
+            } else if (r(0, 0) > r(1, 1) && r(0, 0) > r(2, 2)) {
+                float s = std::sqrt(1.0f + r(0, 0) - r(1, 1) - r(2, 2)) * 2.0f;
+                q[3] = (r(2, 1) - r(1, 2)) / s;
+                q[0] = 0.25f * s;
+                q[1] = (r(0, 1) + r(1, 0)) / s;
+                q[2] = (r(0, 2) + r(2, 0)) / s;
+            } else if (r(1, 1) > r(2, 2)) {
+                float s = std::sqrt(1.0f + r(1, 1) - r(0, 0) - r(2, 2)) * 2.0f;
+                q[3] = (r(0, 2) - r(2, 0)) / s;
+                q[0] = (r(0, 1) + r(1, 0)) / s;
+                q[1] = 0.25f * s;
+                q[2] = (r(1, 2) + r(2, 1)) / s;
+            } else {
+                float s = std::sqrt(1.0f + r(2, 2) - r(0, 0) - r(1, 1)) * 2.0f;
+                q[3] = (r(1, 0) - r(0, 1)) / s;
+                q[0] = (r(0, 2) + r(2, 0)) / s;
+                q[1] = (r(1, 2) + r(2, 1)) / s;
+                q[2] = 0.25f * s;
+            }
+            return local;
+        }
+
+        Transform readTransform(const JsonValue& node) {
+            if (node.contains("matrix")) {
+                return decomposeMatrix(node["matrix"]);
+            }
+            Transform local;
+            const JsonValue& translation = node["translation"];
+            const JsonValue& rotation = node["rotation"];
+            const JsonValue& scale = node["scale"];
+            for (size_t i = 0; i < 3; i++) {
+                local.position[i] = static_cast<float>(translation[i].getNumber());
+            }
+            for (size_t i = 0; i < 4; i++) {
+                local.rotation[i] = static_cast<float>(rotation[i].getNumber(i == 3 ? 1.0 : 0.0));
+            }
+            if (scale.isArray()) {
+                local.scale = static_cast<float>(std::max({ scale[0].getNumber(1.0), scale[1].getNumber(1.0),
+                                                            scale[2].getNumber(1.0) }));
+            }
+            return local;
+        }
+
+        void loadNodes(const JsonValue& document, GltfAsset& asset) {
+            const JsonValue& nodes = document["nodes"];
+            asset.nodes.resize(nodes.size());
+            for (size_t i = 0; i < nodes.size(); i++) {
+                const JsonValue& node = nodes[i];
+                GltfNode& out = asset.nodes[i];
+                out.name = node["name"].getString();
+                out.local = readTransform(node);
+                if (node.contains("mesh")) {
+                    out.mesh = toIndex(node["mesh"], "mesh");
+                    if (out.mesh >= asset.meshes.size()) {
+                        throw std::runtime_error("glTF node references a missing mesh!");
+                    }
+                }
+            }
+            for (size_t i = 0; i < nodes.size(); i++) {
+                const JsonValue& children = nodes[i]["children"];
+                for (size_t c = 0; c < children.size(); c++) {
+                    uint32_t child = toIndex(children[c], "child node");
+                    if (child >= asset.nodes.size() || child == i || asset.nodes[child].parent != Scene::kNoParent) {
+                        throw std::runtime_error("glTF node hierarchy is not a forest!");
+                    }
+                    asset.nodes[child].parent = static_cast<uint32_t>(i);
+                }
+            }
+
+            // Cena padrão (ou a primeira); sem cenas, todos os nós sem pai
+            const JsonValue& scenes = document["scenes"];
+            if (scenes.size() > 0) {
+                uint32_t scene = document.contains("scene") ? toIndex(document["scene"], "scene") : 0;
+                const JsonValue& roots = scenes[scene]["nodes"];
+                for (size_t i = 0; i < roots.size(); i++) {
+                    uint32_t root = toIndex(roots[i], "scene node");
+                    if (root >= asset.nodes.size()) {
+                        throw std::runtime_error("glTF scene references a missing node!");
+                    }
+                    asset.roots.push_back(root);
+                }
+            } else {
+                for (uint32_t i = 0; i < asset.nodes.size(); i++) {
+                    if (asset.nodes[i].parent == Scene::kNoParent) {
+                        asset.roots.push_back(i);
+                    }
+                }
+            }
+        }
+
+    } // namespace
+
+    size_t GltfAsset::getTriangleCount() const {
+        size_t triangles = 0;
+        for (const GltfPrimitive& primitive : primitives) {
+            triangles += primitive.indices.size() / 3;
+        }
+        return triangles;
+    }
+
+    std::vector<SceneNode> GltfAsset::instantiate(Scene& scene) const {
+        std::vector<std::vector<uint32_t>> children(nodes.size());
+        for (uint32_t i = 0; i < nodes.size(); i++) {
+            if (nodes[i].parent != Scene::kNoParent) {
+                children[nodes[i].parent].push_back(i);
+            }
+        }
+
+        // Em profundidade a partir das raízes; visited protege de ciclos num arquivo inválido
+        std::vector<SceneNode> handles(nodes.size());
+        std::vector<uint8_t> visited(nodes.size(), 0);
+        std::vector<std::pair<uint32_t, SceneNode>> stack;
+        for (uint32_t root : roots) {
+            stack.emplace_back(root, SceneNode{});
+        }
+        while (!stack.empty()) {
+            auto [index, parent] = stack.back();
+            stack.pop_back();
+            if (visited[index]) {
+                continue;
+            }
+            visited[index] = 1;
+            handles[index] = scene.create(parent, nodes[index].local);
+            for (uint32_t child : children[index]) {
+                stack.emplace_back(child, handles[index]);
+            }
+        }
+        return handles;
+    }
+
+    GltfAsset GltfImporter::load(const std::string& path, JobSystem* jobs) {
+        VKE_PROFILE_ZONE("GltfImporter::load");
+        MappedFile file(path);
+        const uint8_t* bytes = file.data();
+        std::string_view json(reinterpret_cast<const char*>(bytes), file.size());
+        BufferData binChunk;
+
+        // .glb: cabeçalho de 12 bytes, chunk JSON e chunk BIN opcional (lido no lugar)
+        if (file.size() >= 12 && readU32(bytes) == kGlbMagic) {
+            if (readU32(bytes + 4) != 2 || readU32(bytes + 8) > file.size()) {
+                throw std::runtime_error("Unsupported or truncated .glb: " + path);
+            }
+            size_t total = readU32(bytes + 8);
+            size_t offset = 12;
+            json = {};
+            while (offset + 8 <= total) {
+                uint32_t length = readU32(bytes + offset);
+                uint32_t type = readU32(bytes + offset + 4);
+                offset += 8;
+                if (length > total - offset) {
+                    throw std::runtime_error("Truncated .glb chunk: " + path);
+                }
+                if (type == kGlbChunkJson && json.empty()) {
+                    json = { reinterpret_cast<const char*>(bytes + offset), length };
+                } else if (type == kGlbChunkBin && !binChunk.data) {
+                    binChunk = { bytes + offset, length };
+                }
+                offset += (length + 3) & ~3u;
+            }
+            if (json.empty()) {
+                throw std::runtime_error(".glb has no JSON chunk: " + path);
+            }
+        }
+
+        JsonValue document;
+        {
+            VKE_PROFILE_ZONE("gltf_parse_json");
+            document = JsonValue::parse(json, path);
+        }
+        const std::string& version = document["asset"]["version"].getString();
+        if (version.rfind("2.", 0) != 0) {
+            throw std::runtime_error("Only glTF 2.x is supported: " + path);
+        }
+
+        BufferSources sources;
+        loadBuffers(document, path, binChunk, sources);
+
+        // Meshes viram faixas contíguas de primitivas, na ordem do arquivo
+        GltfAsset asset;
+        std::vector<const JsonValue*> primitives;
+        const JsonValue& meshes = document["meshes"];
+        asset.meshes.resize(meshes.size());
+        for (size_t i = 0; i < meshes.size(); i++) {
+            GltfMesh& mesh = asset.meshes[i];
+            mesh.name = meshes[i]["name"].getString();
+            mesh.firstPrimitive = static_cast<uint32_t>(primitives.size());
+            const JsonValue& meshPrimitives = meshes[i]["primitives"];
+            for (size_t p = 0; p < meshPrimitives.size(); p++) {
+                primitives.push_back(&meshPrimitives[p]);
+            }
+            mesh.primitiveCount = static_cast<uint32_t>(primitives.size()) - mesh.firstPrimitive;
+        }
+        loadNodes(document, asset);
+
+        // Cada primitiva escreve só no próprio slot; jobs não podem lançar, então o
+        // primeiro erro de cada uma é guardado e relançado depois de todas terminarem
+        auto primitiveCount = static_cast<uint32_t>(primitives.size());
+        asset.primitives.resize(primitiveCount);
+        std::vector<std::string> errors(primitiveCount);
+        auto decodeRange = [&](uint32_t begin, uint32_t end) {
+            for (uint32_t i = begin; i < end; i++) {
+                try {
+                    decodePrimitive(document, sources, *primitives[i], asset.primitives[i]);
+                } catch (const std::exception& e) {
+                    errors[i] = e.what();
+                }
+            }
+        };
+        if (jobs && primitiveCount > 1) {
+            jobs->parallelFor(primitiveCount, 1, decodeRange);
+        } else {
+            decodeRange(0, primitiveCount);
+        }
+        for (const std::string& error : errors) {
+            if (!error.empty()) {
+                throw std::runtime_error(error + " (" + path + ")");
+            }
+        }
+        return asset;
+    }
+
+} // namespace vke
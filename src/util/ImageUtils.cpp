@@ -0,0 +1,32 @@
+#include "util/ImageUtils.h"
+
+#include <fstream>
+#include <stdexcept>
+
+namespace vke {
+
+    void writePPM(const std::string& path, const std::vector<uint8_t>& rgba, uint32_t width, uint32_t height) {
+        if (rgba.size() < static_cast<size_t>(width) * height * 4) {
+            throw std::runtime_error("Not enough pixel data for PPM image!");
+        }
+
+        std::ofstream file(path, std::ios::binary);
+        if (!file) {
+            throw std::runtime_error("Failed to open " + path + " for writing!");
+        }
+
+        file << "P6\n" << width << " " << height << "\n255\n";
+
+        std::vector<uint8_t> rgb(static_cast<size_t>(width) * height * 3);
+        for (size_t i = 0, j = 0; j < rgb.size(); i += 4, j += 3) {
+            rgb[j + 0] = rgba[i + 0];
+            rgb[j + 1] = rgba[i + 1];
+            rgb[j + 2] = rgba[i + 2];
+        }
+        file.write(reinterpret_cast<const char*>(rgb.data()), static_cast<std::streamsize>(rgb.size()));
+        if (!file) {
+            throw std::runtime_error("Failed to write " + path + "!");
+        }
+    }
+
+} // namespace vke
@@ -0,0 +1,298 @@
+#include "util/Json.h"
+
+#include <charconv>
+#include <cstdio>
+#include <ostream>
+#include <stdexcept>
+
+namespace vke {
+
+    namespace {
+
+        // Baselines e assets não aninham tanto; o limite evita estourar a pilha com entrada maliciosa
+        constexpr uint32_t kMaxDepth = 256;
+
+        const JsonValue& nullValue() {
+            static const JsonValue value;
+            return value;
+        }
+
+        void appendUtf8(std::string& out, uint32_t codepoint) {
+            if (codepoint < 0x80) {
+                out += static_cast<char>(codepoint);
+            } else if (codepoint < 0x800) {
+                out += static_cast<char>(0xC0 | (codepoint >> 6));
+                out += static_cast<char>(0x80 | (codepoint & 0x3F));
+            } else if (codepoint < 0x10000) {
+                out += static_cast<char>(0xE0 | (codepoint >> 12));
+                out += static_cast<char>(0x80 | ((codepoint >> 6) & 0x3F));
+                out += static_cast<char>(0x80 | (codepoint & 0x3F));
+            } else {
+                out += static_cast<char>(0xF0 | (codepoint >> 18));
+                out += static_cast<char>(0x80 | ((codepoint >> 12) & 0x3F));
+                out += static_cast<char>(0x80 | ((codepoint >> 6) & 0x3F));
+                out += static_cast<char>(0x80 | (codepoint & 0x3F));
+            }
+        }
+
+    } // namespace
+
+    // Descida recursiva sobre o texto inteiro, sem cópias intermediárias além das strings
+    class JsonParser {
+    public:
+        JsonParser(std::string_view text, const std::string& source) : m_text(text), m_source(source) {}
+
+        JsonValue parseDocument() {
+            JsonValue root;
+            parseValue(root, 0);
+            skipSpace();
+            if (m_pos != m_text.size()) {
+                fail("trailing characters");
+            }
+            return root;
+        }
+
+    private:
+        void parseValue(JsonValue& out, uint32_t depth) {
+            if (depth > kMaxDepth) {
+                fail("nesting too deep");
+            }
+            skipSpace();
+            if (m_pos >= m_text.size()) {
+                fail("unexpected end of input");
+            }
+            switch (m_text[m_pos]) {
+                case '{':
+                    parseObject(out, depth);
+                    break;
+                case '[':
+                    parseArray(out, depth);
+                    break;
+                case '"':
+                    out.m_type = JsonValue::Type::String;
+                    parseString(out.m_string);
+                    break;
+                case 't':
+                    parseLiteral("true");
+                    out.m_type = JsonValue::Type::Bool;
+                    out.m_bool = true;
+                    break;
+                case 'f':
+                    parseLiteral("false");
+                    out.m_type = JsonValue::Type::Bool;
+                    break;
+                case 'n':
+                    parseLiteral("null");
+                    break;
+                default:
+                    out.m_type = JsonValue::Type::Number;
+                    out.m_number = parseNumber();
+                    break;
+            }
+        }
+
+        void parseObject(JsonValue& out, uint32_t depth) {
+            out.m_type = JsonValue::Type::Object;
+            m_pos++;
+            if (consume('}')) {
+                return;
+            }
+            do {
+                skipSpace();
+                auto& member = out.m_object.emplace_back();
+                parseString(member.first);
+                expect(':');
+                parseValue(member.second, depth + 1);
+            } while (consume(','));
+            expect('}');
+        }
+
+        void parseArray(JsonValue& out, uint32_t depth) {
+            out.m_type = JsonValue::Type::Array;
+            m_pos++;
+            if (consume(']')) {
+                return;
+            }
+            do {
+                parseValue(out.m_array.emplace_back(), depth + 1);
+            } while (consume(','));
+            expect(']');
+        }
+
+        void parseString(std::string& out) {
+            if (m_pos >= m_text.size() || m_text[m_pos] != '"') {
+                fail("expected string");
+            }
+            m_pos++;
+            while (true) {
+                // Trecho sem escapes copiado de uma vez
+                size_t start = m_pos;
+                while (m_pos < m_text.size() && m_text[m_pos] != '"' && m_text[m_pos] != '\\') {
+                    m_pos++;
+                }
+                out.append(m_text.data() + start, m_pos - start);
+                if (m_pos >= m_text.size()) {
+                    fail("unterminated string");
+                }
+                if (m_text[m_pos++] == '"') {
+                    return;
+                }
+                if (m_pos >= m_text.size()) {
+                    fail("unterminated string");
+                }
+                char escape = m_text[m_pos++];
+                switch (escape) {
+                    case '"': out += '"'; break;
+                    case '\\': out += '\\'; break;
+                    case '/': out += '/'; break;
+                    case 'b': out += '\b'; break;
+                    case 'f': out += '\f'; break;
+                    case 'n': out += '\n'; break;
+                    case 'r': out += '\r'; break;
+                    case 't': out += '\t'; break;
+                    case 'u': {
+                        uint32_t codepoint = parseHex4();
+                        // Par substituto UTF-16
+                        if (codepoint >= 0xD800 && codepoint < 0xDC00 &&
+                            m_text.substr(m_pos, 2) == "\\u") {
+                            m_pos += 2;
+                            uint32_t low = parseHex4();
+                            if (low < 0xDC00 || low >= 0xE000) {
+                                fail("invalid surrogate pair");
+                            }
+                            codepoint = 0x10000 + ((codepoint - 0xD800) << 10) + (low - 0xDC00);
+                        }
+                        appendUtf8(out, codepoint);
+                        break;
+                    }
+                    default:
+                        fail("invalid escape");
+                }
+            }
+        }
+
+        uint32_t parseHex4() {
+            if (m_pos + 4 > m_text.size()) {
+                fail("truncated \\u escape");
+            }
+            uint32_t value = 0;
+            auto result = std::from_chars(m_text.data() + m_pos, m_text.data() + m_pos + 4, value, 16);
+            if (result.ptr != m_text.data() + m_pos + 4) {
+                fail("invalid \\u escape");
+            }
+            m_pos += 4;
+            return value;
+        }
+
+        double parseNumber() {
+            // from_chars não depende do locale, ao contrário de strtod; o '+' inicial não é JSON
+            double value = 0.0;
+            const char* begin = m_text.data() + m_pos;
+            auto result = std::from_chars(begin, m_text.data() + m_text.size(), value);
+            if (result.ec != std::errc() || *begin == '+') {
+                fail("invalid value");
+            }
+            m_pos += static_cast<size_t>(result.ptr - begin);
+            return value;
+        }
+
+        void parseLiteral(std::string_view literal) {
+            if (m_text.substr(m_pos, literal.size()) != literal) {
+                fail("invalid literal");
+            }
+            m_pos += literal.size();
+        }
+
+        void skipSpace() {
+            while (m_pos < m_text.size()) {
+                char c = m_text[m_pos];
+                if (c != ' ' && c != '\t' && c != '\n' && c != '\r') {
+                    break;
+                }
+                m_pos++;
+            }
+        }
+
+        bool consume(char c) {
+            skipSpace();
+            if (m_pos < m_text.size() && m_text[m_pos] == c) {
+                m_pos++;
+                return true;
+            }
+            return false;
+        }
+
+        void expect(char c) {
+            if (!consume(c)) {
+                fail(std::string("expected '") + c + "'");
+            }
+        }
+
+        [[noreturn]] void fail(const std::string& what) const {
+            throw std::runtime_error("Invalid JSON (" + what + ") at offset " + std::to_string(m_pos) + ": " + m_source);
+        }
+
+    private:
+        std::string_view m_text;
+        const std::string& m_source;
+        size_t m_pos = 0;
+    };
+
+    JsonValue JsonValue::parse(std::string_view text, const std::string& source) {
+        return JsonParser(text, source).parseDocument();
+    }
+
+    size_t JsonValue::size() const {
+        if (m_type == Type::Array) {
+            return m_array.size();
+        }
+        return m_type == Type::Object ? m_object.size() : 0;
+    }
+
+    const JsonValue& JsonValue::operator[](size_t index) const {
+        return m_type == Type::Array && index < m_array.size() ? m_array[index] : nullValue();
+    }
+
+    const JsonValue& JsonValue::operator[](std::string_view key) const {
+        for (const auto& [name, value] : m_object) {
+            if (name == key) {
+                return value;
+            }
+        }
+        return nullValue();
+    }
+
+    bool JsonValue::contains(std::string_view key) const {
+        for (const auto& member : m_object) {
+            if (member.first == key) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void writeJsonString(std::ostream& out, std::string_view text) {
+        out << '"';
+        for (char c : text) {
+            switch (c) {
+                case '"': out << "\\\""; break;
+                case '\\': out << "\\\\"; break;
+                case '\n': out << "\\n"; break;
+                case '\r': out << "\\r"; break;
+                case '\t': out << "\\t"; break;
+                case '\b': out << "\\b"; break;
+                case '\f': out << "\\f"; break;
+                default:
+                    if (static_cast<unsigned char>(c) < 0x20) {
+                        char escape[8];
+                        std::snprintf(escape, sizeof(escape), "\\u%04x", static_cast<unsigned>(c));
+                        out << escape;
+                    } else {
+                        out << c;
+                    }
+            }
+        }
+        out << '"';
+    }
+
+} // namespace vke
@@ -0,0 +1,129 @@
+#include "util/MappedFile.h"
+
+#include <stdexcept>
+#include <utility>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace vke {
+
+    MappedFile::MappedFile(const std::string& path) {
+#ifdef _WIN32
+        HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                  FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (file == INVALID_HANDLE_VALUE) {
+            throw std::runtime_error("Failed to open file: " + path);
+        }
+        LARGE_INTEGER size{};
+        if (!GetFileSizeEx(file, &size)) {
+            CloseHandle(file);
+            throw std::runtime_error("Failed to query file size: " + path);
+        }
+        m_file = file;
+        m_size = static_cast<size_t>(size.QuadPart);
+        m_opened = true;
+        if (m_size == 0) {
+            return;
+        }
+
+        HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        void* view = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+        if (!view) {
+            if (mapping) {
+                CloseHandle(mapping);
+            }
+            close();
+            throw std::runtime_error("Failed to map file: " + path);
+        }
+        m_mapping = mapping;
+        m_data = static_cast<const uint8_t*>(view);
+#else
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            throw std::runtime_error("Failed to open file: " + path);
+        }
+        struct stat info{};
+        if (fstat(fd, &info) != 0) {
+            ::close(fd);
+            throw std::runtime_error("Failed to query file size: " + path);
+        }
+        m_size = static_cast<size_t>(info.st_size);
+        m_opened = true;
+        if (m_size == 0) {
+            ::close(fd);
+            return;
+        }
+
+        // O mapeamento continua válido depois de fechar o descritor
+        void* view = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (view == MAP_FAILED) {
+            m_size = 0;
+            m_opened = false;
+            throw std::runtime_error("Failed to map file: " + path);
+        }
+        // As seções são lidas de ponta a ponta logo em seguida: pede o read-ahead já
+        madvise(view, m_size, MADV_WILLNEED);
+        m_data = static_cast<const uint8_t*>(view);
+#endif
+    }
+
+    MappedFile::~MappedFile() {
+        close();
+    }
+
+    MappedFile::MappedFile(MappedFile&& other) noexcept {
+        *this = std::move(other);
+    }
+
+    MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+        if (this != &other) {
+            close();
+            m_data = std::exchange(other.m_data, nullptr);
+            m_size = std::exchange(other.m_size, 0);
+            m_opened = std::exchange(other.m_opened, false);
+#ifdef _WIN32
+            m_file = std::exchange(other.m_file, nullptr);
+            m_mapping = std::exchange(other.m_mapping, nullptr);
+#endif
+        }
+        return *this;
+    }
+
+    void MappedFile::close() {
+#ifdef _WIN32
+        if (m_data) {
+            UnmapViewOfFile(m_data);
+        }
+        if (m_mapping) {
+            CloseHandle(m_mapping);
+            m_mapping = nullptr;
+        }
+        if (m_file) {
+            CloseHandle(m_file);
+            m_file = nullptr;
+        }
+#else
+        if (m_data) {
+            munmap(const_cast<uint8_t*>(m_data), m_size);
+        }
+#endif
+        m_data = nullptr;
+        m_size = 0;
+        m_opened = false;
+    }
+
+} // namespace vke
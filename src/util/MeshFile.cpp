@@ -0,0 +1,172 @@
+#include "util/MeshFile.h"
+
+#include <algorithm>
+#include <fstream>
+#include <stdexcept>
+
+namespace vke {
+
+    namespace {
+
+        uint64_t alignUp(uint64_t value) {
+            return (value + kMeshFileAlignment - 1) / kMeshFileAlignment * kMeshFileAlignment;
+        }
+
+        // Seção dentro do arquivo, alinhada e com tamanho múltiplo do elemento
+        bool validSection(const MeshFileSection& section, size_t fileSize, size_t elementSize) {
+            return section.offset % kMeshFileAlignment == 0 &&
+                   section.offset <= fileSize && section.size <= fileSize - section.offset &&
+                   section.size % elementSize == 0;
+        }
+
+        bool validRange(uint32_t first, uint32_t count, uint64_t total) {
+            return static_cast<uint64_t>(first) + count <= total;
+        }
+
+        void writeSection(std::ofstream& out, const MeshFileSection& section, const void* data) {
+            static const char kPadding[kMeshFileAlignment] = {};
+            auto position = static_cast<uint64_t>(out.tellp());
+            out.write(kPadding, static_cast<std::streamsize>(section.offset - position));
+            out.write(static_cast<const char*>(data), static_cast<std::streamsize>(section.size));
+        }
+
+    } // namespace
+
+    MeshFile::MeshFile(const std::string& path)
+        : m_file(path)
+    {
+        const uint8_t* base = m_file.data();
+        size_t size = m_file.size();
+        if (size < sizeof(MeshFileHeader)) {
+            throw std::runtime_error("Mesh file is truncated: " + path);
+        }
+
+        m_header = reinterpret_cast<const MeshFileHeader*>(base);
+        if (m_header->magic != kMeshFileMagic) {
+            throw std::runtime_error("Not a mesh file: " + path);
+        }
+        if (m_header->version != kMeshFileVersion || m_header->vertexStride != sizeof(Vertex)) {
+            throw std::runtime_error("Unsupported mesh file version or vertex layout (re-cook it): " + path);
+        }
+
+        const MeshFileHeader& header = *m_header;
+        if (!validSection(header.meshes, size, sizeof(MeshFileEntry)) ||
+            !validSection(header.meshlets, size, sizeof(MeshFileMeshlet)) ||
+            !validSection(header.vertices, size, sizeof(Vertex)) ||
+            !validSection(header.indices, size, sizeof(uint32_t)) ||
+            header.meshes.size != static_cast<uint64_t>(header.meshCount) * sizeof(MeshFileEntry)) {
+            throw std::runtime_error("Mesh file has corrupt section table: " + path);
+        }
+
+        // Sem parse: as seções são usadas onde estão no mapeamento
+        m_meshes = reinterpret_cast<const MeshFileEntry*>(base + header.meshes.offset);
+        m_meshlets = reinterpret_cast<const MeshFileMeshlet*>(base + header.meshlets.offset);
+        m_vertices = reinterpret_cast<const Vertex*>(base + header.vertices.offset);
+        m_indices = reinterpret_cast<const uint32_t*>(base + header.indices.offset);
+
+        // Limites das faixas, dos meshlets e o maior índice de cada mesh: sem robustBufferAccess um
+        // índice corrompido faria a GPU ler fora do vertex buffer. A varredura é uma
+        // passada sequencial que deixa as páginas quentes para a cópia ao staging
+        uint64_t meshletTotal = header.meshlets.size / sizeof(MeshFileMeshlet);
+        uint64_t vertexTotal = header.vertices.size / sizeof(Vertex);
+        uint64_t indexTotal = header.indices.size / sizeof(uint32_t);
+        for (uint32_t i = 0; i < header.meshCount; i++) {
+            const MeshFileEntry& mesh = m_meshes[i];
+            if (!validRange(mesh.firstVertex, mesh.vertexCount, vertexTotal) ||
+                !validRange(mesh.firstIndex, mesh.indexCount, indexTotal) ||
+                !validRange(mesh.firstMeshlet, mesh.meshletCount, meshletTotal)) {
+                throw std::runtime_error("Mesh file has a mesh outside its sections: " + path);
+            }
+            const uint32_t* indices = m_indices + mesh.firstIndex;
+            uint32_t maxIndex = 0;
+            for (uint32_t j = 0; j < mesh.indexCount; j++) {
+                maxIndex = std::max(maxIndex, indices[j]);
+            }
+            if (mesh.indexCount > 0 && maxIndex >= mesh.vertexCount) {
+                throw std::runtime_error("Mesh file has an index out of range: " + path);
+            }
+            // Meshlets apontam para faixas dos índices do próprio mesh
+            const MeshFileMeshlet* meshlets = m_meshlets + mesh.firstMeshlet;
+            for (uint32_t j = 0; j < mesh.meshletCount; j++) {
+                if (!validRange(meshlets[j].firstIndex, meshlets[j].indexCount, mesh.indexCount)) {
+                    throw std::runtime_error("Mesh file has a meshlet outside its mesh: " + path);
+                }
+            }
+        }
+    }
+
+    void MeshFile::write(const std::string& path, const std::vector<MeshFileInput>& meshes) {
+        std::vector<MeshFileEntry> entries;
+        std::vector<MeshFileMeshlet> meshlets;
+        std::vector<Vertex> vertices;
+        std::vector<uint32_t> indices;
+        entries.reserve(meshes.size());
+
+        std::vector<Vertex> meshletVertices;
+        for (const MeshFileInput& input : meshes) {
+            if (input.indices.size() % 3 != 0) {
+                throw std::runtime_error("Mesh file input is not a triangle list!");
+            }
+            for (uint32_t index : input.indices) {
+                if (index >= input.vertices.size()) {
+                    throw std::runtime_error("Mesh file input has an index out of range!");
+                }
+            }
+
+            MeshFileEntry entry;
+            entry.firstVertex = static_cast<uint32_t>(vertices.size());
+            entry.vertexCount = static_cast<uint32_t>(input.vertices.size());
+            entry.firstIndex = static_cast<uint32_t>(indices.size());
+            entry.indexCount = static_cast<uint32_t>(input.indices.size());
+            entry.firstMeshlet = static_cast<uint32_t>(meshlets.size());
+            entry.bounds = computeBounds(input.vertices);
+
+            // Meshlets na ordem dos índices: triângulos vizinhos no buffer costumam ser vizinhos no espaço
+            constexpr uint32_t kMeshletIndices = kMeshletMaxTriangles * 3;
+            for (uint32_t first = 0; first < entry.indexCount; first += kMeshletIndices) {
+                MeshFileMeshlet meshlet;
+                meshlet.firstIndex = first;
+                meshlet.indexCount = std::min(kMeshletIndices, entry.indexCount - first);
+                meshletVertices.clear();
+                for (uint32_t i = 0; i < meshlet.indexCount; i++) {
+                    meshletVertices.push_back(input.vertices[input.indices[first + i]]);
+                }
+                meshlet.bounds = computeBounds(meshletVertices);
+                meshlets.push_back(meshlet);
+            }
+            entry.meshletCount = static_cast<uint32_t>(meshlets.size()) - entry.firstMeshlet;
+
+            vertices.insert(vertices.end(), input.vertices.begin(), input.vertices.end());
+            indices.insert(indices.end(), input.indices.begin(), input.indices.end());
+            entries.push_back(entry);
+        }
+
+        MeshFileHeader header;
+        header.meshCount = static_cast<uint32_t>(entries.size());
+        header.bounds = computeBounds(vertices);
+        uint64_t offset = alignUp(sizeof(MeshFileHeader));
+        auto place = [&offset](MeshFileSection& section, uint64_t bytes) {
+            section.offset = offset;
+            section.size = bytes;
+            offset = alignUp(offset + bytes);
+        };
+        place(header.meshes, entries.size() * sizeof(MeshFileEntry));
+        place(header.meshlets, meshlets.size() * sizeof(MeshFileMeshlet));
+        place(header.vertices, vertices.size() * sizeof(Vertex));
+        place(header.indices, indices.size() * sizeof(uint32_t));
+
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        if (!out) {
+            throw std::runtime_error("Failed to open mesh file for writing: " + path);
+        }
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        writeSection(out, header.meshes, entries.data());
+        writeSection(out, header.meshlets, meshlets.data());
+        writeSection(out, header.vertices, vertices.data());
+        writeSection(out, header.indices, indices.data());
+        if (!out) {
+            throw std::runtime_error("Failed to write mesh file: " + path);
+        }
+    }
+
+} // namespace vke
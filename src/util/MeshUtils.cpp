@@ -0,0 +1,61 @@
+#include "util/MeshUtils.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+
+namespace vke {
+
+    namespace {
+
+        // FNV-1a sobre os bytes do vértice
+        uint32_t hashVertex(const Vertex& vertex) {
+            const auto* bytes = reinterpret_cast<const unsigned char*>(&vertex);
+            uint32_t hash = 2166136261u;
+            for (size_t i = 0; i < sizeof(Vertex); i++) {
+                hash = (hash ^ bytes[i]) * 16777619u;
+            }
+            return hash;
+        }
+
+    } // namespace
+
+    void weldVertices(const std::vector<Vertex>& triangleList,
+                      std::vector<Vertex>& outVertices,
+                      std::vector<uint32_t>& outIndices) {
+        constexpr uint32_t kEmpty = UINT32_MAX;
+
+        outVertices.clear();
+        outIndices.clear();
+        outVertices.reserve(triangleList.size());
+        outIndices.reserve(triangleList.size());
+
+        // Tabela de endereçamento aberto com no máximo 50% de ocupação:
+        // uma única alocação, sem nós por vértice como em um unordered_map
+        const size_t tableSize = std::bit_ceil(std::max<size_t>(triangleList.size() * 2, 16));
+        const size_t mask = tableSize - 1;
+        std::vector<uint32_t> table(tableSize, kEmpty);
+
+        for (const Vertex& vertex : triangleList) {
+            size_t slot = hashVertex(vertex) & mask;
+            while (true) {
+                uint32_t existing = table[slot];
+                if (existing == kEmpty) {
+                    existing = static_cast<uint32_t>(outVertices.size());
+                    table[slot] = existing;
+                    outVertices.push_back(vertex);
+                    outIndices.push_back(existing);
+                    break;
+                }
+                if (std::memcmp(&outVertices[existing], &vertex, sizeof(Vertex)) == 0) {
+                    outIndices.push_back(existing);
+                    break;
+                }
+                slot = (slot + 1) & mask;
+            }
+        }
+
+        outVertices.shrink_to_fit();
+    }
+
+} // namespace vke
@@ -0,0 +1,203 @@
+#include "core/JobSystem.h"
+#include "util/GltfImporter.h"
+#include "util/MeshFile.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+    // Subconjunto de OBJ que o Vertex atual representa: "v x y [z] [r g b]" (z é
+    // descartado, a cor padrão é branca), "f" com qualquer número de vértices
+    // (triangulado em leque, índices negativos aceitos) e "o"/"g" abrindo um mesh novo
+    class ObjReader {
+    public:
+        void read(const std::string& path, std::vector<vke::MeshFileInput>& outMeshes) {
+            std::ifstream in(path);
+            if (!in) {
+                throw std::runtime_error("Failed to open OBJ file: " + path);
+            }
+            m_positions.clear();
+            m_meshes = &outMeshes;
+            beginMesh();
+
+            std::string line;
+            uint32_t lineNumber = 0;
+            while (std::getline(in, line)) {
+                lineNumber++;
+                std::istringstream tokens(line);
+                std::string keyword;
+                tokens >> keyword;
+                if (keyword == "v") {
+                    readPosition(tokens);
+                } else if (keyword == "f") {
+                    readFace(tokens, path, lineNumber);
+                } else if (keyword == "o" || keyword == "g") {
+                    beginMesh();
+                }
+            }
+            endMesh();
+        }
+
+    private:
+        void beginMesh() {
+            endMesh();
+            m_current = {};
+            m_remap.clear();
+        }
+
+        // Meshes sem faces (ex.: "o" seguido de outro "o") não vão para o arquivo
+        void endMesh() {
+            if (!m_current.indices.empty()) {
+                m_meshes->push_back(std::move(m_current));
+            }
+            m_current = {};
+        }
+
+        void readPosition(std::istringstream& tokens) {
+            float values[6] = { 0.0f, 0.0f, 0.0f, 1.0f, 1.0f, 1.0f };
+            for (float& value : values) {
+                if (!(tokens >> value)) {
+                    break;
+                }
+            }
+            m_positions.push_back({ { values[0], values[1] }, { values[3], values[4], values[5] } });
+        }
+
+        void readFace(std::istringstream& tokens, const std::string& path, uint32_t lineNumber) {
+            std::vector<uint32_t> face;
+            std::string corner;
+            while (tokens >> corner) {
+                // "a", "a/b", "a//c" ou "a/b/c": só a posição interessa
+                long index = std::strtol(corner.c_str(), nullptr, 10);
+                long count = static_cast<long>(m_positions.size());
+                long resolved = index < 0 ? count + index : index - 1;
+                if (index == 0 || resolved < 0 || resolved >= count) {
+                    throw std::runtime_error(path + ":" + std::to_string(lineNumber) + ": face index out of range");
+                }
+                face.push_back(localIndex(static_cast<uint32_t>(resolved)));
+            }
+            for (size_t i = 2; i < face.size(); i++) {
+                m_current.indices.insert(m_current.indices.end(), { face[0], face[i - 1], face[i] });
+            }
+        }
+
+        // Posições do arquivo inteiro viram vértices locais do mesh corrente
+        uint32_t localIndex(uint32_t position) {
+            auto [it, inserted] = m_remap.try_emplace(position, static_cast<uint32_t>(m_current.vertices.size()));
+            if (inserted) {
+                m_current.vertices.push_back(m_positions[position]);
+            }
+            return it->second;
+        }
+
+        std::vector<vke::Vertex> m_positions;
+        std::unordered_map<uint32_t, uint32_t> m_remap;
+        vke::MeshFileInput m_current;
+        std::vector<vke::MeshFileInput>* m_meshes = nullptr;
+    };
+
+    // glTF: a hierarquia é achatada, cada primitiva de cada nó com mesh vira um
+    // mesh do .vkm com a transformação do nó aplicada aos vértices
+    void readGltf(const std::string& path, vke::JobSystem& jobs, std::vector<vke::MeshFileInput>& outMeshes) {
+        vke::GltfAsset asset = vke::GltfImporter::load(path, &jobs);
+        vke::Scene scene;
+        std::vector<vke::SceneNode> handles = asset.instantiate(scene);
+        scene.updateTransforms(&jobs);
+
+        for (size_t node = 0; node < asset.nodes.size(); node++) {
+            uint32_t meshIndex = asset.nodes[node].mesh;
+            if (meshIndex == vke::GltfNode::kNoMesh || handles[node].isNull()) {
+                continue;
+            }
+            const vke::Mat4& m = scene.getWorldMatrix(handles[node]);
+            const vke::GltfMesh& mesh = asset.meshes[meshIndex];
+            for (uint32_t p = mesh.firstPrimitive; p < mesh.firstPrimitive + mesh.primitiveCount; p++) {
+                const vke::GltfPrimitive& primitive = asset.primitives[p];
+                if (primitive.indices.empty()) {
+                    continue;
+                }
+                vke::MeshFileInput& out = outMeshes.emplace_back();
+                out.vertices = primitive.vertices;
+                out.indices = primitive.indices;
+                // O importador descarta z; a posição do vértice entra com z = 0
+                for (vke::Vertex& vertex : out.vertices) {
+                    float x = vertex.position[0];
+                    float y = vertex.position[1];
+                    vertex.position[0] = m[0] * x + m[4] * y + m[12];
+                    vertex.position[1] = m[1] * x + m[5] * y + m[13];
+                }
+            }
+        }
+    }
+
+    bool isGltf(const std::string& path) {
+        std::string extension = std::filesystem::path(path).extension().string();
+        std::transform(extension.begin(), extension.end(), extension.begin(),
+                       [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+        return extension == ".gltf" || extension == ".glb";
+    }
+
+    void printUsage(const char* program) {
+        std::cerr << "Usage: " << program << " input.obj|input.gltf|input.glb [input...] -o output.vkm\n";
+    }
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::vector<std::string> inputs;
+    std::string output;
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "-o") == 0 && i + 1 < argc) {
+            output = argv[++i];
+        } else if (argv[i][0] == '-') {
+            printUsage(argv[0]);
+            return EXIT_FAILURE;
+        } else {
+            inputs.emplace_back(argv[i]);
+        }
+    }
+    if (inputs.empty() || output.empty()) {
+        printUsage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    try {
+        std::vector<vke::MeshFileInput> meshes;
+        ObjReader reader;
+        vke::JobSystem jobs;
+        for (const std::string& input : inputs) {
+            if (isGltf(input)) {
+                readGltf(input, jobs, meshes);
+            } else {
+                reader.read(input, meshes);
+            }
+        }
+        vke::MeshFile::write(output, meshes);
+
+        // Relê o resultado: o mesmo caminho de validação do Model::loadFromFile
+        vke::MeshFile cooked(output);
+        size_t vertexCount = 0;
+        size_t triangleCount = 0;
+        for (uint32_t i = 0; i < cooked.getMeshCount(); i++) {
+            vertexCount += cooked.getMesh(i).vertexCount;
+            triangleCount += cooked.getMesh(i).indexCount / 3;
+        }
+        std::cout << "Cooked " << cooked.getMeshCount() << " meshes (" << vertexCount << " vertices, "
+                  << triangleCount << " triangles) into " << output << " (" << cooked.getFileSize() << " bytes)\n";
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}